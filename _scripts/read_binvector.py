@@ -0,0 +1,145 @@
+#!/usr/bin/env python3
+"""Reads the .bvec files written by the simu5g_binvector result recorder.
+
+Usage:
+    read_binvector.py FILE                 list the vectors in the file
+    read_binvector.py FILE --csv [FILTER]  dump the vectors (optionally only those whose
+                                           "module.name" contains FILTER) as CSV
+
+The file format is described in src/simu5g/common/BinaryVectorWriter.h.
+"""
+
+import argparse
+import csv
+import struct
+import sys
+
+MAGIC = b"S5GBVEC1"
+
+
+class Reader:
+    def __init__(self, data, pos=0):
+        self.data = data
+        self.pos = pos
+
+    def byte(self):
+        b = self.data[self.pos]
+        self.pos += 1
+        return b
+
+    def varint(self):
+        result = 0
+        shift = 0
+        while True:
+            b = self.byte()
+            result |= (b & 0x7f) << shift
+            if b < 0x80:
+                return result
+            shift += 7
+
+    def signed_varint(self):
+        v = self.varint()
+        return (v >> 1) ^ -(v & 1)
+
+    def string(self):
+        n = self.varint()
+        s = self.data[self.pos:self.pos + n].decode("utf-8")
+        self.pos += n
+        return s
+
+    def times(self, n):
+        result = []
+        t = 0
+        for _ in range(n):
+            t += self.signed_varint()
+            result.append(t)
+        return result
+
+    def doubles(self, n):
+        result = []
+        prev = 0
+        for _ in range(n):
+            header = self.byte()
+            leading = header >> 4
+            trailing = header & 0x0f
+            x = 0
+            for _ in range(8 - leading - trailing):
+                x = (x << 8) | self.byte()
+            prev ^= x << (8 * trailing)
+            result.append(struct.unpack("<d", struct.pack("<Q", prev))[0])
+        return result
+
+
+def read_file(path):
+    """Returns (scale_exponent, vectors), where vectors maps the vector id to a dict with
+    module, name, interval (in seconds, 0 if not decimated) and columns."""
+    with open(path, "rb") as f:
+        data = f.read()
+    if data[:len(MAGIC)] != MAGIC:
+        raise ValueError(f"{path}: not a Simu5G binary vector file")
+    scale_exp = struct.unpack("b", data[len(MAGIC):len(MAGIC) + 1])[0]
+    scale = 10.0 ** scale_exp
+
+    r = Reader(data, len(MAGIC) + 1)
+    vectors = {}
+    while r.pos < len(data):
+        kind = chr(r.byte())
+        vector_id = r.varint()
+        if kind == "V":
+            module = r.string()
+            name = r.string()
+            interval = r.varint() * scale
+            columns = {"time": []}
+            if interval:
+                columns.update({"count": [], "min": [], "max": [], "mean": []})
+            else:
+                columns["value"] = []
+            vectors[vector_id] = {"module": module, "name": name, "interval": interval, "columns": columns}
+            continue
+
+        n = r.varint()
+        length = r.varint()
+        end = r.pos + length
+        columns = vectors[vector_id]["columns"]
+        columns["time"] += [t * scale for t in r.times(n)]
+        if kind == "S":
+            columns["value"] += r.doubles(n)
+        elif kind == "B":
+            columns["count"] += [r.varint() for _ in range(n)]
+            columns["min"] += r.doubles(n)
+            columns["max"] += r.doubles(n)
+            columns["mean"] += r.doubles(n)
+        else:
+            raise ValueError(f"{path}: unknown record type '{kind}'")
+        r.pos = end
+    return scale_exp, vectors
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Reads Simu5G binary vector files (.bvec)")
+    parser.add_argument("file")
+    parser.add_argument("--csv", nargs="?", const="", metavar="FILTER", help="dump the vectors as CSV")
+    args = parser.parse_args()
+
+    _, vectors = read_file(args.file)
+    if args.csv is None:
+        for vector_id, v in sorted(vectors.items()):
+            kind = f"decimated {v['interval']}s" if v["interval"] else "samples"
+            print(f"{vector_id}\t{v['module']}\t{v['name']}\t{len(v['columns']['time'])} {kind}")
+        return
+
+    writer = csv.writer(sys.stdout)
+    writer.writerow(["module", "name", "time", "value", "count", "min", "max"])
+    for vector_id, v in sorted(vectors.items()):
+        if args.csv not in v["module"] + "." + v["name"]:
+            continue
+        c = v["columns"]
+        for i, t in enumerate(c["time"]):
+            if v["interval"]:
+                writer.writerow([v["module"], v["name"], t, c["mean"][i], c["count"][i], c["min"][i], c["max"][i]])
+            else:
+                writer.writerow([v["module"], v["name"], t, c["value"][i], "", "", ""])
+
+
+if __name__ == "__main__":
+    main()
@@ -270,6 +270,12 @@ void DeviceApp::handleSelfMessage(cMessage *msg) {
         if (UalcmpMessage != nullptr)
             delete UalcmpMessage;
         UalcmpMessage = nullptr;
+
+        // a further message may have been received in the meantime
+        if (Http::parseReceivedMsg(std::string_view(), ualcmpMessageBuffer, UalcmpMessage)) {
+            UalcmpMessage->setSockId(ualcmpSocket_.getSocketId());
+            scheduleAt(simTime() + 0.005, processedUalcmpMessage);
+        }
     }
 }
 
@@ -500,11 +506,10 @@ void DeviceApp::socketDataArrived(inet::TcpSocket *socket, inet::Packet *msg, bo
 {
     EV << "DeviceApp::socketDataArrived" << endl;
     std::vector<uint8_t> bytes = msg->peekDataAsBytes()->getBytes();
-    std::string packet(bytes.begin(), bytes.end());
-
-    delete msg;
+    std::string_view packet(reinterpret_cast<const char *>(bytes.data()), bytes.size());
 
     bool res = Http::parseReceivedMsg(packet, ualcmpMessageBuffer, UalcmpMessage);
+    delete msg;
     if (res) {
         EV << "DeviceApp::socketDataArrived - schedule processedUalcmpMessage" << endl;
         UalcmpMessage->setSockId(ualcmpSocket_.getSocketId());
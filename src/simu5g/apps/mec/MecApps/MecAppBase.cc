@@ -104,7 +104,7 @@ void MecAppBase::handleMessage(cMessage *msg)
             if (!packetQueue_.isEmpty()) {
                 double processingTime = scheduleNextMsg(check_and_cast<cMessage *>(packetQueue_.front()));
                 EV << "MecAppBase::scheduleNextMsg() - next msg is processed in " << processingTime << "s" << endl;
-                scheduleAt(simTime() + processingTime, processMessage_);
+                scheduleProcessing(processMessage_, processingTime);
             }
             else {
                 EV << "MecAppBase::handleMessage - no more messages are present in the queue" << endl;
@@ -122,7 +122,7 @@ void MecAppBase::handleMessage(cMessage *msg)
                 if (!msgStatus->httpMessageQueue.isEmpty()) {
                     EV << "MecAppBase::handleMessage(): processedHttpMsg - the httpMessageQueue is not empty, schedule next HTTP message" << endl;
                     double time = vim->calculateProcessingTime(mecAppId, 150);
-                    scheduleAt(simTime() + time, msg);
+                    scheduleProcessing(msg, time);
                 }
             }
         }
@@ -131,7 +131,7 @@ void MecAppBase::handleMessage(cMessage *msg)
         }
     }
     else {
-        if (!processMessage_->isScheduled() && packetQueue_.isEmpty()) {
+        if (!isProcessing(processMessage_) && packetQueue_.isEmpty()) {
             packetQueue_.insert(msg);
             double processingTime;
             if (strcmp(msg->getFullName(), "data") == 0)
@@ -139,9 +139,9 @@ void MecAppBase::handleMessage(cMessage *msg)
             else
                 processingTime = scheduleNextMsg(msg);
             EV << "MecAppBase::scheduleNextMsg() - next msg is processed in " << processingTime << "s" << endl;
-            scheduleAt(simTime() + processingTime, processMessage_);
+            scheduleProcessing(processMessage_, processingTime);
         }
-        else if (processMessage_->isScheduled() && !packetQueue_.isEmpty()) {
+        else if (isProcessing(processMessage_) && !packetQueue_.isEmpty()) {
             packetQueue_.insert(msg);
         }
         else {
@@ -156,6 +156,34 @@ double MecAppBase::scheduleNextMsg(cMessage *msg)
     return processingTime;
 }
 
+void MecAppBase::scheduleProcessing(cMessage *msg, double processingTime)
+{
+    if (vim->isProcessorSharing())
+        vim->startProcessingJob(this, mecAppId, processingTime, msg);
+    else
+        scheduleAt(simTime() + processingTime, msg);
+}
+
+bool MecAppBase::isProcessing(cMessage *msg) const
+{
+    return msg->isScheduled() || vim->isProcessing(msg);
+}
+
+void MecAppBase::cancelProcessing(cMessage *msg)
+{
+    if (msg->isScheduled())
+        cancelEvent(msg);
+    else if (vim->isProcessing(msg))
+        vim->cancelProcessingJob(msg);
+}
+
+void MecAppBase::processingCompleted(cMessage *msg)
+{
+    Enter_Method_Silent("processingCompleted");
+    // deliver the message as if it had been scheduled for the processing time
+    scheduleAt(simTime(), msg);
+}
+
 void MecAppBase::handleProcessedMessage(cMessage *msg)
 {
     if (msg->isSelfMessage()) {
@@ -183,7 +211,7 @@ void MecAppBase::socketDataArrived(inet::TcpSocket *socket, inet::Packet *msg, b
     EV << "MecAppBase::socketDataArrived" << endl;
 
     std::vector<uint8_t> bytes = msg->peekDataAsBytes()->getBytes();
-    std::string packet(bytes.begin(), bytes.end());
+    std::string_view packet(reinterpret_cast<const char *>(bytes.data()), bytes.size());
     HttpMessageStatus *msgStatus = static_cast<HttpMessageStatus *>(socket->getUserData());
 
     bool res = Http::parseReceivedMsg(socket->getSocketId(), packet, msgStatus->httpMessageQueue, msgStatus->bufferedData, msgStatus->currentMessage);
@@ -191,8 +219,8 @@ void MecAppBase::socketDataArrived(inet::TcpSocket *socket, inet::Packet *msg, b
         if (vim == nullptr)
             throw cRuntimeError("MecAppBase::socketDataArrived - vim is null!");
         double time = vim->calculateProcessingTime(mecAppId, 150);
-        if (!msgStatus->processMsgTimer->isScheduled())
-            scheduleAt(simTime() + time, msgStatus->processMsgTimer);
+        if (!isProcessing(msgStatus->processMsgTimer))
+            scheduleProcessing(msgStatus->processMsgTimer, time);
     }
 
     delete msg;
@@ -240,6 +268,7 @@ void MecAppBase::removeSocket(inet::TcpSocket *tcpSock)
     if (msgStatus->currentMessage != nullptr)
         delete msgStatus->currentMessage;
     if (msgStatus->processMsgTimer != nullptr) {
+        cancelProcessing(msgStatus->processMsgTimer);
         cancelAndDelete(msgStatus->processMsgTimer);
     }
     delete sockets_.removeSocket(tcpSock);
@@ -55,7 +55,7 @@ struct HttpMessageStatus
     ProcessingTimeMessage *processMsgTimer = nullptr;
 };
 
-class MecAppBase : public cSimpleModule, public inet::TcpSocket::ICallback
+class MecAppBase : public cSimpleModule, public inet::TcpSocket::ICallback, public IProcessingJobOwner
 {
   protected:
     /* TCP sockets are dynamically created by the user according to her needs
@@ -111,6 +111,17 @@ class MecAppBase : public cSimpleModule, public inet::TcpSocket::ICallback
 
     virtual double scheduleNextMsg(cMessage *msg);
 
+    /*
+     * Schedules msg at the end of a processing time. If the VIM uses processor sharing,
+     * processingTime is the nominal time at the requested CPU and msg is delivered when the
+     * VIM completes the corresponding job
+     */
+    virtual void scheduleProcessing(cMessage *msg, double processingTime);
+
+    // returns true if msg is scheduled or its processing job is in progress
+    virtual bool isProcessing(cMessage *msg) const;
+    virtual void cancelProcessing(cMessage *msg);
+
     virtual inet::TcpSocket *addNewSocket();
 
     virtual void connect(inet::TcpSocket *socket, const inet::L3Address& address, const int port);
@@ -130,6 +141,9 @@ class MecAppBase : public cSimpleModule, public inet::TcpSocket::ICallback
   public:
     ~MecAppBase() override;
 
+    /* IProcessingJobOwner callback method */
+    void processingCompleted(cMessage *msg) override;
+
 };
 
 } //namespace
@@ -0,0 +1,107 @@
+//
+//                  Simu5G
+//
+// Copyright (C) 2019-2021 Giovanni Nardini, Giovanni Stea, Antonio Virdis et al. (University of Pisa)
+// Copyright (C) 2022-2026 Giovanni Nardini, Giovanni Stea et al. (University of Pisa)
+//
+// This file is part of a software released under the license included in file
+// "license.pdf". Please read LICENSE and README files before using it.
+// The above files and the present reference are part of the software itself,
+// and cannot be removed from it.
+//
+
+#include "simu5g/apps/mec/MecRequestResponseApp/LightweightResponseApp.h"
+
+#include <inet/networklayer/common/L3AddressTag_m.h>
+#include <inet/transportlayer/common/L4PortTag_m.h>
+
+#include "simu5g/apps/mec/MecRequestResponseApp/MecResponseApp.h"
+#include "simu5g/apps/mec/MecRequestResponseApp/packets/RequestResponsePacket_m.h"
+
+namespace simu5g {
+
+Register_Class(LightweightResponseApp);
+
+using namespace inet;
+
+LightweightResponseApp::~LightweightResponseApp()
+{
+    while (!requests_.empty()) {
+        delete requests_.front().first;
+        requests_.pop();
+    }
+    // processingTimer_ is owned by the container
+}
+
+void LightweightResponseApp::initialize()
+{
+    EV << "LightweightResponseApp::initialize - MEC application " << instanceId_ << " with mecAppId[" << mecAppId_ << "] has started!" << endl;
+
+    packetSize_ = B(container_->getAppParameter("responsePacketSize", cValue(50)).intValue());
+    minInstructions_ = container_->getAppParameter("minInstructions", cValue(9000000)).intValue();
+    maxInstructions_ = container_->getAppParameter("maxInstructions", cValue(11000000)).intValue();
+
+    processingTimer_ = container_->createTimer(this, "computeMsg");
+}
+
+void LightweightResponseApp::handleUePacket(inet::Packet *packet)
+{
+    auto req = packet->peekAtFront<RequestResponseAppPacket>();
+    if (req->getType() == UEAPP_REQUEST) {
+        requests_.push({packet, simTime()});
+        if (requests_.size() == 1)
+            startProcessing();
+    }
+    else if (req->getType() == UEAPP_STOP) {
+        EV << "LightweightResponseApp::handleUePacket - stop request from the UE app" << endl;
+        delete packet;
+    }
+    else
+        throw cRuntimeError("LightweightResponseApp::handleUePacket - Type not recognized!");
+}
+
+void LightweightResponseApp::startProcessing()
+{
+    processingTime_ = container_->getVim()->calculateProcessingTime(mecAppId_, container_->uniform(minInstructions_, maxInstructions_));
+    processingStarted_ = simTime();
+    container_->scheduleProcessing(this, processingTimer_, processingTime_);
+}
+
+void LightweightResponseApp::handleTimer(cMessage *msg)
+{
+    if (msg == processingTimer_) {
+        sendResponse();
+        if (!requests_.empty())
+            startProcessing();
+    }
+}
+
+void LightweightResponseApp::sendResponse()
+{
+    auto [packet, msgArrived] = requests_.front();
+    requests_.pop();
+
+    L3Address ueAppAddress = packet->getTag<L3AddressInd>()->getSrcAddress();
+    int ueAppPort = packet->getTag<L4PortInd>()->getSrcPort();
+
+    auto req = packet->removeAtFront<RequestResponseAppPacket>();
+    req->setType(MECAPP_RESPONSE);
+    req->setRequestArrivedTimestamp(msgArrived);
+    req->setServiceResponseTime(0);
+    req->setResponseSentTimestamp(simTime());
+    // with processor sharing, the processing takes longer than the nominal time when the CPU is shared
+    req->setProcessingTime(container_->getVim()->isProcessorSharing() ? (simTime() - processingStarted_).dbl() : processingTime_);
+    req->setChunkLength(packetSize_);
+    inet::Packet *pkt = new inet::Packet("ResponseAppPacket");
+    pkt->insertAtBack(req);
+
+    container_->sendToUe(this, pkt, ueAppAddress, ueAppPort);
+    delete packet;
+}
+
+void LightweightResponseApp::finish()
+{
+    container_->cancelTimer(processingTimer_);
+}
+
+} //namespace
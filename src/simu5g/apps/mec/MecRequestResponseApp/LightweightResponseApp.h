@@ -0,0 +1,61 @@
+//
+//                  Simu5G
+//
+// Copyright (C) 2019-2021 Giovanni Nardini, Giovanni Stea, Antonio Virdis et al. (University of Pisa)
+// Copyright (C) 2022-2026 Giovanni Nardini, Giovanni Stea et al. (University of Pisa)
+//
+// This file is part of a software released under the license included in file
+// "license.pdf". Please read LICENSE and README files before using it.
+// The above files and the present reference are part of the software itself,
+// and cannot be removed from it.
+//
+
+#ifndef __LIGHTWEIGHTRESPONSEAPP_H_
+#define __LIGHTWEIGHTRESPONSEAPP_H_
+
+#include <queue>
+
+#include <inet/common/Units.h>
+
+#include "simu5g/mec/vim/MecAppContainer.h"
+
+namespace simu5g {
+
+using namespace omnetpp;
+
+//
+// Lightweight counterpart of MecResponseApp, to be hosted by a MecAppContainer.
+// It serves the requests of a UeRequestApp by simulating their processing on the
+// MEC host, without querying any MEC service. Requests arriving while another one is
+// being processed are queued.
+// Parameters (responsePacketSize, minInstructions, maxInstructions) are read from the
+// appParameters of the container.
+//
+class LightweightResponseApp : public LightweightMecApp
+{
+  protected:
+    // pending requests with their arrival time, the front one is being processed
+    std::queue<std::pair<inet::Packet *, simtime_t>> requests_;
+    cMessage *processingTimer_ = nullptr;
+    double processingTime_ = 0;
+    simtime_t processingStarted_ = 0;
+
+    inet::B packetSize_;
+    int minInstructions_ = 0;
+    int maxInstructions_ = 0;
+
+    void startProcessing();
+    void sendResponse();
+
+  public:
+    ~LightweightResponseApp() override;
+
+    void initialize() override;
+    void handleUePacket(inet::Packet *packet) override;
+    void handleTimer(cMessage *msg) override;
+    void finish() override;
+};
+
+} //namespace
+
+#endif
@@ -33,6 +33,8 @@ using namespace omnetpp;
 
 void MecResponseApp::finish()
 {
+    // the VIM may hold the timer in a processing job
+    cancelProcessing(processingTimer_);
     ueAppSocket_.destroy();
 }
 
@@ -132,7 +134,8 @@ void MecResponseApp::sendResponse()
     req->setRequestArrivedTimestamp(msgArrived_);
     req->setServiceResponseTime(getRequestArrived_ - getRequestSent_);
     req->setResponseSentTimestamp(simTime());
-    req->setProcessingTime(processingTime_);
+    // with processor sharing, the processing takes longer than the nominal time when the CPU is shared
+    req->setProcessingTime(vim->isProcessorSharing() ? (simTime() - processingStarted_).dbl() : processingTime_);
     req->setChunkLength(packetSize_);
     inet::Packet *pkt = new inet::Packet("ResponseAppPacket");
     pkt->insertAtBack(req);
@@ -144,6 +147,7 @@ void MecResponseApp::sendResponse()
     currentRequestfMsg_ = nullptr;
     msgArrived_ = 0;
     processingTime_ = 0;
+    processingStarted_ = 0;
     getRequestArrived_ = 0;
     getRequestSent_ = 0;
 }
@@ -220,8 +224,9 @@ void MecResponseApp::handleServiceMessage(int connId)
 void MecResponseApp::doComputation()
 {
     processingTime_ = vim->calculateProcessingTime(mecAppId, uniform(minInstructions_, maxInstructions_));
+    processingStarted_ = simTime();
     EV << "time " << processingTime_ << endl;
-    scheduleAt(simTime() + processingTime_, processingTimer_);
+    scheduleProcessing(processingTimer_, processingTime_);
 }
 
 void MecResponseApp::sendGetRequest()
@@ -47,6 +47,7 @@ class MecResponseApp : public MecAppBase
     simtime_t getRequestSent_ = 0;
     simtime_t getRequestArrived_ = 0;
     double processingTime_ = 0;
+    simtime_t processingStarted_ = 0;
 
     inet::B packetSize_;
 
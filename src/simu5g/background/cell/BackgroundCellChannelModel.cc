@@ -11,6 +11,9 @@
 //
 
 #include "simu5g/background/cell/BackgroundCellChannelModel.h"
+
+#include <algorithm>
+
 #include "simu5g/background/cell/BackgroundScheduler.h"
 #include "simu5g/stack/phy/LtePhyBase.h"
 #include "simu5g/stack/phy/LtePhyUe.h"
@@ -71,49 +74,155 @@ void BackgroundCellChannelModel::initialize(int stage)
 
 std::vector<double> BackgroundCellChannelModel::getSINR(MacNodeId bgUeId, inet::Coord bgUePos, TrafficGeneratorBase *bgUe, BackgroundScheduler *bgScheduler, Direction dir)
 {
-    unsigned int numBands = bgScheduler->getNumBands();
-    inet::Coord bgBsPos = bgScheduler->getPosition();
-    int bgBsId = bgScheduler->getId();
+    SinrContext ctx;
+    initSinrContext(ctx, bgScheduler, dir);
 
-    //get tx power
-    double recvPower = (dir == DL) ? bgScheduler->getTxPower() : bgUe->getTxPwr(); // dBm
+    std::vector<double> snrVector;
+    computeSinr(ctx, bgUeId, bgUePos, bgUe->getTxPwr(), snrVector);
+    return snrVector;
+}
 
-    double antennaGainTx = 0.0;
-    double antennaGainRx = 0.0;
-    double noiseFigure = 0.0;
+void BackgroundCellChannelModel::getSINR(const std::vector<int>& bgUeIndexes, const BackgroundUeState& bgUeState, BackgroundScheduler *bgScheduler, Direction dir, std::vector<std::vector<double>>& sinr)
+{
+    SinrContext ctx;
+    initSinrContext(ctx, bgScheduler, dir);
+
+    sinr.resize(bgUeIndexes.size());
+    for (size_t k = 0; k < bgUeIndexes.size(); k++) {
+        int index = bgUeIndexes[k];
+        MacNodeId bgUeId = MacNodeId(BGUE_MIN_ID + index);
+        computeSinr(ctx, bgUeId, bgUeState.pos[index], bgUeState.txPower[index], sinr[k]);
+    }
+}
+
+void BackgroundCellChannelModel::initSinrContext(SinrContext& ctx, BackgroundScheduler *bgScheduler, Direction dir)
+{
+    ctx.bgScheduler = bgScheduler;
+    ctx.dir = dir;
+    ctx.numBands = bgScheduler->getNumBands();
+    ctx.bgBsPos = bgScheduler->getPosition();
 
+    double noiseFigure = 0.0;
     if (dir == DL) {
         //set noise Figure
         noiseFigure = ueNoiseFigure_; //dB
         //set antenna gain Figure
-        antennaGainTx = antennaGainEnB_; //dB
-        antennaGainRx = antennaGainUe_;  //dB
+        ctx.antennaGainTx = antennaGainEnB_; //dB
+        ctx.antennaGainRx = antennaGainUe_;  //dB
     }
     else { // if( dir == UL )
         // TODO check if antennaGainEnB should be added in UL direction too
-        antennaGainTx = antennaGainUe_;
-        antennaGainRx = antennaGainEnB_;
+        ctx.antennaGainTx = antennaGainUe_;
+        ctx.antennaGainRx = antennaGainEnB_;
         noiseFigure = bsNoiseFigure_;
     }
 
+    // compute and linearize total noise
+    ctx.totN = dBmToLinear(thermalNoise_ + noiseFigure);
+
+    ctx.multiCellInterference.resize(ctx.numBands);
+    ctx.bgCellInterference.resize(ctx.numBands);
+
+    if (dir != DL)
+        return;
+
+    // collect the interfering e/gNodeBs. Only their distance from the bg UE changes from one UE to another
+    if (enableDownlinkInterference_) {
+        unsigned int numBands = ctx.numBands;
+        for (const auto& enb : binder_->getEnbList()) {
+            MacNodeId id = enb->id;
+
+            // initialize eNb data structures
+            if (!enb->init) {
+                // obtain a reference to enb phy and obtain tx power
+                enb->phy = check_and_cast<LtePhyBase *>(binder_->getPhyByNodeId(id));
+
+                enb->txPwr = enb->phy->getTxPwr();//dBm
+
+                // get tx direction
+                enb->txDirection = enb->phy->getTxDirection();
+
+                // get tx angle
+                enb->txAngle = enb->phy->getTxAngle();
+
+                //get reference to mac layer
+                enb->mac = check_and_cast<LteMacEnb *>(binder_->getMacByNodeId(id));
+
+                enb->init = true;
+            }
+
+            LteRealisticChannelModel *interfChanModel = dynamic_cast<LteRealisticChannelModel *>(enb->phy->getChannelModel(carrierFrequency_));
+
+            // if the interfering BS does not use the selected carrier frequency, skip it
+            if (interfChanModel == nullptr)
+                continue;
+
+            DlInterferer interferer;
+            interferer.pos = enb->phy->getCoord();
+            interferer.txPwr = enb->txPwr;
+            interferer.txDirection = enb->txDirection;
+            interferer.txAngle = enb->txAngle;
+
+            numBands = std::min(numBands, interfChanModel->getNumBands());
+            for (unsigned int i = 0; i < numBands; i++) {
+                if (enb->mac->getDlBandStatus(i) != 0)
+                    interferer.occupiedBands.push_back(i);
+            }
+            ctx.enbInterferers.push_back(std::move(interferer));
+        }
+    }
+
+    // collect the interfering background cells
+    if (enableBackgroundCellInterference_) {
+        unsigned int numBands = ctx.numBands;
+        for (auto& bgCell : binder_->getBackgroundSchedulerList(carrierFrequency_)) {
+            // skip interference from serving Bg Bs
+            if (bgCell->getId() == bgScheduler->getId())
+                continue;
+
+            DlInterferer interferer;
+            interferer.pos = bgCell->getPosition();
+            interferer.txPwr = bgCell->getTxPower();
+            interferer.txDirection = bgCell->getTxDirection();
+            interferer.txAngle = bgCell->getTxAngle();
+
+            numBands = std::min(numBands, bgCell->getNumBands());
+            for (unsigned int i = 0; i < numBands; i++) {
+                if (bgCell->getBandStatus(i, DL) > 0)
+                    interferer.occupiedBands.push_back(i);
+            }
+            ctx.bgCellInterferers.push_back(std::move(interferer));
+        }
+    }
+}
+
+void BackgroundCellChannelModel::computeSinr(SinrContext& ctx, MacNodeId bgUeId, inet::Coord bgUePos, double bgUeTxPower, std::vector<double>& snrVector)
+{
+    Direction dir = ctx.dir;
+    unsigned int numBands = ctx.numBands;
+    inet::Coord bgBsPos = ctx.bgBsPos;
+
+    //get tx power
+    double recvPower = (dir == DL) ? ctx.bgScheduler->getTxPower() : bgUeTxPower; // dBm
+
     double attenuation = getAttenuation(bgUeId, dir, bgBsPos, bgUePos);
 
     //compute attenuation (PATHLOSS + SHADOWING)
     recvPower -= attenuation; // (dBm-dB)=dBm
 
     //add antenna gain
-    recvPower += antennaGainTx; // (dBm+dB)=dBm
-    recvPower += antennaGainRx; // (dBm+dB)=dBm
+    recvPower += ctx.antennaGainTx; // (dBm+dB)=dBm
+    recvPower += ctx.antennaGainRx; // (dBm+dB)=dBm
 
     //sub cable loss
     recvPower -= cableLoss_; // (dBm-dB)=dBm
 
 
     //=============== ANGULAR ATTENUATION =================
-    if (dir == DL && bgScheduler->getTxDirection() == ANISOTROPIC) {
+    if (dir == DL && ctx.bgScheduler->getTxDirection() == ANISOTROPIC) {
 
         // get tx angle
-        double txAngle = bgScheduler->getTxAngle();
+        double txAngle = ctx.bgScheduler->getTxAngle();
 
         // compute the angle between uePosition and reference axis, considering the Bs as center
         double ueAngle = computeAngle(bgBsPos, bgUePos);
@@ -134,69 +243,71 @@ std::vector<double> BackgroundCellChannelModel::getSINR(MacNodeId bgUeId, inet::
     //=============== END ANGULAR ATTENUATION =================
 
     //===================== SINR COMPUTATION ========================
-    std::vector<double> snrVector;
-    snrVector.resize(numBands, recvPower);
-
-    double speed = computeSpeed(bgUeId, bgUePos);
+    snrVector.assign(numBands, recvPower);
 
     // compute and add interference due to fading
     // Apply fading for each band
-    double fadingAttenuation = 0;
-
-    // for each logical band
     // FIXME compute fading only for used RBs
-    for (unsigned int i = 0; i < numBands; i++) {
-        fadingAttenuation = 0;
-        //if fading is enabled
-        if (fading_) {
-            //Appling fading
-            if (fadingType_ == RAYLEIGH)
-                fadingAttenuation = rayleighFading(bgUeId, i);
-
-            else if (fadingType_ == JAKES)
-                fadingAttenuation = jakesFading(bgUeId, speed, i, numBands);
+    if (fading_) {
+        if (fadingType_ == RAYLEIGH) {
+            for (unsigned int i = 0; i < numBands; i++)
+                snrVector[i] += rayleighFading(bgUeId, i); // (dBm+dB)=dBm
+        }
+        else if (fadingType_ == JAKES) {
+            double speed = computeSpeed(bgUeId, bgUePos);
+            for (unsigned int i = 0; i < numBands; i++)
+                snrVector[i] += jakesFading(bgUeId, speed, i, numBands); // (dBm+dB)=dBm
+        }
+    }
+
+    if (dir == UL) {
+        // the interference at the base station is the same for all the bg UEs of the cell
+        if (!ctx.ulDenReady) {
+            //============ MULTI CELL INTERFERENCE COMPUTATION =================
+            // for background UEs, we only compute CQI
+            RbMap rbmap;
+            //vector containing the sum of multicell interference for each band
+            std::fill(ctx.multiCellInterference.begin(), ctx.multiCellInterference.end(), 0.0); // Linear value (mW)
+            if (enableUplinkInterference_)
+                computeUplinkInterference(bgUeId, bgBsPos, carrierFrequency_, rbmap, numBands, &ctx.multiCellInterference);
+
+            //============ BACKGROUND CELLS INTERFERENCE COMPUTATION =================
+            //vector containing the sum of bg-cell interference for each band
+            std::fill(ctx.bgCellInterference.begin(), ctx.bgCellInterference.end(), 0.0); // Linear value (mW)
+            if (enableBackgroundCellInterference_)
+                computeBackgroundCellUplinkInterference(ctx, ctx.bgCellInterference);
+
+            // denominator expressed in dBm as (N+extCell+multiCell)
+            ctx.ulDen.resize(numBands);
+            for (unsigned int i = 0; i < numBands; i++)
+                ctx.ulDen[i] = linearToDBm(ctx.multiCellInterference[i] + ctx.bgCellInterference[i] + ctx.totN);
+            ctx.ulDenReady = true;
         }
-        // add fading contribution to the received pwr
-        double finalRecvPower = recvPower + fadingAttenuation; // (dBm+dB)=dBm
 
-        snrVector[i] = finalRecvPower;
+        // compute final SINR
+        for (unsigned int i = 0; i < numBands; i++)
+            snrVector[i] -= ctx.ulDen[i];
+        return;
     }
 
     //============ MULTI CELL INTERFERENCE COMPUTATION =================
-    // for background UEs, we only compute CQI
-    RbMap rbmap;
-    //vector containing the sum of multicell interference for each band
-    std::vector<double> multiCellInterference; // Linear value (mW)
-    // prepare data structure
-    multiCellInterference.resize(numBands, 0);
-    if (enableDownlinkInterference_ && dir == DL) {
-        computeDownlinkInterference(bgUeId, bgUePos, carrierFrequency_, rbmap, numBands, &multiCellInterference);
-    }
-    else if (enableUplinkInterference_ && dir == UL) {
-        computeUplinkInterference(bgUeId, bgBsPos, carrierFrequency_, rbmap, numBands, &multiCellInterference);
-    }
+    std::fill(ctx.multiCellInterference.begin(), ctx.multiCellInterference.end(), 0.0); // Linear value (mW)
+    if (enableDownlinkInterference_)
+        computeDownlinkInterference(ctx, bgUeId, bgUePos, ctx.multiCellInterference);
 
     //============ BACKGROUND CELLS INTERFERENCE COMPUTATION =================
-    //vector containing the sum of bg-cell interference for each band
-    std::vector<double> bgCellInterference; // Linear value (mW)
-    // prepare data structure
-    bgCellInterference.resize(numBands, 0);
-    if (enableBackgroundCellInterference_) {
-        computeBackgroundCellInterference(bgUeId, bgUePos, bgBsId, bgBsPos, carrierFrequency_, rbmap, dir, numBands, &bgCellInterference); // dBm
-    }
-
-    // compute and linearize total noise
-    double totN = dBmToLinear(thermalNoise_ + noiseFigure);
+    std::fill(ctx.bgCellInterference.begin(), ctx.bgCellInterference.end(), 0.0); // Linear value (mW)
+    if (enableBackgroundCellInterference_)
+        computeBackgroundCellInterference(ctx, bgUePos, ctx.bgCellInterference);
 
     for (unsigned int i = 0; i < numBands; i++) {
         // denominator expressed in dBm as (N+extCell+multiCell)
         //               (      mW                 +          mW           +  mW  )
-        double den = linearToDBm(multiCellInterference[i] + bgCellInterference[i] + totN);
+        double den = linearToDBm(ctx.multiCellInterference[i] + ctx.bgCellInterference[i] + ctx.totN);
 
         // compute final SINR
         snrVector[i] -= den;
     }
-    return snrVector;
 }
 
 double BackgroundCellChannelModel::getAttenuation(MacNodeId nodeId, Direction dir, inet::Coord bgBsCoord, inet::Coord bgUeCoord)
@@ -845,68 +956,27 @@ double BackgroundCellChannelModel::getReceivedPower_bgUe(double txPower, inet::C
     return recvPower;
 }
 
-bool BackgroundCellChannelModel::computeDownlinkInterference(MacNodeId bgUeId, inet::Coord bgUePos, GHz carrierFrequency, const RbMap& rbmap, unsigned int numBands,
-        std::vector<double> *interference)
+void BackgroundCellChannelModel::computeDownlinkInterference(const SinrContext& ctx, MacNodeId bgUeId, inet::Coord bgUePos, std::vector<double>& interference)
 {
     EV << "**** Downlink Interference ****" << endl;
 
-    // reference to the mac/phy/channel of each cell
-
-    int temp;
-    double att;
-
-    double txPwr;
-
-    for (const auto& enb : binder_->getEnbList()) {
-        MacNodeId id = enb->id;
-
-        // initialize eNb data structures
-        if (!enb->init) {
-            // obtain a reference to enb phy and obtain tx power
-            enb->phy = check_and_cast<LtePhyBase *>(binder_->getPhyByNodeId(id));
-
-            enb->txPwr = enb->phy->getTxPwr();//dBm
-
-            // get tx direction
-            enb->txDirection = enb->phy->getTxDirection();
-
-            // get tx angle
-            enb->txAngle = enb->phy->getTxAngle();
-
-            //get reference to mac layer
-            enb->mac = check_and_cast<LteMacEnb *>(binder_->getMacByNodeId(id));
-
-            enb->init = true;
-        }
-
-        Coord bsPos = enb->phy->getCoord();
-
-        LteRealisticChannelModel *interfChanModel = dynamic_cast<LteRealisticChannelModel *>(enb->phy->getChannelModel(carrierFrequency));
-
-        // if the interfering BS does not use the selected carrier frequency, skip it
-        if (interfChanModel == nullptr) {
-            continue;
-        }
+    for (const auto& enb : ctx.enbInterferers) {
+        double att = getAttenuation(bgUeId, DL, enb.pos, bgUePos);
 
-        att = getAttenuation(bgUeId, DL, bsPos, bgUePos);
-
-        EV << "BsId [" << id << "] - attenuation [" << att << "]";
+        EV << "BsPos [" << enb.pos << "] - attenuation [" << att << "]";
 
         //=============== ANGULAR ATTENUATION =================
         double angularAtt = 0;
-        if (enb->txDirection == ANISOTROPIC) {
-            //get tx angle
-            double txAngle = enb->txAngle;
-
+        if (enb.txDirection == ANISOTROPIC) {
             // compute the angle between uePosition and reference axis, considering the eNb as center
-            double ueAngle = computeAngle(bsPos, bgUePos);
+            double ueAngle = computeAngle(enb.pos, bgUePos);
 
             // compute the reception angle between ue and eNb
-            double recvAngle = fabs(txAngle - ueAngle);
+            double recvAngle = fabs(enb.txAngle - ueAngle);
             if (recvAngle > 180)
                 recvAngle = 360 - recvAngle;
 
-            double verticalAngle = computeVerticalAngle(bsPos, bgUePos);
+            double verticalAngle = computeVerticalAngle(enb.pos, bgUePos);
 
             // compute attenuation due to sectorial tx
             angularAtt = computeAngularAttenuation(recvAngle, verticalAngle);
@@ -916,20 +986,14 @@ bool BackgroundCellChannelModel::computeDownlinkInterference(MacNodeId bgUeId, i
         // else, antenna is omni-directional
         //=============== END ANGULAR ATTENUATION =================
 
-        txPwr = enb->txPwr - angularAtt - cableLoss_ + antennaGainEnB_ + antennaGainUe_;
+        double txPwr = enb.txPwr - angularAtt - cableLoss_ + antennaGainEnB_ + antennaGainUe_;
+        double recvPwr = dBmToLinear(txPwr - att); //(dBm-dB)=dBm
 
-        numBands = std::min(numBands, interfChanModel->getNumBands());
-        for (unsigned int i = 0; i < numBands; i++) {
-            // compute the number of occupied slot (unnecessary)
-            temp = enb->mac->getDlBandStatus(i);
-            if (temp != 0)
-                (*interference)[i] += dBmToLinear(txPwr - att); //(dBm-dB)=dBm
+        EV << " - pwr[" << txPwr << "] on " << enb.occupiedBands.size() << " occupied bands" << endl;
 
-            EV << "\t band " << i << " occupied " << temp << "/pwr[" << txPwr << "]-int[" << (*interference)[i] << "]" << endl;
-        }
+        for (unsigned int band : enb.occupiedBands)
+            interference[band] += recvPwr;
     }
-
-    return true;
 }
 
 bool BackgroundCellChannelModel::computeUplinkInterference(MacNodeId bgUeId, inet::Coord bgBsPos, GHz carrierFrequency, const RbMap& rbmap, unsigned int numBands,
@@ -981,130 +1045,95 @@ bool BackgroundCellChannelModel::computeUplinkInterference(MacNodeId bgUeId, ine
     return true;
 }
 
-bool BackgroundCellChannelModel::computeBackgroundCellInterference(MacNodeId bgUeId, inet::Coord bgUeCoord, int bgBsId, inet::Coord bgBsCoord, GHz carrierFrequency, const RbMap& rbmap, Direction dir,
-        unsigned int numBands, std::vector<double> *interference)
+void BackgroundCellChannelModel::computeBackgroundCellInterference(const SinrContext& ctx, inet::Coord bgUeCoord, std::vector<double>& interference)
 {
     EV << "**** Background Cell Interference **** " << endl;
 
-    // get external cell list
-    const BackgroundSchedulerList& list = binder_->getBackgroundSchedulerList(carrierFrequency);
-
-    double dist, // meters
-           txPwr, // dBm
-           recvPwr, // watt
-           recvPwrDBm, // dBm
-           att, // dBm
-           angularAtt; // dBm
-
-    //compute distance for each cell
-    for (auto& bgScheduler : list) {
-        // skip interference from serving Bg Bs
-        if (bgScheduler->getId() == bgBsId)
-            continue;
-
-        if (dir == DL) {
-            // compute interference with respect to the background base station
-
-            // get external cell position
-            Coord c = bgScheduler->getPosition();
-
-            // computer distance between UE and the ext cell
-            dist = bgUeCoord.distance(c);
-
-            EV << "\t distance between BgUe[" << bgUeCoord.x << "," << bgUeCoord.y <<
-                "] and backgroundCell[" << c.x << "," << c.y << "] is -> "
-               << dist << "\t";
-
-            // compute attenuation according to some path loss model
-            bool los = false;
-            double dbp = 0;
-            att = computePathLoss(dist, dbp, los);
-
-            txPwr = bgScheduler->getTxPower();
-
-            //=============== ANGULAR ATTENUATION =================
-            if (bgScheduler->getTxDirection() == OMNI) {
-                angularAtt = 0;
-            }
-            else {
-                // compute the angle between uePosition and reference axis, considering the eNb as center
-                double ueAngle = computeAngle(c, bgUeCoord);
+    // compute interference with respect to the background base stations
+    for (const auto& bgCell : ctx.bgCellInterferers) {
+        // computer distance between UE and the ext cell
+        double dist = bgUeCoord.distance(bgCell.pos);
 
-                // compute the reception angle between ue and eNb
-                double recvAngle = fabs(bgScheduler->getTxAngle() - ueAngle);
+        EV << "\t distance between BgUe[" << bgUeCoord.x << "," << bgUeCoord.y <<
+            "] and backgroundCell[" << bgCell.pos.x << "," << bgCell.pos.y << "] is -> "
+           << dist << "\t";
 
-                if (recvAngle > 180)
-                    recvAngle = 360 - recvAngle;
+        // compute attenuation according to some path loss model
+        bool los = false;
+        double dbp = 0;
+        double att = computePathLoss(dist, dbp, los);
 
-                double verticalAngle = computeVerticalAngle(c, bgUeCoord);
-
-                // compute attenuation due to sectorial tx
-                angularAtt = computeAngularAttenuation(recvAngle, verticalAngle);
-            }
-            //=============== END ANGULAR ATTENUATION =================
+        //=============== ANGULAR ATTENUATION =================
+        double angularAtt = 0;
+        if (bgCell.txDirection != OMNI) {
+            // compute the angle between uePosition and reference axis, considering the eNb as center
+            double ueAngle = computeAngle(bgCell.pos, bgUeCoord);
 
-            // TODO do we need to use (- cableLoss_ + antennaGainEnB_) in ext cells too?
-            // compute and linearize received power
-            recvPwrDBm = txPwr - att - angularAtt - cableLoss_ + antennaGainEnB_ + antennaGainUe_;
-            recvPwr = dBmToLinear(recvPwrDBm);
+            // compute the reception angle between ue and eNb
+            double recvAngle = fabs(bgCell.txAngle - ueAngle);
 
-            numBands = std::min(numBands, bgScheduler->getNumBands());
+            if (recvAngle > 180)
+                recvAngle = 360 - recvAngle;
 
-            // add interference in those bands where the ext cell is active
-            for (unsigned int i = 0; i < numBands; i++) {
-                int occ = 0;
-                occ = bgScheduler->getBandStatus(i, DL);
+            double verticalAngle = computeVerticalAngle(bgCell.pos, bgUeCoord);
 
-                // if the ext cell is active, add interference
-                if (occ > 0) {
-                    (*interference)[i] += recvPwr;
-                }
-            }
+            // compute attenuation due to sectorial tx
+            angularAtt = computeAngularAttenuation(recvAngle, verticalAngle);
         }
-        else { // dir == UL
-            // for each RB occupied in the background cell, compute interference with respect to the
-            // background UE that is using that RB
-            TrafficGeneratorBase *bgUe;
+        //=============== END ANGULAR ATTENUATION =================
 
-            double antennaGainBgUe = antennaGainUe_;  // TODO get this from the bgUe
+        // TODO do we need to use (- cableLoss_ + antennaGainEnB_) in ext cells too?
+        // compute and linearize received power
+        double recvPwrDBm = bgCell.txPwr - att - angularAtt - cableLoss_ + antennaGainEnB_ + antennaGainUe_;
+        double recvPwr = dBmToLinear(recvPwrDBm);
 
-            angularAtt = 0;  // we assume OMNI directional UEs
+        // add interference in those bands where the ext cell is active
+        for (unsigned int band : bgCell.occupiedBands)
+            interference[band] += recvPwr;
+    }
+}
 
-            numBands = std::min(numBands, bgScheduler->getNumBands());
+void BackgroundCellChannelModel::computeBackgroundCellUplinkInterference(const SinrContext& ctx, std::vector<double>& interference)
+{
+    EV << "**** Background Cell Uplink Interference **** " << endl;
 
-            // add interference in those bands where a UE in the background cell is active
-            for (unsigned int i = 0; i < numBands; i++) {
-                int occ = 0;
+    inet::Coord bgBsCoord = ctx.bgBsPos;
+    double antennaGainBgUe = antennaGainUe_;  // TODO get this from the bgUe
+    double angularAtt = 0;  // we assume OMNI directional UEs
 
-                occ = bgScheduler->getBandStatus(i, UL);
-                if (occ)
-                    bgUe = bgScheduler->getBandInterferingUe(i);
+    // for each RB occupied in the background cell, compute interference with respect to the
+    // background UE that is using that RB
+    unsigned int numBands = ctx.numBands;
+    for (auto& bgScheduler : binder_->getBackgroundSchedulerList(carrierFrequency_)) {
+        // skip interference from serving Bg Bs
+        if (bgScheduler->getId() == ctx.bgScheduler->getId())
+            continue;
 
-                // if the ext cell is active, add interference
-                if (occ) {
-                    txPwr = bgUe->getTxPwr();
-                    Coord c = bgUe->getCoord();
-                    dist = bgBsCoord.distance(c);
+        numBands = std::min(numBands, bgScheduler->getNumBands());
 
-                    EV << "\t distance between BgBS[" << bgBsCoord.x << "," << bgBsCoord.y <<
-                        "] and backgroundUE[" << c.x << "," << c.y << "] is -> "
-                       << dist << "\t";
+        // add interference in those bands where a UE in the background cell is active
+        for (unsigned int i = 0; i < numBands; i++) {
+            if (!bgScheduler->getBandStatus(i, UL))
+                continue;
 
-                    // compute attenuation according to some path loss model
-                    bool los = false;
-                    double dbp = 0;
-                    att = computePathLoss(dist, dbp, los);
+            TrafficGeneratorBase *bgUe = bgScheduler->getBandInterferingUe(i);
+            double txPwr = bgUe->getTxPwr();
+            Coord c = bgUe->getCoord();
+            double dist = bgBsCoord.distance(c);
 
-                    recvPwrDBm = txPwr - att - angularAtt - cableLoss_ + antennaGainEnB_ + antennaGainBgUe;
-                    recvPwr = dBmToLinear(recvPwrDBm);
+            EV << "\t distance between BgBS[" << bgBsCoord.x << "," << bgBsCoord.y <<
+                "] and backgroundUE[" << c.x << "," << c.y << "] is -> "
+               << dist << "\t";
 
-                    (*interference)[i] += recvPwr;
-                }
-            }
+            // compute attenuation according to some path loss model
+            bool los = false;
+            double dbp = 0;
+            double att = computePathLoss(dist, dbp, los);
+
+            double recvPwrDBm = txPwr - att - angularAtt - cableLoss_ + antennaGainEnB_ + antennaGainBgUe;
+            interference[i] += dBmToLinear(recvPwrDBm);
         }
     }
-
-    return true;
 }
 
 } //namespace
@@ -17,6 +17,7 @@
 
 #include "simu5g/common/LteCommon.h"
 #include "simu5g/common/binder/Binder.h"
+#include "simu5g/background/trafficGenerator/BackgroundUeState.h"
 
 namespace simu5g {
 
@@ -275,9 +276,53 @@ class BackgroundCellChannelModel : public cSimpleModule
     double getTwoDimDistance(inet::Coord a, inet::Coord b);
     double computeAngularAttenuation(double hAngle, double vAngle);
 
-    bool computeDownlinkInterference(MacNodeId bgUeId, inet::Coord bgUePos, GHz carrierFrequency, const RbMap& rbmap, unsigned int numBands, std::vector<double> *interference);
+    // a base station interfering in DL, with the bands it is currently using
+    struct DlInterferer
+    {
+        inet::Coord pos;
+        double txPwr;
+        TxDirectionType txDirection;
+        double txAngle;
+        std::vector<unsigned int> occupiedBands;
+    };
+
+    // data shared by all the SINR computations performed for the same background cell and direction
+    struct SinrContext
+    {
+        BackgroundScheduler *bgScheduler;
+        Direction dir;
+        unsigned int numBands;
+        inet::Coord bgBsPos;
+        double antennaGainTx;
+        double antennaGainRx;
+
+        // total noise [mW]
+        double totN;
+
+        // DL only: e/gNodeBs and background cells interfering with the bg UEs
+        std::vector<DlInterferer> enbInterferers;
+        std::vector<DlInterferer> bgCellInterferers;
+
+        // UL only: interference plus noise at the background base station [dBm]. It does not depend on
+        // the bg UE, hence it is computed once, when the first bg UE is evaluated
+        bool ulDenReady = false;
+        std::vector<double> ulDen;
+
+        // scratch vectors of interference [mW]
+        std::vector<double> multiCellInterference;
+        std::vector<double> bgCellInterference;
+    };
+
+    // gather the per-cell data needed to compute the SINR of the bg UEs
+    void initSinrContext(SinrContext& ctx, BackgroundScheduler *bgScheduler, Direction dir);
+
+    // compute the SINR of a single bg UE on each band
+    void computeSinr(SinrContext& ctx, MacNodeId bgUeId, inet::Coord bgUePos, double bgUeTxPower, std::vector<double>& snrVector);
+
+    void computeDownlinkInterference(const SinrContext& ctx, MacNodeId bgUeId, inet::Coord bgUePos, std::vector<double>& interference);
     bool computeUplinkInterference(MacNodeId bgUeId, inet::Coord bgUePos, GHz carrierFrequency, const RbMap& rbmap, unsigned int numBands, std::vector<double> *interference);
-    bool computeBackgroundCellInterference(MacNodeId bgUeId, inet::Coord bgUeCoord, int bgBsId, inet::Coord bgBsCoord, GHz carrierFrequency, const RbMap& rbmap, Direction dir, unsigned int numBands, std::vector<double> *interference);
+    void computeBackgroundCellInterference(const SinrContext& ctx, inet::Coord bgUeCoord, std::vector<double>& interference);
+    void computeBackgroundCellUplinkInterference(const SinrContext& ctx, std::vector<double>& interference);
 
   protected:
     void initialize(int stage) override;
@@ -298,6 +343,12 @@ class BackgroundCellChannelModel : public cSimpleModule
      */
     virtual std::vector<double> getSINR(MacNodeId bgUeId, inet::Coord bgUePos, TrafficGeneratorBase *bgUe, BackgroundScheduler *bgScheduler, Direction dir);
 
+    /*
+     * Compute SINR for each band for all the given bg UEs of the cell in one pass. Interferers and their band
+     * occupancy are collected once, and in UL the interference at the base station is shared by all the UEs
+     */
+    virtual void getSINR(const std::vector<int>& bgUeIndexes, const BackgroundUeState& bgUeState, BackgroundScheduler *bgScheduler, Direction dir, std::vector<std::vector<double>>& sinr);
+
     /*
      * Compute received power for a background UE according to pathloss
      *
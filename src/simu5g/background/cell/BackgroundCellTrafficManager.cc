@@ -66,10 +66,16 @@ std::vector<double> BackgroundCellTrafficManager::getSINR(int bgUeIndex, Directi
     return snr;
 }
 
+void BackgroundCellTrafficManager::getBatchSINR(const std::vector<int>& bgUeIndexes, Direction dir, std::vector<std::vector<double>>& sinr)
+{
+    BackgroundCellChannelModel *bgChannelModel = bgScheduler_->getChannelModel();
+    bgChannelModel->getSINR(bgUeIndexes, bgUeState_, bgScheduler_, dir, sinr);
+}
+
 unsigned int BackgroundCellTrafficManager::getBackloggedUeBytesPerBlock(MacNodeId bgUeId, Direction dir)
 {
     int index = num(bgUeId) - BGUE_MIN_ID;
-    Cqi cqi = bgUe_.at(index)->getCqi(dir);
+    Cqi cqi = bgUeState_.cqi[dir].at(index);
 
     return bgAmc_->computeBitsPerRbBackground(cqi, dir, carrierFrequency_) / 8;
 }
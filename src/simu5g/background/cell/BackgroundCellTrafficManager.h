@@ -40,6 +40,7 @@ class BackgroundCellTrafficManager : public BackgroundTrafficManagerBase
     double getTtiPeriod() override;
     bool isSetBgTrafficManagerInfoInit() override;
     std::vector<double> getSINR(int bgUeIndex, Direction dir, inet::Coord bgUePos, double bgUeTxPower) override;
+    void getBatchSINR(const std::vector<int>& bgUeIndexes, Direction dir, std::vector<std::vector<double>>& sinr) override;
 
   public:
     ~BackgroundCellTrafficManager() override;
@@ -74,7 +74,7 @@ std::vector<double> BackgroundTrafficManager::getSINR(int bgUeIndex, Direction d
 unsigned int BackgroundTrafficManager::getBackloggedUeBytesPerBlock(MacNodeId bgUeId, Direction dir)
 {
     int index = num(bgUeId) - BGUE_MIN_ID;
-    Cqi cqi = bgUe_.at(index)->getCqi(dir);
+    Cqi cqi = bgUeState_.cqi[dir].at(index);
 
     // Get bytes per block based on CQI
     return mac_->getAmc()->computeBitsPerRbBackground(cqi, dir, carrierFrequency_) / 8;
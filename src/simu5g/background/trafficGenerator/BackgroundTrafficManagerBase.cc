@@ -11,40 +11,21 @@
 //
 
 #include "simu5g/background/trafficGenerator/BackgroundTrafficManagerBase.h"
+
+#include <algorithm>
+
 #include "simu5g/background/trafficGenerator/ActiveUeNotification_m.h"
 #include "simu5g/stack/phy/channelmodel/LteChannelModel.h"
 
 namespace simu5g {
 
-const double BackgroundTrafficManagerBase::nrCqiTable[16] = {
-    -9999.0,
-    -9999.0,
-    -9999.0,
-    -5.5,
-    -3.5,
-    -1.5,
-    0.5,
-    4.5,
-    5.5,
-    7.5,
-    10.5,
-    12.5,
-    15.5,
-    17.5,
-    21.5,
-    25.5
-};
-
-double BackgroundTrafficManagerBase::getCqiFromTable(double snr)
+BackgroundTrafficManagerBase::~BackgroundTrafficManagerBase()
 {
-    for (unsigned int i = 0; i < 16; i++) {
-        if (snr < nrCqiTable[i])
-            return i - 1;
-    }
-    return 15;
+    cancelAndDelete(arrivalTick_);
+    for (auto& group : cqiUpdateGroups_)
+        cancelAndDelete(group.tick);
 }
 
-
 void BackgroundTrafficManagerBase::initialize(int stage)
 {
     cSimpleModule::initialize(stage);
@@ -56,6 +37,9 @@ void BackgroundTrafficManagerBase::initialize(int stage)
         for (int i = 0; i < numBgUEs_; i++)
             bgUe_.push_back(check_and_cast<TrafficGeneratorBase *>(getParentModule()->getSubmodule("bgUE", i)->getSubmodule("generator")));
 
+        // generators may have already registered themselves, resize() preserves their entries
+        bgUeState_.resize(numBgUEs_);
+
         phyPisaData_ = &(binder_->phyPisaData);
     }
     if (stage == INITSTAGE_SIMU5G_BACKGROUNDTRAFFICMANAGER) {
@@ -78,6 +62,19 @@ void BackgroundTrafficManagerBase::initialize(int stage)
 
 void BackgroundTrafficManagerBase::handleMessage(cMessage *msg)
 {
+    if (msg == arrivalTick_) {
+        handleArrivals();
+        return;
+    }
+
+    for (auto& group : cqiUpdateGroups_) {
+        if (msg == group.tick) {
+            updateCqi(group);
+            scheduleAt(simTime() + group.period, group.tick);
+            return;
+        }
+    }
+
     if (msg->isSelfMessage()) { // this is an activeUeNotification message
         ActiveUeNotification *notification = check_and_cast<ActiveUeNotification *>(msg);
 
@@ -104,10 +101,127 @@ void BackgroundTrafficManagerBase::notifyBacklog(int index, Direction dir, bool
     }
 }
 
+void BackgroundTrafficManagerBase::scheduleArrival(int index, Direction dir, simtime_t time)
+{
+    Enter_Method_Silent("BackgroundTrafficManagerBase::scheduleArrival");
+
+    if (dir != DL && dir != UL)
+        throw cRuntimeError("BackgroundTrafficManagerBase::scheduleArrival - unrecognized direction: %d", dir);
+
+    pendingArrivals_.push({time, index, dir});
+
+    // this is invoked during initialization, when the TTI period may not be known yet
+    if (arrivalTick_ == nullptr)
+        arrivalTick_ = new cMessage("arrivalTick");
+    scheduleArrivalTick(false);
+}
+
+void BackgroundTrafficManagerBase::handleArrivals()
+{
+    // generate the traffic of all the bg UEs whose arrival is due. The generators
+    // do not keep any self message, hence one event per TTI serves all of them
+    while (!pendingArrivals_.empty() && pendingArrivals_.top().time <= NOW) {
+        PendingArrival arrival = pendingArrivals_.top();
+        pendingArrivals_.pop();
+
+        simtime_t offset = bgUe_.at(arrival.index)->generateArrival(arrival.dir);
+        if (offset <= 0)
+            throw cRuntimeError("BackgroundTrafficManagerBase::handleArrivals - non-positive inter-arrival time for bg UE %d", arrival.index);
+
+        // the next arrival is relative to the exact arrival time, only its generation is deferred
+        // to the TTI boundary. Arrivals due within the current TTI are generated by this loop
+        pendingArrivals_.push({arrival.time + offset, arrival.index, arrival.dir});
+    }
+
+    scheduleArrivalTick(true);
+}
+
+void BackgroundTrafficManagerBase::scheduleArrivalTick(bool alignToTti)
+{
+    if (pendingArrivals_.empty())
+        return;
+
+    simtime_t next = pendingArrivals_.top().time;
+    if (alignToTti) {
+        // postpone the arrival to the next TTI boundary, so that all the arrivals
+        // falling within the same TTI are handled by the same event. Arrivals are
+        // not visible to the scheduler before the next TTI anyway
+        int64_t ttiPeriod = SimTime(getTtiPeriod()).raw();
+        next = SimTime::fromRaw((next.raw() + ttiPeriod - 1) / ttiPeriod * ttiPeriod);
+    }
+    if (next < NOW)
+        next = NOW;
+
+    if (arrivalTick_->isScheduled()) {
+        if (arrivalTick_->getArrivalTime() <= next)
+            return;
+        cancelEvent(arrivalTick_);
+    }
+    scheduleAt(next, arrivalTick_);
+}
+
+void BackgroundTrafficManagerBase::removeBgUe(std::vector<int>& bgUes, int index)
+{
+    // preserve the order of the remaining UEs, since it determines the scheduling order
+    bgUes.erase(std::remove(bgUes.begin(), bgUes.end(), index), bgUes.end());
+}
+
+void BackgroundTrafficManagerBase::registerCqiUpdate(int index, simtime_t period)
+{
+    Enter_Method_Silent("BackgroundTrafficManagerBase::registerCqiUpdate");
+
+    for (auto& group : cqiUpdateGroups_) {
+        if (group.period == period) {
+            group.bgUes.push_back(index);
+            return;
+        }
+    }
+
+    // first UE with this period, start updating the CQI now
+    CqiUpdateGroup group;
+    group.period = period;
+    group.tick = new cMessage("cqiUpdateTick");
+    group.bgUes.push_back(index);
+    scheduleAt(simTime(), group.tick);
+    cqiUpdateGroups_.push_back(group);
+}
+
+void BackgroundTrafficManagerBase::updateCqi(const CqiUpdateGroup& group)
+{
+    for (Direction dir : {DL, UL}) {
+        cqiUpdateUes_.clear();
+        for (int index : group.bgUes) {
+            if (bgUe_.at(index)->isTrafficEnabled(dir))
+                cqiUpdateUes_.push_back(index);
+        }
+        if (cqiUpdateUes_.empty())
+            continue;
+
+        getBatchSINR(cqiUpdateUes_, dir, cqiUpdateSinr_);
+        for (size_t k = 0; k < cqiUpdateUes_.size(); k++) {
+            int index = cqiUpdateUes_[k];
+            bgUeState_.cqi[dir][index] = computeMeanCqi(index, cqiUpdateSinr_[k], dir);
+        }
+    }
+}
+
+void BackgroundTrafficManagerBase::getBatchSINR(const std::vector<int>& bgUeIndexes, Direction dir, std::vector<std::vector<double>>& sinr)
+{
+    sinr.resize(bgUeIndexes.size());
+    for (size_t k = 0; k < bgUeIndexes.size(); k++) {
+        int index = bgUeIndexes[k];
+        sinr[k] = getSINR(index, dir, bgUeState_.pos[index], bgUeState_.txPower[index]);
+    }
+}
+
 Cqi BackgroundTrafficManagerBase::computeCqi(int bgUeIndex, Direction dir, inet::Coord bgUePos, double bgUeTxPower)
 {
     std::vector<double> snr = getSINR(bgUeIndex, dir, bgUePos, bgUeTxPower);
+    return computeMeanCqi(bgUeIndex, snr, dir);
+}
 
+Cqi BackgroundTrafficManagerBase::computeMeanCqi(int bgUeIndex, const std::vector<double>& snr, Direction dir)
+{
     // convert the SNR to CQI and compute the mean
     double meanSinr = 0;
     Cqi bandCqi, meanCqi = 0;
@@ -140,26 +254,28 @@ Cqi BackgroundTrafficManagerBase::computeCqiFromSinr(double sinr)
     if (newsnr > phyPisaData_->maxSnr())
         return 15;
 
-    unsigned int txm = 1;
-    std::vector<double> min;
-    int found = 0;
-    double low = 2;
-
-    // TODO do this once in the initialize
-    min.resize(phyPisaData_->nCqi(), 2);
-
-    double targetBler = 0.01; // TODO get this from parameters
-
-    for (int i = 0; i < phyPisaData_->nCqi(); i++) {
-        double tmp = phyPisaData_->getBler(txm, i + 1, newsnr);
-        double diff = targetBler - tmp;
-        min[i] = (diff > 0) ? diff : (diff * -1);
-        if (low >= min[i]) {
-            found = i;
-            low = min[i];
+    if (sinrToCqi_.empty()) {
+        // for each SINR, select the CQI whose BLER is the closest to the target one
+        unsigned int txm = 1;
+        double targetBler = 0.01; // TODO get this from parameters
+
+        sinrToCqiMinSnr_ = phyPisaData_->minSnr();
+        for (int snr = sinrToCqiMinSnr_; snr <= phyPisaData_->maxSnr(); snr++) {
+            int found = 0;
+            double low = 2;
+            for (int i = 0; i < phyPisaData_->nCqi(); i++) {
+                double tmp = phyPisaData_->getBler(txm, i + 1, snr);
+                double diff = targetBler - tmp;
+                double min = (diff > 0) ? diff : (diff * -1);
+                if (low >= min) {
+                    found = i;
+                    low = min;
+                }
+            }
+            sinrToCqi_.push_back(found + 1);
         }
     }
-    return found + 1;
+    return sinrToCqi_[newsnr - sinrToCqiMinSnr_];
 }
 
 TrafficGeneratorBase *BackgroundTrafficManagerBase::getTrafficGenerator(MacNodeId bgUeId)
@@ -178,7 +294,7 @@ std::vector<TrafficGeneratorBase *>::const_iterator BackgroundTrafficManagerBase
     return bgUe_.end();
 }
 
-std::list<int>::const_iterator BackgroundTrafficManagerBase::getBackloggedUesBegin(Direction dir, bool rtx)
+std::vector<int>::const_iterator BackgroundTrafficManagerBase::getBackloggedUesBegin(Direction dir, bool rtx)
 {
     if (!rtx)
         return backloggedBgUes_[dir].begin();
@@ -186,7 +302,7 @@ std::list<int>::const_iterator BackgroundTrafficManagerBase::getBackloggedUesBeg
         return backloggedRtxBgUes_[dir].begin();
 }
 
-std::list<int>::const_iterator BackgroundTrafficManagerBase::getBackloggedUesEnd(Direction dir, bool rtx)
+std::vector<int>::const_iterator BackgroundTrafficManagerBase::getBackloggedUesEnd(Direction dir, bool rtx)
 {
     if (!rtx)
         return backloggedBgUes_[dir].end();
@@ -194,12 +310,12 @@ std::list<int>::const_iterator BackgroundTrafficManagerBase::getBackloggedUesEnd
         return backloggedRtxBgUes_[dir].end();
 }
 
-std::list<int>::const_iterator BackgroundTrafficManagerBase::getWaitingForRacUesBegin()
+std::vector<int>::const_iterator BackgroundTrafficManagerBase::getWaitingForRacUesBegin()
 {
     return waitingForRac_.begin();
 }
 
-std::list<int>::const_iterator BackgroundTrafficManagerBase::getWaitingForRacUesEnd()
+std::vector<int>::const_iterator BackgroundTrafficManagerBase::getWaitingForRacUesEnd()
 {
     return waitingForRac_.end();
 }
@@ -207,7 +323,7 @@ std::list<int>::const_iterator BackgroundTrafficManagerBase::getWaitingForRacUes
 unsigned int BackgroundTrafficManagerBase::getBackloggedUeBuffer(MacNodeId bgUeId, Direction dir, bool rtx)
 {
     int index = num(bgUeId) - BGUE_MIN_ID;
-    return bgUe_.at(index)->getBufferLength(dir, rtx);
+    return (!rtx) ? bgUeState_.bufferedBytes[dir].at(index) : bgUeState_.bufferedBytesRtx[dir].at(index);
 }
 
 unsigned int BackgroundTrafficManagerBase::consumeBackloggedUeBytes(MacNodeId bgUeId, unsigned int bytes, Direction dir, bool rtx)
@@ -217,9 +333,9 @@ unsigned int BackgroundTrafficManagerBase::consumeBackloggedUeBytes(MacNodeId bg
 
     if (newBuffLen == 0) { // bg UE is no longer active
         if (!rtx)
-            backloggedBgUes_[dir].remove(index);
+            removeBgUe(backloggedBgUes_[dir], index);
         else
-            backloggedRtxBgUes_[dir].remove(index);
+            removeBgUe(backloggedRtxBgUes_[dir], index);
     }
     return newBuffLen;
 }
@@ -230,7 +346,7 @@ void BackgroundTrafficManagerBase::racHandled(MacNodeId bgUeId)
 
     int index = num(bgUeId) - BGUE_MIN_ID;
 
-    waitingForRac_.remove(index);
+    removeBgUe(waitingForRac_, index);
 
     // some bytes have been added in the RB assigned for the first BSR, consume them from the buffer
     // TODO consider MAC and RLC header?
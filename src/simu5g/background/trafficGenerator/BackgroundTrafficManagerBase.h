@@ -13,6 +13,8 @@
 #ifndef BACKGROUNDTRAFFICMANAGERBASE_H_
 #define BACKGROUNDTRAFFICMANAGERBASE_H_
 
+#include <queue>
+
 #include <inet/common/ModuleRefByPar.h>
 
 #include "simu5g/common/LteCommon.h"
@@ -43,14 +45,54 @@ class BackgroundTrafficManagerBase : public cSimpleModule, public IBackgroundTra
     // reference to all the background UEs
     std::vector<TrafficGeneratorBase *> bgUe_;
 
+    // status of all the background UEs (position, tx power, CQI, backlog)
+    BackgroundUeState bgUeState_;
+
     // indexes of the backlogged bg UEs
-    std::list<int> backloggedBgUes_[2];
+    std::vector<int> backloggedBgUes_[2];
 
     // indexes of the backlogged bg UEs for retransmission
-    std::list<int> backloggedRtxBgUes_[2];
+    std::vector<int> backloggedRtxBgUes_[2];
 
     // indexes of the backlogged bg UEs waiting for RAC+BSR handshake
-    std::list<int> waitingForRac_;
+    std::vector<int> waitingForRac_;
+
+    /********************************************
+     * Support to per-TTI generation of traffic *
+     * *****************************************/
+
+    struct PendingArrival
+    {
+        simtime_t time;
+        int index;
+        Direction dir;
+
+        bool operator>(const PendingArrival& other) const
+        {
+            if (time != other.time)
+                return time > other.time;
+            if (index != other.index)
+                return index > other.index;
+            return dir > other.dir;
+        }
+    };
+
+    // next arrival of the bg UEs whose traffic is generated by this module, earliest first
+    std::priority_queue<PendingArrival, std::vector<PendingArrival>, std::greater<PendingArrival>> pendingArrivals_;
+
+    // self message triggering the generation of all the arrivals due in the current TTI
+    cMessage *arrivalTick_ = nullptr;
+
+    // generate the traffic for all the bg UEs whose arrival is due
+    void handleArrivals();
+
+    // schedule arrivalTick_ at the TTI boundary following the earliest pending arrival
+    void scheduleArrivalTick(bool alignToTti);
+
+    // remove the given bg UE from a list of backlogged UEs
+    static void removeBgUe(std::vector<int>& bgUes, int index);
+
+    /********************************************/
 
     // reference to binder module
     inet::ModuleRefByPar<Binder> binder_;
@@ -84,7 +126,31 @@ class BackgroundTrafficManagerBase : public cSimpleModule, public IBackgroundTra
 
     /*************************************/
 
-    static const double nrCqiTable[16];
+    /*******************************************
+     * Support to batch computation of the CQI *
+     * ****************************************/
+
+    // bg UEs whose CQI is periodically updated by this module with the same period
+    struct CqiUpdateGroup
+    {
+        simtime_t period;
+        cMessage *tick;
+        std::vector<int> bgUes;
+    };
+    std::vector<CqiUpdateGroup> cqiUpdateGroups_;
+
+    // scratch structures used by updateCqi()
+    std::vector<int> cqiUpdateUes_;
+    std::vector<std::vector<double>> cqiUpdateSinr_;
+
+    // compute the CQI of all the bg UEs of the given group
+    void updateCqi(const CqiUpdateGroup& group);
+
+    /*******************************************/
+
+    // CQI corresponding to each integer SINR between PhyPisaData's minSnr() and maxSnr(). Built on first use
+    std::vector<Cqi> sinrToCqi_;
+    int sinrToCqiMinSnr_ = 0;
 
   protected:
 
@@ -92,15 +158,20 @@ class BackgroundTrafficManagerBase : public cSimpleModule, public IBackgroundTra
     int numInitStages() const override { return inet::NUM_INIT_STAGES; }
     void handleMessage(cMessage *msg) override;
 
-    static double getCqiFromTable(double snr);
-
     virtual double getTtiPeriod() = 0;
     virtual bool isSetBgTrafficManagerInfoInit() = 0;
     virtual std::vector<double> getSINR(int bgUeIndex, Direction dir, inet::Coord bgUePos, double bgUeTxPower) = 0;
 
+    // compute the SINR of all the given bg UEs. By default, this invokes getSINR() for each UE
+    virtual void getBatchSINR(const std::vector<int>& bgUeIndexes, Direction dir, std::vector<std::vector<double>>& sinr);
+
+    // convert the per-band SINR of the given bg UE to its CQI and record the measured SINR
+    Cqi computeMeanCqi(int bgUeIndex, const std::vector<double>& snr, Direction dir);
+
     // define functions for interactions with the NIC
 
   public:
+    ~BackgroundTrafficManagerBase() override;
 
     // set carrier frequency
     void setCarrierFrequency(GHz carrierFrequency) override { carrierFrequency_ = carrierFrequency; }
@@ -114,6 +185,15 @@ class BackgroundTrafficManagerBase : public cSimpleModule, public IBackgroundTra
     // invoked by the UE's traffic generator when new data is backlogged
     void notifyBacklog(int index, Direction dir, bool rtx = false) override;
 
+    // returns the per-UE status arrays shared with the traffic generators
+    BackgroundUeState& getBgUeState() override { return bgUeState_; }
+
+    // invoked by the UE's traffic generator to have its next arrival generated by this module
+    void scheduleArrival(int index, Direction dir, simtime_t time) override;
+
+    // invoked by the UE's traffic generator to have its CQI periodically computed by this module
+    void registerCqiUpdate(int index, simtime_t period) override;
+
     // returns the CQI based on the given position and power
     Cqi computeCqi(int bgUeIndex, Direction dir, inet::Coord bgUePos, double bgUeTxPower = 0.0) override;
 
@@ -128,12 +208,12 @@ class BackgroundTrafficManagerBase : public cSimpleModule, public IBackgroundTra
     std::vector<TrafficGeneratorBase *>::const_iterator getBgUesEnd() override;
 
     // returns the begin (end) iterator of the vector of backlogged UEs
-    std::list<int>::const_iterator getBackloggedUesBegin(Direction dir, bool rtx = false) override;
-    std::list<int>::const_iterator getBackloggedUesEnd(Direction dir, bool rtx = false) override;
+    std::vector<int>::const_iterator getBackloggedUesBegin(Direction dir, bool rtx = false) override;
+    std::vector<int>::const_iterator getBackloggedUesEnd(Direction dir, bool rtx = false) override;
 
     // returns the begin (end) iterator of the vector of backlogged UEs that are waiting for RAC handshake to finish
-    std::list<int>::const_iterator getWaitingForRacUesBegin() override;
-    std::list<int>::const_iterator getWaitingForRacUesEnd() override;
+    std::vector<int>::const_iterator getWaitingForRacUesBegin() override;
+    std::vector<int>::const_iterator getWaitingForRacUesEnd() override;
 
     // returns the buffer of the given UE for in the given direction
     unsigned int getBackloggedUeBuffer(MacNodeId bgUeId, Direction dir, bool rtx = false) override;
@@ -0,0 +1,70 @@
+//
+//                  Simu5G
+//
+// Copyright (C) 2019-2021 Giovanni Nardini, Giovanni Stea, Antonio Virdis et al. (University of Pisa)
+// Copyright (C) 2022-2026 Giovanni Nardini, Giovanni Stea et al. (University of Pisa)
+//
+// This file is part of a software released under the license included in file
+// "license.pdf". Please read LICENSE and README files before using it.
+// The above files and the present reference are part of the software itself,
+// and cannot be removed from it.
+//
+
+#ifndef BACKGROUNDUESTATE_H_
+#define BACKGROUNDUESTATE_H_
+
+#include <vector>
+
+#include <inet/common/geometry/common/Coord.h>
+
+#include "simu5g/common/LteTypes.h"
+
+namespace simu5g {
+
+//
+// BackgroundUeState
+//
+// Status of all the background UEs handled by one traffic manager, stored as a
+// structure of arrays indexed by the bg UE index. Schedulers and channel models
+// scan these attributes for every backlogged UE at every TTI, hence each of them
+// is kept contiguous rather than scattered across the traffic generator modules.
+//
+struct BackgroundUeState
+{
+    // position of the bg UEs
+    std::vector<inet::Coord> pos;
+
+    // tx power of the bg UEs [dBm]
+    std::vector<double> txPower;
+
+    // current DL and UL CQI
+    std::vector<Cqi> cqi[2];
+
+    // current DL and UL backlog
+    std::vector<unsigned int> bufferedBytes[2];
+
+    // current DL and UL backlog for retransmissions
+    std::vector<unsigned int> bufferedBytesRtx[2];
+
+    size_t size() const { return pos.size(); }
+
+    // make room for at least n bg UEs. Existing entries are left untouched, so that
+    // generators and managers can size the arrays in any initialization order
+    void resize(size_t n)
+    {
+        if (n <= size())
+            return;
+
+        pos.resize(n);
+        txPower.resize(n, 0.0);
+        for (int dir = 0; dir < 2; dir++) {
+            cqi[dir].resize(n, 0);
+            bufferedBytes[dir].resize(n, 0);
+            bufferedBytesRtx[dir].resize(n, 0);
+        }
+    }
+};
+
+} //namespace
+
+#endif
@@ -13,11 +13,11 @@
 #ifndef IBACKGROUNDTRAFFICMANAGER_H_
 #define IBACKGROUNDTRAFFICMANAGER_H_
 
-#include <list>
 #include <vector>
 
 #include <inet/common/geometry/common/Coord.h>
 
+#include "simu5g/background/trafficGenerator/BackgroundUeState.h"
 #include "simu5g/background/trafficGenerator/generators/TrafficGeneratorBase.h"
 #include "simu5g/common/LteCommon.h"
 #include "simu5g/common/LteCommonEnum_m.h"
@@ -46,6 +46,17 @@ class IBackgroundTrafficManager
     // Invoked by the UE's traffic generator when new data is backlogged
     virtual void notifyBacklog(int index, Direction dir, bool rtx = false) = 0;
 
+    // Returns the per-UE status arrays shared with the traffic generators
+    virtual BackgroundUeState& getBgUeState() = 0;
+
+    // Invoked by the UE's traffic generator to have its next arrival generated
+    // by the manager, together with the other arrivals of the same TTI
+    virtual void scheduleArrival(int index, Direction dir, omnetpp::simtime_t time) = 0;
+
+    // Invoked by the UE's traffic generator to have its CQI periodically computed by the
+    // manager, in one pass together with the other UEs having the same period
+    virtual void registerCqiUpdate(int index, omnetpp::simtime_t period) = 0;
+
     // Returns the CQI based on the given position and power
     virtual Cqi computeCqi(int bgUeIndex, Direction dir, inet::Coord bgUePos, double bgUeTxPower = 0.0) = 0;
 
@@ -60,12 +71,12 @@ class IBackgroundTrafficManager
     virtual std::vector<TrafficGeneratorBase *>::const_iterator getBgUesEnd() = 0;
 
     // Returns the begin (end) iterator of the vector of backlogged UEs
-    virtual std::list<int>::const_iterator getBackloggedUesBegin(Direction dir, bool rtx = false) = 0;
-    virtual std::list<int>::const_iterator getBackloggedUesEnd(Direction dir, bool rtx = false) = 0;
+    virtual std::vector<int>::const_iterator getBackloggedUesBegin(Direction dir, bool rtx = false) = 0;
+    virtual std::vector<int>::const_iterator getBackloggedUesEnd(Direction dir, bool rtx = false) = 0;
 
     // Returns the begin (end) iterator of the vector of backlogged UEs that are waiting for RAC handshake to finish
-    virtual std::list<int>::const_iterator getWaitingForRacUesBegin() = 0;
-    virtual std::list<int>::const_iterator getWaitingForRacUesEnd() = 0;
+    virtual std::vector<int>::const_iterator getWaitingForRacUesBegin() = 0;
+    virtual std::vector<int>::const_iterator getWaitingForRacUesEnd() = 0;
 
     // Returns the buffer of the given UE in the given direction
     virtual unsigned int getBackloggedUeBuffer(MacNodeId bgUeId, Direction dir, bool rtx = false) = 0;
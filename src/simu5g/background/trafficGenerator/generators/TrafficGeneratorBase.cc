@@ -31,8 +31,6 @@ simsignal_t TrafficGeneratorBase::bgHarqErrorRateUlSignal_ = registerSignal("bgH
 TrafficGeneratorBase::TrafficGeneratorBase()
 {
     selfSource_[DL] = selfSource_[UL] = nullptr;
-    bufferedBytes_[DL] = bufferedBytes_[UL] = 0;
-    bufferedBytesRtx_[DL] = bufferedBytesRtx_[UL] = 0;
     trafficEnabled_[DL] = trafficEnabled_[UL] = false;
 }
 
@@ -54,7 +52,6 @@ void TrafficGeneratorBase::initialize(int stage)
         startTime_[UL] = par("startTimeUl");
 
         headerLen_ = par("headerLen");
-        txPower_ = par("txPower");
 
         rtxRate_[DL] = par("rtxRateDl");
         rtxRate_[UL] = par("rtxRateUl");
@@ -64,16 +61,33 @@ void TrafficGeneratorBase::initialize(int stage)
 
         bgTrafficManager_.reference(this, "backgroundTrafficManagerModule", true);
 
+        // the manager may not be initialized yet, resize() preserves the entries of other UEs
+        state_ = &bgTrafficManager_->getBgUeState();
+        state_->resize(bgUeIndex_ + 1);
+        state_->txPower[bgUeIndex_] = par("txPower");
+
+        ttiArrivals_ = par("ttiArrivals");
+
         if (startTime_[DL] >= 0.0) {
             trafficEnabled_[DL] = true;
-            selfSource_[DL] = new cMessage("selfSourceDl");
-            scheduleAt(simTime() + startTime_[DL], selfSource_[DL]);
+            if (ttiArrivals_) {
+                bgTrafficManager_->scheduleArrival(bgUeIndex_, DL, simTime() + startTime_[DL]);
+            }
+            else {
+                selfSource_[DL] = new cMessage("selfSourceDl");
+                scheduleAt(simTime() + startTime_[DL], selfSource_[DL]);
+            }
         }
 
         if (startTime_[UL] >= 0.0) {
             trafficEnabled_[UL] = true;
-            selfSource_[UL] = new cMessage("selfSourceUl");
-            scheduleAt(simTime() + startTime_[UL], selfSource_[UL]);
+            if (ttiArrivals_) {
+                bgTrafficManager_->scheduleArrival(bgUeIndex_, UL, simTime() + startTime_[UL]);
+            }
+            else {
+                selfSource_[UL] = new cMessage("selfSourceUl");
+                scheduleAt(simTime() + startTime_[UL], selfSource_[UL]);
+            }
         }
 
         cqiMeanDl_ = par("cqiMeanDl");
@@ -86,27 +100,33 @@ void TrafficGeneratorBase::initialize(int stage)
         computeAvgInterference_ = par("computeAvgInterference");
         if (enablePeriodicCqiUpdate_) {
             fbPeriod_ = (simtime_t)(int(par("fbPeriod")) * TTI); // TTI -> seconds
-            fbSource_ = new cMessage("fbSource");
-            scheduleAt(simTime(), fbSource_);
+            if (par("batchCqiUpdate").boolValue() && !useProbabilisticCqi_) {
+                // the manager computes the CQI of all the UEs with the same period at once
+                bgTrafficManager_->registerCqiUpdate(bgUeIndex_, fbPeriod_);
+            }
+            else {
+                fbSource_ = new cMessage("fbSource");
+                scheduleAt(simTime(), fbSource_);
+            }
         }
         else if (!computeAvgInterference_) {
             // use fixed CQI given as parameters
 
             double cqiDl = normal(cqiMeanDl_, cqiStddevDl_);
             if (cqiDl > 15)
-                cqi_[DL] = 15;
+                cqi(DL) = 15;
             else if (cqiDl < 2)
-                cqi_[DL] = 2;
+                cqi(DL) = 2;
             else
-                cqi_[DL] = floor(cqiDl);
+                cqi(DL) = floor(cqiDl);
 
             double cqiUl = normal(cqiMeanUl_, cqiStddevUl_);
             if (cqiUl > 15)
-                cqi_[UL] = 15;
+                cqi(UL) = 15;
             else if (cqiUl < 2)
-                cqi_[UL] = 2;
+                cqi(UL) = 2;
             else
-                cqi_[UL] = floor(cqiUl);
+                cqi(UL) = floor(cqiUl);
         }
 
         // register to get a notification when positions change
@@ -130,32 +150,20 @@ void TrafficGeneratorBase::handleMessage(cMessage *msg)
             updateMeasurements();
 
         if (msg == selfSource_[DL]) {
-            unsigned int genBytes = generateTraffic(DL);
-            if (genBytes == bufferedBytes_[DL]) {
-                // the UE has become active, signal to the manager
-                bgTrafficManager_->notifyBacklog(bgUeIndex_, DL);
-            }
-
             // generate new traffic in 'offset' seconds
-            simtime_t offset = getNextGenerationTime(DL);
+            simtime_t offset = handleArrival(DL);
             scheduleAt(simTime() + offset, selfSource_[DL]);
         }
         else if (msg == selfSource_[UL]) {
-            unsigned int genBytes = generateTraffic(UL);
-            if (genBytes == bufferedBytes_[UL]) {
-                // the UE has become active, signal to the manager
-                bgTrafficManager_->notifyBacklog(bgUeIndex_, UL);
-            }
-
             // generate new traffic in 'offset' seconds
-            simtime_t offset = getNextGenerationTime(UL);
+            simtime_t offset = handleArrival(UL);
             scheduleAt(simTime() + offset, selfSource_[UL]);
         }
         else if (!strcmp(msg->getName(), "rtxNotification")) {
             RtxNotification *rtxNotification = check_and_cast<RtxNotification *>(msg);
             Direction dir = rtxNotification->getDirection();
-            bufferedBytesRtx_[dir] += rtxNotification->getBytes();
-            if (rtxNotification->getBytes() == bufferedBytesRtx_[dir]) {
+            bufferedBytesRtx(dir) += rtxNotification->getBytes();
+            if (rtxNotification->getBytes() == bufferedBytesRtx(dir)) {
                 // the UE has become active, signal to the manager
                 bgTrafficManager_->notifyBacklog(bgUeIndex_, dir, true);
             }
@@ -164,6 +172,28 @@ void TrafficGeneratorBase::handleMessage(cMessage *msg)
     }
 }
 
+simtime_t TrafficGeneratorBase::handleArrival(Direction dir)
+{
+    unsigned int genBytes = generateTraffic(dir);
+    if (genBytes == bufferedBytes(dir)) {
+        // the UE has become active, signal to the manager
+        bgTrafficManager_->notifyBacklog(bgUeIndex_, dir);
+    }
+
+    return getNextGenerationTime(dir);
+}
+
+simtime_t TrafficGeneratorBase::generateArrival(Direction dir)
+{
+    Enter_Method_Silent("TrafficGeneratorBase::generateArrival");
+
+    // same as for self messages, see handleMessage()
+    if (!enablePeriodicCqiUpdate_ && !computeAvgInterference_ && positionUpdated_)
+        updateMeasurements();
+
+    return handleArrival(dir);
+}
+
 void TrafficGeneratorBase::updateMeasurements()
 {
     if (useProbabilisticCqi_) {
@@ -171,29 +201,29 @@ void TrafficGeneratorBase::updateMeasurements()
             double cqiDl = normal(cqiMeanDl_, cqiStddevDl_);
 
             if (cqiDl > 15)
-                cqi_[DL] = 15;
+                cqi(DL) = 15;
             else if (cqiDl < 2)
-                cqi_[DL] = 2;
+                cqi(DL) = 2;
             else
-                cqi_[DL] = floor(cqiDl + 0.5);
+                cqi(DL) = floor(cqiDl + 0.5);
         }
 
         if (trafficEnabled_[UL]) {
             double cqiUl = normal(cqiMeanUl_, cqiStddevUl_);
             if (cqiUl > 15)
-                cqi_[UL] = 15;
+                cqi(UL) = 15;
             else if (cqiUl < 2)
-                cqi_[UL] = 2;
+                cqi(UL) = 2;
             else
-                cqi_[UL] = floor(cqiUl + 0.5);
+                cqi(UL) = floor(cqiUl + 0.5);
         }
     }
     else {
         if (trafficEnabled_[DL])
-            cqi_[DL] = bgTrafficManager_->computeCqi(bgUeIndex_, DL, pos_);
+            cqi(DL) = bgTrafficManager_->computeCqi(bgUeIndex_, DL, getCoord());
 
         if (trafficEnabled_[UL])
-            cqi_[UL] = bgTrafficManager_->computeCqi(bgUeIndex_, UL, pos_, txPower_);
+            cqi(UL) = bgTrafficManager_->computeCqi(bgUeIndex_, UL, getCoord(), getTxPwr());
     }
 
     positionUpdated_ = false;
@@ -202,7 +232,7 @@ void TrafficGeneratorBase::updateMeasurements()
 unsigned int TrafficGeneratorBase::generateTraffic(Direction dir)
 {
     unsigned int dataLen = (dir == DL) ? par("packetSizeDl") : par("packetSizeUl");
-    bufferedBytes_[dir] += (dataLen + headerLen_);
+    bufferedBytes(dir) += (dataLen + headerLen_);
     return dataLen + headerLen_;
 }
 
@@ -217,19 +247,19 @@ simtime_t TrafficGeneratorBase::getNextGenerationTime(Direction dir)
 unsigned int TrafficGeneratorBase::getBufferLength(Direction dir, bool rtx)
 {
     if (!rtx)
-        return bufferedBytes_[dir];
+        return bufferedBytes(dir);
     else
-        return bufferedBytesRtx_[dir];
+        return bufferedBytesRtx(dir);
 }
 
 void TrafficGeneratorBase::setCqiFromSinr(double sinr, Direction dir)
 {
-    cqi_[dir] = bgTrafficManager_->computeCqiFromSinr(sinr);
+    cqi(dir) = bgTrafficManager_->computeCqiFromSinr(sinr);
 }
 
 Cqi TrafficGeneratorBase::getCqi(Direction dir)
 {
-    return cqi_[dir];
+    return cqi(dir);
 }
 
 unsigned int TrafficGeneratorBase::consumeBytes(int bytes, Direction dir, bool rtx)
@@ -239,22 +269,15 @@ unsigned int TrafficGeneratorBase::consumeBytes(int bytes, Direction dir, bool r
     if (dir != DL && dir != UL)
         throw cRuntimeError("TrafficGeneratorBase::consumeBytes - unrecognized direction: %d", dir);
 
-    if (!rtx) {
-        if (bytes > bufferedBytes_[dir])
-            bytes = bufferedBytes_[dir];
+    unsigned int& buffered = (!rtx) ? bufferedBytes(dir) : bufferedBytesRtx(dir);
+    if (bytes > buffered)
+        bytes = buffered;
 
-        bufferedBytes_[dir] -= bytes;
-    }
-    else {
-        if (bytes > bufferedBytesRtx_[dir])
-            bytes = bufferedBytesRtx_[dir];
-
-        bufferedBytesRtx_[dir] -= bytes;
-    }
+    buffered -= bytes;
 
     // this simulates a transmission, so emit CQI statistic
     simsignal_t cqiSignal = (dir == DL) ? bgAverageCqiDlSignal_ : bgAverageCqiUlSignal_;
-    emit(cqiSignal, (long)cqi_[dir]);
+    emit(cqiSignal, (long)cqi(dir));
 
     // "schedule" a retransmission with the given probability
     double err = uniform(0.0, 1.0);
@@ -272,14 +295,14 @@ unsigned int TrafficGeneratorBase::consumeBytes(int bytes, Direction dir, bool r
         emit(harqErrorSignal, 0.0);
     }
 
-    return (!rtx) ? bufferedBytes_[dir] : bufferedBytesRtx_[dir];
+    return buffered;
 }
 
 void TrafficGeneratorBase::receiveSignal(cComponent *source, simsignal_t signalID, cObject *obj, cObject *)
 {
     if (signalID == inet::IMobility::mobilityStateChangedSignal) {
         inet::IMobility *mobility = check_and_cast<inet::IMobility *>(obj);
-        pos_ = mobility->getCurrentPosition();
+        state_->pos[bgUeIndex_] = mobility->getCurrentPosition();
         positionUpdated_ = true;
     }
 }
@@ -17,6 +17,7 @@
 #include <inet/mobility/contract/IMobility.h>
 
 #include "simu5g/common/LteCommon.h"
+#include "simu5g/background/trafficGenerator/BackgroundUeState.h"
 #include "simu5g/background/trafficGenerator/IBackgroundTrafficManager.h"
 
 namespace simu5g {
@@ -36,6 +37,12 @@ class TrafficGeneratorBase : public cSimpleModule, public cListener
     // index of the bg UE within the vector of bg UEs
     int bgUeIndex_;
 
+    // status arrays of the bg UEs owned by the traffic manager
+    BackgroundUeState *state_ = nullptr;
+
+    // if true, arrivals are generated by the traffic manager once per TTI rather than by selfSource_
+    bool ttiArrivals_;
+
     // self messages for DL and UL
     cMessage *selfSource_[2];
 
@@ -47,9 +54,6 @@ class TrafficGeneratorBase : public cSimpleModule, public cListener
     // total length of above-the-MAC-layer headers
     unsigned int headerLen_;
 
-    // tx power of the bg UE
-    double txPower_;
-
     // if true, the CQI of the bg UE is affected by external interference
     bool enablePeriodicCqiUpdate_;
 
@@ -73,17 +77,10 @@ class TrafficGeneratorBase : public cSimpleModule, public cListener
 
     /*
      * STATUS
+     *
+     * backlog, CQI, position and tx power are stored in the manager's BackgroundUeState
      */
 
-    // current DL and UL backlog
-    unsigned int bufferedBytes_[2];
-
-    // current DL and UL backlog for retransmissions
-    unsigned int bufferedBytesRtx_[2];
-
-    // the physical position of the UE (derived from display string or from mobility models)
-    inet::Coord pos_;
-
     // flag that signals when new SNR and CQI must be computed
     bool positionUpdated_;
 
@@ -93,9 +90,6 @@ class TrafficGeneratorBase : public cSimpleModule, public cListener
     double cqiMeanUl_;
     double cqiStddevUl_;
 
-    // current CQI based on the last position update
-    Cqi cqi_[2];
-
     // statistics
     static simsignal_t bgMeasuredSinrDlSignal_;
     static simsignal_t bgMeasuredSinrUlSignal_;
@@ -111,6 +105,14 @@ class TrafficGeneratorBase : public cSimpleModule, public cListener
     // get new values for SINR and CQI
     void updateMeasurements();
 
+    // accessors to the status of this bg UE
+    unsigned int& bufferedBytes(Direction dir) { return state_->bufferedBytes[dir][bgUeIndex_]; }
+    unsigned int& bufferedBytesRtx(Direction dir) { return state_->bufferedBytesRtx[dir][bgUeIndex_]; }
+    Cqi& cqi(Direction dir) { return state_->cqi[dir][bgUeIndex_]; }
+
+    // generate new traffic, notify the manager if the UE became active and return the time to the next arrival
+    simtime_t handleArrival(Direction dir);
+
     // virtual functions that implement the generation of
     // traffic according to some distribution
     virtual unsigned int generateTraffic(Direction dir);
@@ -127,14 +129,20 @@ class TrafficGeneratorBase : public cSimpleModule, public cListener
     virtual double getAvgLoad(Direction dir) { return 1000.0; }
 
     // returns the tx power of this bg UE
-    virtual double getTxPwr() { return txPower_; }
+    virtual double getTxPwr() { return state_->txPower[bgUeIndex_]; }
 
     // returns the position of this bg UE
-    virtual inet::Coord getCoord() { return pos_; }
+    virtual inet::Coord getCoord() { return state_->pos[bgUeIndex_]; }
+
+    // invoked by the traffic manager when the next arrival is due (per-TTI generation only)
+    simtime_t generateArrival(Direction dir);
 
     // This module is subscribed to position changes.
     void receiveSignal(cComponent *source, simsignal_t signalID, cObject *obj, cObject *) override;
 
+    // returns true if this bg UE generates traffic in the given direction
+    bool isTrafficEnabled(Direction dir) const { return trafficEnabled_[dir]; }
+
     // returns the number of buffered bytes for the given direction
     unsigned int getBufferLength(Direction dir, bool rtx = false);
 
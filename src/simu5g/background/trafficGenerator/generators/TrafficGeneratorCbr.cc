@@ -31,7 +31,7 @@ void TrafficGeneratorCbr::initialize(int stage)
 
 unsigned int TrafficGeneratorCbr::generateTraffic(Direction dir)
 {
-    bufferedBytes_[dir] += (size_[dir] + headerLen_);
+    bufferedBytes(dir) += (size_[dir] + headerLen_);
     return size_[dir] + headerLen_;
 }
 
@@ -0,0 +1,262 @@
+//
+//                  Simu5G
+//
+// Copyright (C) 2022-2026 Giovanni Nardini, Giovanni Stea et al. (University of Pisa)
+//
+// This file is part of a software released under the license included in file
+// "license.pdf". Please read LICENSE and README files before using it.
+// The above files and the present reference are part of the software itself,
+// and cannot be removed from it.
+//
+
+#include "simu5g/common/BinaryVectorWriter.h"
+
+#include <cstring>
+#include <filesystem>
+
+namespace simu5g {
+
+Register_PerRunConfigOption(CFGID_BINVECTOR_FILE, "binvector-file", CFG_FILENAME, "",
+        "Output file of the simu5g_binvector result recorder. Defaults to "
+        "${resultdir}/${configname}-${runnumber}.bvec");
+Register_PerRunConfigOption(CFGID_BINVECTOR_CHUNK_SIZE, "binvector-chunk-size", CFG_INT, "4096",
+        "Number of samples (or time buckets) buffered for each vector by the simu5g_binvector "
+        "result recorder before they are handed over to the writer thread");
+
+BinaryVectorWriter *BinaryVectorWriter::instance = nullptr;
+int BinaryVectorWriter::numUsers = 0;
+
+namespace {
+
+void putVarint(std::string& out, uint64_t value)
+{
+    while (value >= 0x80) {
+        out.push_back((char)((value & 0x7f) | 0x80));
+        value >>= 7;
+    }
+    out.push_back((char)value);
+}
+
+void putSignedVarint(std::string& out, int64_t value)
+{
+    putVarint(out, ((uint64_t)value << 1) ^ (uint64_t)(value >> 63));
+}
+
+void putString(std::string& out, const std::string& str)
+{
+    putVarint(out, str.size());
+    out.append(str);
+}
+
+void putTimes(std::string& out, const std::vector<int64_t>& times)
+{
+    int64_t prev = 0;
+    for (int64_t t : times) {
+        putSignedVarint(out, t - prev);
+        prev = t;
+    }
+}
+
+void putDoubles(std::string& out, const std::vector<double>& values)
+{
+    uint64_t prev = 0;
+    for (double value : values) {
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        uint64_t x = bits ^ prev;
+        prev = bits;
+        if (x == 0) {
+            out.push_back((char)0x80);
+            continue;
+        }
+        int leading = __builtin_clzll(x) / 8;
+        int trailing = __builtin_ctzll(x) / 8;
+        out.push_back((char)((leading << 4) | trailing));
+        for (int i = 7 - leading; i >= trailing; i--)
+            out.push_back((char)(x >> (8 * i)));
+    }
+}
+
+} // namespace
+
+void BinaryVectorChunk::clear()
+{
+    kind = SAMPLES;
+    vectorId = -1;
+    moduleName.clear();
+    vectorName.clear();
+    decimationInterval = 0;
+    times.clear();
+    values.clear();
+    counts.clear();
+    mins.clear();
+    maxs.clear();
+}
+
+BinaryVectorWriter *BinaryVectorWriter::acquire()
+{
+    if (instance == nullptr) {
+        cConfigurationEx *config = getEnvir()->getConfigEx();
+        std::string fileName = config->getAsFilename(CFGID_BINVECTOR_FILE);
+        if (fileName.empty())
+            fileName = std::string(config->getVariable(CFGVAR_RESULTDIR)) + "/" + config->getVariable(CFGVAR_CONFIGNAME) + "-" + config->getVariable(CFGVAR_RUNNUMBER) + ".bvec";
+        long chunkSize = config->getAsInt(CFGID_BINVECTOR_CHUNK_SIZE);
+        if (chunkSize < 1)
+            throw cRuntimeError("BinaryVectorWriter: binvector-chunk-size must be positive");
+        instance = new BinaryVectorWriter(fileName, chunkSize);
+    }
+    numUsers++;
+    return instance;
+}
+
+void BinaryVectorWriter::release()
+{
+    if (--numUsers == 0 && instance->runEnded) {
+        delete instance;
+        instance = nullptr;
+    }
+}
+
+void BinaryVectorWriter::lifecycleEvent(SimulationLifecycleEventType eventType, cObject *details)
+{
+    if (eventType != LF_ON_RUN_END && eventType != LF_ON_SHUTDOWN)
+        return;
+    runEnded = true;
+    // otherwise, the recorders still alive are deleted with the network and the last one closes the file
+    if (numUsers == 0) {
+        instance = nullptr;
+        delete this;
+    }
+}
+
+BinaryVectorWriter::BinaryVectorWriter(const std::string& fileName, size_t chunkSize) : fileName(fileName), chunkSize(chunkSize)
+{
+    std::filesystem::path dir = std::filesystem::path(fileName).parent_path();
+    if (!dir.empty()) {
+        std::error_code ec;
+        std::filesystem::create_directories(dir, ec);
+    }
+    file = fopen(fileName.c_str(), "wb");
+    if (file == nullptr)
+        throw cRuntimeError("BinaryVectorWriter: cannot open output file '%s'", fileName.c_str());
+
+    std::string header("S5GBVEC1");
+    header.push_back((char)SimTime::getScaleExp());
+    fwrite(header.data(), 1, header.size(), file);
+
+    thread = std::thread(&BinaryVectorWriter::run, this);
+    getSimulation()->addLifecycleListener(this);
+}
+
+BinaryVectorWriter::~BinaryVectorWriter()
+{
+    getSimulation()->removeLifecycleListener(this);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    queueChanged.notify_one();
+    thread.join();
+    fclose(file);
+}
+
+int BinaryVectorWriter::declareVector(const std::string& moduleName, const std::string& vectorName, simtime_t decimationInterval)
+{
+    auto chunk = obtainChunk();
+    chunk->kind = BinaryVectorChunk::DECLARATION;
+    chunk->vectorId = numVectors++;
+    chunk->moduleName = moduleName;
+    chunk->vectorName = vectorName;
+    chunk->decimationInterval = decimationInterval.raw();
+    int id = chunk->vectorId;
+    submit(std::move(chunk));
+    return id;
+}
+
+std::unique_ptr<BinaryVectorChunk> BinaryVectorWriter::obtainChunk()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!freeChunks.empty()) {
+            auto chunk = std::move(freeChunks.back());
+            freeChunks.pop_back();
+            return chunk;
+        }
+    }
+    return std::make_unique<BinaryVectorChunk>();
+}
+
+void BinaryVectorWriter::submit(std::unique_ptr<BinaryVectorChunk> chunk)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        queue.push_back(std::move(chunk));
+    }
+    queueChanged.notify_one();
+}
+
+bool BinaryVectorWriter::hasFailed()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return failed;
+}
+
+void BinaryVectorWriter::run()
+{
+    std::deque<std::unique_ptr<BinaryVectorChunk>> pending;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            queueChanged.wait(lock, [this] { return stopping || !queue.empty(); });
+            if (queue.empty())
+                return;  // stopping, and everything has been written
+            pending.swap(queue);
+        }
+
+        buffer.clear();
+        for (auto& chunk : pending)
+            encode(*chunk);
+        bool ok = fwrite(buffer.data(), 1, buffer.size(), file) == buffer.size();
+
+        std::lock_guard<std::mutex> lock(mutex);
+        failed = failed || !ok;
+        for (auto& chunk : pending) {
+            chunk->clear();
+            freeChunks.push_back(std::move(chunk));
+        }
+        pending.clear();
+    }
+}
+
+void BinaryVectorWriter::encode(const BinaryVectorChunk& chunk)
+{
+    if (chunk.kind == BinaryVectorChunk::DECLARATION) {
+        buffer.push_back('V');
+        putVarint(buffer, chunk.vectorId);
+        putString(buffer, chunk.moduleName);
+        putString(buffer, chunk.vectorName);
+        putVarint(buffer, chunk.decimationInterval);
+        return;
+    }
+
+    std::string payload;
+    putTimes(payload, chunk.times);
+    if (chunk.kind == BinaryVectorChunk::SAMPLES) {
+        putDoubles(payload, chunk.values);
+    }
+    else {
+        for (uint64_t count : chunk.counts)
+            putVarint(payload, count);
+        putDoubles(payload, chunk.mins);
+        putDoubles(payload, chunk.maxs);
+        putDoubles(payload, chunk.values);
+    }
+
+    buffer.push_back(chunk.kind == BinaryVectorChunk::SAMPLES ? 'S' : 'B');
+    putVarint(buffer, chunk.vectorId);
+    putVarint(buffer, chunk.size());
+    putVarint(buffer, payload.size());
+    buffer.append(payload);
+}
+
+} // namespace simu5g
@@ -0,0 +1,149 @@
+//
+//                  Simu5G
+//
+// Copyright (C) 2022-2026 Giovanni Nardini, Giovanni Stea et al. (University of Pisa)
+//
+// This file is part of a software released under the license included in file
+// "license.pdf". Please read LICENSE and README files before using it.
+// The above files and the present reference are part of the software itself,
+// and cannot be removed from it.
+//
+
+#ifndef __SIMU5G_BINARYVECTORWRITER_H_
+#define __SIMU5G_BINARYVECTORWRITER_H_
+
+#include <omnetpp.h>
+
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace omnetpp;
+
+namespace simu5g {
+
+/**
+ * A chunk of samples of one output vector, stored column by column. Chunks
+ * either hold the raw samples (times and values) or, for decimated vectors,
+ * one entry per time bucket (bucket start, count, min, max, mean). Times are
+ * raw simtime values.
+ */
+struct BinaryVectorChunk
+{
+    enum Kind { DECLARATION, SAMPLES, BUCKETS };
+
+    Kind kind = SAMPLES;
+    int vectorId = -1;
+
+    // DECLARATION only
+    std::string moduleName;
+    std::string vectorName;
+    int64_t decimationInterval = 0;
+
+    std::vector<int64_t> times;
+    std::vector<double> values;    // sample values, or mean of each bucket
+    std::vector<uint64_t> counts;  // BUCKETS only
+    std::vector<double> mins;      // BUCKETS only
+    std::vector<double> maxs;      // BUCKETS only
+
+    size_t size() const { return times.size(); }
+    void clear();
+};
+
+/**
+ * Writes the output vectors recorded by BinaryVectorRecorder into a single
+ * binary file per run. Chunks are handed over by the recorders and encoded and
+ * written by a background thread, so that the simulation does not wait for I/O.
+ *
+ * File format (all integers are LEB128 varints, signed ones zigzag-encoded):
+ * - header: the 8 bytes "S5GBVEC1", followed by the simtime scale exponent (1 byte, signed)
+ * - vector declaration: 'V', vector id, module name, vector name, decimation interval
+ *   (raw simtime, 0 if not decimated); strings are stored as length + bytes
+ * - chunk: 'S' (samples) or 'B' (buckets), vector id, number of entries, length of
+ *   the payload in bytes, payload. The payload stores the columns one after the
+ *   other: times as signed deltas from the previous one (the first one from 0),
+ *   counts as varints, and double columns XOR-ed with the previous value of the
+ *   same column, as a byte containing the number of leading (high nibble) and
+ *   trailing (low nibble) zero bytes of the result, followed by the remaining
+ *   bytes, most significant first. Sample chunks have the times and values
+ *   columns, bucket chunks the times (bucket start), counts, mins, maxs and means.
+ *
+ * The writer is shared by all the recorders of a run: it is opened by the first
+ * recorder that acquires it and closed at the end of the run, or when the last
+ * recorder releases it if that happens later. Recorders that are deleted during
+ * the run (e.g., together with a dynamically removed module) do not close it, so
+ * the file is written only once per run and the vector ids stay unique.
+ */
+class BinaryVectorWriter : public cISimulationLifecycleListener
+{
+  protected:
+    static BinaryVectorWriter *instance;
+    static int numUsers;
+
+    bool runEnded = false;
+
+    std::string fileName;
+    FILE *file = nullptr;
+    size_t chunkSize;
+    int numVectors = 0;
+
+    // written by the simulation thread, consumed by the writer thread
+    std::mutex mutex;
+    std::condition_variable queueChanged;
+    std::deque<std::unique_ptr<BinaryVectorChunk>> queue;
+    std::vector<std::unique_ptr<BinaryVectorChunk>> freeChunks;
+    bool stopping = false;
+    bool failed = false;
+    std::thread thread;
+
+    // only used by the writer thread
+    std::string buffer;
+
+    BinaryVectorWriter(const std::string& fileName, size_t chunkSize);
+    ~BinaryVectorWriter() override;
+
+    void lifecycleEvent(SimulationLifecycleEventType eventType, cObject *details) override;
+
+    void run();
+    void submit(std::unique_ptr<BinaryVectorChunk> chunk);
+    void encode(const BinaryVectorChunk& chunk);
+
+  public:
+    /*
+     * Returns the writer of the current run, opening the output file if needed
+     */
+    static BinaryVectorWriter *acquire();
+    static void release();
+
+    /*
+     * Declares a vector and returns its id. A non-zero decimation interval means
+     * that the chunks of the vector will hold time buckets
+     */
+    int declareVector(const std::string& moduleName, const std::string& vectorName, simtime_t decimationInterval);
+
+    /*
+     * Returns an empty chunk, reusing the storage of a chunk already written if possible
+     */
+    std::unique_ptr<BinaryVectorChunk> obtainChunk();
+
+    /*
+     * Queues the given chunk for writing
+     */
+    void write(std::unique_ptr<BinaryVectorChunk> chunk) { submit(std::move(chunk)); }
+
+    // number of entries after which the recorders hand over their chunk
+    size_t getChunkSize() const { return chunkSize; }
+
+    bool hasFailed();
+    const std::string& getFileName() const { return fileName; }
+};
+
+} // namespace simu5g
+
+#endif
@@ -14,6 +14,8 @@
 #define _LTE_CIRCULAR_H_
 
 #include <list>
+#include <vector>
+#include <utility>
 #include <assert.h>
 
 namespace simu5g {
@@ -211,6 +213,160 @@ class CircularList
 
 };
 
+//! Circular buffer of elements stored in contiguous memory.
+/*!
+   Elements live in a power-of-two sized array addressed by a head index and
+   a length, so that insertion and removal at both ends is O(1) and does not
+   allocate per element. The storage only grows (by doubling) when a push
+   finds the buffer full, hence buffers that are sized appropriately at
+   construction never reallocate.
+ */
+template<typename T>
+class CircularBuffer
+{
+    //! Element storage, its size is always a power of two (or zero).
+    std::vector<T> data_;
+
+    //! Index of the first element.
+    unsigned int head_ = 0;
+
+    //! Number of elements.
+    unsigned int size_ = 0;
+
+    //! Mask used to wrap indices (capacity - 1).
+    unsigned int mask_ = 0;
+
+    //! Physical index of the i-th element.
+    unsigned int slot(unsigned int i) const
+    {
+        return (head_ + i) & mask_;
+    }
+
+    //! Doubles the capacity, moving elements so that head_ is 0.
+    void grow()
+    {
+        unsigned int newCapacity = data_.empty() ? 4 : data_.size() * 2;
+        std::vector<T> newData(newCapacity);
+        for (unsigned int i = 0; i < size_; ++i)
+            newData[i] = std::move(data_[slot(i)]);
+        data_.swap(newData);
+        head_ = 0;
+        mask_ = newCapacity - 1;
+    }
+
+  public:
+    //! Create an empty buffer, able to hold at least the given number of elements without reallocating.
+    explicit CircularBuffer(unsigned int capacity = 0)
+    {
+        reserve(capacity);
+    }
+
+    //! Make sure that at least the given number of elements fit without reallocating.
+    void reserve(unsigned int capacity)
+    {
+        while (data_.size() < capacity)
+            grow();
+    }
+
+    //! Return true if the buffer is empty.
+    bool empty() const
+    {
+        return size_ == 0;
+    }
+
+    //! Return the number of elements.
+    unsigned int size() const
+    {
+        return size_;
+    }
+
+    //! Return the number of elements that fit without reallocating.
+    unsigned int capacity() const
+    {
+        return data_.size();
+    }
+
+    //! Removes all the elements, keeping the storage.
+    void clear()
+    {
+        head_ = 0;
+        size_ = 0;
+    }
+
+    //! Insert a new element at the back.
+    void push_back(const T& t)
+    {
+        if (size_ == data_.size())
+            grow();
+        data_[slot(size_)] = t;
+        ++size_;
+    }
+
+    //! Insert a new element at the front.
+    void push_front(const T& t)
+    {
+        if (size_ == data_.size())
+            grow();
+        head_ = (head_ - 1) & mask_;
+        data_[head_] = t;
+        ++size_;
+    }
+
+    //! Removes the element at the front. The buffer must not be empty.
+    void pop_front()
+    {
+        assert(size_ > 0);
+        head_ = (head_ + 1) & mask_;
+        --size_;
+    }
+
+    //! Removes the element at the back. The buffer must not be empty.
+    void pop_back()
+    {
+        assert(size_ > 0);
+        --size_;
+    }
+
+    //! Return the element at the front. The buffer must not be empty.
+    T& front()
+    {
+        assert(size_ > 0);
+        return data_[head_];
+    }
+
+    const T& front() const
+    {
+        assert(size_ > 0);
+        return data_[head_];
+    }
+
+    //! Return the element at the back. The buffer must not be empty.
+    T& back()
+    {
+        assert(size_ > 0);
+        return data_[slot(size_ - 1)];
+    }
+
+    const T& back() const
+    {
+        assert(size_ > 0);
+        return data_[slot(size_ - 1)];
+    }
+
+    //! Return the i-th element starting from the front.
+    T& operator[](unsigned int i)
+    {
+        assert(i < size_);
+        return data_[slot(i)];
+    }
+
+    const T& operator[](unsigned int i) const
+    {
+        assert(i < size_);
+        return data_[slot(i)];
+    }
+};
+
 } //namespace
 
 #endif // _LTE_CIRCULAR_H_
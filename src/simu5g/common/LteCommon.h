@@ -268,8 +268,42 @@ typedef std::set<MacNodeId> UeSet;
 /// time interval between two transmissions of the same pdu
 #define HARQ_TX_INTERVAL         7 * TTI
 
-// Codeword List - returned by Harq functions
-typedef std::list<Codeword> CwList;
+/**
+ * Codeword List - returned by Harq functions
+ *
+ * Codewords are stored inline (there can be at most MAX_CODEWORDS of them),
+ * so that building and copying lists never allocates memory.
+ */
+class CwList
+{
+  protected:
+    Codeword cws_[MAX_CODEWORDS];
+    unsigned char size_ = 0;
+
+  public:
+    void push_back(Codeword cw)
+    {
+        ASSERT(size_ < MAX_CODEWORDS);
+        cws_[size_++] = cw;
+    }
+
+    void pop_front()
+    {
+        ASSERT(size_ > 0);
+        for (unsigned char i = 1; i < size_; i++)
+            cws_[i - 1] = cws_[i];
+        size_--;
+    }
+
+    Codeword front() const { ASSERT(size_ > 0); return cws_[0]; }
+    Codeword back() const { ASSERT(size_ > 0); return cws_[size_ - 1]; }
+    unsigned int size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    void clear() { size_ = 0; }
+
+    const Codeword *begin() const { return cws_; }
+    const Codeword *end() const { return cws_ + size_; }
+};
 
 /// Pair of acid, list of unit ids
 typedef std::pair<unsigned char, CwList> UnitList;
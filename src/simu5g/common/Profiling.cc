@@ -0,0 +1,82 @@
+//
+//                  Simu5G
+//
+// Copyright (C) 2022-2026 Giovanni Nardini, Giovanni Stea et al. (University of Pisa)
+//
+// This file is part of a software released under the license included in file
+// "license.pdf". Please read LICENSE and README files before using it.
+// The above files and the present reference are part of the software itself,
+// and cannot be removed from it.
+//
+
+#include "simu5g/common/Profiling.h"
+
+namespace simu5g {
+
+bool Profiling::enabled_ = false;
+std::map<std::pair<int, std::string>, ProfilingCounter> Profiling::counters_;
+
+ProfilingCounter *Profiling::getCounter(const cComponent *owner, const char *name)
+{
+    auto key = std::make_pair(owner->getId(), std::string(name));
+    auto it = counters_.find(key);
+    if (it == counters_.end())
+        it = counters_.emplace(std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple(owner, name)).first;
+    return &it->second;
+}
+
+void Profiling::recordPeriodic()
+{
+    for (auto& [key, counter] : counters_) {
+        // skip the modules deleted during the simulation (module ids are not reused,
+        // so this also guarantees that the vectors of the counter still exist)
+        cComponent *owner = getSimulation()->getComponent(counter.ownerId_);
+        if (owner == nullptr)
+            continue;
+
+        if (counter.timeVector_ == nullptr) {
+            // the vectors belong to the module being profiled
+            cContextSwitcher context(owner);
+            counter.timeVector_ = new cOutVector(("profiling:" + counter.name_ + ":time").c_str());
+            counter.timeVector_->setUnit("s");
+            counter.callsVector_ = new cOutVector(("profiling:" + counter.name_ + ":calls").c_str());
+        }
+        counter.timeVector_->record(std::chrono::duration<double>(counter.time_ - counter.reportedTime_).count());
+        counter.callsVector_->record((double)(counter.calls_ - counter.reportedCalls_));
+        counter.reportedTime_ = counter.time_;
+        counter.reportedCalls_ = counter.calls_;
+    }
+}
+
+void Profiling::recordScalars(cComponent *totalsOwner)
+{
+    std::map<std::string, std::pair<double, uint64_t>> totals;
+    for (auto& [key, counter] : counters_) {
+        auto& total = totals[counter.name_];
+        total.first += counter.getTime();
+        total.second += counter.getCalls();
+
+        cComponent *owner = getSimulation()->getComponent(counter.ownerId_);
+        if (owner == nullptr || counter.getCalls() == 0)
+            continue;
+        opp_string_map attributes = { { "unit", "s" } };
+        getEnvir()->recordScalar(owner, ("profiling:" + counter.name_ + ":time").c_str(), counter.getTime(), &attributes);
+        getEnvir()->recordScalar(owner, ("profiling:" + counter.name_ + ":calls").c_str(), (double)counter.getCalls());
+    }
+
+    for (auto& [name, total] : totals) {
+        if (total.second == 0)
+            continue;
+        EV_INFO << "Profiling: " << name << " " << total.first << "s, " << total.second << " calls" << endl;
+        opp_string_map attributes = { { "unit", "s" } };
+        getEnvir()->recordScalar(totalsOwner, ("profiling:" + name + ":time").c_str(), total.first, &attributes);
+        getEnvir()->recordScalar(totalsOwner, ("profiling:" + name + ":calls").c_str(), (double)total.second);
+    }
+}
+
+void Profiling::clear()
+{
+    counters_.clear();
+}
+
+} // namespace simu5g
@@ -0,0 +1,137 @@
+//
+//                  Simu5G
+//
+// Copyright (C) 2022-2026 Giovanni Nardini, Giovanni Stea et al. (University of Pisa)
+//
+// This file is part of a software released under the license included in file
+// "license.pdf". Please read LICENSE and README files before using it.
+// The above files and the present reference are part of the software itself,
+// and cannot be removed from it.
+//
+
+#ifndef __SIMU5G_PROFILING_H_
+#define __SIMU5G_PROFILING_H_
+
+#include <omnetpp.h>
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <string>
+
+using namespace omnetpp;
+
+namespace simu5g {
+
+/**
+ * Processing time and number of calls of one instrumented function of a module.
+ * Times are inclusive, i.e., they also count the instrumented functions called
+ * by this one (e.g., the time of "schedule" is part of "handleSelfMessage").
+ */
+class ProfilingCounter
+{
+    friend class Profiling;
+
+  protected:
+    int ownerId_;
+    std::string name_;
+
+    std::chrono::steady_clock::duration time_ = std::chrono::steady_clock::duration::zero();
+    uint64_t calls_ = 0;
+
+    // values at the last periodic report
+    std::chrono::steady_clock::duration reportedTime_ = std::chrono::steady_clock::duration::zero();
+    uint64_t reportedCalls_ = 0;
+
+    // owned by the owner module, which deletes them together with itself: they
+    // must be neither deleted nor used once the owner module no longer exists
+    cOutVector *timeVector_ = nullptr;
+    cOutVector *callsVector_ = nullptr;
+
+  public:
+    ProfilingCounter(const cComponent *owner, const char *name) : ownerId_(owner->getId()), name_(name) {}
+    ProfilingCounter(const ProfilingCounter&) = delete;
+    ProfilingCounter& operator=(const ProfilingCounter&) = delete;
+
+    void add(std::chrono::steady_clock::duration time)
+    {
+        time_ += time;
+        calls_++;
+    }
+
+    double getTime() const { return std::chrono::duration<double>(time_).count(); }
+    uint64_t getCalls() const { return calls_; }
+};
+
+/**
+ * Registry of the profiling counters of the current run.
+ *
+ * Profiling is enabled by the enableProfiling parameter of the Binder. Modules
+ * get their counters with getCounter() during initialization, and time the
+ * instrumented functions with a ProfilingScope, which does nothing (except
+ * checking a flag) when profiling is disabled. At the end of the simulation,
+ * the Binder records the time and the number of calls of each counter as
+ * scalars of the owner module, and their totals per function as scalars of
+ * the Binder itself.
+ */
+class Profiling
+{
+  protected:
+    static bool enabled_;
+    static std::map<std::pair<int, std::string>, ProfilingCounter> counters_;
+
+  public:
+    static bool isEnabled() { return enabled_; }
+    static void setEnabled(bool enabled) { enabled_ = enabled; }
+
+    /*
+     * Returns the counter with the given name of the given module, creating it if needed
+     */
+    static ProfilingCounter *getCounter(const cComponent *owner, const char *name);
+
+    /*
+     * Records the time and calls since the previous call as vector values of the owner modules
+     */
+    static void recordPeriodic();
+
+    /*
+     * Records the time and calls of all the counters as scalars of the owner modules,
+     * and their totals per function name as scalars of the given module
+     */
+    static void recordScalars(cComponent *totalsOwner);
+
+    /*
+     * Removes all the counters. Their vectors are left to the owner modules
+     */
+    static void clear();
+};
+
+/**
+ * Adds the time spent in the enclosing scope to the given counter, if profiling is enabled
+ */
+class ProfilingScope
+{
+  protected:
+    ProfilingCounter *counter_;
+    std::chrono::steady_clock::time_point start_;
+
+  public:
+    explicit ProfilingScope(ProfilingCounter *counter) : counter_(Profiling::isEnabled() ? counter : nullptr)
+    {
+        if (counter_ != nullptr)
+            start_ = std::chrono::steady_clock::now();
+    }
+
+    ~ProfilingScope()
+    {
+        if (counter_ != nullptr)
+            counter_->add(std::chrono::steady_clock::now() - start_);
+    }
+
+    ProfilingScope(const ProfilingScope&) = delete;
+    ProfilingScope& operator=(const ProfilingScope&) = delete;
+};
+
+} // namespace simu5g
+
+#endif
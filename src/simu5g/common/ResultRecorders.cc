@@ -10,6 +10,7 @@
 //
 
 #include "simu5g/common/ResultRecorders.h"
+#include <algorithm>
 #include <sstream>
 
 namespace simu5g {
@@ -49,4 +50,108 @@ std::string RateAverageRecorder::str() const
     return os.str();
 }
 
+Register_ResultRecorder2("simu5g_binvector", BinaryVectorRecorder,
+        "Records the signal values as an output vector in a compressed binary file (see the binvector-file option), "
+        "written by a background thread. If binvector-decimation-interval is set for the statistic, only the count, "
+        "minimum, maximum and mean of the values in each time bucket are recorded. "
+);
+
+Register_PerObjectConfigOptionU(CFGID_BINVECTOR_DECIMATION_INTERVAL, "binvector-decimation-interval", KIND_STATISTIC, "s", "0s",
+        "Length of the time buckets of a statistic recorded with the simu5g_binvector recorder. "
+        "0 means that all the samples are recorded. Example: **.macDelayDl.binvector-decimation-interval = 10ms"
+);
+
+void BinaryVectorRecorder::init(Context *ctx)
+{
+    cNumericResultRecorder::init(ctx);
+
+    std::string objectFullPath = getComponent()->getFullPath() + "." + getStatisticName();
+    simtime_t decimationInterval = getEnvir()->getConfig()->getAsDouble(objectFullPath.c_str(), CFGID_BINVECTOR_DECIMATION_INTERVAL, 0);
+    if (decimationInterval < SIMTIME_ZERO)
+        throw cRuntimeError("BinaryVectorRecorder: negative binvector-decimation-interval for %s", objectFullPath.c_str());
+    interval = decimationInterval.raw();
+
+    writer = BinaryVectorWriter::acquire();
+    vectorId = writer->declareVector(getComponent()->getFullPath(), getResultName(), decimationInterval);
+    chunk = writer->obtainChunk();
+}
+
+BinaryVectorRecorder::~BinaryVectorRecorder()
+{
+    if (writer != nullptr) {
+        // finish() is not called if the simulation ended with an error
+        if (bucketCount > 0)
+            closeBucket();
+        if (chunk->size() > 0)
+            flushChunk();
+        BinaryVectorWriter::release();
+    }
+}
+
+void BinaryVectorRecorder::collect(simtime_t_cref t, double value, cObject *details)
+{
+    numRecorded++;
+    if (interval == 0) {
+        chunk->times.push_back(t.raw());
+        chunk->values.push_back(value);
+        if (chunk->size() >= writer->getChunkSize())
+            flushChunk();
+        return;
+    }
+
+    if (std::isnan(value))
+        return;
+    int64_t valueBucket = t.raw() / interval;
+    if (bucketCount > 0 && valueBucket != bucket)
+        closeBucket();
+    if (bucketCount == 0) {
+        bucket = valueBucket;
+        bucketMin = bucketMax = value;
+        bucketSum = 0;
+    }
+    bucketMin = std::min(bucketMin, value);
+    bucketMax = std::max(bucketMax, value);
+    bucketSum += value;
+    bucketCount++;
+}
+
+void BinaryVectorRecorder::closeBucket()
+{
+    chunk->kind = BinaryVectorChunk::BUCKETS;
+    chunk->times.push_back(bucket * interval);
+    chunk->counts.push_back(bucketCount);
+    chunk->mins.push_back(bucketMin);
+    chunk->maxs.push_back(bucketMax);
+    chunk->values.push_back(bucketSum / bucketCount);
+    bucketCount = 0;
+    if (chunk->size() >= writer->getChunkSize())
+        flushChunk();
+}
+
+void BinaryVectorRecorder::flushChunk()
+{
+    chunk->vectorId = vectorId;
+    if (interval != 0)
+        chunk->kind = BinaryVectorChunk::BUCKETS;
+    writer->write(std::move(chunk));
+    chunk = writer->obtainChunk();
+}
+
+void BinaryVectorRecorder::finish(cResultFilter *prev)
+{
+    if (bucketCount > 0)
+        closeBucket();
+    if (chunk->size() > 0)
+        flushChunk();
+    if (writer->hasFailed())
+        throw cRuntimeError("BinaryVectorRecorder: error writing file '%s'", writer->getFileName().c_str());
+}
+
+std::string BinaryVectorRecorder::str() const
+{
+    std::stringstream os;
+    os << getResultName() << ": " << numRecorded << " values";
+    return os.str();
+}
+
 } // namespace simu5g
@@ -14,6 +14,8 @@
 
 #include <omnetpp.h>
 
+#include "simu5g/common/BinaryVectorWriter.h"
+
 using namespace omnetpp;
 
 namespace simu5g {
@@ -52,6 +54,45 @@ class RateAverageRecorder : public cNumericResultRecorder
         virtual std::string str() const override;
 };
 
+/**
+ * @brief Listener for recording signal values as an output vector in the
+ * binary file written by BinaryVectorWriter, instead of the .vec file.
+ *
+ * Samples are buffered in columnar chunks that are compressed and written by a
+ * background thread. If the binvector-decimation-interval option is set for the
+ * statistic, the recorder only stores the count, minimum, maximum and mean of
+ * the (non-NaN) values emitted in each time bucket of that length.
+ *
+ * The file can be read with _scripts/read_binvector.py.
+ */
+class BinaryVectorRecorder : public cNumericResultRecorder
+{
+    protected:
+        BinaryVectorWriter *writer = nullptr;
+        int vectorId = -1;
+        std::unique_ptr<BinaryVectorChunk> chunk;
+        uint64_t numRecorded = 0;
+
+        // decimation
+        int64_t interval = 0;
+        int64_t bucket = 0;
+        uint64_t bucketCount = 0;
+        double bucketMin = 0;
+        double bucketMax = 0;
+        double bucketSum = 0;
+
+    protected:
+        virtual void init(Context *ctx) override;
+        virtual void collect(simtime_t_cref t, double value, cObject *details) override;
+        virtual void finish(cResultFilter *prev) override;
+        void closeBucket();
+        void flushChunk();
+    public:
+        BinaryVectorRecorder() {}
+        virtual ~BinaryVectorRecorder();
+        virtual std::string str() const override;
+};
+
 } // namespace simu5g
 
 #endif
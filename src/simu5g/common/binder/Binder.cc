@@ -168,12 +168,15 @@ void Binder::registerNode(MacNodeId nodeId, cModule *nodeModule, RanNodeType typ
     NodeInfo nodeInfo;
     nodeInfo.moduleRef = nodeModule;
     nodeInfoMap_[nodeId] = nodeInfo;
+    topologyEpoch_++;
 }
 
 void Binder::unregisterNode(MacNodeId id)
 {
     EV << NOW << " Binder::unregisterNode - unregistering node " << id << endl;
 
+    topologyEpoch_++;
+
     for (auto it = ipAddressToMacNodeId_.begin(); it != ipAddressToMacNodeId_.end(); ) {
         if (it->second == id) {
             it = ipAddressToMacNodeId_.erase(it);
@@ -222,6 +225,7 @@ void Binder::registerServingNode(MacNodeId enbId, MacNodeId ueId)
     if (servingNode_.size() <= num(ueId))
         servingNode_.resize(num(ueId) + 1);
     servingNode_[num(ueId)] = enbId;
+    topologyEpoch_++;
 }
 
 void Binder::unregisterServingNode(MacNodeId enbId, MacNodeId ueId)
@@ -235,6 +239,7 @@ void Binder::unregisterServingNode(MacNodeId enbId, MacNodeId ueId)
     if (servingNode_.size() <= num(ueId))
         return;
     servingNode_[num(ueId)] = NODEID_NONE;
+    topologyEpoch_++;
 }
 
 MacNodeId Binder::getServingNode(MacNodeId ueId)
@@ -255,6 +260,7 @@ void Binder::registerMasterNode(MacNodeId masterId, MacNodeId slaveId)
     if (secondaryNodeToMasterNodeOrSelf_.size() <= num(slaveId))
         secondaryNodeToMasterNodeOrSelf_.resize(num(slaveId) + 1);
     secondaryNodeToMasterNodeOrSelf_[num(slaveId)] = (masterId != NODEID_NONE) ? masterId : slaveId;  // the "or self" bit
+    topologyEpoch_++;
 }
 
 inline ostream& operator<<(ostream& os, const L3Address& addr) { return os << addr.str(); }
@@ -268,6 +274,13 @@ void Binder::initialize(int stage)
         phyPisaData.setBlerShift(par("blerShift"));
         networkName_ = getSystemModule()->getName();
 
+        Profiling::setEnabled(par("enableProfiling").boolValue());
+        profilingInterval_ = par("profilingInterval");
+        if (Profiling::isEnabled() && profilingInterval_ > 0) {
+            profilingTimer_ = new cMessage("profilingTimer");
+            scheduleAfter(profilingInterval_, profilingTimer_);
+        }
+
         // Add WATCH macros for all member variables
         WATCH(networkName_);
         WATCH_MAP(ipAddressToMacNodeId_);
@@ -301,8 +314,19 @@ void Binder::initialize(int stage)
     }
 }
 
+void Binder::handleMessage(cMessage *msg)
+{
+    if (msg == profilingTimer_) {
+        Profiling::recordPeriodic();
+        scheduleAfter(profilingInterval_, profilingTimer_);
+    }
+}
+
 void Binder::finish()
 {
+    if (Profiling::isEnabled())
+        Profiling::recordScalars(this);
+
     if (par("printTrafficGeneratorConfig").boolValue()) {
         // build filename
         std::stringstream outputFilenameStr;
@@ -444,11 +468,13 @@ MacNodeId Binder::getUeNodeId(MacNodeId ue, bool isNr)
 void Binder::registerMecHost(const inet::L3Address& mecHostAddress)
 {
     mecHostAddress_.insert(mecHostAddress);
+    topologyEpoch_++;
 }
 
 void Binder::registerMecHostUpfAddress(const inet::L3Address& mecHostAddress, const inet::L3Address& gtpAddress)
 {
     mecHostToUpfAddress_[mecHostAddress] = gtpAddress;
+    topologyEpoch_++;
 }
 
 bool Binder::isMecHost(const inet::L3Address& mecHostAddress)
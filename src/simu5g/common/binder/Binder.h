@@ -19,6 +19,7 @@
 #include <inet/networklayer/common/L3Address.h>
 
 #include "simu5g/common/LteCommon.h"
+#include "simu5g/common/Profiling.h"
 #include "simu5g/common/blerCurves/PhyPisaData.h"
 #include "simu5g/nodes/ExtCell.h"
 #include "simu5g/stack/mac/LteMacBase.h"
@@ -67,6 +68,10 @@ class Binder : public cSimpleModule
     // the IP address of the corresponding UPF
     std::map<inet::L3Address, inet::L3Address> mecHostToUpfAddress_;
 
+    // incremented whenever the address/node/serving-node mappings change, so that modules
+    // caching results derived from them (e.g. the TrafficFlowFilter) can detect stale entries
+    unsigned long topologyEpoch_ = 0;
+
     // list of static external cells. Used for intercell interference evaluation
     std::map<GHz, ExtCellList> extCellList_;
 
@@ -152,10 +157,14 @@ class Binder : public cSimpleModule
     std::set<MacNodeId> ueHandoverTriggered_;
     std::map<MacNodeId, std::pair<MacNodeId, MacNodeId>> handoverTriggered_;
 
+    // periodic recording of the profiling counters
+    cMessage *profilingTimer_ = nullptr;
+    simtime_t profilingInterval_;
+
   protected:
     void initialize(int stages) override;
     int numInitStages() const override { return inet::NUM_INIT_STAGES; }
-    void handleMessage(cMessage *msg) override {}
+    void handleMessage(cMessage *msg) override;
 
     void finish() override;
 
@@ -181,6 +190,9 @@ class Binder : public cSimpleModule
 
         for (auto ue : ueList_)
             delete ue;
+
+        cancelAndDelete(profilingTimer_);
+        Profiling::clear();
     }
 
     virtual std::string& getNetworkName()
@@ -271,6 +283,12 @@ class Binder : public cSimpleModule
      */
     virtual void registerMasterNode(MacNodeId masterId, MacNodeId slaveId);
 
+    /**
+     * Returns a counter that changes every time a node, an IP address, a serving node,
+     * a master node or a MEC host is (un)registered.
+     */
+    unsigned long getTopologyEpoch() const { return topologyEpoch_; }
+
     /**
      * Returns true if the node exists.
      */
@@ -392,6 +410,7 @@ class Binder : public cSimpleModule
      */
     virtual void setMacNodeId(inet::Ipv4Address address, MacNodeId nodeId)
     {
+        topologyEpoch_++;
         if (isNrUe(nodeId))
             ipAddressToNrMacNodeId_[address] = nodeId;
         else
@@ -26,6 +26,9 @@ Define_Module(GtpUser);
 using namespace omnetpp;
 using namespace inet;
 
+simsignal_t GtpUser::gtpPacketSentSignal_ = registerSignal("gtpPacketSent");
+simsignal_t GtpUser::gtpPacketReceivedSignal_ = registerSignal("gtpPacketReceived");
+
 void GtpUser::initialize(int stage)
 {
     cSimpleModule::initialize(stage);
@@ -67,6 +70,9 @@ void GtpUser::initialize(int stage)
         myMacNodeID = NODEID_NONE;
 
     ie_ = detectInterface();
+
+    WATCH(nextTeid_);
+    WATCH(numPathSwitches_);
 }
 
 NetworkInterface *GtpUser::detectInterface()
@@ -168,43 +174,96 @@ void GtpUser::handleFromTrafficFlowFilter(Packet *datagram)
         const auto& hdr = datagram->peekAtFront<Ipv4Header>();
         const Ipv4Address& destAddr = hdr->getDestAddress();
 
-        // create a new GtpUserMessage and encapsulate the datagram within the GtpUserMessage
-        auto header = makeShared<GtpUserMsg>();
-        header->setTeid(0);
-        header->setQfi(qfi);
-        header->setChunkLength(B(8));
-        auto gtpPacket = new Packet(datagram->getName());
-        gtpPacket->insertAtFront(header);
-        auto data = datagram->peekData();
-        gtpPacket->insertAtBack(data);
+        // on a BS the traffic comes from the UE (uplink), elsewhere it is directed to the UE
+        const Ipv4Address& ueAddr = isBaseStation(ownerType_) ? hdr->getSrcAddress() : destAddr;
+        const Tunnel& tunnel = getTunnel(ueAddr, qfi, flowId, destAddr);
 
-        delete datagram;
+        EV << "GtpUser::handleFromTrafficFlowFilter - tunneling to " << tunnel.peerAddress.str() << " teid[" << tunnel.teid << "]" << endl;
+        sendThroughTunnel(datagram, tunnel, qfi);
+    }
+}
 
-        L3Address tunnelPeerAddress;
-        if (flowId == TFT_EXTERNAL_DESTINATION) { // send to the gateway
-            if (gwAddress_.isUnspecified())
-                throw cRuntimeError("Packet is destined by TFT to external destination (Internet), but gateway address is not configured");
-            EV << "GtpUser::handleFromTrafficFlowFilter - tunneling to " << gwAddress_.str() << endl;
-            tunnelPeerAddress = gwAddress_;
-        }
-        else if (flowId == TFT_MEC_HOST) { // send to a MEC host
-            // check if the destination MEC host is within the same core network
+const GtpUser::Tunnel& GtpUser::getTunnel(const Ipv4Address& ueAddress, Qfi qfi, TrafficFlowTemplateId flowId, const Ipv4Address& destAddress)
+{
+    // traffic of the same bearer towards the gateway, a MEC host or the radio network uses separate tunnels
+    uint64_t endpointType = (flowId < 0) ? -flowId : 0;
+    BearerKey bearerKey = { ((uint64_t)ueAddress.getInt() << 16) | (endpointType << 8) | num(qfi), 0 };
+
+    // the MEC host is given by the destination address, and it is part of the bearer key
+    L3Address mecHostPeer;
+    if (flowId == TFT_MEC_HOST) {
+        mecHostPeer = resolveTunnelPeer(flowId, destAddress);
+        bearerKey.mecHostAddress = mecHostPeer.toIpv4().getInt();
+    }
 
-            // retrieve the address of the UPF included within the MEC host
-            EV << "GtpUser::handleFromTrafficFlowFilter - tunneling to " << destAddr.str() << endl;
-            tunnelPeerAddress = binder_->getUpfFromMecHost(inet::L3Address(destAddr));
-        }
-        else { // send to a BS
-            // check if the destination is within the same core network
-
-            // get the symbolic IP address of the tunnel destination ID
-            // then obtain the address via IPvXAddressResolver
-            std::string  symbolicName = binder_->getNodeModule(MacNodeId(flowId))->getFullPath();
-            EV << "GtpUser::handleFromTrafficFlowFilter - tunneling to " << symbolicName << endl;
-            tunnelPeerAddress = L3AddressResolver().resolve(symbolicName.c_str());
-        }
-        socket_.sendTo(gtpPacket, tunnelPeerAddress, tunnelPeerPort_);
+    auto it = teidByBearer_.find(bearerKey);
+    if (it == teidByBearer_.end()) {
+        // bearer setup: allocate a new TEID
+        Tunnel& tunnel = tunnels_[nextTeid_];
+        tunnel.teid = nextTeid_++;
+        tunnel.flowId = flowId;
+        tunnel.peerAddress = (flowId == TFT_MEC_HOST) ? mecHostPeer : resolveTunnelPeer(flowId, destAddress);
+        teidByBearer_[bearerKey] = tunnel.teid;
+
+        EV << "GtpUser::getTunnel - new tunnel teid[" << tunnel.teid << "] for UE " << ueAddress << " qfi[" << qfi << "] towards " << tunnel.peerAddress.str() << endl;
+        return tunnel;
+    }
+
+    Tunnel& tunnel = tunnels_.at(it->second);
+    if (tunnel.flowId != flowId) {
+        // path switch, e.g. the UE has been handed over to another BS
+        L3Address peerAddress = resolveTunnelPeer(flowId, destAddress);
+        EV << "GtpUser::getTunnel - switching tunnel teid[" << tunnel.teid << "] from " << tunnel.peerAddress.str() << " to " << peerAddress.str() << endl;
+        tunnel.flowId = flowId;
+        tunnel.peerAddress = peerAddress;
+        numPathSwitches_++;
     }
+    return tunnel;
+}
+
+L3Address GtpUser::resolveTunnelPeer(TrafficFlowTemplateId flowId, const Ipv4Address& destAddress)
+{
+    if (flowId == TFT_EXTERNAL_DESTINATION) { // send to the gateway
+        if (gwAddress_.isUnspecified())
+            throw cRuntimeError("Packet is destined by TFT to external destination (Internet), but gateway address is not configured");
+        return gwAddress_;
+    }
+    else if (flowId == TFT_MEC_HOST) { // send to a MEC host
+        // retrieve the address of the UPF included within the MEC host
+        return binder_->getUpfFromMecHost(inet::L3Address(destAddress));
+    }
+    // send to a BS
+    return getBsAddress(MacNodeId(flowId));
+}
+
+const L3Address& GtpUser::getBsAddress(MacNodeId bsId)
+{
+    auto it = bsAddress_.find(bsId);
+    if (it != bsAddress_.end())
+        return it->second;
+
+    // get the symbolic IP address of the tunnel destination ID
+    // then obtain the address via IPvXAddressResolver
+    std::string symbolicName = binder_->getNodeModule(bsId)->getFullPath();
+    EV << "GtpUser::getBsAddress - resolving tunnel endpoint address of " << symbolicName << endl;
+    return bsAddress_[bsId] = L3AddressResolver().resolve(symbolicName.c_str());
+}
+
+void GtpUser::sendThroughTunnel(Packet *packet, const Tunnel& tunnel, Qfi qfi)
+{
+    // encapsulate the datagram in place: drop the popped parts and the tags of the inner datagram,
+    // then prepend the GTP-U header
+    packet->trim();
+    packet->clearTags();
+
+    auto header = makeShared<GtpUserMsg>();
+    header->setTeid(tunnel.teid);
+    header->setQfi(qfi);
+    header->setChunkLength(B(8));
+    packet->insertAtFront(header);
+
+    emit(gtpPacketSentSignal_, packet);
+    socket_.sendTo(packet, tunnel.peerAddress, tunnelPeerPort_);
 }
 
 void GtpUser::handleFromUdp(Packet *pkt)
@@ -229,21 +288,22 @@ void GtpUser::handleFromUdp(Packet *pkt)
 
     EV << "GtpUser::handleFromUdp - Decapsulating and forwarding to the correct destination" << endl;
 
-    // re-create the original IP datagram and send it to the local network
-    auto originalPacket = new Packet(pkt->getName());
+    emit(gtpPacketReceivedSignal_, pkt);
+
+    // decapsulate the original IP datagram in place and send it to the local network
     auto gtpUserMsg = pkt->popAtFront<GtpUserMsg>();
-    originalPacket->insertAtBack(pkt->peekData());
-    originalPacket->addTagIfAbsent<PacketProtocolTag>()->setProtocol(&Protocol::ipv4);
+    pkt->trimFront();
+    // remove the tags of the GTP-U packet (e.g. pending socket indications)
+    pkt->clearTags();
+    pkt->addTag<PacketProtocolTag>()->setProtocol(&Protocol::ipv4);
 
     // Restore QFI from GTP-U header so SDAP can use it for QFI-to-DRB mapping.
     // Always set the tag, even for QFI 0 (unmarked/default-flow traffic): SDAP
     // relies on QfiReq being present on the gNB DL path, and maps QFI 0 to the
     // default DRB.
-    originalPacket->addTagIfAbsent<QfiReq>()->setQfi(gtpUserMsg->getQfi());
-    // remove any pending socket indications
-    auto sockInd = pkt->removeTagIfPresent<SocketInd>();
+    pkt->addTag<QfiReq>()->setQfi(gtpUserMsg->getQfi());
 
-    delete pkt;
+    Packet *originalPacket = pkt;
 
     const auto& hdr = originalPacket->peekAtFront<Ipv4Header>();
     const Ipv4Address& destAddr = hdr->getDestAddress();
@@ -271,27 +331,12 @@ void GtpUser::handleFromUdp(Packet *pkt)
             std::string gwFullPath = binder_->getNetworkName() + "." + binder_->getModuleByMacNodeId(destMaster)->par("gateway").stdstringValue();
             if (networkNode_->getFullPath() == gwFullPath) {
                 // the destination is a Base Station under the same core network as this PGW/UPF,
-                // tunnel the packet toward that BS
-                std::string symbolicName = binder_->getNodeModule(destMaster)->getFullPath();
-                L3Address tunnelPeerAddress = L3AddressResolver().resolve(symbolicName.c_str());
-                EV << "GtpUser::handleFromUdp - tunneling to BS " << symbolicName << endl;
-
-                // send the message to the BS through GTP tunneling
-                // * create a new GtpUserMessage
-                // * encapsulate the datagram within the GtpUserMsg
-                auto header = makeShared<GtpUserMsg>();
-                header->setTeid(0);
-                header->setQfi(gtpUserMsg->getQfi());  // preserve QFI from incoming GTP-U
-                header->setChunkLength(B(8));
-                auto gtpMsg = new Packet(originalPacket->getName());
-                gtpMsg->insertAtFront(header);
-                auto data = originalPacket->peekData();
-                gtpMsg->insertAtBack(data);
-                delete originalPacket;
+                // tunnel the packet toward that BS, preserving the QFI from the incoming GTP-U header
+                const Tunnel& tunnel = getTunnel(destAddr, gtpUserMsg->getQfi(), num(destMaster), destAddr);
 
                 // forward the re-encapsulated GTP-U message
-                EV << "GtpUser::handleFromUdp - Tunneling datagram to " << tunnelPeerAddress.str() << ", final destination[" << destAddr.str() << "]" << endl;
-                socket_.sendTo(gtpMsg, tunnelPeerAddress, tunnelPeerPort_);
+                EV << "GtpUser::handleFromUdp - Tunneling datagram to " << tunnel.peerAddress.str() << " teid[" << tunnel.teid << "], final destination[" << destAddr.str() << "]" << endl;
+                sendThroughTunnel(originalPacket, tunnel, gtpUserMsg->getQfi());
                 return;
             }
         }
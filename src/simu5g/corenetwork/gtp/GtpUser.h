@@ -14,6 +14,7 @@
 #define __GTP_USER_H_
 
 #include <map>
+#include <unordered_map>
 
 #include "simu5g/common/LteDefs.h"
 #include <inet/common/ModuleAccess.h>
@@ -61,6 +62,44 @@ class GtpUser : public cSimpleModule
 
     opp_component_ptr<cModule> networkNode_;
 
+    // GTP-U tunnel towards the next hop of the traffic of one UE with a given QFI
+    struct Tunnel
+    {
+        unsigned int teid;
+        TrafficFlowTemplateId flowId;   // result of the traffic flow filter when the tunnel was (last) set up
+        inet::L3Address peerAddress;
+    };
+
+    // (UE address, type of endpoint, QFI), plus the address of the endpoint for the tunnels towards
+    // MEC hosts, as the traffic of the same bearer may be directed to different MEC hosts
+    struct BearerKey
+    {
+        uint64_t bearer;
+        uint32_t mecHostAddress;
+
+        bool operator==(const BearerKey& other) const { return bearer == other.bearer && mecHostAddress == other.mecHostAddress; }
+    };
+
+    struct BearerKeyHash
+    {
+        size_t operator()(const BearerKey& key) const { return std::hash<uint64_t>()(key.bearer * 31 + key.mecHostAddress); }
+    };
+
+    // TEID -> tunnel
+    std::unordered_map<unsigned int, Tunnel> tunnels_;
+    // bearer -> TEID
+    std::unordered_map<BearerKey, unsigned int, BearerKeyHash> teidByBearer_;
+    // next TEID to be allocated (0 is never used)
+    unsigned int nextTeid_ = 1;
+    // number of tunnels whose endpoint has been switched (e.g. after a handover)
+    unsigned int numPathSwitches_ = 0;
+
+    // tunnel endpoint address of the base stations, resolved on first use
+    std::map<MacNodeId, inet::L3Address> bsAddress_;
+
+    static simsignal_t gtpPacketSentSignal_;
+    static simsignal_t gtpPacketReceivedSignal_;
+
     CoreNodeType selectOwnerType(const char *type);
 
   protected:
@@ -75,6 +114,24 @@ class GtpUser : public cSimpleModule
     // receive a GTP-U packet from Udp, reads the TEID and decides whether performing label switching or removal
     void handleFromUdp(inet::Packet *gtpMsg);
 
+    /*
+     * Returns the tunnel carrying the traffic of the given UE and QFI towards the endpoint
+     * identified by flowId. The tunnel (and its TEID) is created the first time a bearer is seen;
+     * if the flow has moved to another endpoint since then (e.g. handover), the peer address
+     * is updated and the TEID is kept (path switch). Each MEC host the bearer is directed to
+     * gets its own tunnel.
+     */
+    const Tunnel& getTunnel(const inet::Ipv4Address& ueAddress, Qfi qfi, TrafficFlowTemplateId flowId, const inet::Ipv4Address& destAddress);
+
+    // returns the address of the tunnel endpoint for the given flowId
+    inet::L3Address resolveTunnelPeer(TrafficFlowTemplateId flowId, const inet::Ipv4Address& destAddress);
+
+    // returns the tunnel endpoint address of the given BS
+    const inet::L3Address& getBsAddress(MacNodeId bsId);
+
+    // prepends the GTP-U header to the packet and sends it through the given tunnel
+    void sendThroughTunnel(inet::Packet *packet, const Tunnel& tunnel, Qfi qfi);
+
     // detect outgoing interface name (CellularNic)
     inet::NetworkInterface *detectInterface();
 };
@@ -93,6 +93,7 @@ void BaseStationStatsCollector::handleMessage(cMessage *msg)
 {
     if (msg->isSelfMessage()) {
         EV << collectorType_ << "::handleMessage - get " << msg->getName() << " statistics" << endl;
+        version_++;
 
         if (msg == prbUsage_) {
             add_dl_total_prb_usage_cell();
@@ -105,35 +106,19 @@ void BaseStationStatsCollector::handleMessage(cMessage *msg)
             scheduleAt(NOW + activeUsersPeriod_, activeUsers_);
         }
         else if (msg == tPut_) {
-            add_dl_nongbr_throughput_ue_perUser();
-            add_ul_nongbr_throughput_ue_perUser();
+            collectThroughputs();
             scheduleAt(NOW + tPutPeriod_, tPut_);
         }
         else if (msg == discardRate_) {
-            add_dl_nongbr_pdr_cell();
-            add_ul_nongbr_pdr_cell();
-
-            // add packet discard rate stats for each user
-            add_dl_nongbr_pdr_cell_perUser();
-            add_ul_nongbr_pdr_cell_perUser();
-
-            //reset counters
-            packetFlowObserver_->resetDiscardCounter();
-            resetDiscardCounterPerUe();
+            collectDiscardRates();
             scheduleAt(NOW + discardRatePeriod_, discardRate_);
         }
         else if (msg == packetDelay_) {
-            add_dl_nongbr_delay_perUser();
-            add_ul_nongbr_delay_perUser();
-
-            //reset counter
-            resetDelayCounterPerUe();
+            collectPacketDelays();
             scheduleAt(NOW + delayPacketPeriod_, packetDelay_);
         }
         else if (msg == pdcpBytes_) {
-            add_ul_nongbr_data_volume_ue_perUser();
-            add_dl_nongbr_data_volume_ue_perUser();
-            resetBytesCountersPerUe();
+            collectDataVolumes();
             scheduleAt(NOW + dataVolumePeriod_, pdcpBytes_);
         }
         else {
@@ -146,44 +131,17 @@ void BaseStationStatsCollector::handleMessage(cMessage *msg)
     }
 }
 
-void BaseStationStatsCollector::resetDiscardCounterPerUe()
-{
-    EV << collectorType_ << "::resetDiscardCounterPerUe " << endl;
-    for (auto const& [ueId, ueCollector] : ueCollectors_) {
-        packetFlowObserver_->resetDiscardCounterPerUe(ueId);
-    }
-}
-
-void BaseStationStatsCollector::resetDelayCounterPerUe()
-{
-    EV << collectorType_ << "::resetDelayCounterPerUe " << endl;
-    for (auto const& [ueId, ueCollector] : ueCollectors_) {
-        packetFlowObserver_->resetDelayCounterPerUe(ueId);
-        ueCollector->resetDelayCounter();
-    }
-}
-
-void BaseStationStatsCollector::resetThroughputCountersPerUe()
-{
-    EV << collectorType_ << "::resetThroughputCountersPerUe " << endl;
-    for (auto const& [ueId, ueCollector] : ueCollectors_) {
-        packetFlowObserver_->resetThroughputCounterPerUe(ueId);
-    }
-}
-
-void BaseStationStatsCollector::resetBytesCountersPerUe()
-{
-    EV << collectorType_ << "::resetBytesCountersPerUe " << endl;
-    for (auto const& [ueId, ueCollector] : ueCollectors_) {
-        packetFlowObserver_->resetDataVolume(ueId);
-    }
-}
-
 // BaseStationStatsCollector management methods
 void BaseStationStatsCollector::addUeCollector(MacNodeId id, UeStatsCollector *ueCollector)
 {
     if (ueCollectors_.find(id) == ueCollectors_.end()) {
         ueCollectors_.insert({id, ueCollector});
+        unsigned int slot = ueMeasures_.addUe(id);
+        if (slot >= slotCollectors_.size())
+            slotCollectors_.resize(slot + 1, nullptr);
+        slotCollectors_[slot] = ueCollector;
+        ueCollector->attachMeasStore(&ueMeasures_, slot);
+        version_++;
     }
     else {
         throw cRuntimeError("%s::addUeCollector - UeStatsCollector already present for UE node id [%hu]", collectorType_.c_str(), num(id));
@@ -194,7 +152,12 @@ void BaseStationStatsCollector::removeUeCollector(MacNodeId id)
 {
     std::map<MacNodeId, UeStatsCollector *>::iterator it = ueCollectors_.find(id);
     if (it != ueCollectors_.end()) {
+        unsigned int slot = it->second->getMeasSlot();
+        ueMeasures_.removeUe(slot);
+        slotCollectors_[slot] = nullptr;
+        it->second->detachMeasStore();
         ueCollectors_.erase(it);
+        version_++;
         EV << "BaseStationStatsCollector::removeUeCollector - removing UE pfm stats for UE with id[" << id << "]" << endl;
         packetFlowObserver_->deleteUe(id);
     }
@@ -258,113 +221,109 @@ void BaseStationStatsCollector::add_dl_nongbr_pdr_cell()
     dl_nongbr_pdr_cell.addValue((int)discard);
 }
 
-void BaseStationStatsCollector::add_ul_nongbr_pdr_cell()
-{
-    double pdr = 0.0;
-    DiscardedPkts pair = { 0, 0 };
-    DiscardedPkts temp = { 0, 0 };
-
-    for (auto const& [ueId, ueCollector] : ueCollectors_) {
-        temp = ueCollector->getULDiscardedPkt();
-        pair.discarded += temp.discarded;
-        pair.total += temp.total;
-    }
-
-    if (pair.total == 0)
-        pdr = 0.0;
-    else
-        pdr = ((double)pair.discarded * 1000000) / pair.total;
-    ul_nongbr_pdr_cell.addValue((int)pdr);
-}
-
 //TODO handover management
 
 // for each user save stats
 
-void BaseStationStatsCollector::add_dl_nongbr_pdr_cell_perUser()
+void BaseStationStatsCollector::collectPacketDelays()
 {
-    EV << collectorType_ << "::add_dl_nongbr_pdr_cell_perUser()" << endl;
-    double discard;
-    for (auto const& [ueId, ueCollector] : ueCollectors_) {
-        discard = packetFlowObserver_->getDiscardedPktPerUe(ueId);
-        ueCollector->add_dl_nongbr_pdr_ue((int)discard);
-    }
-}
-
-void BaseStationStatsCollector::add_ul_nongbr_pdr_cell_perUser()
-{
-    EV << collectorType_ << "::add_ul_nongbr_pdr_cell_perUser()" << endl;
-    for (auto const& [ueId, ueCollector] : ueCollectors_) {
-        ueCollector->add_ul_nongbr_pdr_ue();
-    }
-}
+    EV << collectorType_ << "::collectPacketDelays()" << endl;
+    for (unsigned int slot = 0; slot < slotCollectors_.size(); slot++) {
+        UeStatsCollector *ueCollector = slotCollectors_[slot];
+        if (ueCollector == nullptr)
+            continue;
+        MacNodeId ueId = ueMeasures_.getUeId(slot);
+
+        double delay = packetFlowObserver_->getDelayStatsPerUe(ueId);
+        EV << collectorType_ << "::collectPacketDelays - DL delay: " << delay << " for node id: " << ueId << endl;
+        if (delay != 0)
+            ueMeasures_.addValue(DL_NONGBR_DELAY_UE, slot, (int)delay);
+
+        if (PacketFlowObserverUe *uePfo = ueCollector->getPacketFlowObserver()) {
+            delay = uePfo->getDelayStats();
+            if (delay != 0)
+                EV << collectorType_ << "::collectPacketDelays - UL delay: " << delay << " for node id: " << ueId << endl;
+            ueMeasures_.addValue(UL_NONGBR_DELAY_UE, slot, (int)delay);
+        }
 
-void BaseStationStatsCollector::add_ul_nongbr_delay_perUser()
-{
-    EV << collectorType_ << "::add_ul_nongbr_delay_perUser()" << endl;
-    for (auto const& [ueId, ueCollector] : ueCollectors_) {
-        ueCollector->add_ul_nongbr_delay_ue();
+        //reset counters
+        packetFlowObserver_->resetDelayCounterPerUe(ueId);
+        ueCollector->resetDelayCounter();
     }
 }
 
-void BaseStationStatsCollector::add_dl_nongbr_delay_perUser()
+void BaseStationStatsCollector::collectDiscardRates()
 {
-    EV << collectorType_ << "::add_dl_nongbr_delay_perUser()" << endl;
-    double delay;
-    for (auto const& [ueId, ueCollector] : ueCollectors_) {
-        delay = packetFlowObserver_->getDelayStatsPerUe(ueId);
-        EV << collectorType_ << "::add_dl_nongbr_delay_perUser - delay: " << delay << " for node id: " << ueId << endl;
-        if (delay != 0) {
-            ueCollector->add_dl_nongbr_delay_ue((int)delay);
+    EV << collectorType_ << "::collectDiscardRates()" << endl;
+    add_dl_nongbr_pdr_cell();
+
+    // the UL discard rate of the cell is computed while visiting the UEs
+    DiscardedPkts ulPair = { 0, 0 };
+    for (unsigned int slot = 0; slot < slotCollectors_.size(); slot++) {
+        UeStatsCollector *ueCollector = slotCollectors_[slot];
+        if (ueCollector == nullptr)
+            continue;
+        MacNodeId ueId = ueMeasures_.getUeId(slot);
+
+        double discard = packetFlowObserver_->getDiscardedPktPerUe(ueId);
+        ueMeasures_.addValue(DL_NONGBR_PDR_UE, slot, (int)discard);
+
+        DiscardedPkts pair = ueCollector->getULDiscardedPkt();
+        ulPair.discarded += pair.discarded;
+        ulPair.total += pair.total;
+        if (ueCollector->getPacketFlowObserver() != nullptr) {
+            double rate = (pair.total == 0) ? 0.0 : ((double)pair.discarded * 1000000) / pair.total;
+            ueMeasures_.addValue(UL_NONGBR_PDR_UE, slot, (int)rate);
         }
-    }
-}
 
-void BaseStationStatsCollector::add_ul_nongbr_data_volume_ue_perUser()
-{
-    EV << collectorType_ << "::add_ul_nongbr_data_volume_ue_perUser" << endl;
-    unsigned int bytes;
-    for (auto const& [ueId, ueCollector] : ueCollectors_) {
-        bytes = packetFlowObserver_->getDataVolume(ueId, UL);
-        EV << collectorType_ << "::add_ul_nongbr_data_volume_ue_perUser - received: " << bytes << "B in UL from node id: " << ueId << endl;
-        ueCollector->add_ul_nongbr_data_volume_ue(bytes);
+        //reset counters
+        packetFlowObserver_->resetDiscardCounterPerUe(ueId);
     }
+
+    double pdr = (ulPair.total == 0) ? 0.0 : ((double)ulPair.discarded * 1000000) / ulPair.total;
+    ul_nongbr_pdr_cell.addValue((int)pdr);
+
+    packetFlowObserver_->resetDiscardCounter();
 }
 
-void BaseStationStatsCollector::add_dl_nongbr_data_volume_ue_perUser()
+void BaseStationStatsCollector::collectDataVolumes()
 {
-    EV << collectorType_ << "::add_dl_nongbr_data_volume_ue_perUser" << endl;
-    unsigned int bytes;
-    for (auto const& [ueId, ueCollector] : ueCollectors_) {
-        bytes = packetFlowObserver_->getDataVolume(ueId, DL);
-        EV << collectorType_ << "::add_dl_nongbr_data_volume_ue_perUser - sent: " << bytes << "B in DL to node id: " << ueId << endl;
-        ueCollector->add_dl_nongbr_data_volume_ue(bytes);
+    EV << collectorType_ << "::collectDataVolumes" << endl;
+    for (unsigned int slot = 0; slot < slotCollectors_.size(); slot++) {
+        if (slotCollectors_[slot] == nullptr)
+            continue;
+        MacNodeId ueId = ueMeasures_.getUeId(slot);
+
+        unsigned int ulBytes = packetFlowObserver_->getDataVolume(ueId, UL);
+        unsigned int dlBytes = packetFlowObserver_->getDataVolume(ueId, DL);
+        EV << collectorType_ << "::collectDataVolumes - " << ulBytes << "B in UL and " << dlBytes << "B in DL for node id: " << ueId << endl;
+        ueMeasures_.addValue(UL_NONGBR_DATA_VOLUME_UE, slot, ulBytes);
+        ueMeasures_.addValue(DL_NONGBR_DATA_VOLUME_UE, slot, dlBytes);
+
+        //reset counters
+        packetFlowObserver_->resetDataVolume(ueId);
     }
 }
 
-void BaseStationStatsCollector::add_dl_nongbr_throughput_ue_perUser()
+void BaseStationStatsCollector::collectThroughputs()
 {
-    EV << collectorType_ << "::add_dl_nongbr_throughput_ue_perUser" << endl;
-    double throughput;
-    for (auto const& [ueId, ueCollector] : ueCollectors_) {
-        throughput = packetFlowObserver_->getThroughputStatsPerUe(ueId);
-        EV << collectorType_ << "::add_dl_nongbr_throughput_ue_perUser - throughput: " << throughput << " for node " << ueId << endl;
+    EV << collectorType_ << "::collectThroughputs" << endl;
+    for (unsigned int slot = 0; slot < slotCollectors_.size(); slot++) {
+        if (slotCollectors_[slot] == nullptr)
+            continue;
+        MacNodeId ueId = ueMeasures_.getUeId(slot);
+
+        double throughput = packetFlowObserver_->getThroughputStatsPerUe(ueId);
+        EV << collectorType_ << "::collectThroughputs - DL throughput: " << throughput << " for node " << ueId << endl;
         packetFlowObserver_->resetThroughputCounterPerUe(ueId);
         if (throughput > 0.0)
-            ueCollector->add_dl_nongbr_throughput_ue((int)throughput);
-    }
-}
+            ueMeasures_.addValue(DL_NONGBR_THROUGHPUT_UE, slot, (int)throughput);
 
-void BaseStationStatsCollector::add_ul_nongbr_throughput_ue_perUser()
-{
-    EV << collectorType_ << "::add_ul_nongbr_throughput_ue_perUser" << endl;
-    double throughput;
-    for (auto const& [ueId, ueCollector] : ueCollectors_) {
         throughput = rlc_->getUeThroughput(ueId);
-        EV << collectorType_ << "::add_ul_nongbr_throughput_ue_perUser - throughput: " << throughput << " for node " << ueId << endl;
+        EV << collectorType_ << "::collectThroughputs - UL throughput: " << throughput << " for node " << ueId << endl;
         rlc_->resetThroughputStats(ueId);
         if (throughput > 0.0)
-            ueCollector->add_ul_nongbr_throughput_ue((int)throughput);
+            ueMeasures_.addValue(UL_NONGBR_THROUGHPUT_UE, slot, (int)throughput);
     }
 }
 
@@ -420,8 +379,10 @@ MacCellId BaseStationStatsCollector::getCellId() const
 void BaseStationStatsCollector::resetStats(MacNodeId nodeId)
 {
     auto ue = ueCollectors_.find(nodeId);
-    if (ue != ueCollectors_.end())
+    if (ue != ueCollectors_.end()) {
         ue->second->resetStats();
+        version_++;
+    }
 }
 
 } //namespace
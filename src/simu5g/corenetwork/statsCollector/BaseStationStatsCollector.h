@@ -19,6 +19,7 @@
 #include "simu5g/mec/utils/MecCommon.h"
 #include <map>
 #include "simu5g/corenetwork/statsCollector/L2Measures/L2MeasBase.h"
+#include "simu5g/corenetwork/statsCollector/L2Measures/UeL2MeasStore.h"
 #include "simu5g/common/cellInfo/CellInfo.h"
 #include "simu5g/stack/mac/LteMacEnb.h"
 #include "simu5g/stack/rlc/RlcMux.h"
@@ -32,7 +33,8 @@ using namespace inet;
  * service Layer2Measurements resource. The RNI service will call its methods in order to
  * respond to requests.
  * It holds a map structure with all the UeCollectors of the UEs connected to the
- * eNodeB/gNodeB
+ * eNodeB/gNodeB. The per-UE measures are stored in a columnar store, where each UE
+ * has a slot, so that each timer updates a measure for all the UEs in a single pass.
  */
 
 class UeStatsCollector;
@@ -56,6 +58,14 @@ class BaseStationStatsCollector : public cSimpleModule
 
     UeStatsCollectorMap ueCollectors_;
 
+    // per-UE L2 measures, and the UE collector owning each slot (nullptr if free)
+    UeL2MeasStore ueMeasures_;
+    std::vector<UeStatsCollector *> slotCollectors_;
+
+    // incremented whenever the L2 measures or the set of UE collectors change,
+    // so that consumers (e.g. the RNI service) can cache what they build from them
+    unsigned long version_ = 0;
+
     // L2 Measures per EnodeB
     L2MeasBase dl_total_prb_usage_cell;
     L2MeasBase ul_total_prb_usage_cell;
@@ -95,6 +105,7 @@ class BaseStationStatsCollector : public cSimpleModule
 
     const mec::Ecgi& getEcgi() const;
     MacCellId getCellId() const;
+    unsigned long getVersion() const { return version_; }
 
     // UeStatsCollector management methods
 
@@ -151,11 +162,10 @@ class BaseStationStatsCollector : public cSimpleModule
 
     /*
      * It indicates the packet discard rate in percentage of the
-     * UL/DL non-GBR traffic in a cell, as defined in ETSI
-     * TS 136 314
+     * DL non-GBR traffic in a cell, as defined in ETSI
+     * TS 136 314 (the UL rate is computed by collectDiscardRates())
      */
     void add_dl_nongbr_pdr_cell();
-    void add_ul_nongbr_pdr_cell();
 
     /*
      * It indicates (in percentage) the PRB usage for total UL/DL
@@ -174,15 +184,11 @@ class BaseStationStatsCollector : public cSimpleModule
     int get_dl_nongbr_pdr_cell();
     int get_ul_nongbr_pdr_cell();
 
-    // save stats into UeCollectors
-    void add_dl_nongbr_delay_perUser();
-    void add_ul_nongbr_delay_perUser();
-    void add_dl_nongbr_pdr_cell_perUser();
-    void add_ul_nongbr_pdr_cell_perUser();
-    void add_ul_nongbr_data_volume_ue_perUser();
-    void add_dl_nongbr_data_volume_ue_perUser();
-    void add_dl_nongbr_throughput_ue_perUser();
-    void add_ul_nongbr_throughput_ue_perUser();
+    // save stats of all the UEs into the per-UE measure store
+    void collectPacketDelays();
+    void collectDiscardRates();
+    void collectDataVolumes();
+    void collectThroughputs();
 
     /* getters for GBR (Guaranteed Bit Rate) L2 measures.
      * currently not implemented since the simulator does not
@@ -198,12 +204,6 @@ class BaseStationStatsCollector : public cSimpleModule
     int get_dl_gbr_pdr_cell() { return -1; }
     int get_ul_gbr_pdr_cell() { return -1; }
 
-    // reset structures to calculate the measure
-    void resetDiscardCounterPerUe();
-    void resetDelayCounterPerUe();
-    void resetBytesCountersPerUe();
-    void resetThroughputCountersPerUe();
-
     void resetStats(MacNodeId nodeId);
 
   protected:
@@ -0,0 +1,125 @@
+//
+//                  Simu5G
+//
+// Copyright (C) 2019-2021 Giovanni Nardini, Giovanni Stea, Antonio Virdis et al. (University of Pisa)
+// Copyright (C) 2022-2026 Giovanni Nardini, Giovanni Stea et al. (University of Pisa)
+//
+// This file is part of a software released under the license included in file
+// "license.pdf". Please read LICENSE and README files before using it.
+// The above files and the present reference are part of the software itself,
+// and cannot be removed from it.
+//
+
+#include <cmath>
+#include "UeL2MeasStore.h"
+
+namespace simu5g {
+
+void L2MeasColumn::resize(unsigned int numSlots)
+{
+    values_.resize((size_t)numSlots * stride_, 0.);
+    sum_.resize(numSlots, 0.);
+    lastValue_.resize(numSlots, 0);
+    mean_.resize(numSlots, 0);
+    index_.resize(numSlots, 0);
+    period_.resize(numSlots, 1);
+    size_.resize(numSlots, 0);
+    movingAverage_.resize(numSlots, false);
+}
+
+void L2MeasColumn::initSlot(unsigned int slot, int period, bool movingAverage)
+{
+    if (period < 1)
+        throw cRuntimeError("L2MeasColumn::initSlot - the number of periods must be positive");
+
+    if (period > stride_) {
+        // widen the windows of all the slots
+        unsigned int numSlots = sum_.size();
+        std::vector<double> values((size_t)numSlots * period, 0.);
+        for (unsigned int s = 0; s < numSlots; s++)
+            std::copy(values_.begin() + (size_t)s * stride_, values_.begin() + (size_t)s * stride_ + period_[s], values.begin() + (size_t)s * period);
+        values_.swap(values);
+        stride_ = period;
+    }
+    period_[slot] = period;
+    movingAverage_[slot] = movingAverage;
+    reset(slot);
+}
+
+void L2MeasColumn::addValue(unsigned int slot, double value)
+{
+    double *values = values_.data() + (size_t)slot * stride_;
+    int& index = index_[slot];
+
+    lastValue_[slot] = (int)value;
+    sum_[slot] += value;
+    if (size_[slot] < period_[slot]) {
+        size_[slot]++;
+    }
+    else {
+        index = index % period_[slot];
+        sum_[slot] -= values[index];
+    }
+    values[index++] = value;
+
+    if (movingAverage_[slot] || index == period_[slot]) // compute mean
+        mean_[slot] = computeMean(slot);
+}
+
+int L2MeasColumn::computeMean(unsigned int slot) const
+{
+    if (index_[slot] == 0)
+        return 0;
+    if (!movingAverage_[slot] && size_[slot] < period_[slot]) // not enough data
+        return 0;
+    else {
+        int mean = floor(sum_[slot] / size_[slot]);
+        return mean < 0 ? 0 : mean; // round could return -0.00 -> -1
+    }
+}
+
+void L2MeasColumn::reset(unsigned int slot)
+{
+    std::fill(values_.begin() + (size_t)slot * stride_, values_.begin() + (size_t)(slot + 1) * stride_, 0.);
+    lastValue_[slot] = 0;
+    size_[slot] = 0;
+    index_[slot] = 0;
+    sum_[slot] = 0;
+    mean_[slot] = 0;
+}
+
+unsigned int UeL2MeasStore::addUe(MacNodeId ueId)
+{
+    unsigned int slot;
+    if (!freeSlots_.empty()) {
+        slot = freeSlots_.back();
+        freeSlots_.pop_back();
+    }
+    else {
+        slot = ueIds_.size();
+        ueIds_.push_back(NODEID_NONE);
+        for (auto& column : columns_)
+            column.resize(ueIds_.size());
+    }
+    ueIds_[slot] = ueId;
+    numUes_++;
+    return slot;
+}
+
+void UeL2MeasStore::removeUe(unsigned int slot)
+{
+    if (slot >= ueIds_.size() || ueIds_[slot] == NODEID_NONE)
+        throw cRuntimeError("UeL2MeasStore::removeUe - slot %u is not in use", slot);
+    resetUe(slot);
+    ueIds_[slot] = NODEID_NONE;
+    freeSlots_.push_back(slot);
+    numUes_--;
+}
+
+void UeL2MeasStore::resetUe(unsigned int slot)
+{
+    for (auto& column : columns_)
+        column.reset(slot);
+}
+
+} //namespace
@@ -0,0 +1,101 @@
+//
+//                  Simu5G
+//
+// Copyright (C) 2019-2021 Giovanni Nardini, Giovanni Stea, Antonio Virdis et al. (University of Pisa)
+// Copyright (C) 2022-2026 Giovanni Nardini, Giovanni Stea et al. (University of Pisa)
+//
+// This file is part of a software released under the license included in file
+// "license.pdf". Please read LICENSE and README files before using it.
+// The above files and the present reference are part of the software itself,
+// and cannot be removed from it.
+//
+
+#ifndef _UEL2MEASSTORE_H_
+#define _UEL2MEASSTORE_H_
+
+#include <vector>
+#include "simu5g/common/LteCommon.h"
+
+namespace simu5g {
+
+/*
+ * Per-UE L2 measures of the RNI service
+ */
+enum UeL2Meas
+{
+    UL_NONGBR_DELAY_UE,
+    DL_NONGBR_DELAY_UE,
+    UL_NONGBR_PDR_UE,
+    DL_NONGBR_PDR_UE,
+    UL_NONGBR_THROUGHPUT_UE,
+    DL_NONGBR_THROUGHPUT_UE,
+    UL_NONGBR_DATA_VOLUME_UE,
+    DL_NONGBR_DATA_VOLUME_UE,
+    NUM_UE_L2_MEAS
+};
+
+/**
+ * One L2 measure for all the UE slots of a cell. Each slot computes the average of
+ * its last values like L2MeasBase does; the windows of all the slots are stored
+ * contiguously, with a stride equal to the largest window.
+ */
+class L2MeasColumn
+{
+  private:
+    std::vector<double> values_;
+    std::vector<double> sum_;
+    std::vector<int> lastValue_;
+    std::vector<int> mean_;
+    std::vector<int> index_;
+    std::vector<int> period_;
+    std::vector<int> size_;
+    std::vector<bool> movingAverage_;
+    int stride_ = 1;
+
+    int computeMean(unsigned int slot) const;
+
+  public:
+    void resize(unsigned int numSlots);
+    void initSlot(unsigned int slot, int period, bool movingAverage);
+    void addValue(unsigned int slot, double value);
+    int getMean(unsigned int slot) const { return mean_[slot]; }
+    int getLastValue(unsigned int slot) const { return lastValue_[slot]; }
+    void reset(unsigned int slot);
+};
+
+/**
+ * Columnar store of the per-UE L2 measures of a cell. UEs are assigned dense slots,
+ * reused after the UE leaves the cell, and every measure is an L2MeasColumn
+ * indexed by slot, so that the collector updates a measure for all the UEs with a
+ * single pass over contiguous arrays.
+ */
+class UeL2MeasStore
+{
+  private:
+    L2MeasColumn columns_[NUM_UE_L2_MEAS];
+    std::vector<MacNodeId> ueIds_;  // UE of each slot, NODEID_NONE if the slot is free
+    std::vector<unsigned int> freeSlots_;
+    unsigned int numUes_ = 0;
+
+  public:
+    /*
+     * Assigns a slot to the given UE. The measures of the slot must be initialized
+     * with initMeasure()
+     */
+    unsigned int addUe(MacNodeId ueId);
+    void removeUe(unsigned int slot);
+    void initMeasure(unsigned int slot, UeL2Meas meas, int period, bool movingAverage) { columns_[meas].initSlot(slot, period, movingAverage); }
+
+    void addValue(UeL2Meas meas, unsigned int slot, double value) { columns_[meas].addValue(slot, value); }
+    int getMean(UeL2Meas meas, unsigned int slot) const { return columns_[meas].getMean(slot); }
+    void resetUe(unsigned int slot);
+
+    // slots are in [0, getNumSlots()), free ones have NODEID_NONE as UE
+    unsigned int getNumSlots() const { return ueIds_.size(); }
+    MacNodeId getUeId(unsigned int slot) const { return ueIds_[slot]; }
+    unsigned int getNumUes() const { return numUes_; }
+};
+
+} //namespace
+
+#endif //_UEL2MEASSTORE_H_
@@ -43,117 +43,38 @@ void UeStatsCollector::initialize(int stage)
         bool isNr_ = (std::string(getContainingNicModule(mac_)->getComponentType()->getName()) == "NrNicUe");
 
         packetFlowObserver_.reference(this, "packetFlowObserverModule", isNr_);
-
-        // packet delay
-        ul_nongbr_delay_ue.init("ul_nongbr_delay_ue", par("delayPacketPeriods"), par("movingAverage"));
-        dl_nongbr_delay_ue.init("dl_nongbr_delay_ue", par("delayPacketPeriods"), par("movingAverage"));
-        // packet discard rate
-        ul_nongbr_pdr_ue.init("ul_nongbr_pdr_ue", par("discardRatePeriods"), par("movingAverage"));
-        dl_nongbr_pdr_ue.init("dl_nongbr_pdr_ue", par("discardRatePeriods"), par("movingAverage"));
-        // scheduled throughput
-        ul_nongbr_throughput_ue.init("ul_nongbr_throughput_ue", par("tPutPeriods"), par("movingAverage"));
-        dl_nongbr_throughput_ue.init("dl_nongbr_throughput_ue", par("tPutPeriods"), par("movingAverage"));
-        // data volume
-        ul_nongbr_data_volume_ue.init("ul_nongbr_data_volume_ue", par("dataVolumePeriods"), par("movingAverage"));
-        dl_nongbr_data_volume_ue.init("dl_nongbr_data_volume_ue", par("dataVolumePeriods"), par("movingAverage"));
     }
 }
 
-void UeStatsCollector::resetDelayCounter()
-{
-    if (packetFlowObserver_ != nullptr)
-        packetFlowObserver_->resetDelayCounter();
-}
-
-void UeStatsCollector::add_ul_nongbr_delay_ue()
-{
-    if (packetFlowObserver_ != nullptr) {
-        double delay = packetFlowObserver_->getDelayStats();
-        if (delay != 0)
-            EV << "UeStatsCollector::add_ul_nongbr_delay_ue() - delay: " << delay << endl;
-        ul_nongbr_delay_ue.addValue((int)delay);
-    }
-}
-
-// called by the eNodeBCollector
-void UeStatsCollector::add_dl_nongbr_delay_ue(double value)
-{
-    dl_nongbr_delay_ue.addValue(value);
-}
-
-void UeStatsCollector::add_ul_nongbr_pdr_ue()
+void UeStatsCollector::attachMeasStore(UeL2MeasStore *store, unsigned int slot)
 {
-    DiscardedPkts pair = packetFlowObserver_->getDiscardedPkt();
-    double rate = ((double)pair.discarded * 1000000) / pair.total;
-    ul_nongbr_pdr_ue.addValue((int)rate);
-}
-
-// called by the eNodeBCollector
-void UeStatsCollector::add_dl_nongbr_pdr_ue(double value)
-{
-    dl_nongbr_pdr_ue.addValue(value);
-}
+    measStore_ = store;
+    measSlot_ = slot;
 
-// called by the eNodeBCollector
-void UeStatsCollector::add_ul_nongbr_throughput_ue(double value)
-{
-    ul_nongbr_throughput_ue.addValue(value);
-}
-
-void UeStatsCollector::add_dl_nongbr_throughput_ue(double value)
-{
-    dl_nongbr_throughput_ue.addValue(value);
-}
-
-// called by the eNodeBCollector
-void UeStatsCollector::add_ul_nongbr_data_volume_ue(unsigned int value)
-{
-    ul_nongbr_data_volume_ue.addValue(value);
-}
-
-void UeStatsCollector::add_dl_nongbr_data_volume_ue(unsigned int value)
-{
-    dl_nongbr_data_volume_ue.addValue(value);
-}
-
-int UeStatsCollector::get_ul_nongbr_delay_ue()
-{
-    return ul_nongbr_delay_ue.getMean();
-}
-
-int UeStatsCollector::get_dl_nongbr_delay_ue()
-{
-    return dl_nongbr_delay_ue.getMean();
-}
-
-int UeStatsCollector::get_ul_nongbr_pdr_ue()
-{
-    return ul_nongbr_pdr_ue.getMean();
-}
-
-int UeStatsCollector::get_dl_nongbr_pdr_ue()
-{
-    return dl_nongbr_pdr_ue.getMean();
-}
-
-int UeStatsCollector::get_ul_nongbr_throughput_ue()
-{
-    return ul_nongbr_throughput_ue.getMean();
-}
-
-int UeStatsCollector::get_dl_nongbr_throughput_ue()
-{
-    return dl_nongbr_throughput_ue.getMean();
+    bool movingAverage = par("movingAverage");
+    // packet delay
+    store->initMeasure(slot, UL_NONGBR_DELAY_UE, par("delayPacketPeriods"), movingAverage);
+    store->initMeasure(slot, DL_NONGBR_DELAY_UE, par("delayPacketPeriods"), movingAverage);
+    // packet discard rate
+    store->initMeasure(slot, UL_NONGBR_PDR_UE, par("discardRatePeriods"), movingAverage);
+    store->initMeasure(slot, DL_NONGBR_PDR_UE, par("discardRatePeriods"), movingAverage);
+    // scheduled throughput
+    store->initMeasure(slot, UL_NONGBR_THROUGHPUT_UE, par("tPutPeriods"), movingAverage);
+    store->initMeasure(slot, DL_NONGBR_THROUGHPUT_UE, par("tPutPeriods"), movingAverage);
+    // data volume
+    store->initMeasure(slot, UL_NONGBR_DATA_VOLUME_UE, par("dataVolumePeriods"), movingAverage);
+    store->initMeasure(slot, DL_NONGBR_DATA_VOLUME_UE, par("dataVolumePeriods"), movingAverage);
 }
 
-int UeStatsCollector::get_ul_nongbr_data_volume_ue()
+void UeStatsCollector::detachMeasStore()
 {
-    return ul_nongbr_data_volume_ue.getMean();
+    measStore_ = nullptr;
 }
 
-int UeStatsCollector::get_dl_nongbr_data_volume_ue()
+void UeStatsCollector::resetDelayCounter()
 {
-    return dl_nongbr_data_volume_ue.getMean();
+    if (packetFlowObserver_ != nullptr)
+        packetFlowObserver_->resetDelayCounter();
 }
 
 DiscardedPkts UeStatsCollector::getULDiscardedPkt()
@@ -169,19 +90,10 @@ DiscardedPkts UeStatsCollector::getULDiscardedPkt()
 
 void UeStatsCollector::resetStats()
 {
-    packetFlowObserver_->clearStats();
-    // packet delay
-    ul_nongbr_delay_ue.reset();
-    dl_nongbr_delay_ue.reset();
-    // packet discard rate
-    ul_nongbr_pdr_ue.reset();
-    dl_nongbr_pdr_ue.reset();
-    // scheduled throughput
-    ul_nongbr_throughput_ue.reset();
-    dl_nongbr_throughput_ue.reset();
-    // data volume
-    ul_nongbr_data_volume_ue.reset();
-    dl_nongbr_data_volume_ue.reset();
+    if (packetFlowObserver_ != nullptr)
+        packetFlowObserver_->clearStats();
+    if (measStore_ != nullptr)
+        measStore_->resetUe(measSlot_);
 }
 
 } //namespace
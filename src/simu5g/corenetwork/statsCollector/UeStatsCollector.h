@@ -17,7 +17,7 @@
 
 #include "simu5g/common/LteCommon.h"
 #include "simu5g/mec/utils/MecCommon.h"
-#include "simu5g/corenetwork/statsCollector/L2Measures/L2MeasBase.h"
+#include "simu5g/corenetwork/statsCollector/L2Measures/UeL2MeasStore.h"
 #include <string>
 #include "simu5g/corenetwork/statsCollector/UeStatsCollector.h"
 #include "simu5g/stack/mac/LteMacBase.h"
@@ -33,7 +33,8 @@ using namespace inet;
  * the MEC framework. In particular, it retrieves packet delays and discard rates.
  *
  * It is managed by the eNodeBStatsCollector modules. The latter has timers that
- * periodically calculate the measures.
+ * periodically calculate the measures, and stores them in a slot of its per-UE
+ * measure store, which this module reads.
  *
  */
 class UeStatsCollector : public cSimpleModule
@@ -49,42 +50,28 @@ class UeStatsCollector : public cSimpleModule
     inet::ModuleRefByPar<LteMacBase> mac_;
     inet::ModuleRefByPar<PacketFlowObserverUe> packetFlowObserver_;
 
-    // packet delay
-    L2MeasBase ul_nongbr_delay_ue;
-    L2MeasBase dl_nongbr_delay_ue;
-    // packet discard rate
-    L2MeasBase ul_nongbr_pdr_ue;
-    L2MeasBase dl_nongbr_pdr_ue;
-    // scheduled throughput
-    L2MeasBase ul_nongbr_throughput_ue;
-    L2MeasBase dl_nongbr_throughput_ue;
-    // data volume
-    L2MeasBase ul_nongbr_data_volume_ue;
-    L2MeasBase dl_nongbr_data_volume_ue;
+    // slot of this UE in the measure store of the serving cell (nullptr if not attached)
+    UeL2MeasStore *measStore_ = nullptr;
+    unsigned int measSlot_ = 0;
 
     // TODO insert signals for statistics
 
     bool handover_ = false;
 
-  public:
-
-    // methods to update L2 measures
-
-    // packet delay
-    void add_ul_nongbr_delay_ue();
-    void add_dl_nongbr_delay_ue(double value); // called by the eNodeBCollector
+    int getMeasMean(UeL2Meas meas) const { return measStore_ != nullptr ? measStore_->getMean(meas, measSlot_) : 0; }
 
-    // packet discard rate
-    void add_ul_nongbr_pdr_ue();
-    void add_dl_nongbr_pdr_ue(double value); // called by the eNodeBCollector
+  public:
 
-    // throughput
-    void add_ul_nongbr_throughput_ue(double value);
-    void add_dl_nongbr_throughput_ue(double value);
+    /*
+     * Called by the eNodeBStatsCollector when the UE is added to/removed from its cell:
+     * initializes the measures of the given slot according to the parameters of this module
+     */
+    void attachMeasStore(UeL2MeasStore *store, unsigned int slot);
+    void detachMeasStore();
+    unsigned int getMeasSlot() const { return measSlot_; }
 
-    // PDPC bytes
-    void add_ul_nongbr_data_volume_ue(unsigned int value); // called by the eNodeBCollector
-    void add_dl_nongbr_data_volume_ue(unsigned int value); // called by the eNodeBCollector
+    // returns nullptr if the UE has no packetFlowObserver
+    PacketFlowObserverUe *getPacketFlowObserver() { return packetFlowObserver_.getNullable(); }
 
     void resetDelayCounter(); // reset structures to calculate the measures
 
@@ -96,20 +83,20 @@ class UeStatsCollector : public cSimpleModule
     // getters to retrieve L2 measures (e.g. from RNI service)
 
     // packet delay getters
-    int get_ul_nongbr_delay_ue();
-    int get_dl_nongbr_delay_ue();
+    int get_ul_nongbr_delay_ue() const { return getMeasMean(UL_NONGBR_DELAY_UE); }
+    int get_dl_nongbr_delay_ue() const { return getMeasMean(DL_NONGBR_DELAY_UE); }
 
     // packet discard rate getters
-    int get_ul_nongbr_pdr_ue();
-    int get_dl_nongbr_pdr_ue();
+    int get_ul_nongbr_pdr_ue() const { return getMeasMean(UL_NONGBR_PDR_UE); }
+    int get_dl_nongbr_pdr_ue() const { return getMeasMean(DL_NONGBR_PDR_UE); }
 
     // throughput getters
-    int get_ul_nongbr_throughput_ue();
-    int get_dl_nongbr_throughput_ue();
+    int get_ul_nongbr_throughput_ue() const { return getMeasMean(UL_NONGBR_THROUGHPUT_UE); }
+    int get_dl_nongbr_throughput_ue() const { return getMeasMean(DL_NONGBR_THROUGHPUT_UE); }
 
     // PDPC bytes getters
-    int get_ul_nongbr_data_volume_ue();
-    int get_dl_nongbr_data_volume_ue();
+    int get_ul_nongbr_data_volume_ue() const { return getMeasMean(UL_NONGBR_DATA_VOLUME_UE); }
+    int get_dl_nongbr_data_volume_ue() const { return getMeasMean(DL_NONGBR_DATA_VOLUME_UE); }
 
     /* getters for GBR (Guaranteed Bit Rate) L2 measures.
      * currently not implemented since the simulator does not
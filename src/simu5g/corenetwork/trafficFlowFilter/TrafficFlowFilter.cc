@@ -22,6 +22,8 @@ Define_Module(TrafficFlowFilter);
 using namespace inet;
 using namespace omnetpp;
 
+simsignal_t TrafficFlowFilter::flowCacheHitSignal_ = registerSignal("flowCacheHit");
+
 void TrafficFlowFilter::initialize(int stage)
 {
     // wait until all the IP addresses are configured
@@ -32,6 +34,8 @@ void TrafficFlowFilter::initialize(int stage)
     binder_.reference(this, "binderModule", true);
 
     fastForwarding_ = par("fastForwarding");
+    flowCacheEnabled_ = par("flowCache");
+    maxFlowCacheSize_ = par("maxFlowCacheSize");
 
     // reading and setting owner type
     ownerType_ = selectOwnerType(par("ownerType"));
@@ -128,7 +132,7 @@ void TrafficFlowFilter::handleMessage(cMessage *msg)
 
     // run packet filter and associate a flowId to the connection (default bearer?)
     // search within tftTable the proper entry for this destination
-    TrafficFlowTemplateId tftId = findTrafficFlow(srcAddr, destAddr);   // search for the tftId in the binder
+    TrafficFlowTemplateId tftId = classify(srcAddr, destAddr);   // search for the tftId in the binder
 
     // add control info to the normal IP datagram. This info will be read by the GTP-U application
     auto tftInfo = pkt->addTag<TftControlInfo>();
@@ -145,6 +149,35 @@ void TrafficFlowFilter::handleMessage(cMessage *msg)
     send(pkt, "gtpUserGateOut");
 }
 
+TrafficFlowTemplateId TrafficFlowFilter::classify(const Ipv4Address& srcAddress, const Ipv4Address& destAddress)
+{
+    if (!flowCacheEnabled_)
+        return findTrafficFlow(srcAddress, destAddress);
+
+    // the classification only depends on the mappings stored in the Binder, drop all the
+    // entries as soon as any of them changes (e.g. handover, new MEC host)
+    unsigned long epoch = binder_->getTopologyEpoch();
+    if (epoch != flowCacheEpoch_) {
+        flowCache_.clear();
+        flowCacheEpoch_ = epoch;
+    }
+
+    uint64_t key = ((uint64_t)srcAddress.getInt() << 32) | destAddress.getInt();
+    auto it = flowCache_.find(key);
+    if (it != flowCache_.end()) {
+        emit(flowCacheHitSignal_, true);
+        EV << "TrafficFlowFilter::classify - cached flowId " << it->second << " for " << srcAddress << " -> " << destAddress << endl;
+        return it->second;
+    }
+    emit(flowCacheHitSignal_, false);
+
+    TrafficFlowTemplateId tftId = findTrafficFlow(srcAddress, destAddress);
+    if (flowCache_.size() >= maxFlowCacheSize_)
+        flowCache_.clear();
+    flowCache_[key] = tftId;
+    return tftId;
+}
+
 TrafficFlowTemplateId TrafficFlowFilter::findTrafficFlow(L3Address srcAddress, L3Address destAddress)
 {
     // check whether the destination address is a (simulated) MEC host's address
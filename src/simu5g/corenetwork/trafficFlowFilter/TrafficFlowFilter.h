@@ -13,6 +13,8 @@
 #ifndef __TRAFFICFLOWFILTER_H_
 #define __TRAFFICFLOWFILTER_H_
 
+#include <unordered_map>
+
 #include <inet/common/ModuleRefByPar.h>
 
 #include "simu5g/common/LteDefs.h"
@@ -64,6 +66,16 @@ class TrafficFlowFilter : public cSimpleModule
     inet::L3Address meAppsExtAddress_;
     int meAppsExtAddressMask_;
 
+    // === flow classification cache === //
+
+    // (src, dst) IPv4 address pair -> result of findTrafficFlow()
+    bool flowCacheEnabled_;
+    unsigned int maxFlowCacheSize_;
+    std::unordered_map<uint64_t, TrafficFlowTemplateId> flowCache_;
+    // Binder topology epoch the cached entries were computed at
+    unsigned long flowCacheEpoch_ = 0;
+
+    static simsignal_t flowCacheHitSignal_;
 
   protected:
     int numInitStages() const override { return inet::NUM_INIT_STAGES; }
@@ -76,6 +88,9 @@ class TrafficFlowFilter : public cSimpleModule
 
     // functions for managing filter tables
     TrafficFlowTemplateId findTrafficFlow(inet::L3Address srcAddress, inet::L3Address destAddress);
+
+    // same as findTrafficFlow(), going through the flow cache when enabled
+    TrafficFlowTemplateId classify(const inet::Ipv4Address& srcAddress, const inet::Ipv4Address& destAddress);
 };
 
 } //namespace
@@ -68,6 +68,14 @@ ApplicationDescriptor::ApplicationDescriptor(const char *fileName)
         omnetppServiceRequired_ = jsonFile["omnetppServiceRequired"];
     }
 
+    /*
+     * MEC apps with a lightweight implementation (i.e., a subclass of LightweightMecApp) can be
+     * deployed in the MecAppContainer of the MEC host instead of being instantiated as a module
+     */
+    if (jsonFile.contains("containerAppClass")) {
+        containerAppClass_ = jsonFile["containerAppClass"];
+    }
+
     /*
      * If the application descriptor refers to a MEC application running outside the simulator, i.e. emulation mode,
      * the fields address and port refer to the endpoint to communicate with the MEC application
@@ -39,6 +39,9 @@ class ApplicationDescriptor
 
     std::string omnetppServiceRequired_;
 
+    // class of the lightweight implementation of the MEC app, if it can be deployed in a MecAppContainer
+    std::string containerAppClass_;
+
     /*
      * emulated mecApplication variables
      */
@@ -62,6 +65,7 @@ class ApplicationDescriptor
     std::string getAppDescription() const { return appDescription_; }
 
     std::string getOmnetppServiceRequired() const { return omnetppServiceRequired_; }
+    std::string getContainerAppClass() const { return containerAppClass_; }
 
     std::string getExternalAddress() const { return externalAddress; }
     int getExternalPort() const { return externalPort; }
@@ -28,6 +28,7 @@
 #include "simu5g/mec/orchestrator/policies/MecServiceBasedSelectionPolicy.h"
 #include "simu5g/mec/orchestrator/policies/AvailableResourcesBasedSelectionPolicy.h"
 #include "simu5g/mec/orchestrator/policies/MecHostBasedSelectionPolicy.h"
+#include "simu5g/mec/orchestrator/policies/LatencyLoadAwareSelectionPolicy.h"
 
 // Emulation debug
 #include <iostream>
@@ -50,9 +51,17 @@ void MecOrchestrator::initialize(int stage)
             mecHostSelectionPolicy_ = new AvailableResourcesBasedSelectionPolicy(this);
         else if (!strcmp(selectionPolicyPar, "MecHostBased"))
             mecHostSelectionPolicy_ = new MecHostBasedSelectionPolicy(this, par("mecHostIndex"));
+        else if (!strcmp(selectionPolicyPar, "LatencyLoadAware"))
+            mecHostSelectionPolicy_ = new LatencyLoadAwareSelectionPolicy(this, par("latencyWeight"), par("loadWeight"), par("cpuWeight"), par("hostStateRefreshInterval"));
         else
             throw cRuntimeError("MecOrchestrator::initialize - Selection policy '%s' not present!", selectionPolicyPar);
 
+        const char *deploymentPolicyPar = par("appDeploymentPolicy");
+        if (!strcmp(deploymentPolicyPar, "container"))
+            containerDeployment_ = true;
+        else if (strcmp(deploymentPolicyPar, "module"))
+            throw cRuntimeError("MecOrchestrator::initialize - Deployment policy '%s' not present!", deploymentPolicyPar);
+
         onboardingTime = par("onboardingTime").doubleValue();
         instantiationTime = par("instantiationTime").doubleValue();
         terminationTime = par("terminationTime").doubleValue();
@@ -163,7 +172,8 @@ void MecOrchestrator::startMecApp(UalcmpMessage *msg)
 
     const ApplicationDescriptor& desc = it->second;
 
-    cModule *bestHost = mecHostSelectionPolicy_->findBestMecHost(desc);
+    MacNodeId ueId = binder_->getMacNodeId(inet::L3AddressResolver().resolve(contAppMsg->getUeIpAddress()).toIpv4());
+    cModule *bestHost = mecHostSelectionPolicy_->findBestMecHost(desc, ueId);
 
     if (bestHost != nullptr) {
         CreateAppMessage *createAppMsg = new CreateAppMessage();
@@ -190,6 +200,10 @@ void MecOrchestrator::startMecApp(UalcmpMessage *msg)
 
         createAppMsg->setContextId(contextIdCounter);
 
+        // lightweight MEC apps are hosted by the MecAppContainer, if the MEC host has one
+        if (containerDeployment_ && !desc.getContainerAppClass().empty() && bestHost->getSubmodule("mecAppContainer") != nullptr)
+            createAppMsg->setContainerAppClass(desc.getContainerAppClass().c_str());
+
         // Add the new MEC app in the map structure
         MecAppMapEntry newMecApp;
         newMecApp.appDId = appDid;
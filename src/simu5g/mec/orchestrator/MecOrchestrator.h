@@ -78,6 +78,7 @@ class MecOrchestrator : public cSimpleModule
     friend class MecServiceBasedSelectionPolicy;
     friend class AvailableResourcesBasedSelectionPolicy;
     friend class MecHostBasedSelectionPolicy;
+    friend class LatencyLoadAwareSelectionPolicy;
 
     SelectionPolicyBase *mecHostSelectionPolicy_ = nullptr;
 
@@ -97,6 +98,9 @@ class MecOrchestrator : public cSimpleModule
 
     int contextIdCounter = 0;
 
+    // if true, MEC apps are deployed in the MecAppContainer of the MEC host when possible
+    bool containerDeployment_ = false;
+
     double onboardingTime;
     double instantiationTime;
     double terminationTime;
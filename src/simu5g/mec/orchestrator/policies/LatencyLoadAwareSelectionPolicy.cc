@@ -0,0 +1,147 @@
+//
+//                  Simu5G
+//
+// Copyright (C) 2019-2021 Giovanni Nardini, Giovanni Stea, Antonio Virdis et al. (University of Pisa)
+// Copyright (C) 2022-2026 Giovanni Nardini, Giovanni Stea et al. (University of Pisa)
+//
+// This file is part of a software released under the license included in file
+// "license.pdf". Please read LICENSE and README files before using it.
+// The above files and the present reference are part of the software itself,
+// and cannot be removed from it.
+//
+
+#include "simu5g/mec/orchestrator/policies/LatencyLoadAwareSelectionPolicy.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "simu5g/mec/platform/services/base/MecServiceBase.h"
+#include "simu5g/mec/vim/VirtualisationInfrastructureManager.h"
+
+namespace simu5g {
+
+void LatencyLoadAwareSelectionPolicy::initHostStates()
+{
+    for (auto mecHost : mecOrchestrator_->mecHosts) {
+        HostState state;
+        state.mecHost = mecHost;
+        state.vim = check_and_cast<VirtualisationInfrastructureManager *>(mecHost->getSubmodule("vim"));
+        cModule *mecPlatform = mecHost->getSubmodule("mecPlatform");
+        if (mecPlatform != nullptr) {
+            for (cModule::SubmoduleIterator it(mecPlatform); !it.end(); ++it) {
+                MecServiceBase *service = dynamic_cast<MecServiceBase *>(*it);
+                if (service != nullptr)
+                    state.services.push_back(service);
+            }
+        }
+        hosts_.push_back(state);
+    }
+}
+
+void LatencyLoadAwareSelectionPolicy::refreshHostStates()
+{
+    if (hosts_.empty())
+        initHostStates();
+
+    for (auto& state : hosts_) {
+        ResourceDescriptor available = state.vim->getAvailableResources();
+        double maxCpu = state.mecHost->par("maxCpuSpeed").doubleValue();
+        state.cpuUtilization = maxCpu > 0 ? 1.0 - available.cpu / maxCpu : 1.0;
+
+        state.serviceLoad = 0;
+        for (auto service : state.services)
+            state.serviceLoad += (double)service->getNumPendingRequests() / std::max(1, service->getNumWorkers());
+    }
+    ranking_.clear();
+    lastRefresh_ = simTime();
+}
+
+void LatencyLoadAwareSelectionPolicy::computeRtt(MacNodeId bsId)
+{
+    cModule *bs = mecOrchestrator_->binder_->getNodeModule(bsId);
+
+    // network nodes and MEC hosts, connected through wired links weighted by their delay
+    cTopology topo("topo");
+    topo.extractFromNetwork([this, bs](cModule *module) {
+        if (module == bs || module->getProperties()->get("networkNode") != nullptr)
+            return true;
+        return std::any_of(hosts_.begin(), hosts_.end(), [module](const HostState& state) { return state.mecHost == module; });
+    });
+
+    for (int i = 0; i < topo.getNumNodes(); i++) {
+        cTopology::Node *node = topo.getNode(i);
+        for (int j = 0; j < node->getNumOutLinks(); j++) {
+            cTopology::LinkOut *link = node->getLinkOut(j);
+            cChannel *channel = link->getLocalGate()->getChannel();
+            double delay = (channel != nullptr && channel->hasPar("delay")) ? channel->par("delay").doubleValue() : 0.0;
+            link->setWeight(delay);
+        }
+    }
+
+    cTopology::Node *bsNode = topo.getNodeFor(bs);
+    if (bsNode != nullptr)
+        topo.calculateWeightedSingleShortestPathsTo(bsNode);
+
+    for (auto& state : hosts_) {
+        cTopology::Node *hostNode = topo.getNodeFor(state.mecHost);
+        double distance = (bsNode != nullptr && hostNode != nullptr) ? hostNode->getDistanceToTarget() : INFINITY;
+        state.rtt[bsId] = 2 * distance;
+        EV << "LatencyLoadAwareSelectionPolicy::computeRtt - RTT between BS " << bsId << " and MEC host [" << state.mecHost->getName() << "]: " << state.rtt[bsId] << "s" << endl;
+    }
+}
+
+const std::set<std::pair<double, int>>& LatencyLoadAwareSelectionPolicy::getRanking(MacNodeId bsId)
+{
+    if (lastRefresh_ < 0 || simTime() - lastRefresh_ >= refreshInterval_)
+        refreshHostStates();
+
+    auto it = ranking_.find(bsId);
+    if (it != ranking_.end())
+        return it->second;
+
+    if (bsId != NODEID_NONE && hosts_.front().rtt.find(bsId) == hosts_.front().rtt.end())
+        computeRtt(bsId);
+
+    std::set<std::pair<double, int>>& ranking = ranking_[bsId];
+    for (size_t i = 0; i < hosts_.size(); i++) {
+        const HostState& state = hosts_[i];
+        double cost = loadWeight_ * state.serviceLoad + cpuWeight_ * state.cpuUtilization;
+        if (bsId != NODEID_NONE) {
+            double rtt = state.rtt.at(bsId);
+            if (std::isinf(rtt))
+                continue; // not reachable from the BS
+            cost += latencyWeight_ * rtt * 1000; // in ms
+        }
+        ranking.insert({cost, i});
+    }
+    return ranking;
+}
+
+cModule *LatencyLoadAwareSelectionPolicy::findBestMecHost(const ApplicationDescriptor& appDesc)
+{
+    return findBestMecHost(appDesc, NODEID_NONE);
+}
+
+cModule *LatencyLoadAwareSelectionPolicy::findBestMecHost(const ApplicationDescriptor& appDesc, MacNodeId ueId)
+{
+    EV << "LatencyLoadAwareSelectionPolicy::findBestMecHost - finding best MecHost..." << endl;
+    if (mecOrchestrator_->mecHosts.empty())
+        return nullptr;
+
+    MacNodeId bsId = (ueId != NODEID_NONE) ? mecOrchestrator_->binder_->getServingNode(ueId) : NODEID_NONE;
+    ResourceDescriptor resources = appDesc.getVirtualResources();
+
+    // the resources are checked on the current state of the VIM, as the cached one may be outdated
+    for (const auto& [cost, index] : getRanking(bsId)) {
+        const HostState& state = hosts_[index];
+        if (state.vim->isAllocable(resources.ram, resources.disk, resources.cpu)) {
+            EV << "LatencyLoadAwareSelectionPolicy::findBestMecHost - MEC host [" << state.mecHost->getName() << "] has been chosen as the best Mec Host, cost " << cost << endl;
+            return state.mecHost;
+        }
+        EV << "LatencyLoadAwareSelectionPolicy::findBestMecHost - MEC host [" << state.mecHost->getName() << "] does not have enough resources. Searching again..." << endl;
+    }
+    EV << "LatencyLoadAwareSelectionPolicy::findBestMecHost - No Mec Host found" << endl;
+    return nullptr;
+}
+
+} //namespace
@@ -0,0 +1,81 @@
+//
+//                  Simu5G
+//
+// Copyright (C) 2019-2021 Giovanni Nardini, Giovanni Stea, Antonio Virdis et al. (University of Pisa)
+// Copyright (C) 2022-2026 Giovanni Nardini, Giovanni Stea et al. (University of Pisa)
+//
+// This file is part of a software released under the license included in file
+// "license.pdf". Please read LICENSE and README files before using it.
+// The above files and the present reference are part of the software itself,
+// and cannot be removed from it.
+//
+
+#ifndef NODES_MEC_MECORCHESTRATOR_MECHOSTSELECTIONPOLICIES_LATENCYLOADAWARESELECTION_H_
+#define NODES_MEC_MECORCHESTRATOR_MECHOSTSELECTIONPOLICIES_LATENCYLOADAWARESELECTION_H_
+
+#include <map>
+#include <set>
+#include <vector>
+
+#include "simu5g/mec/orchestrator/policies/SelectionPolicyBase.h"
+
+namespace simu5g {
+
+class MecServiceBase;
+class VirtualisationInfrastructureManager;
+
+//
+// Selects the MEC host with the minimum weighted cost, which takes into account
+// - the round-trip time between the BS serving the UE and the MEC host, computed from
+//   the delays of the wired links of the network,
+// - the load of the MEC services of the MEC host (pending requests per worker),
+// - the CPU utilization of the MEC host.
+// The load of the MEC hosts is cached in a state table, refreshed when older than
+// the configured interval, and the MEC hosts are kept ordered by cost for every BS.
+// Thus, a selection usually costs a lookup, without querying all the MEC hosts.
+// If the UE is unknown, only the load is considered.
+//
+class LatencyLoadAwareSelectionPolicy : public SelectionPolicyBase
+{
+  protected:
+    struct HostState
+    {
+        cModule *mecHost = nullptr;
+        VirtualisationInfrastructureManager *vim = nullptr;
+        std::vector<MecServiceBase *> services;
+
+        double cpuUtilization = 0;
+        double serviceLoad = 0;         // pending requests per worker, summed over the MEC services
+        std::map<MacNodeId, double> rtt; // key = BS id, computed once
+    };
+
+    double latencyWeight_;
+    double loadWeight_;
+    double cpuWeight_;
+    simtime_t refreshInterval_;
+
+    std::vector<HostState> hosts_;
+    simtime_t lastRefresh_ = -1;
+
+    // MEC hosts ordered by cost, for every BS (NODEID_NONE = unknown BS). Rebuilt at every refresh
+    std::map<MacNodeId, std::set<std::pair<double, int>>> ranking_;
+
+    void initHostStates();
+    void refreshHostStates();
+
+    // computes the RTT between the BS and every MEC host on the shortest path of the network topology
+    void computeRtt(MacNodeId bsId);
+
+    const std::set<std::pair<double, int>>& getRanking(MacNodeId bsId);
+
+    cModule *findBestMecHost(const ApplicationDescriptor&) override;
+    cModule *findBestMecHost(const ApplicationDescriptor& appDesc, MacNodeId ueId) override;
+
+  public:
+    LatencyLoadAwareSelectionPolicy(MecOrchestrator *mecOrchestrator, double latencyWeight, double loadWeight, double cpuWeight, simtime_t refreshInterval) :
+        SelectionPolicyBase(mecOrchestrator), latencyWeight_(latencyWeight), loadWeight_(loadWeight), cpuWeight_(cpuWeight), refreshInterval_(refreshInterval) {}
+};
+
+} //namespace
+
+#endif /* NODES_MEC_MECORCHESTRATOR_MECHOSTSELECTIONPOLICIES_LATENCYLOADAWARESELECTION_H_ */
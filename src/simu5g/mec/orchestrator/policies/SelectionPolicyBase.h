@@ -28,6 +28,9 @@ class SelectionPolicyBase
     MecOrchestrator *mecOrchestrator_ = nullptr;
     virtual cModule *findBestMecHost(const ApplicationDescriptor&) = 0;
 
+    // used by the policies that take into account the UE requesting the MEC app (NODEID_NONE if unknown)
+    virtual cModule *findBestMecHost(const ApplicationDescriptor& appDesc, MacNodeId ueId) { return findBestMecHost(appDesc); }
+
   public:
     SelectionPolicyBase(MecOrchestrator *mecOrchestrator) : mecOrchestrator_(mecOrchestrator) {}
 };
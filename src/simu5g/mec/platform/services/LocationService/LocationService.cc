@@ -48,6 +48,11 @@ void LocationService::initialize(int stage)
         LocationResource_.addEnodeB(eNodeB_);
         LocationResource_.addBinder(binder_);
         LocationResource_.setBaseUri(host_ + baseUriQueries_);
+        locationTracker_.init(binder_, par("pollUeMobility").boolValue());
+        LocationResource_.setLocationTracker(&locationTracker_);
+        geofence_.addEnodeB(eNodeB_);
+        geofence_.setLocationTracker(&locationTracker_);
+        geofence_.setCellSize(par("geofenceCellSize"));
         EV << "Host: " << host_ + baseUriQueries_ << endl;
         LocationSubscriptionEvent_ = new cMessage("LocationSubscriptionEvent");
         locationSubscriptionPeriod_ = par("locationSubscriptionPeriod");
@@ -88,12 +93,15 @@ void LocationService::handleMessage(cMessage *msg)
     if (msg->isSelfMessage()) {
         if (msg == subscriptionTimer_) {
             EV << "subscriptionTimer" << endl;
+            // evaluate the position of every tracked UE once, against the circles that may contain it
+            geofence_.update();
+
             std::set<int> subIds = subscriptionTimer_->getSubIdSet(); // TODO pass it as reference
             for (auto sub : subIds) {
                 if (subscriptions_.find(sub) != subscriptions_.end()) {
                     EV << "subscriptionTimer for subscription: " << sub << endl;
-                    SubscriptionBase *subscription = subscriptions_[sub];//upcasting (getSubscriptionType is in SubscriptionBase)
-                    EventNotification *event = subscription->handleSubscription();
+                    CircleNotificationSubscription *subscription = check_and_cast<CircleNotificationSubscription *>(subscriptions_[sub]);
+                    EventNotification *event = subscription->getPendingNotification();
                     if (event != nullptr)
                         newSubscriptionEvent(event);
                 }
@@ -235,6 +243,7 @@ void LocationService::handlePOSTRequest(const HttpRequestMessage *currentRequest
                 if (event != nullptr)
                     newSubscriptionEvent(event);
             }
+            geofence_.addSubscription(newSubscription);
             //start timer
             subscriptionTimer_->insertSubId(subscriptionId_);
             if (!subscriptionTimer_->isScheduled())
@@ -292,8 +301,10 @@ void LocationService::handlePUTRequest(const HttpRequestMessage *currentRequestM
                 std::string resourceUrl = newSubscription->getResourceUrl();
                 response["circleNotificationSubscription"]["resourceURL"] = resourceUrl;
                 Http::send200Response(socket, response.dump(2).c_str());
+                geofence_.removeSubscription(sub);
                 delete it->second; // remove old subscription
                 subscriptions_[id] = newSubscription; // replace with the new subscription
+                geofence_.addSubscription(newSubscription);
             }
             else {
                 delete newSubscription; // delete the new created subscription
@@ -326,7 +337,8 @@ void LocationService::handleDELETERequest(const HttpRequestMessage *currentReque
         int subId = std::stoi(ssubId);
         Subscriptions::iterator it = subscriptions_.find(subId);
         if (it != subscriptions_.end()) {
-            // CircleNotificationSubscription *sub = check_and_cast<CircleNotificationSubscription *>(it->second);
+            CircleNotificationSubscription *sub = check_and_cast<CircleNotificationSubscription *>(it->second);
+            geofence_.removeSubscription(sub);
             subscriptionTimer_->removeSubId(subId);
             if (subscriptionTimer_->getSubIdSetSize() == 0 && subscriptionTimer_->isScheduled())
                 cancelEvent(subscriptionTimer_);
@@ -343,6 +355,16 @@ void LocationService::handleDELETERequest(const HttpRequestMessage *currentReque
     }
 }
 
+void LocationService::removeSubscriptions(int connId)
+{
+    // unregister the subscriptions from the geofence index before they are deleted
+    for (const auto& [subId, subscription] : subscriptions_) {
+        if (subscription->getSocketConnId() == connId)
+            geofence_.removeSubscription(check_and_cast<CircleNotificationSubscription *>(subscription));
+    }
+    MecServiceBase::removeSubscriptions(connId);
+}
+
 LocationService::~LocationService() {
     cancelAndDelete(LocationSubscriptionEvent_);
     cancelAndDelete(subscriptionTimer_);
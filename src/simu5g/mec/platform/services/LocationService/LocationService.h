@@ -13,7 +13,9 @@
 #ifndef _LOCATIONSERVICE_H
 #define _LOCATIONSERVICE_H
 
+#include "simu5g/mec/platform/services/LocationService/resources/GeofenceIndex.h"
 #include "simu5g/mec/platform/services/LocationService/resources/LocationResource.h"
+#include "simu5g/mec/platform/services/LocationService/resources/LocationTracker.h"
 #include "simu5g/mec/platform/services/base/MecServiceBase2.h"
 
 namespace simu5g {
@@ -39,6 +41,9 @@ class LocationService : public MecServiceBase2
 
     LocationResource LocationResource_;
 
+    // latest position of the UEs, shared by the resources and the subscriptions
+    LocationTracker locationTracker_;
+
     double locationSubscriptionPeriod_;
     cMessage *LocationSubscriptionEvent_ = nullptr;
 
@@ -49,6 +54,9 @@ class LocationService : public MecServiceBase2
      */
     AperiodicSubscriptionTimer *subscriptionTimer_ = nullptr;
 
+    // spatial index of the circle notification subscriptions, evaluated at every subscriptionTimer_ expiration
+    GeofenceIndex geofence_;
+
   public:
     LocationService();
 
@@ -67,6 +75,8 @@ class LocationService : public MecServiceBase2
      */
     bool manageSubscription() override;
 
+    void removeSubscriptions(int connId) override;
+
     ~LocationService() override;
 
 };
@@ -266,49 +266,61 @@ EventNotification *CircleNotificationSubscription::handleSubscription()
 {
     EV << "CircleNotificationSubscription::handleSubscription()" << endl;
     terminalLocations.clear();
-    for (auto &[macNodeId, isInside] : users) {
-        bool found = false;
+    for (const auto& [macNodeId, isInside] : users) {
         //check if the user is under one of the EnodeB connected to the Mehost
 
         if (!findUe(macNodeId))
             continue; // TODO manage what to do
-        inet::Coord coord = LocationUtils::getCoordinates(binder, macNodeId);
-        inet::Coord center = inet::Coord(latitude, longitude, 0.);
-
-        if (actionCriteria == LocationUtils::Entering) {
-            if (coord.distance(center) <= radius && !isInside) {
-                isInside = true;
-                EV << "inside" << endl;
-                found = true;
-            }
-            else if (coord.distance(center) >= radius) {
-                isInside = false;
-            }
+        updateUser(macNodeId, LocationUtils::getCoordinates(binder, macNodeId));
+    }
+    return getPendingNotification();
+}
+
+bool CircleNotificationSubscription::updateUser(MacNodeId nodeId, const inet::Coord& coord)
+{
+    bool& isInside = users.at(nodeId);
+    bool found = false;
+    inet::Coord center = inet::Coord(latitude, longitude, 0.);
+    double distance = coord.distance(center);
+
+    if (actionCriteria == LocationUtils::Entering) {
+        if (distance <= radius && !isInside) {
+            isInside = true;
+            EV << "inside" << endl;
+            found = true;
         }
-        else {
-            if (coord.distance(center) >= radius && isInside) {
-                isInside = false;
-                EV << "outside" << endl;
-                found = true;
-            }
-            else if (coord.distance(center) <= radius) {
-                isInside = true;
-            }
+        else if (distance >= radius) {
+            isInside = false;
         }
-
-        if (found) {
-            std::string status = "Retrieved";
-            CurrentLocation location(100, coord);
-            TerminalLocation user(binder->getIPv4Address(macNodeId).str(), status, location);
-            terminalLocations.push_back(user);
+    }
+    else {
+        if (distance >= radius && isInside) {
+            isInside = false;
+            EV << "outside" << endl;
+            found = true;
+        }
+        else if (distance <= radius) {
+            isInside = true;
         }
     }
-    if (!terminalLocations.empty()) {
-        CircleNotificationEvent *notificationEvent = new CircleNotificationEvent(subscriptionType_, subscriptionId_, terminalLocations);
-        return notificationEvent;
+
+    if (found) {
+        std::string status = "Retrieved";
+        CurrentLocation location(100, coord);
+        TerminalLocation user(binder->getIPv4Address(nodeId).str(), status, location);
+        terminalLocations.push_back(user);
     }
-    else
+    return isInside;
+}
+
+EventNotification *CircleNotificationSubscription::getPendingNotification()
+{
+    if (terminalLocations.empty())
         return nullptr;
+
+    CircleNotificationEvent *notificationEvent = new CircleNotificationEvent(subscriptionType_, subscriptionId_, terminalLocations);
+    terminalLocations.clear();
+    return notificationEvent;
 }
 
 bool CircleNotificationSubscription::findUe(MacNodeId nodeId)
@@ -51,6 +51,25 @@ class CircleNotificationSubscription : public SubscriptionBase
 
     bool findUe(MacNodeId nodeId);
 
+    inet::Coord getCenter() const { return inet::Coord(latitude, longitude, 0.); }
+    double getRadius() const { return radius; }
+
+    // tracked users, with their last known position with respect to the area (true = inside)
+    const std::map<MacNodeId, bool>& getUsers() const { return users; }
+
+    /*
+     * Evaluates a new position of one of the tracked users and records its
+     * entering/leaving, if any, for the next notification.
+     * Returns true if the user is now considered inside the area
+     */
+    bool updateUser(MacNodeId nodeId, const inet::Coord& coord);
+
+    /*
+     * Returns a notification for the users that entered/left the area since the
+     * last call (nullptr if none)
+     */
+    EventNotification *getPendingNotification();
+
   protected:
 
     opp_component_ptr<Binder> binder; // used to retrieve NodeId - Ipv4Address mapping
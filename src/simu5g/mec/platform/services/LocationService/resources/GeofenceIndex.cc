@@ -0,0 +1,172 @@
+//
+//                  Simu5G
+//
+// Copyright (C) 2019-2021 Giovanni Nardini, Giovanni Stea, Antonio Virdis et al. (University of Pisa)
+// Copyright (C) 2022-2026 Giovanni Nardini, Giovanni Stea et al. (University of Pisa)
+//
+// This file is part of a software released under the license included in file
+// "license.pdf". Please read LICENSE and README files before using it.
+// The above files and the present reference are part of the software itself,
+// and cannot be removed from it.
+//
+
+#include "simu5g/mec/platform/services/LocationService/resources/GeofenceIndex.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "simu5g/common/cellInfo/CellInfo.h"
+#include "simu5g/mec/platform/services/LocationService/resources/CircleNotificationSubscription.h"
+#include "simu5g/mec/platform/services/LocationService/resources/LocationTracker.h"
+
+namespace simu5g {
+
+void GeofenceIndex::setCellSize(double cellSize)
+{
+    if (cellSize <= 0)
+        throw cRuntimeError("GeofenceIndex::setCellSize - cell size must be positive, got %f", cellSize);
+    if (!grid_.empty() || !largeCircles_.empty())
+        throw cRuntimeError("GeofenceIndex::setCellSize - cannot change the cell size after subscriptions have been added");
+    cellSize_ = cellSize;
+}
+
+void GeofenceIndex::addEnodeB(std::set<cModule *, simu5g::utils::cModule_LessId>& eNodeBs)
+{
+    for (auto& eNodeB : eNodeBs) {
+        CellInfo *cellInfo = check_and_cast<CellInfo *>(eNodeB->getSubmodule("cellInfo"));
+        eNodeBs_.insert({cellInfo->getMacCellId(), cellInfo});
+    }
+}
+
+int GeofenceIndex::cellIndex(double coord) const
+{
+    // keep far-away points within range, they end up in the outermost cells
+    double index = std::floor(coord / cellSize_);
+    return (int)std::max(-1e9, std::min(1e9, index));
+}
+
+bool GeofenceIndex::getCellRange(const CircleNotificationSubscription *subscription, int& minX, int& minY, int& maxX, int& maxY) const
+{
+    inet::Coord center = subscription->getCenter();
+    double radius = subscription->getRadius();
+
+    minX = cellIndex(center.x - radius);
+    maxX = cellIndex(center.x + radius);
+    minY = cellIndex(center.y - radius);
+    maxY = cellIndex(center.y + radius);
+
+    return ((double)maxX - minX + 1) * ((double)maxY - minY + 1) <= MAX_CELLS_PER_CIRCLE;
+}
+
+bool GeofenceIndex::isServed(MacNodeId nodeId) const
+{
+    for (const auto& [cellId, cellInfo] : eNodeBs_) {
+        if (cellInfo->getUePosition(nodeId) != inet::Coord::ZERO)
+            return true;
+    }
+    return false;
+}
+
+void GeofenceIndex::addSubscription(CircleNotificationSubscription *subscription)
+{
+    int minX, minY, maxX, maxY;
+    if (getCellRange(subscription, minX, minY, maxX, maxY)) {
+        for (int x = minX; x <= maxX; ++x)
+            for (int y = minY; y <= maxY; ++y)
+                grid_[cellKey(x, y)].push_back(subscription);
+    }
+    else {
+        largeCircles_.push_back(subscription);
+    }
+
+    for (const auto& [nodeId, isInside] : subscription->getUsers()) {
+        TrackedUe& ue = trackedUes_[nodeId];
+        ue.numSubscriptions++;
+        ue.version = 0; // the new circle has not been evaluated yet
+        if (isInside)
+            insideOf_[nodeId].insert(subscription);
+    }
+}
+
+void GeofenceIndex::removeSubscription(CircleNotificationSubscription *subscription)
+{
+    int minX, minY, maxX, maxY;
+    if (getCellRange(subscription, minX, minY, maxX, maxY)) {
+        for (int x = minX; x <= maxX; ++x) {
+            for (int y = minY; y <= maxY; ++y) {
+                auto it = grid_.find(cellKey(x, y));
+                if (it == grid_.end())
+                    continue;
+                auto& circles = it->second;
+                circles.erase(std::remove(circles.begin(), circles.end(), subscription), circles.end());
+                if (circles.empty())
+                    grid_.erase(it);
+            }
+        }
+    }
+    else {
+        largeCircles_.erase(std::remove(largeCircles_.begin(), largeCircles_.end(), subscription), largeCircles_.end());
+    }
+
+    for (const auto& [nodeId, isInside] : subscription->getUsers()) {
+        auto it = trackedUes_.find(nodeId);
+        if (it != trackedUes_.end() && --(it->second.numSubscriptions) == 0)
+            trackedUes_.erase(it);
+
+        auto in = insideOf_.find(nodeId);
+        if (in != insideOf_.end()) {
+            in->second.erase(subscription);
+            if (in->second.empty())
+                insideOf_.erase(in);
+        }
+    }
+}
+
+void GeofenceIndex::update()
+{
+    for (auto& [nodeId, ue] : trackedUes_) {
+        if (!isServed(nodeId))
+            continue;
+        const LocationTracker::UeLocation *location = locationTracker_->getLocation(nodeId);
+        if (location == nullptr || location->version == ue.version)
+            continue; // evaluating the same position again would not change any state
+        ue.version = location->version;
+        updatePosition(nodeId, location->position);
+    }
+}
+
+void GeofenceIndex::updatePosition(MacNodeId nodeId, const inet::Coord& coord)
+{
+    // collect the circles the UE may enter (same cell) or leave (currently inside)
+    candidates_.clear();
+    auto cell = grid_.find(cellKey(cellIndex(coord.x), cellIndex(coord.y)));
+    if (cell != grid_.end())
+        candidates_.insert(candidates_.end(), cell->second.begin(), cell->second.end());
+    candidates_.insert(candidates_.end(), largeCircles_.begin(), largeCircles_.end());
+    auto in = insideOf_.find(nodeId);
+    if (in != insideOf_.end())
+        candidates_.insert(candidates_.end(), in->second.begin(), in->second.end());
+
+    std::sort(candidates_.begin(), candidates_.end(), [](const CircleNotificationSubscription *a, const CircleNotificationSubscription *b) {
+        return a->getSubscriptionId() < b->getSubscriptionId();
+    });
+    candidates_.erase(std::unique(candidates_.begin(), candidates_.end()), candidates_.end());
+
+    for (auto subscription : candidates_) {
+        if (subscription->getUsers().find(nodeId) == subscription->getUsers().end())
+            continue;
+
+        if (subscription->updateUser(nodeId, coord))
+            insideOf_[nodeId].insert(subscription);
+        else {
+            auto it = insideOf_.find(nodeId);
+            if (it != insideOf_.end()) {
+                it->second.erase(subscription);
+                if (it->second.empty())
+                    insideOf_.erase(it);
+            }
+        }
+    }
+}
+
+} //namespace
@@ -0,0 +1,112 @@
+//
+//                  Simu5G
+//
+// Copyright (C) 2019-2021 Giovanni Nardini, Giovanni Stea, Antonio Virdis et al. (University of Pisa)
+// Copyright (C) 2022-2026 Giovanni Nardini, Giovanni Stea et al. (University of Pisa)
+//
+// This file is part of a software released under the license included in file
+// "license.pdf". Please read LICENSE and README files before using it.
+// The above files and the present reference are part of the software itself,
+// and cannot be removed from it.
+//
+
+#ifndef APPS_MEC_MESERVICES_LOCATIONSERVICE_RESOURCES_GEOFENCEINDEX_H_
+#define APPS_MEC_MESERVICES_LOCATIONSERVICE_RESOURCES_GEOFENCEINDEX_H_
+
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+#include <inet/common/geometry/common/Coord.h>
+
+#include "simu5g/common/LteCommon.h"
+#include "simu5g/common/utils/utils.h"
+
+namespace simu5g {
+
+using namespace omnetpp;
+
+class CellInfo;
+class CircleNotificationSubscription;
+class LocationTracker;
+
+/**
+ * GeofenceIndex
+ *
+ * Spatial index of the circle notification subscriptions of the Location Service.
+ * The plane is divided in square cells, and each circle is registered in all the cells
+ * overlapped by its bounding box. At every check, the position of each tracked UE is
+ * read once from the LocationTracker and, if it changed since the previous check, it is
+ * evaluated only against the circles registered in its cell and the circles the UE is
+ * currently inside of (whose leaving may have to be notified), rather than against every
+ * subscription.
+ * Circles that would span too many cells are kept in a separate list and always evaluated.
+ */
+class GeofenceIndex
+{
+  protected:
+    // circles overlapping more cells than this are not indexed
+    static const int MAX_CELLS_PER_CIRCLE = 4096;
+
+    double cellSize_ = 100.0;
+
+    LocationTracker *locationTracker_ = nullptr;
+    std::map<MacCellId, CellInfo *> eNodeBs_;
+
+    // cell key -> circles overlapping the cell
+    std::unordered_map<int64_t, std::vector<CircleNotificationSubscription *>> grid_;
+    std::vector<CircleNotificationSubscription *> largeCircles_;
+
+    struct TrackedUe
+    {
+        unsigned int numSubscriptions = 0;
+        unsigned long version = 0; // version of the last evaluated position, 0 = to be evaluated
+    };
+
+    // UEs referenced by at least one subscription
+    std::map<MacNodeId, TrackedUe> trackedUes_;
+
+    // circles each UE is currently flagged inside of
+    std::map<MacNodeId, std::set<CircleNotificationSubscription *>> insideOf_;
+
+    // candidate circles for the UE being evaluated, reused across evaluations
+    std::vector<CircleNotificationSubscription *> candidates_;
+
+    int cellIndex(double coord) const;
+    int64_t cellKey(int x, int y) const { return ((int64_t)x << 32) ^ (uint32_t)y; }
+
+    // computes the range of cells overlapped by the circle. Returns false if the circle is too large to be indexed
+    bool getCellRange(const CircleNotificationSubscription *subscription, int& minX, int& minY, int& maxX, int& maxY) const;
+
+    // checks if the UE is under one of the BSs connected to the MEC host
+    bool isServed(MacNodeId nodeId) const;
+
+  public:
+    void setCellSize(double cellSize);
+    void setLocationTracker(LocationTracker *locationTracker) { locationTracker_ = locationTracker; }
+    void addEnodeB(std::set<cModule *, simu5g::utils::cModule_LessId>& eNodeBs);
+
+    /*
+     * Registers/unregisters a circle subscription. The subscription must be
+     * unregistered before it is deleted or its area is changed
+     */
+    void addSubscription(CircleNotificationSubscription *subscription);
+    void removeSubscription(CircleNotificationSubscription *subscription);
+
+    /*
+     * Retrieves the current position of every tracked UE served by the MEC host
+     * and, if it changed, evaluates it against the circles that may contain it. The
+     * resulting transitions are stored by the subscriptions until their next notification
+     */
+    void update();
+
+    // evaluates a new position of a single UE
+    void updatePosition(MacNodeId nodeId, const inet::Coord& coord);
+
+    unsigned int getNumTrackedUes() const { return trackedUes_.size(); }
+};
+
+} //namespace
+
+#endif /* APPS_MEC_MESERVICES_LOCATIONSERVICE_RESOURCES_GEOFENCEINDEX_H_ */
@@ -17,6 +17,7 @@
 #include "simu5g/common/binder/Binder.h"
 #include "simu5g/common/cellInfo/CellInfo.h"
 #include "simu5g/mec/platform/services/LocationService/resources/LocationApiDefs.h"
+#include "simu5g/mec/platform/services/LocationService/resources/LocationTracker.h"
 
 namespace simu5g {
 
@@ -50,6 +51,11 @@ void LocationResource::addBinder(Binder *binder)
     binder_ = binder;
 }
 
+void LocationResource::setLocationTracker(LocationTracker *locationTracker)
+{
+    locationTracker_ = locationTracker;
+}
+
 void LocationResource::setBaseUri(const std::string& baseUri)
 {
     baseUri_ = baseUri;
@@ -61,8 +67,15 @@ UserInfo LocationResource::getUserInfoByNodeId(MacNodeId nodeId, MacCellId cellI
     // throw exception if macNodeId does not exist?
     inet::Ipv4Address ipAddress = binder_->getIPv4Address(nodeId);
     std::string refUrl = baseUri_ + "?address=acr:" + ipAddress.str();
-    inet::Coord speed = LocationUtils::getSpeed(binder_, nodeId);
-    inet::Coord position = LocationUtils::getCoordinates(binder_, nodeId);
+    inet::Coord speed, position;
+    if (locationTracker_ != nullptr) {
+        speed = locationTracker_->getSpeed(nodeId);
+        position = locationTracker_->getPosition(nodeId);
+    }
+    else {
+        speed = LocationUtils::getSpeed(binder_, nodeId);
+        position = LocationUtils::getCoordinates(binder_, nodeId);
+    }
     UserInfo ueInfo = UserInfo(position, speed, ipAddress, cellId, refUrl);
     return ueInfo;
 }
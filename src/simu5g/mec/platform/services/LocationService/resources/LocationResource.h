@@ -29,6 +29,7 @@ namespace simu5g {
 using namespace omnetpp;
 
 class CellInfo;
+class LocationTracker;
 
 class LocationResource : public AttributeBase
 {
@@ -45,6 +46,7 @@ class LocationResource : public AttributeBase
     void addEnodeB(std::set<cModule *, simu5g::utils::cModule_LessId>& eNodeBs);
     void addEnodeB(cModule *eNodeB);
     void addBinder(Binder *binder);
+    void setLocationTracker(LocationTracker *locationTracker);
     void setBaseUri(const std::string& baseUri);
     nlohmann::ordered_json toJsonCell(std::vector<MacCellId>& cellsID) const;
     nlohmann::ordered_json toJsonUe(std::vector<inet::Ipv4Address>& uesID) const;
@@ -53,6 +55,7 @@ class LocationResource : public AttributeBase
   protected:
     // better to map <cellID, CellInfo>
     opp_component_ptr<Binder> binder_;
+    LocationTracker *locationTracker_ = nullptr; // if set, UE positions are read from it
     TimeStamp timestamp_;
     std::map<MacCellId, CellInfo *> eNodeBs_;
     std::string baseUri_;
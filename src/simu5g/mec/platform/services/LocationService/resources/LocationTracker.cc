@@ -0,0 +1,104 @@
+//
+//                  Simu5G
+//
+// Copyright (C) 2019-2021 Giovanni Nardini, Giovanni Stea, Antonio Virdis et al. (University of Pisa)
+// Copyright (C) 2022-2026 Giovanni Nardini, Giovanni Stea et al. (University of Pisa)
+//
+// This file is part of a software released under the license included in file
+// "license.pdf". Please read LICENSE and README files before using it.
+// The above files and the present reference are part of the software itself,
+// and cannot be removed from it.
+//
+
+#include "simu5g/mec/platform/services/LocationService/resources/LocationTracker.h"
+
+#include "simu5g/common/binder/Binder.h"
+
+namespace simu5g {
+
+LocationTracker::~LocationTracker()
+{
+    if (subscribedModule_ && subscribedModule_->isSubscribed(inet::IMobility::mobilityStateChangedSignal, this))
+        subscribedModule_->unsubscribe(inet::IMobility::mobilityStateChangedSignal, this);
+}
+
+void LocationTracker::init(Binder *binder, bool pollMobility)
+{
+    binder_ = binder;
+    pollMobility_ = pollMobility;
+
+    // mobility state changes propagate up to the network module, a single subscription is enough for all the UEs
+    subscribedModule_ = getSimulation()->getSystemModule();
+    subscribedModule_->subscribe(inet::IMobility::mobilityStateChangedSignal, this);
+}
+
+LocationTracker::UeLocation *LocationTracker::getEntry(MacNodeId nodeId)
+{
+    unsigned int index = num(nodeId);
+    if (index >= table_.size())
+        table_.resize(index + 1);
+
+    UeLocation& entry = table_[index];
+    if (!entry.mobilityModule) {
+        // not tracked yet, or its node has been deleted
+        cModule *module = binder_->getNodeModule(nodeId);
+        if (module == nullptr)
+            return nullptr;
+        cModule *mobilityModule = module->getSubmodule("mobility");
+        entry = UeLocation();
+        entry.mobilityModule = mobilityModule;
+        entry.mobility = check_and_cast<inet::IMobility *>(mobilityModule);
+        uesByMobility_[mobilityModule->getId()].push_back(nodeId);
+        sample(entry);
+    }
+    return &entry;
+}
+
+void LocationTracker::sample(UeLocation& entry)
+{
+    inet::Coord position = entry.mobility->getCurrentPosition();
+    inet::Coord speed = entry.mobility->getCurrentVelocity();
+    if (entry.version == 0 || position != entry.position)
+        entry.version = ++version_;
+    entry.position = position;
+    entry.speed = speed;
+    entry.lastUpdate = simTime();
+}
+
+void LocationTracker::receiveSignal(cComponent *source, simsignal_t signalID, cObject *obj, cObject *details)
+{
+    if (signalID != inet::IMobility::mobilityStateChangedSignal)
+        return;
+
+    auto it = uesByMobility_.find(source->getId());
+    if (it == uesByMobility_.end())
+        return; // not a tracked UE
+
+    for (MacNodeId nodeId : it->second) {
+        UeLocation& entry = table_[num(nodeId)];
+        if (entry.mobilityModule == source)
+            sample(entry);
+    }
+}
+
+const LocationTracker::UeLocation *LocationTracker::getLocation(MacNodeId nodeId)
+{
+    UeLocation *entry = getEntry(nodeId);
+    if (entry != nullptr && pollMobility_ && entry->lastUpdate != simTime())
+        sample(*entry);
+    return entry;
+}
+
+inet::Coord LocationTracker::getPosition(MacNodeId nodeId)
+{
+    const UeLocation *entry = getLocation(nodeId);
+    return entry != nullptr ? entry->position : inet::Coord::NIL;
+}
+
+inet::Coord LocationTracker::getSpeed(MacNodeId nodeId)
+{
+    const UeLocation *entry = getLocation(nodeId);
+    return entry != nullptr ? entry->speed : inet::Coord::NIL;
+}
+
+} //namespace
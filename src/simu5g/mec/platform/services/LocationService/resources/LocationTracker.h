@@ -0,0 +1,103 @@
+//
+//                  Simu5G
+//
+// Copyright (C) 2019-2021 Giovanni Nardini, Giovanni Stea, Antonio Virdis et al. (University of Pisa)
+// Copyright (C) 2022-2026 Giovanni Nardini, Giovanni Stea et al. (University of Pisa)
+//
+// This file is part of a software released under the license included in file
+// "license.pdf". Please read LICENSE and README files before using it.
+// The above files and the present reference are part of the software itself,
+// and cannot be removed from it.
+//
+
+#ifndef APPS_MEC_MESERVICES_LOCATIONSERVICE_RESOURCES_LOCATIONTRACKER_H_
+#define APPS_MEC_MESERVICES_LOCATIONSERVICE_RESOURCES_LOCATIONTRACKER_H_
+
+#include <unordered_map>
+#include <vector>
+
+#include <inet/common/geometry/common/Coord.h>
+#include <inet/mobility/contract/IMobility.h>
+
+#include "simu5g/common/LteCommon.h"
+
+namespace simu5g {
+
+using namespace omnetpp;
+
+class Binder;
+
+/**
+ * LocationTracker
+ *
+ * Keeps the latest position and speed of the UEs queried by the Location Service,
+ * in a table indexed by MacNodeId. The table is kept up to date by listening to the
+ * mobility state changes of all the nodes, so that the resources and subscriptions
+ * of the service (queries, circle notifications) share the same samples instead of
+ * retrieving them separately from the mobility modules.
+ *
+ * By default, the mobility module is also polled when a UE is read and its sample is
+ * older than the current simulation time, so that the returned position is exactly
+ * the current one. If polling is disabled, the position notified by the latest
+ * mobility update is returned, which may be up to one mobility update interval old.
+ *
+ * Each sample has a version number, increased every time the position of the UE
+ * changes, which consumers can use to process only the UEs that moved.
+ */
+class LocationTracker : public cListener
+{
+  public:
+    struct UeLocation
+    {
+        opp_component_ptr<cModule> mobilityModule; // null if the UE is not tracked (yet)
+        inet::IMobility *mobility = nullptr;
+        inet::Coord position;
+        inet::Coord speed;
+        simtime_t lastUpdate = -1;
+        unsigned long version = 0; // 0 = never sampled
+    };
+
+  protected:
+    opp_component_ptr<Binder> binder_;
+    opp_component_ptr<cModule> subscribedModule_;
+    bool pollMobility_ = true;
+
+    // tracked UEs, indexed by MacNodeId
+    std::vector<UeLocation> table_;
+
+    // id of the mobility module -> UEs using it
+    std::unordered_map<int, std::vector<MacNodeId>> uesByMobility_;
+
+    unsigned long version_ = 0;
+
+    // returns the entry of the UE, starting to track it if needed. Returns nullptr if the UE does not exist
+    UeLocation *getEntry(MacNodeId nodeId);
+
+    void sample(UeLocation& entry);
+
+    void receiveSignal(cComponent *source, simsignal_t signalID, cObject *obj, cObject *details) override;
+
+  public:
+    ~LocationTracker() override;
+
+    /*
+     * Starts listening to the mobility updates of the nodes of the network
+     *
+     * @param pollMobility if true, samples older than the current time are refreshed when read
+     */
+    void init(Binder *binder, bool pollMobility);
+
+    // returns the current location of the UE, or nullptr if the UE does not exist
+    const UeLocation *getLocation(MacNodeId nodeId);
+
+    // same as LocationUtils::getCoordinates()/getSpeed(), NIL if the UE does not exist
+    inet::Coord getPosition(MacNodeId nodeId);
+    inet::Coord getSpeed(MacNodeId nodeId);
+
+    // version of the latest position change of any tracked UE
+    unsigned long getVersion() const { return version_; }
+};
+
+} //namespace
+
+#endif /* APPS_MEC_MESERVICES_LOCATIONSERVICE_RESOURCES_LOCATIONTRACKER_H_ */
@@ -32,6 +32,8 @@ namespace simu5g {
 
 Define_Module(RniService);
 
+simsignal_t RniService::l2MeasCacheHitSignal_ = registerSignal("l2MeasCacheHit");
+
 RniService::RniService():L2MeasResource_() {
     baseUriQueries_ = "/example/rni/v2/queries";
     baseUriSubscriptions_ = "/example/rni/v2/subscriptions";
@@ -107,14 +109,11 @@ void RniService::handleGETRequest(const HttpRequestMessage *currentRequestMessag
             }
 
             //send response
-            if (!ues.empty() && !cellIds.empty()) {
-                Http::send200Response(socket, L2MeasResource_.toJson(cellIds, ues).dump().c_str());
-            }
-            else if (ues.empty() && !cellIds.empty()) {
-                Http::send200Response(socket, L2MeasResource_.toJsonCell(cellIds).dump().c_str());
-            }
-            else if (!ues.empty() && cellIds.empty()) {
-                Http::send200Response(socket, L2MeasResource_.toJsonUe(ues).dump().c_str());
+            if (!ues.empty() || !cellIds.empty()) {
+                bool cacheHit;
+                const std::string& body = L2MeasResource_.getSerializedJson(cellIds, ues, cacheHit);
+                emit(l2MeasCacheHitSignal_, cacheHit);
+                Http::send200Response(socket, body.c_str());
             }
             else {
                 Http::send400Response(socket);
@@ -122,7 +121,12 @@ void RniService::handleGETRequest(const HttpRequestMessage *currentRequestMessag
         }
         else {
             //no query params
-            Http::send200Response(socket, L2MeasResource_.toJson().dump().c_str());
+            std::vector<MacNodeId> cellIds;
+            std::vector<inet::Ipv4Address> ues;
+            bool cacheHit;
+            const std::string& body = L2MeasResource_.getSerializedJson(cellIds, ues, cacheHit);
+            emit(l2MeasCacheHitSignal_, cacheHit);
+            Http::send200Response(socket, body.c_str());
             return;
         }
     }
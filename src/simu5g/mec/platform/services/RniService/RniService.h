@@ -31,6 +31,9 @@ class RniService : public MecServiceBase2
 
     L2Meas L2MeasResource_;
 
+    // emitted for every L2 measurements query: true if the response was found in the cache
+    static simsignal_t l2MeasCacheHitSignal_;
+
   public:
     RniService();
 
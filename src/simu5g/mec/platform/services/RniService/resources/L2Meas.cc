@@ -43,6 +43,76 @@ void L2Meas::addEnodeB(cModule *eNodeB) {
     eNodeBs_.insert({collector->getCellId(), collector});
 }
 
+unsigned long L2Meas::getVersion() const
+{
+    // versions only increase, so the sum changes whenever any cell changes
+    unsigned long version = 0;
+    for (const auto& [cellId, collector] : eNodeBs_)
+        version += collector->getVersion();
+    return version;
+}
+
+const L2Meas::CellSnapshot& L2Meas::getSnapshot(MacCellId cellId, BaseStationStatsCollector *collector) const
+{
+    CellSnapshot& snapshot = snapshots_[cellId];
+    if (snapshot.valid && snapshot.version == collector->getVersion())
+        return snapshot;
+
+    snapshot.cellInfo = RniCellInfo(collector).toJson();
+    snapshot.ueInfo.clear();
+    for (const auto& [ueId, ueCollector] : *collector->getCollectorMap())
+        snapshot.ueInfo[ueId] = CellUeInfo(ueCollector, collector->getEcgi()).toJson();
+    snapshot.version = collector->getVersion();
+    snapshot.valid = true;
+    return snapshot;
+}
+
+bool L2Meas::addUeInfo(MacNodeId nodeId, nlohmann::ordered_json& ueArray) const
+{
+    for (const auto& [cellId, baseStation] : eNodeBs_) {
+        const CellSnapshot& snapshot = getSnapshot(cellId, baseStation);
+        auto it = snapshot.ueInfo.find(nodeId);
+        if (it != snapshot.ueInfo.end()) {
+            ueArray.push_back(it->second);
+            return true;
+        }
+    }
+    return false;
+}
+
+const std::string& L2Meas::getSerializedJson(std::vector<MacCellId>& cellsID, std::vector<inet::Ipv4Address>& uesID, bool& cacheHit)
+{
+    unsigned long version = getVersion();
+    if (version != cacheVersion_ || cache_.size() >= MAX_CACHED_QUERIES) {
+        cache_.clear();
+        cacheVersion_ = version;
+    }
+
+    std::string query;
+    for (const auto& cellId : cellsID)
+        query += std::to_string(num(cellId)) + ",";
+    query += ";";
+    for (const auto& ipAddress : uesID)
+        query += ipAddress.str() + ",";
+
+    auto it = cache_.find(query);
+    cacheHit = (it != cache_.end());
+    if (cacheHit)
+        return it->second;
+
+    nlohmann::ordered_json val;
+    if (!uesID.empty() && !cellsID.empty())
+        val = toJson(cellsID, uesID);
+    else if (!cellsID.empty())
+        val = toJsonCell(cellsID);
+    else if (!uesID.empty())
+        val = toJsonUe(uesID);
+    else
+        val = toJson();
+
+    return cache_[query] = val.dump();
+}
+
 
 nlohmann::ordered_json L2Meas::toJson() const {
     nlohmann::ordered_json val;
@@ -55,13 +125,10 @@ nlohmann::ordered_json L2Meas::toJson() const {
     }
 
     for (const auto &[macCellId, baseStationStatsCollector] : eNodeBs_) {
-        UeStatsCollectorMap *ueMap = baseStationStatsCollector->getCollectorMap();
-        for (const auto &[ueId, ueStatsCollector] : *ueMap) {
-            CellUeInfo cellUeInfo = CellUeInfo(ueStatsCollector, baseStationStatsCollector->getEcgi());
-            ueArray.push_back(cellUeInfo.toJson());
-        }
-        RniCellInfo cellInfo = RniCellInfo(baseStationStatsCollector);
-        cellArray.push_back(cellInfo.toJson());
+        const CellSnapshot& snapshot = getSnapshot(macCellId, baseStationStatsCollector);
+        for (const auto &[ueId, ueInfo] : snapshot.ueInfo)
+            ueArray.push_back(ueInfo);
+        cellArray.push_back(snapshot.cellInfo);
     }
 
     if (cellArray.size() > 1) {
@@ -91,7 +158,6 @@ nlohmann::ordered_json L2Meas::toJsonUe(std::vector<inet::Ipv4Address>& uesID) c
         val["timestamp"] = timestamp_.toJson();
     }
 
-    std::map<MacCellId, BaseStationStatsCollector *>::const_iterator eit;
     bool found = false;
     ASSERT(binder_ != nullptr);
     for (auto ipAddress: uesID) {
@@ -114,18 +180,7 @@ nlohmann::ordered_json L2Meas::toJsonUe(std::vector<inet::Ipv4Address>& uesID) c
             break;
         }
         else if (lteNodeId != NODEID_NONE && lteNodeId == nrNodeId) { //only nr
-            found = false;
-            for (const auto& [cellId, baseStation]: eNodeBs_) {
-                if (nrNodeId == NODEID_NONE) // enodeb does not have nrNodeId
-                    continue;
-                if (baseStation->hasUeCollector(nrNodeId)) {
-                    UeStatsCollector *ueColl = baseStation->getUeCollector(nrNodeId);
-                    CellUeInfo cellUeInfo = CellUeInfo(ueColl, baseStation->getEcgi());
-                    ueArray.push_back(cellUeInfo.toJson());
-                    found = true;
-                    break; // next ue id
-                }
-            }
+            found = addUeInfo(nrNodeId, ueArray);
             if (!found) {
                 // ETSI sandbox does not return anything in case the ip is not valid
                 std::string notFound = "Address: " + ipAddress.str() + " Not found.";
@@ -133,45 +188,15 @@ nlohmann::ordered_json L2Meas::toJsonUe(std::vector<inet::Ipv4Address>& uesID) c
             }
         }
         else if (lteNodeId != NODEID_NONE && nrNodeId == NODEID_NONE) { //only lte
-            found = false;
-            for (const auto& [cellId, baseStation]: eNodeBs_) {
-                if (lteNodeId == NODEID_NONE) // gnodeb does not have lteNodeId
-                    continue;
-                if (baseStation->hasUeCollector(lteNodeId)) {
-                    UeStatsCollector *ueColl = baseStation->getUeCollector(lteNodeId);
-                    CellUeInfo cellUeInfo = CellUeInfo(ueColl, baseStation->getEcgi());
-                    ueArray.push_back(cellUeInfo.toJson());
-                    found = true;
-                    break; // next ue id
-                }
-            }
+            found = addUeInfo(lteNodeId, ueArray);
             if (!found) {
                 std::string notFound = "Address: " + ipAddress.str() + " Not found.";
                 ueArray.push_back(notFound);
             }
         }
         else if (lteNodeId != nrNodeId && nrNodeId != NODEID_NONE && lteNodeId != NODEID_NONE) { // both lte and nr
-            found = false;
-            for (const auto& [cellId, baseStation]: eNodeBs_) {
-                if (baseStation->hasUeCollector(lteNodeId)) {
-                    UeStatsCollector *ueColl = baseStation->getUeCollector(lteNodeId);
-                    CellUeInfo cellUeInfo = CellUeInfo(ueColl, baseStation->getEcgi());
-                    ueArray.push_back(cellUeInfo.toJson());
-                    found = true;
-                    break; // next ue id
-                }
-            }
-
-            found = false;
-            for (const auto& [cellId, baseStation]: eNodeBs_) {
-                if (baseStation->hasUeCollector(nrNodeId)) {
-                    UeStatsCollector *ueColl = baseStation->getUeCollector(nrNodeId);
-                    CellUeInfo cellUeInfo = CellUeInfo(ueColl, baseStation->getEcgi());
-                    ueArray.push_back(cellUeInfo.toJson());
-                    found = true;
-                    break; // next ue id
-                }
-            }
+            addUeInfo(lteNodeId, ueArray);
+            found = addUeInfo(nrNodeId, ueArray);
             if (!found) {
                 std::string notFound = "Address: " + ipAddress.str() + " Not found.";
                 ueArray.push_back(notFound);
@@ -204,14 +229,11 @@ nlohmann::ordered_json L2Meas::toJsonCell(std::vector<MacCellId>& cellsID) const
     for (const auto& cid : cellsID) {
         auto it = eNodeBs_.find(cid);
         if (it != eNodeBs_.end()) {
-            RniCellInfo cellInfo = RniCellInfo(it->second);
-            cellArray.push_back(cellInfo.toJson());
+            const CellSnapshot& snapshot = getSnapshot(it->first, it->second);
+            cellArray.push_back(snapshot.cellInfo);
 
-            UeStatsCollectorMap *ueMap = it->second->getCollectorMap();
-            for (const auto& [ueId, ueCollector] : *ueMap) {
-                CellUeInfo cellUeInfo = CellUeInfo(ueCollector, it->second->getEcgi());
-                ueArray.push_back(cellUeInfo.toJson());
-            }
+            for (const auto& [ueId, ueInfo] : snapshot.ueInfo)
+                ueArray.push_back(ueInfo);
         }
     }
 
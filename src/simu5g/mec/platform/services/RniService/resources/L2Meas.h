@@ -31,6 +31,10 @@ class Binder;
  * This class is responsible for retrieving the L2 measures and creating the JSON body
  * response. It maintains the list of all the eNB/gNBs associated with the MEC host
  * where the RNIS is running and keeps the pointers to the s.*
+ *
+ * The JSON objects of each cell and of its UEs are kept in a snapshot, which is rebuilt
+ * only when the BaseStationStatsCollector reports a new version of its measures. Also,
+ * the serialized response of each query is cached until any of the measures changes.
  */
 
 class L2Meas : public AttributeBase
@@ -50,11 +54,46 @@ class L2Meas : public AttributeBase
     nlohmann::ordered_json toJsonUe(std::vector<inet::Ipv4Address>& uesID) const;
     nlohmann::ordered_json toJson(std::vector<MacNodeId>& cellsID, std::vector<inet::Ipv4Address>& uesID) const;
 
+    /*
+     * Returns the serialized body of the response to a query on the given cells and UEs
+     * (empty vectors mean no filter). The body is taken from the cache, if the
+     * L2 measures did not change since it was built
+     *
+     * @param cacheHit set to true if the body was found in the cache
+     */
+    const std::string& getSerializedJson(std::vector<MacCellId>& cellsID, std::vector<inet::Ipv4Address>& uesID, bool& cacheHit);
+
+    // overall version of the L2 measures of all the cells
+    unsigned long getVersion() const;
+
   protected:
 
+    // JSON objects built from the statistics collector of a cell
+    struct CellSnapshot
+    {
+        bool valid = false;
+        unsigned long version = 0;
+        nlohmann::ordered_json cellInfo;
+        std::map<MacNodeId, nlohmann::ordered_json> ueInfo;
+    };
+
+    // maximum number of queries whose response is cached
+    static const size_t MAX_CACHED_QUERIES = 128;
+
     TimeStamp timestamp_;
     std::map<MacCellId, BaseStationStatsCollector *> eNodeBs_;
     opp_component_ptr<Binder> binder_;
+
+    mutable std::map<MacCellId, CellSnapshot> snapshots_;
+
+    unsigned long cacheVersion_ = 0;
+    std::map<std::string, std::string> cache_; // query -> serialized response
+
+    // returns the up-to-date snapshot of the given cell
+    const CellSnapshot& getSnapshot(MacCellId cellId, BaseStationStatsCollector *collector) const;
+
+    // looks for the UE in the cells and appends its JSON object to ueArray
+    bool addUeInfo(MacNodeId nodeId, nlohmann::ordered_json& ueArray) const;
 };
 
 } //namespace
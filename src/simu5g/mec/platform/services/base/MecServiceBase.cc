@@ -12,6 +12,7 @@
 
 #include "simu5g/mec/platform/services/base/MecServiceBase.h"
 
+#include <algorithm>
 #include <iostream>
 #include <sstream>
 #include <string>
@@ -35,6 +36,12 @@ using namespace omnetpp;
 
 simsignal_t MecServiceBase::loadGeneratorNumBackgroundRequestsSignal_ = registerSignal("loadGeneratorNumBackgroundRequests");
 simsignal_t MecServiceBase::responseTimeSignal_ = registerSignal("responseTime");
+simsignal_t MecServiceBase::busyWorkersSignal_ = registerSignal("busyWorkers");
+simsignal_t MecServiceBase::queueingDelaySignal_ = registerSignal("queueingDelay");
+simsignal_t MecServiceBase::workerUtilizationSignal_ = registerSignal("workerUtilization");
+simsignal_t MecServiceBase::backgroundWorkSignal_ = registerSignal("backgroundWork");
+simsignal_t MecServiceBase::httpMessagesSentSignal_ = registerSignal("httpMessagesSent");
+simsignal_t MecServiceBase::httpPayloadAllocationsSignal_ = registerSignal("httpPayloadAllocations");
 
 void MecServiceBase::initialize(int stage)
 {
@@ -46,15 +53,23 @@ void MecServiceBase::initialize(int stage)
 
         serviceName_ = par("serviceName").stringValue();
         requestServiceTime_ = par("requestServiceTime");
-        requestService_ = new cMessage("serveRequest");
-        requestQueueSize_ = par("requestQueueSize");
+        requests_.maxSize = par("requestQueueSize");
+        backgroundRequests_.maxSize = par("backgroundRequestQueueSize");
+        priorityClasses_ = par("priorityClasses");
 
         subscriptionServiceTime_ = par("subscriptionServiceTime");
-        subscriptionService_ = new cMessage("serveSubscription");
-        subscriptionQueueSize_ = par("subscriptionQueueSize");
+        subscriptionEvents_.maxSize = par("subscriptionQueueSize");
+
+        int numWorkers = par("numWorkers");
+        if (numWorkers < 1)
+            throw cRuntimeError("MecServiceBase::initialize - the number of workers must be at least 1, %d found", numWorkers);
+        workers_.resize(numWorkers);
+        for (auto& worker : workers_)
+            worker.serviceTimer = new cMessage("serveWorker");
 
         EV << "MecServiceBase::initialize - mean request service time " << requestServiceTime_ << endl;
         EV << "MecServiceBase::initialize - mean subscription service time " << subscriptionServiceTime_ << endl;
+        EV << "MecServiceBase::initialize - number of workers " << numWorkers << endl;
 
         EV << "MecServiceBase::initialize" << endl;
 
@@ -146,17 +161,13 @@ void MecServiceBase::handleMessageWhenUp(cMessage *msg)
 {
     if (msg->isSelfMessage()) {
         EV << " MecServiceBase::handleMessageWhenUp - " << msg->getName() << endl;
-        if (msg == subscriptionService_) {
-            bool res = manageSubscription();
-            scheduleNextEvent(!res);
-        }
-        else if (msg == requestService_) {
-            bool res = manageRequest();
-            scheduleNextEvent(!res);
-        }
-        else {
-            delete msg;
+        for (auto& worker : workers_) {
+            if (msg == worker.serviceTimer) {
+                handleServiceCompletion(worker);
+                return;
+            }
         }
+        delete msg;
     }
     else {
         inet::TcpSocket *socket = check_and_cast_nullable<inet::TcpSocket *>(socketMap.findSocketFor(msg));
@@ -238,41 +249,84 @@ bool MecServiceBase::manageRequest()
 void MecServiceBase::scheduleNextEvent(bool now)
 {
     EV << "MecServiceBase::scheduleNextEvent" << endl;
-    // schedule next event
-    if (subscriptionEvents_.size() != 0 && !subscriptionService_->isScheduled() && !requestService_->isScheduled()) {
-        EV << "MecServiceBase::scheduleNextEvent - subscription branch" << endl;
-        currentSubscriptionServed_ = subscriptionEvents_.front();
-        subscriptionEvents_.pop();
-        if (now)
-            scheduleAt(simTime() + 0, subscriptionService_);
-        else {
-            double serviceTime = calculateSubscriptionServiceTime(); //must be >0
-            EV << "MecServiceBase::scheduleNextEvent- subscription service time: " << serviceTime << endl;
-            scheduleAt(simTime() + serviceTime, subscriptionService_);
+    // schedule next event on every idle worker
+    for (auto& worker : workers_) {
+        if (worker.isBusy())
+            continue;
+
+        simtime_t arrivalTime;
+        double serviceTime;
+        if (!subscriptionEvents_.empty()) {
+            EV << "MecServiceBase::scheduleNextEvent - subscription branch" << endl;
+            worker.subscriptionEvent = subscriptionEvents_.pop(arrivalTime);
+            if (now)
+                serviceTime = 0;
+            else {
+                serviceTime = calculateSubscriptionServiceTime(); //must be >0
+                EV << "MecServiceBase::scheduleNextEvent- subscription service time: " << serviceTime << endl;
+            }
         }
-    }
-    else if (requests_.getLength() != 0 && !requestService_->isScheduled() && !subscriptionService_->isScheduled()) {
-        EV << "MecServiceBase::scheduleNextEvent - request branch" << endl;
-        currentRequestMessageServed_ = check_and_cast<HttpRequestMessage *>(requests_.pop());
-
-        if (loadGenerator_ && !currentRequestMessageServed_->isBackgroundRequest()) {
-            EV << "MecServiceBase::scheduleNextEvent - load generator is on, use the response time in the packet" << endl;
-            /*
-             * If the loadGenerator flag is active, use the responseTime calculated at arriving time
-             */
-            scheduleAt(simTime() + currentRequestMessageServed_->getResponseTime(), requestService_);
-            return;
+        else if (!requests_.empty() || !backgroundRequests_.empty()) {
+            EV << "MecServiceBase::scheduleNextEvent - request branch" << endl;
+            // background requests are served only if no foreground request is waiting
+            worker.request = !requests_.empty() ? requests_.pop(arrivalTime) : backgroundRequests_.pop(arrivalTime);
+
+            if (loadGenerator_ && !worker.request->isBackgroundRequest()) {
+                EV << "MecServiceBase::scheduleNextEvent - load generator is on, use the response time in the packet" << endl;
+                /*
+                 * If the loadGenerator flag is active, use the responseTime calculated at arriving time
+                 */
+                serviceTime = worker.request->getResponseTime();
+            }
+            else if (now)
+                serviceTime = 0;
+            else {
+                //calculate the serviceTime based on the type | parameters
+                currentRequestMessageServed_ = worker.request;
+                serviceTime = calculateRequestServiceTime(); //must be >0
+                currentRequestMessageServed_ = nullptr;
+
+                // wait for the background work still ahead of the request, which has been served since its arrival
+                if (bgLoadModel_ != BG_NONE && !worker.request->isBackgroundRequest())
+                    serviceTime += std::max(0.0, worker.request->getBackgroundWork() / workers_.size() - (simTime() - arrivalTime).dbl());
+                EV << "MecServiceBase::scheduleNextEvent- request service time: " << serviceTime << endl;
+            }
         }
+        else
+            break;
 
-        if (now)
-            scheduleAt(simTime() + 0, subscriptionService_);
-        else {
-            //calculate the serviceTime based on the type | parameters
-            double serviceTime = calculateRequestServiceTime(); //must be >0
-            EV << "MecServiceBase::scheduleNextEvent- request service time: " << serviceTime << endl;
-            scheduleAt(simTime() + serviceTime, requestService_);
-        }
+        emit(queueingDelaySignal_, simTime() - arrivalTime);
+        worker.busySince = simTime();
+        emit(busyWorkersSignal_, ++numBusyWorkers_);
+        scheduleAt(simTime() + serviceTime, worker.serviceTimer);
+
+        // only the first event is scheduled immediately
+        now = false;
+    }
+}
+
+void MecServiceBase::handleServiceCompletion(Worker& worker)
+{
+    Http::MessageCounters counters = Http::getMessageCounters();
+    bool res;
+    worker.busyTime += simTime() - worker.busySince;
+    if (worker.subscriptionEvent != nullptr) {
+        currentSubscriptionServed_ = worker.subscriptionEvent;
+        worker.subscriptionEvent = nullptr;
+        res = manageSubscription();
+        // manageSubscription() may leave the event to the caller
+        delete currentSubscriptionServed_;
+        currentSubscriptionServed_ = nullptr;
     }
+    else {
+        currentRequestMessageServed_ = worker.request;
+        worker.request = nullptr;
+        res = manageRequest();
+    }
+    httpMessagesSent_ += Http::getMessageCounters().messagesSent - counters.messagesSent;
+    httpPayloadAllocations_ += Http::getMessageCounters().payloadAllocations - counters.payloadAllocations;
+    emit(busyWorkersSignal_, --numBusyWorkers_);
+    scheduleNextEvent(!res);
 }
 
 void MecServiceBase::handleRequestQueueFull(HttpRequestMessage *msg)
@@ -295,9 +349,12 @@ void MecServiceBase::handleRequestQueueFull(HttpRequestMessage *msg)
 
 void MecServiceBase::newRequest(HttpRequestMessage *msg)
 {
-    EV << "Queue length: " << requests_.getLength() << endl;
+    // with priority classes, background requests have their own queue
+    ServiceQueue<HttpRequestMessage>& queue = (priorityClasses_ && msg->isBackgroundRequest()) ? backgroundRequests_ : requests_;
+
+    EV << "Queue length: " << queue.length() << endl;
     // If queue is full respond 503 queue full
-    if (requestQueueSize_ != 0 && requests_.getLength() == requestQueueSize_) {
+    if (queue.isFull()) {
         EV << "MecServiceBase::newRequest - queue is full" << endl;
         handleRequestQueueFull(msg);
         return;
@@ -315,7 +372,7 @@ void MecServiceBase::newRequest(HttpRequestMessage *msg)
     if (loadGenerator_) {
         int numOfBGReqs;
 
-        if (requests_.getLength() == 0) {
+        if (requests_.empty()) {
             // debug
             numOfBGReqs = geometric((1 - rho_), 0);
             EV << "MecServiceBase::newRequest - number of BG requests in front of this FG request: " << numOfBGReqs << endl;
@@ -339,15 +396,21 @@ void MecServiceBase::newRequest(HttpRequestMessage *msg)
         emit(loadGeneratorNumBackgroundRequestsSignal_, numOfBGReqs);
     }
 
-    requests_.insert(msg);
+    else if (bgLoadModel_ != BG_NONE && !msg->isBackgroundRequest()) {
+        updateBackgroundWork();
+        msg->setBackgroundWork(bgWork_);
+        emit(backgroundWorkSignal_, bgWork_);
+    }
+
+    queue.push(msg);
     scheduleNextEvent();
 }
 
 void MecServiceBase::newSubscriptionEvent(EventNotification *event)
 {
-    EV << "Queue length: " << subscriptionEvents_.size() << endl;
+    EV << "Queue length: " << subscriptionEvents_.length() << endl;
     // If queue is full delete event
-    if (subscriptionQueueSize_ != 0 && subscriptionEvents_.size() == subscriptionQueueSize_) {
+    if (subscriptionEvents_.isFull()) {
         EV << "MecServiceBase::newSubscriptionEvent - subscription queue is full. Deleting event..." << endl;
         delete event;
         return;
@@ -385,6 +448,65 @@ double MecServiceBase::calculateRequestServiceTime()
     return time;
 }
 
+void MecServiceBase::initBackgroundLoad()
+{
+    const char *model = par("backgroundLoadModel");
+    if (!strcmp(model, "none"))
+        return;
+    if (!strcmp(model, "poisson"))
+        bgLoadModel_ = BG_POISSON;
+    else if (!strcmp(model, "mmpp"))
+        bgLoadModel_ = BG_MMPP;
+    else
+        throw cRuntimeError("MecServiceBase::initBackgroundLoad - background load model '%s' not recognized", model);
+
+    if (loadGenerator_)
+        throw cRuntimeError("MecServiceBase::initBackgroundLoad - loadGenerator and backgroundLoadModel cannot be used together");
+
+    bgArrivalRate_[0] = par("backgroundArrivalRate");
+    double meanRate = bgArrivalRate_[0];
+    if (bgLoadModel_ == BG_MMPP) {
+        bgArrivalRate_[1] = par("backgroundArrivalRateHigh");
+        bgMeanStateDuration_[0] = par("backgroundLowStateDuration");
+        bgMeanStateDuration_[1] = par("backgroundHighStateDuration");
+        if (bgMeanStateDuration_[0] <= 0 || bgMeanStateDuration_[1] <= 0)
+            throw cRuntimeError("MecServiceBase::initBackgroundLoad - MMPP state durations must be positive");
+        meanRate = (bgArrivalRate_[0] * bgMeanStateDuration_[0] + bgArrivalRate_[1] * bgMeanStateDuration_[1]) / (bgMeanStateDuration_[0] + bgMeanStateDuration_[1]);
+        bgNextStateChange_ = simTime() + exponential(bgMeanStateDuration_[0], REQUEST_RNG);
+    }
+
+    // the background load alone must not saturate the workers
+    double rho = meanRate * requestServiceTime_ / workers_.size();
+    if (rho >= 1)
+        throw cRuntimeError("MecServiceBase::initBackgroundLoad - background load is unstable: rho is %f", rho);
+    EV << "MecServiceBase::initBackgroundLoad - background load rho: " << rho << endl;
+    bgLastUpdate_ = simTime();
+}
+
+void MecServiceBase::updateBackgroundWork()
+{
+    simtime_t now = simTime();
+    while (bgLoadModel_ == BG_MMPP && bgNextStateChange_ <= now) {
+        advanceBackgroundWork(bgArrivalRate_[bgState_], (bgNextStateChange_ - bgLastUpdate_).dbl());
+        bgLastUpdate_ = bgNextStateChange_;
+        bgState_ = 1 - bgState_;
+        bgNextStateChange_ += exponential(bgMeanStateDuration_[bgState_], REQUEST_RNG);
+    }
+    advanceBackgroundWork(bgArrivalRate_[bgState_], (now - bgLastUpdate_).dbl());
+    bgLastUpdate_ = now;
+}
+
+void MecServiceBase::advanceBackgroundWork(double rate, double interval)
+{
+    if (interval <= 0)
+        return;
+
+    // the sum of the exponential service times of the arrived requests is Erlang distributed
+    long numArrivals = poisson(rate * interval, REQUEST_RNG);
+    double work = numArrivals > 0 ? gamma_d(numArrivals, requestServiceTime_, REQUEST_RNG) : 0.0;
+    bgWork_ = std::max(0.0, bgWork_ + work - workers_.size() * interval);
+}
+
 double MecServiceBase::calculateSubscriptionServiceTime()
 {
     double time;
@@ -471,24 +593,37 @@ void MecServiceBase::finish()
     while (!threadSet.empty()) {
         removeConnection(*threadSet.begin());
     }
+
+    // fraction of time each worker has been busy
+    if (simTime() > 0) {
+        for (auto& worker : workers_) {
+            simtime_t busyTime = worker.busyTime;
+            if (worker.isBusy())
+                busyTime += simTime() - worker.busySince;
+            emit(workerUtilizationSignal_, busyTime.dbl() / simTime().dbl());
+        }
+    }
+
+    emit(httpMessagesSentSignal_, httpMessagesSent_);
+    emit(httpPayloadAllocationsSignal_, httpPayloadAllocations_);
 }
 
 MecServiceBase::~MecServiceBase() {
     // remove and delete threads
-    cancelAndDelete(requestService_);
-    cancelAndDelete(subscriptionService_);
+    for (auto& worker : workers_) {
+        cancelAndDelete(worker.serviceTimer);
+        delete worker.request;
+        delete worker.subscriptionEvent;
+    }
     delete currentRequestMessageServed_;
     delete currentSubscriptionServed_;
 
-    while (!requests_.isEmpty()) {
-        delete requests_.pop();
-    }
-
-    while (!subscriptionEvents_.empty()) {
-        EventNotification *notEv = subscriptionEvents_.front();
-        subscriptionEvents_.pop();
-        delete notEv;
-    }
+    for (auto& [request, arrivalTime] : requests_.items)
+        delete request;
+    for (auto& [request, arrivalTime] : backgroundRequests_.items)
+        delete request;
+    for (auto& [event, arrivalTime] : subscriptionEvents_.items)
+        delete event;
     for (auto &[subscriptionId, subscription] : subscriptions_) {
         delete subscription;
     }
@@ -496,7 +631,7 @@ MecServiceBase::~MecServiceBase() {
 
 void MecServiceBase::emitRequestQueueLength()
 {
-    // emit(requestQueueSizeSignal_, requests_.getLength());
+    // emit(requestQueueSizeSignal_, requests_.length());
 }
 
 void MecServiceBase::removeSubscriptions(int connId)
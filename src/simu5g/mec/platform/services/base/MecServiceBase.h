@@ -13,6 +13,7 @@
 #ifndef __INET_GENERICSERVICE_H
 #define __INET_GENERICSERVICE_H
 
+#include <deque>
 #include <map>
 #include <queue>
 #include <vector>
@@ -38,8 +39,9 @@ using namespace omnetpp;
  *
  * This class implements the general structure of an MEC Service. It holds all the TCP connections
  * with the e.g. MEC Applications and manages its lifecycle. It manages Request-Reply and Subscribe-Notify schemes.
- * Every request is inserted in the queue and executed in FIFO order. Also, subscription events are queued in a separate queue and
- * have priority. The execution times are calculated with the calculateRequestServiceTime method.
+ * Every request is inserted in the queue and executed in FIFO order by one of the (numWorkers) workers. Also, subscription
+ * events are queued in a separate queue and have priority. Optionally, background requests are queued in a third queue with the
+ * lowest priority. The execution times are calculated with the calculateRequestServiceTime method.
  * During initialization, it saves all the eNodeB/gNodeBs connected to the MEC Host on which the service is running.
  *
  * Each connection is managed by the SocketManager object that implements the TcpSocket::CallbackInterface
@@ -93,6 +95,22 @@ class MecServiceBase : public inet::ApplicationBase, public inet::TcpSocket::ICa
     double rho_ = 0;
     simtime_t lastFGRequestArrived_ = 0;
 
+    /*
+     * Analytic background load
+     * Background requests are not materialized as messages. Their aggregate arrival process
+     * (Poisson or two-state MMPP) is sampled lazily, upon foreground request arrivals, and
+     * only the resulting unfinished work is kept. Foreground requests wait until the
+     * background work queued ahead of them has been served by the workers
+     */
+    enum BackgroundLoadModel { BG_NONE, BG_POISSON, BG_MMPP };
+    BackgroundLoadModel bgLoadModel_ = BG_NONE;
+    double bgArrivalRate_[2] = { 0, 0 };       // arrival rate in the low and high state (only the former for Poisson)
+    double bgMeanStateDuration_[2] = { 0, 0 }; // mean sojourn time in the low and high state (MMPP only)
+    int bgState_ = 0;
+    simtime_t bgNextStateChange_ = 0;
+    double bgWork_ = 0; // unfinished background work, in seconds of service of one worker
+    simtime_t bgLastUpdate_ = 0;
+
     unsigned int subscriptionId_ = 0; // identifier for new subscriptions
 
     // currently not used
@@ -104,23 +122,73 @@ class MecServiceBase : public inet::ApplicationBase, public inet::TcpSocket::ICa
 
     std::set<cModule *, simu5g::utils::cModule_LessId> eNodeB_;     // eNodeBs connected to the MEC Host
 
-    int requestQueueSize_;
-
+    /*
+     * Request processing model
+     *
+     * The service runs a pool of workers, each serving one request or one subscription
+     * event at a time. Subscription events have precedence over requests. If priority
+     * classes are enabled, background requests are queued separately and are served
+     * only when no foreground request is waiting.
+     * Every class has its own queue, whose size can be limited (0 = unlimited)
+     */
+    template<typename T>
+    struct ServiceQueue
+    {
+        std::deque<std::pair<T *, simtime_t>> items; // queued element and its arrival time
+        int maxSize = 0;
+
+        bool empty() const { return items.empty(); }
+        int length() const { return items.size(); }
+        bool isFull() const { return maxSize != 0 && length() >= maxSize; }
+        void push(T *item) { items.emplace_back(item, simTime()); }
+        T *pop(simtime_t& arrivalTime)
+        {
+            auto [item, time] = items.front();
+            items.pop_front();
+            arrivalTime = time;
+            return item;
+        }
+    };
+
+    struct Worker
+    {
+        cMessage *serviceTimer = nullptr;
+        HttpRequestMessage *request = nullptr;          // request being served, if any
+        EventNotification *subscriptionEvent = nullptr; // subscription event being served, if any
+        simtime_t busySince = 0;
+        simtime_t busyTime = 0;                         // overall busy time, for utilization statistics
+
+        bool isBusy() const { return serviceTimer->isScheduled(); }
+    };
+
+    std::vector<Worker> workers_;
+    int numBusyWorkers_ = 0;
+    bool priorityClasses_ = false;
+
+    // request or subscription event currently handled by manageRequest()/manageSubscription()
     HttpRequestMessage *currentRequestMessageServed_ = nullptr;
+    EventNotification *currentSubscriptionServed_ = nullptr;
 
-    cMessage *requestService_ = nullptr;
     double requestServiceTime_;
-    cQueue requests_;               // queue that holds incoming requests
+    ServiceQueue<HttpRequestMessage> requests_;           // queue that holds incoming requests
+    ServiceQueue<HttpRequestMessage> backgroundRequests_; // queue that holds background requests, if priority classes are enabled
 
-    cMessage *subscriptionService_ = nullptr;
     double subscriptionServiceTime_;
-    int subscriptionQueueSize_;
-    std::queue<EventNotification *> subscriptionEvents_;          // queue that holds events related to subscriptions
-    EventNotification *currentSubscriptionServed_ = nullptr;
+    ServiceQueue<EventNotification> subscriptionEvents_;  // queue that holds events related to subscriptions
 
     // signals for statistics
     static simsignal_t loadGeneratorNumBackgroundRequestsSignal_;
     static simsignal_t responseTimeSignal_;
+    static simsignal_t busyWorkersSignal_;
+    static simsignal_t queueingDelaySignal_;
+    static simsignal_t workerUtilizationSignal_;
+    static simsignal_t backgroundWorkSignal_;
+    static simsignal_t httpMessagesSentSignal_;
+    static simsignal_t httpPayloadAllocationsSignal_;
+
+    // HTTP messages sent and payload allocations made while serving requests and subscription events
+    unsigned long httpMessagesSent_ = 0;
+    unsigned long httpPayloadAllocations_ = 0;
 
     /*
      * This method is called for every request in the requests_ queue.
@@ -134,16 +202,22 @@ class MecServiceBase : public inet::ApplicationBase, public inet::TcpSocket::ICa
     virtual bool manageSubscription();
 
     /*
-     * This method checks the queue lengths and in case it simulates a request/subscription
-     * execution time.
+     * This method checks the queue lengths and, for every idle worker, it simulates
+     * a request/subscription execution time.
      * Subscriptions have precedence over requests
      *
-     * if the parameter is true -> scheduleAt(NOW)
+     * if the parameter is true -> the first event is scheduled at NOW
      *
      * @param now when to send the next event
      */
     virtual void scheduleNextEvent(bool now = false);
 
+    /*
+     * This method is called when the service timer of a worker expires.
+     * It manages the request/subscription event assigned to the worker and makes it idle
+     */
+    virtual void handleServiceCompletion(Worker& worker);
+
     void initialize(int stage) override;
     int numInitStages() const override { return inet::NUM_INIT_STAGES; }
     void handleMessageWhenUp(cMessage *msg) override;
@@ -183,6 +257,16 @@ class MecServiceBase : public inet::ApplicationBase, public inet::TcpSocket::ICa
     virtual double calculateRequestServiceTime();
     virtual double calculateSubscriptionServiceTime();
 
+    /*
+     * These methods implement the analytic background load.
+     * updateBackgroundWork() brings the unfinished background work up to the current time,
+     * advanceBackgroundWork() adds the arrivals of an interval with constant rate and
+     * removes the work served by the workers in the meantime
+     */
+    virtual void initBackgroundLoad();
+    virtual void updateBackgroundWork();
+    void advanceBackgroundWork(double rate, double interval);
+
     /*
      * Abstract methods
      *
@@ -265,6 +349,15 @@ class MecServiceBase : public inet::ApplicationBase, public inet::TcpSocket::ICa
      * with a closed connection
      */
     virtual void removeSubscriptions(int connId);
+
+    const std::string& getServiceName() const { return serviceName_; }
+    int getNumWorkers() const { return workers_.size(); }
+
+    // returns the number of requests and subscription events that are queued or being served
+    int getNumPendingRequests() const
+    {
+        return requests_.length() + backgroundRequests_.length() + subscriptionEvents_.length() + numBusyWorkers_;
+    }
 };
 
 } //namespace
@@ -40,6 +40,7 @@ void MecServiceBase2::initialize(int stage)
                 throw cRuntimeError("M/M/1 system is unstable: rho is %f", rho_);
             EV << "MecServiceBase::initialize - rho: " << rho_ << endl;
         }
+        initBackgroundLoad();
 
         int found = getParentModule()->findSubmodule("serviceRegistry");
         if (found == -1)
@@ -30,7 +30,7 @@ void SocketManager::dataArrived(inet::Packet *msg, bool urgent) {
 
     std::vector<uint8_t> bytes = msg->peekDataAsBytes()->getBytes();
     EV << "SocketManager::dataArrived - payload length: " << bytes.size() << endl;
-    std::string packet(bytes.begin(), bytes.end());
+    std::string_view packet(reinterpret_cast<const char *>(bytes.data()), bytes.size());
     EV << "SocketManager::dataArrived - payload : " << packet << endl;
 
     /**
@@ -41,7 +41,7 @@ void SocketManager::dataArrived(inet::Packet *msg, bool urgent) {
      */
     if (packet.rfind("BulkRequest", 0) == 0) {
         EV << "Bulk Request ";
-        std::string size = simu5g::utils::splitString(packet, ": ")[1];
+        std::string size = simu5g::utils::splitString(std::string(packet), ": ")[1];
         int requests = std::stoi(size);
         if (requests < 0)
             throw cRuntimeError("Number of requests must be non-negative");
@@ -1,11 +1,22 @@
 //
 
+#include <charconv>
+#include <string_view>
+
 #include <inet/common/INETDefs.h>
 
 #include "simu5g/mec/platform/services/messages/HttpRequestMessage.h"
+#include "simu5g/mec/utils/httpUtils/httpUtils.h"
 
 namespace simu5g {
 
+namespace {
+
+constexpr std::string_view CRLF = "\r\n";
+constexpr std::string_view DEFAULT_HEADERS = "Content-Type: application/json\r\nConnection: keep-alive\r\n";
+
+} // namespace
+
 HttpRequestMessage::HttpRequestMessage(const char *name, short kind) : isBackgroundRequest_(false), isLastBackgroundRequest_(false)
 {
     setContentType("application/json");
@@ -31,30 +42,74 @@ void HttpRequestMessage::setHeaderField(const std::string& key, const std::strin
     headerFields_[key] = value;
 }
 
+template<typename Output>
+void HttpRequestMessage::writePayload(Output& out) const
+{
+    out.append(method.c_str());
+    out.append(" ");
+    out.append(uri.c_str());
+    if (!parameters.empty()) {
+        out.append("?");
+        out.append(parameters.c_str());
+    }
+    out.append(" ");
+    out.append(httpProtocol.c_str());
+    out.append(CRLF);
+    if (!host.empty()) {
+        out.append("Host: ");
+        out.append(host.c_str());
+        out.append(CRLF);
+    }
+
+    if (contentLength != 0) {
+        char number[24];
+        out.append("Content-Length: ");
+        out.append(std::string_view(number, std::to_chars(number, number + sizeof(number), contentLength).ptr - number));
+        out.append(CRLF);
+    }
+    if (!strcmp(contentType.c_str(), "application/json") && !strcmp(connection.c_str(), "keep-alive"))
+        out.append(DEFAULT_HEADERS);
+    else {
+        out.append("Content-Type: ");
+        out.append(contentType.c_str());
+        out.append(CRLF);
+        out.append("Connection: ");
+        out.append(connection.c_str());
+        out.append(CRLF);
+    }
+
+    for (const auto& header : headerFields_) {
+        out.append(header.first);
+        out.append(header.second);
+        out.append(CRLF);
+    }
+    out.append(CRLF);
+    out.append(body.c_str());
+}
+
 std::string HttpRequestMessage::getPayload() const {
-    std::string crlf = "\r\n";
     std::string payload;
-    if (this->parameters.size() == 0)
-        payload = this->method.str() + " " + this->uri.str() + " " + this->httpProtocol.str() + crlf;
-    else
-        payload = this->method.str() + " " + this->uri.str() + "?" + this->parameters.str() + " " + this->httpProtocol.str() + crlf;
-    if (host != "")
-        payload += "Host: " + this->host.str() + crlf;
-
-    if (contentLength != 0)
-        payload += "Content-Length: " + std::to_string(this->contentLength) + crlf;
-    payload += "Content-Type: " + this->contentType.str() + crlf;
-    payload += "Connection: " + this->connection.str() + crlf;
-
-    if (!headerFields_.empty()) {
-        for (const auto& header : headerFields_) {
-            payload += header.first + header.second + crlf;
-        }
-    }
-    payload += crlf + body.str();
+    appendPayload(payload);
     return payload;
 }
 
+void HttpRequestMessage::appendPayload(std::string& out) const
+{
+    // reserve the whole payload at once, so that at most one allocation is made
+    size_t capacity = out.capacity();
+    out.reserve(out.size() + getPayloadLength());
+    if (out.capacity() != capacity)
+        Http::getMessageCounters().payloadAllocations++;
+    writePayload(out);
+}
+
+size_t HttpRequestMessage::getPayloadLength() const
+{
+    Http::PayloadLength length;
+    writePayload(length);
+    return length.length;
+}
+
 void HttpRequestMessage::addBodyChunk(const std::string& bodyChunk)
 {
     handleChange();
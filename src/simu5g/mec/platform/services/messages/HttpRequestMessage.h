@@ -72,6 +72,16 @@ class HttpRequestMessage : public HttpRequestMessage_m
     }
 
     virtual std::string getPayload() const;
+
+    // appends the serialized message to out, e.g. a buffer reused across messages
+    virtual void appendPayload(std::string& out) const;
+
+    // returns the size of the serialized message, without building it
+    virtual size_t getPayloadLength() const;
+
+  private:
+    template<typename Output>
+    void writePayload(Output& out) const;
 };
 
 } //namespace
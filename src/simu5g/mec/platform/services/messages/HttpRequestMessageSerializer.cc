@@ -33,7 +33,10 @@ void HttpRequestMessageSerializer::serialize(MemoryOutputStream& stream, const P
     EV << "HttpRequestMessageSerializer::serialize" << endl;
     auto startPosition = stream.getLength();
     const auto& applicationPacket = staticPtrCast<const HttpRequestMessage>(chunk);
-    stream.writeBytes((const uint8_t *)applicationPacket->getPayload().c_str(), B(applicationPacket->getPayload().size()));
+    static std::string payload; // reused across messages, to keep its capacity
+    payload.clear();
+    applicationPacket->appendPayload(payload);
+    stream.writeBytes((const uint8_t *)payload.c_str(), B(payload.size()));
 
     int64_t remainders = B(applicationPacket->getChunkLength() - (stream.getLength() - startPosition)).get();
     if (remainders < 0)
@@ -2,12 +2,37 @@
 
 #include "simu5g/mec/platform/services/messages/HttpResponseMessage.h"
 
+#include <charconv>
+#include <map>
+#include <string_view>
+
 #include <inet/common/INETDefs.h>
 
+#include "simu5g/mec/utils/httpUtils/httpUtils.h"
+
 namespace simu5g {
 
 using namespace omnetpp;
 
+namespace {
+
+constexpr std::string_view CRLF = "\r\n";
+constexpr std::string_view DEFAULT_HEADERS = "Content-Type: application/json\r\nConnection: keep-alive\r\n";
+
+// status lines of the HTTP/1.1 responses, e.g. "HTTP/1.1 200 OK\r\n", built once per code
+const std::string& getStatusLine(int code, const char *status)
+{
+    static std::map<int, std::pair<std::string, std::string>> statusLines; // code -> (status, line)
+    auto& [cachedStatus, line] = statusLines[code];
+    if (line.empty() || cachedStatus != status) {
+        cachedStatus = status;
+        line = "HTTP/1.1 " + std::to_string(code) + " " + cachedStatus + std::string(CRLF);
+    }
+    return line;
+}
+
+} // namespace
+
 HttpResponseMessage::HttpResponseMessage(const char *name, short kind)
 {
     setContentType("application/json");
@@ -102,23 +127,69 @@ std::string HttpResponseMessage::getHeaderField(const std::string& key) const
     return it->second;
 }
 
-std::string HttpResponseMessage::getPayload() const {
-    std::string crlf = "\r\n";
-    std::string payload = this->httpProtocol.str() + " " + std::to_string(this->code) + " " + status.str() + crlf;
-    if (contentLength != 0)
-        payload += "Content-Length: " + std::to_string(this->contentLength) + crlf;
-    payload += "Content-Type: " + this->contentType.str() + crlf;
-    payload += "Connection: " + this->connection.str() + crlf;
-
-    if (!headerFields_.empty()) {
-        for (const auto& headerField : headerFields_) {
-            payload += headerField.first + ": " + headerField.second + crlf; // Added colon separator
-        }
+template<typename Output>
+void HttpResponseMessage::writePayload(Output& out) const
+{
+    char number[24];
+    if (!strcmp(httpProtocol.c_str(), "HTTP/1.1"))
+        out.append(getStatusLine(code, status.c_str()));
+    else {
+        out.append(httpProtocol.c_str());
+        out.append(" ");
+        out.append(std::string_view(number, std::to_chars(number, number + sizeof(number), code).ptr - number));
+        out.append(" ");
+        out.append(status.c_str());
+        out.append(CRLF);
+    }
+    if (contentLength != 0) {
+        out.append("Content-Length: ");
+        out.append(std::string_view(number, std::to_chars(number, number + sizeof(number), contentLength).ptr - number));
+        out.append(CRLF);
     }
-    payload += crlf + body.str();
+    if (!strcmp(contentType.c_str(), "application/json") && !strcmp(connection.c_str(), "keep-alive"))
+        out.append(DEFAULT_HEADERS);
+    else {
+        out.append("Content-Type: ");
+        out.append(contentType.c_str());
+        out.append(CRLF);
+        out.append("Connection: ");
+        out.append(connection.c_str());
+        out.append(CRLF);
+    }
+
+    for (const auto& headerField : headerFields_) {
+        out.append(headerField.first);
+        out.append(": "); // Added colon separator
+        out.append(headerField.second);
+        out.append(CRLF);
+    }
+    out.append(CRLF);
+    out.append(body.c_str());
+}
+
+std::string HttpResponseMessage::getPayload() const {
+    std::string payload;
+    appendPayload(payload);
     return payload;
 }
 
+void HttpResponseMessage::appendPayload(std::string& out) const
+{
+    // reserve the whole payload at once, so that at most one allocation is made
+    size_t capacity = out.capacity();
+    out.reserve(out.size() + getPayloadLength());
+    if (out.capacity() != capacity)
+        Http::getMessageCounters().payloadAllocations++;
+    writePayload(out);
+}
+
+size_t HttpResponseMessage::getPayloadLength() const
+{
+    Http::PayloadLength length;
+    writePayload(length);
+    return length.length;
+}
+
 void HttpResponseMessage::copy(const HttpResponseMessage& other)
 {
     this->headerFields_ = other.headerFields_;
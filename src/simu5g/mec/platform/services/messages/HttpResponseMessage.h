@@ -61,6 +61,16 @@ class HttpResponseMessage : public HttpResponseMessage_m
     virtual void setStatus(HttpResponseStatus code);
     void setStatus(const char *status) override;
     virtual std::string getPayload() const;
+
+    // appends the serialized message to out, e.g. a buffer reused across messages
+    virtual void appendPayload(std::string& out) const;
+
+    // returns the size of the serialized message, without building it
+    virtual size_t getPayloadLength() const;
+
+  private:
+    template<typename Output>
+    void writePayload(Output& out) const;
 };
 
 } //namespace
@@ -35,7 +35,9 @@ void HttpResponseMessageSerializer::serialize(MemoryOutputStream& stream, const
     EV << "HttpResponseMessageSerializer::serialize" << endl;
     auto startPosition = stream.getLength();
     const auto& applicationPacket = staticPtrCast<const HttpResponseMessage>(chunk);
-    std::string payload = applicationPacket->getPayload();
+    static std::string payload; // reused across messages, to keep its capacity
+    payload.clear();
+    applicationPacket->appendPayload(payload);
     stream.writeBytes((const uint8_t *)payload.c_str(), B(payload.size()));
     int64_t remainders = B(applicationPacket->getChunkLength() - (stream.getLength() - startPosition)).get();
     if (remainders < 0)
@@ -12,6 +12,8 @@
 
 #include "simu5g/mec/utils/httpUtils/httpUtils.h"
 
+#include <algorithm>
+
 #include <inet/common/INETDefs.h>
 #include <inet/common/ProtocolTag_m.h>
 #include <inet/common/TagBase_m.h>
@@ -31,6 +33,12 @@ using namespace inet;
 
 namespace Http {
 
+MessageCounters& getMessageCounters()
+{
+    static MessageCounters counters;
+    return counters;
+}
+
 /*
  * Method for sending raw bytes.
  */
@@ -44,29 +52,127 @@ void sendPacket(const char *payload, inet::TcpSocket *socket) {
     Packet *packet = new Packet("Packet");
     packet->insertAtBack(chunkPayload);
     socket->send(packet);
+    getMessageCounters().messagesSent++;
     EV << "Http Utils - sendPacket" << endl;
 }
 
-bool checkHttpVersion(const std::string& httpVersion) {
+bool checkHttpVersion(std::string_view httpVersion) {
     // HTTP/1.1 or HTTP/2
     return httpVersion == "HTTP/1.1" || httpVersion == "HTTP/2";
 }
 
-bool checkHttpRequestMethod(const std::string& method) {
+bool checkHttpRequestMethod(std::string_view method) {
     return method == "GET" || method == "POST" || method == "PUT" || method == "DELETE";
 }
 
-HttpBaseMessage *parseHeader(const std::string& data)
+namespace {
+
+const std::string_view HEADER_DELIMITER = "\r\n\r\n";
+
+/*
+ * Splits str on delim without copying it, skipping empty tokens (same semantics
+ * as utils::splitString). At most maxTokens views are stored in tokens, but the
+ * total number of tokens is returned
+ */
+size_t splitView(std::string_view str, std::string_view delim, std::string_view *tokens, size_t maxTokens)
+{
+    size_t count = 0;
+    size_t last = 0;
+    size_t next = 0;
+    while (last < str.size()) {
+        next = str.find(delim, last);
+        if (next == std::string_view::npos)
+            next = str.size();
+        if (next != last) {
+            if (count < maxTokens)
+                tokens[count] = str.substr(last, next - last);
+            ++count;
+        }
+        last = next + delim.size();
+    }
+    return count;
+}
+
+/*
+ * Returns the next non-empty line of the header, and advances the cursor past it.
+ * An empty view is returned when there are no more lines
+ */
+std::string_view nextLine(std::string_view& header)
+{
+    while (!header.empty()) {
+        size_t end = header.find("\r\n");
+        std::string_view line = header.substr(0, end);
+        header.remove_prefix(end == std::string_view::npos ? header.size() : end + 2);
+        if (!line.empty())
+            return line;
+    }
+    return std::string_view();
+}
+
+/*
+ * Extracts (at most) one HTTP message from data, starting from pos.
+ * If no message is being received, the header is looked for and parsed, then the
+ * body is read as far as it is available. pos is advanced past the consumed bytes.
+ *
+ * @return bool - true if currentHttpMessage has been completed
+ */
+bool parseNextMsg(std::string_view data, size_t& pos, HttpBaseMessage *& currentHttpMessage)
+{
+    if (currentHttpMessage == nullptr || !currentHttpMessage->isReceivingMsg()) {
+        size_t end = data.find(HEADER_DELIMITER, pos);
+        if (end == std::string_view::npos) {
+            // the header is fragmented and will be completed by the subsequent segments
+            if (data.size() - pos > MAX_HEADER_SIZE)
+                throw cRuntimeError("httpUtils parseReceivedMsg - the HTTP header exceeds the maximum size of %zu bytes", MAX_HEADER_SIZE);
+            return false;
+        }
+        EV << "httpUtils::parseReceivedMsg - new HTTP message" << endl;
+        currentHttpMessage = parseHeader(data.substr(pos, end - pos));
+        pos = end + HEADER_DELIMITER.size();
+    }
+
+    HttpMsgState res = parseTcpData(data, pos, currentHttpMessage);
+    return res == COMPLETE_DATA || res == COMPLETE_NO_DATA;
+}
+
+/*
+ * Returns the bytes to be parsed. If no data is buffered from previous segments,
+ * the incoming segment is parsed in place, otherwise it is appended to the buffer
+ */
+std::string_view prepareData(std::string_view inPacket, std::string& storedData, bool& inPlace)
 {
-    std::vector<std::string> lines = simu5g::utils::splitString(data, "\r\n");
-    std::vector<std::string>::iterator it = lines.begin();
-    std::vector<std::string> line;
+    inPlace = storedData.empty();
+    if (inPlace)
+        return inPacket;
+    storedData.append(inPacket);
+    return storedData;
+}
+
+/*
+ * Keeps the bytes not consumed yet for the next segment. The buffer is compacted
+ * once per segment, and it keeps its capacity across segments
+ */
+void storeRemainingData(std::string_view data, size_t pos, bool inPlace, std::string& storedData)
+{
+    if (inPlace)
+        storedData.assign(data.substr(pos));
+    else
+        storedData.erase(0, pos);
+}
+
+} // namespace
+
+HttpBaseMessage *parseHeader(std::string_view data)
+{
+    std::string_view lines = data;
+    std::string_view line[5];
+    size_t numTokens;
     EV << "httpUtils::parseHeader - Header: " << data << endl;
 
     // Request-Line: Method SP Request-URI SP HTTP-Version CRLF
     // Status-Line: HTTP-Version SP Status-Code SP Reason-Phrase CRLF
 
-    line = simu5g::utils::splitString(*it, " ");
+    numTokens = splitView(nextLine(lines), " ", line, 5);
 
     /* it may be a request or a response, so the first line is different
      *
@@ -76,33 +182,34 @@ HttpBaseMessage *parseHeader(const std::string& data)
      */
 
     // if the first word is not HTTP/1.1 nor HTTP/2 (NOTE: assuming the HTTP is correct ---> it is a request)
-    if (!checkHttpVersion(line[0])) {
+    if (numTokens == 0 || !checkHttpVersion(line[0])) {
         EV << "httpUtils::parseHeader - It is a request" << endl;
         // It is a request
         HttpRequestMessage *httpRequest = new HttpRequestMessage();
         // request line is: VERB uri HTTPversion
-        if (line.size() == 3) {
+        if (numTokens == 3) {
             httpRequest->setType(REQUEST);
             if (!checkHttpRequestMethod(line[0])) {
                 httpRequest->setState(BAD_REQ_METHOD);
                 return httpRequest;
             }
-            httpRequest->setMethod(line[0].c_str());
+            httpRequest->setMethod(std::string(line[0]).c_str());
 
             /*
              * get URI and parameters
              */
-            std::vector<std::string> uriParams = cStringTokenizer(line[1].c_str(), "?").asVector();
-            if (uriParams.size() == 2) {
+            std::string_view uriParams[2];
+            size_t numUriParams = splitView(line[1], "?", uriParams, 2);
+            if (numUriParams == 2) {
                 // debug
                 EV << "httpUtils::parseHeader - There are parameters" << endl;
-                httpRequest->setUri(uriParams[0].c_str());
-                httpRequest->setParameters(uriParams[1].c_str());
+                httpRequest->setUri(std::string(uriParams[0]).c_str());
+                httpRequest->setParameters(std::string(uriParams[1]).c_str());
             }
-            else if (uriParams.size() == 1) {
+            else if (numUriParams == 1) {
                 // debug
                 EV << "httpUtils::parseHeader - There are no parameters" << endl;
-                httpRequest->setUri(uriParams[0].c_str());
+                httpRequest->setUri(std::string(uriParams[0]).c_str());
             }
             else {
                 //debug
@@ -115,7 +222,7 @@ HttpBaseMessage *parseHeader(const std::string& data)
                 httpRequest->setState(BAD_HTTP);
                 return httpRequest;
             }
-            httpRequest->setHttpProtocol(line[2].c_str());
+            httpRequest->setHttpProtocol(std::string(line[2]).c_str());
         }
         else {
             httpRequest->setState(BAD_REQ_LINE);
@@ -123,29 +230,29 @@ HttpBaseMessage *parseHeader(const std::string& data)
         }
 
         // read for headers
-        for (++it; it != lines.end(); ++it) {
-            line = simu5g::utils::splitString(*it, ": ");
-            if (line.size() == 2) {
+        for (std::string_view headerLine = nextLine(lines); !headerLine.empty(); headerLine = nextLine(lines)) {
+            if (splitView(headerLine, ": ", line, 2) == 2) {
+                std::string value(line[1]);
                 if (line[0] == "Content-Length") {
-                    EV << "httpUtils::parseHeader - Content-Length: " << line[1] << endl;
-                    httpRequest->setContentLength(std::stoi(line[1]));
-                    httpRequest->setRemainingDataToRecv(std::stoi(line[1]));
+                    EV << "httpUtils::parseHeader - Content-Length: " << value << endl;
+                    httpRequest->setContentLength(std::stoi(value));
+                    httpRequest->setRemainingDataToRecv(std::stoi(value));
                 }
                 else if (line[0] == "Content-Type") {
-                    EV << "httpUtils::parseHeader - Content-Type: " << line[1] << endl;
-                    httpRequest->setContentType(line[1].c_str());
+                    EV << "httpUtils::parseHeader - Content-Type: " << value << endl;
+                    httpRequest->setContentType(value.c_str());
                 }
                 else if (line[0] == "Host") {
-                    EV << "httpUtils::parseHeader - Host: " << line[1] << endl;
-                    httpRequest->setHost(line[1].c_str());
+                    EV << "httpUtils::parseHeader - Host: " << value << endl;
+                    httpRequest->setHost(value.c_str());
                 }
                 else if (line[0] == "Connection") {
-                    EV << "httpUtils::parseHeader - Connection: " << line[1] << endl;
-                    httpRequest->setConnection(line[1].c_str());
+                    EV << "httpUtils::parseHeader - Connection: " << value << endl;
+                    httpRequest->setConnection(value.c_str());
                 }
                 else {
-                    EV << "httpUtils::parseHeader - Header: " << line[1] << ": " << line[0] << endl;
-                    httpRequest->setHeaderField(line[0], line[1]);
+                    EV << "httpUtils::parseHeader - Header: " << value << ": " << line[0] << endl;
+                    httpRequest->setHeaderField(std::string(line[0]), value);
                 }
             }
             else {
@@ -162,27 +269,20 @@ HttpBaseMessage *parseHeader(const std::string& data)
         HttpResponseMessage *httpResponse = new HttpResponseMessage();
         httpResponse->setType(RESPONSE);
 
-        if (line.size() < 3 || line.size() > 5) {
+        if (numTokens < 3 || numTokens > 5) {
             EV << "httpUtils::parseHeader - BAD_RES_LINE" << endl;
             httpResponse->setState(BAD_RES_LINE);
             return httpResponse;
         }
 
         // response line is: HTTPversion code reason
-        if (!checkHttpVersion(line[0])) {
-            EV << "httpUtils::parseHeader - BAD_HTTP" << endl;
-            httpResponse->setState(BAD_HTTP);
-            return httpResponse;
-        }
-
-        httpResponse->setHttpProtocol(line[0].c_str());
-        httpResponse->setCode(std::stoi(line[1]));
+        httpResponse->setHttpProtocol(std::string(line[0]).c_str());
+        httpResponse->setCode(std::stoi(std::string(line[1])));
 
         std::string reason;
-        int size = line.size();
-        for (int i = 2; i < size; ++i) {
+        for (size_t i = 2; i < numTokens; ++i) {
             reason += line[i];
-            if (i != size - 1)
+            if (i != numTokens - 1)
                 reason += " ";
         }
 
@@ -190,25 +290,25 @@ HttpBaseMessage *parseHeader(const std::string& data)
         EV << "httpUtils::parseHeader - code " << httpResponse->getCode() << endl;
 
         // read for headers
-        for (++it; it != lines.end(); ++it) {
-            line = simu5g::utils::splitString(*it, ": ");
-            if (line.size() == 2) {
+        for (std::string_view headerLine = nextLine(lines); !headerLine.empty(); headerLine = nextLine(lines)) {
+            if (splitView(headerLine, ": ", line, 2) == 2) {
+                std::string value(line[1]);
                 if (line[0] == "Content-Length") {
-                    EV << "httpUtils::parseHeader - Content-Length: " << line[1] << endl;
-                    httpResponse->setContentLength(std::stoi(line[1]));
-                    httpResponse->setRemainingDataToRecv(std::stoi(line[1]));
+                    EV << "httpUtils::parseHeader - Content-Length: " << value << endl;
+                    httpResponse->setContentLength(std::stoi(value));
+                    httpResponse->setRemainingDataToRecv(std::stoi(value));
                 }
                 else if (line[0] == "Content-Type") {
-                    EV << "httpUtils::parseHeader - Content-Type: " << line[1] << endl;
-                    httpResponse->setContentType(line[1].c_str());
+                    EV << "httpUtils::parseHeader - Content-Type: " << value << endl;
+                    httpResponse->setContentType(value.c_str());
                 }
                 else if (line[0] == "Connection") {
-                    EV << "httpUtils::parseHeader - Connection: " << line[1] << endl;
-                    httpResponse->setConnection(line[1].c_str());
+                    EV << "httpUtils::parseHeader - Connection: " << value << endl;
+                    httpResponse->setConnection(value.c_str());
                 }
                 else {
-                    EV << "httpUtils::parseHeader - Header: " << line[1] << ": " << line[0] << endl;
-                    httpResponse->setHeaderField(line[0], line[1]);
+                    EV << "httpUtils::parseHeader - Header: " << value << ": " << line[0] << endl;
+                    httpResponse->setHeaderField(std::string(line[0]), value);
                 }
             }
             else {
@@ -221,179 +321,72 @@ HttpBaseMessage *parseHeader(const std::string& data)
     }
 }
 
-HttpMsgState parseTcpData(std::string& data, HttpBaseMessage *httpMessage)
+HttpMsgState parseTcpData(std::string_view data, size_t& pos, HttpBaseMessage *httpMessage)
 {
     if (httpMessage == nullptr)
         throw cRuntimeError("httpUtils parseTcpData - httpMessage must not be null");
 
     httpMessage->setIsReceivingMsg(true);
-    addBodyChunk(data, httpMessage);
-
-    if (data.length() == 0 && httpMessage->getRemainingDataToRecv() == 0)
-        return COMPLETE_NO_DATA;
-    else if (data.length() > 0 && httpMessage->getRemainingDataToRecv() == 0)
-        return COMPLETE_DATA; // there is a new message
-    else if (data.length() == 0 && httpMessage->getRemainingDataToRecv() > 0)
-        return INCOMPLETE_NO_DATA; //
-    else if (data.length() >= 0 && httpMessage->getRemainingDataToRecv() > 0)
-        return INCOMPLETE_DATA; // this should not happen
+    pos += addBodyChunk(data.substr(pos), httpMessage);
+
+    if (httpMessage->getRemainingDataToRecv() == 0) {
+        // the message is complete, following bytes (if any) belong to a new message
+        httpMessage->setIsReceivingMsg(false);
+        return pos < data.size() ? COMPLETE_DATA : COMPLETE_NO_DATA;
+    }
+    else if (httpMessage->getRemainingDataToRecv() > 0) {
+        // the whole data has been consumed by the body
+        return INCOMPLETE_NO_DATA;
+    }
     else {
-        throw cRuntimeError("httpUtils parseTcpData - something went wrong: data length: %lu and remaining data to receive: %d", data.length(), httpMessage->getRemainingDataToRecv());
+        throw cRuntimeError("httpUtils parseTcpData - something went wrong: data length: %zu and remaining data to receive: %d", data.size() - pos, httpMessage->getRemainingDataToRecv());
     }
 }
 
-bool parseReceivedMsg(const std::string& inPacket, std::string& storedData, HttpBaseMessage *& currentHttpMessage)
+bool parseReceivedMsg(std::string_view inPacket, std::string& storedData, HttpBaseMessage *& currentHttpMessage)
 {
     EV_INFO << "httpUtils::parseReceivedMsg- start..." << endl;
-    std::string delimiter = "\r\n\r\n";
-    size_t pos = 0;
-    std::string header;
-    std::string packet(inPacket);
-    if (currentHttpMessage != nullptr && currentHttpMessage->isReceivingMsg()) {
-        EV << "MecAppBase::parseReceivedMsg - Continue receiving data for the current HttpMessage" << endl;
-        Http::HttpMsgState res = Http::parseTcpData(packet, currentHttpMessage);
-        switch (res) {
-            case (Http::COMPLETE_NO_DATA):
-                EV << "MecAppBase::parseReceivedMsg - passing HttpMessage to application: " << res << endl;
-                return true;
-            case (Http::COMPLETE_DATA):
-                throw cRuntimeError("httpUtils parseReceivedMsg - This function does not support multiple HTTP messages in one segment");
-                break;
-            case (Http::INCOMPLETE_DATA):
-                throw cRuntimeError("httpUtils parseReceivedMsg - current Http Message is incomplete, but there is still data to read");
-            case (Http::INCOMPLETE_NO_DATA):
-                return false;
-        }
-    }
-
-    /*
-     * If I get here OR:
-     *  - I am not receiving an http message
-     *  - I was receiving an http message but I still have data (i.e a new HttpMessage) to manage.
-     *    Start reading the header
-     */
 
-    std::string temp;
-    if (storedData.length() > 0) {
-        EV << "MecAppBase::parseReceivedMsg - buffered data" << endl;
-        temp = packet;
-        packet = storedData + temp;
+    // the last completed message has not been consumed by the application yet,
+    // so just keep the data until it is done
+    if (currentHttpMessage != nullptr && !currentHttpMessage->isReceivingMsg()) {
+        EV << "httpUtils::parseReceivedMsg - previous HttpMessage still pending, buffering data" << endl;
+        storedData.append(inPacket);
+        return false;
     }
 
-    while ((pos = packet.find(delimiter)) != std::string::npos) {
-        EV << "MecAppBase::parseReceivedMsg - new HTTP message" << endl;
-        header = packet.substr(0, pos);
-        packet.erase(0, pos + delimiter.length()); //remove header
-        currentHttpMessage = Http::parseHeader(header);
-
-        Http::HttpMsgState res = Http::parseTcpData(packet, currentHttpMessage);
-
-        switch (res) {
-            case (Http::COMPLETE_NO_DATA):
-                EV << "MecAppBase::parseReceivedMsg - passing HttpMessage to application: " << res << endl;
-                return true;
-            case (Http::COMPLETE_DATA):
-                throw cRuntimeError("httpUtils parseReceivedMsg - This function does not support multiple HTTP messages in one segment");
-            case (Http::INCOMPLETE_DATA):
-                throw cRuntimeError("httpUtils parseReceivedMsg - current Http Message is incomplete, but there is still data to read");
-            case (Http::INCOMPLETE_NO_DATA):
-                return false;
-        }
-    }
+    bool inPlace;
+    std::string_view data = prepareData(inPacket, storedData, inPlace);
+    size_t pos = 0;
+
+    bool completeMsg = parseNextMsg(data, pos, currentHttpMessage);
+    if (completeMsg)
+        EV << "httpUtils::parseReceivedMsg - passing HttpMessage to application" << endl;
 
     /*
-     * If I did not find the delimiter ("\r\n\r\n")
-     * it could mean that the HTTP message is fragmented at the header, so the data
-     * should be saved and aggregated with the subsequent fragmented
+     * Data not consumed is either a fragmented header, which will be aggregated
+     * with the subsequent segments, or pipelined messages, which are parsed at the
+     * next call
      */
-    if (packet.length() != 0) {
-        EV << "MecAppBase::parseReceivedMsg - stored data: " << packet << endl;
-        storedData = packet;
-        return false;
-    }
-    return false;
+    storeRemainingData(data, pos, inPlace, storedData);
+    return completeMsg;
 }
 
-bool parseReceivedMsg(int socketId, const std::string& inPacket, cQueue& messageQueue, std::string& storedData, HttpBaseMessage *& currentHttpMessage)
+bool parseReceivedMsg(int socketId, std::string_view inPacket, cQueue& messageQueue, std::string& storedData, HttpBaseMessage *& currentHttpMessage)
 {
     EV_INFO << "httpUtils::parseReceivedMsg" << endl;
-    //std::cout << "MecAppBase::parseReceivedMsg" << std::endl;
-    //std::cout << "MecAppBase::parseReceivedMsg MSG :" << packet << std::endl;
 
-    std::string delimiter = "\r\n\r\n";
+    bool inPlace;
+    std::string_view data = prepareData(inPacket, storedData, inPlace);
     size_t pos = 0;
-    std::string header;
-    std::string packet(inPacket);
     bool completeMsg = false;
 
-    // continue receiving the message
-    if (currentHttpMessage != nullptr && currentHttpMessage->isReceivingMsg()) {
-        // EV << "MecAppBase::parseReceivedMsg - Continue receiving data for the current HttpMessage" << endl;
-        Http::HttpMsgState res = Http::parseTcpData(packet, currentHttpMessage);
-        switch (res) {
-            case (Http::COMPLETE_NO_DATA):
-                // EV << "MecAppBase::parseReceivedMsg - passing HttpMessage to application: " << res << endl;
-                currentHttpMessage->setSockId(socketId);
-                messageQueue.insert(currentHttpMessage);
-                completeMsg = true;
-                currentHttpMessage = nullptr;
-                return completeMsg;
-            case (Http::COMPLETE_DATA):
-                // EV << "MecAppBase::parseReceivedMsg - passing HttpMessage to application: " << res << endl;
-                currentHttpMessage->setSockId(socketId);
-                messageQueue.insert(currentHttpMessage);
-                completeMsg = true;
-                currentHttpMessage = nullptr;
-                break;
-            case (Http::INCOMPLETE_DATA):
-                throw cRuntimeError("httpUtils parseReceivedMsg - current Http Message is incomplete, but there is still data to read");
-            case (Http::INCOMPLETE_NO_DATA):
-                return completeMsg;
-        }
-    }
-
-    /*
-     * If I get here OR:
-     *  - I am not receiving an http message
-     *  - I was receiving an http message but I still have data (i.e a new HttpMessage) to manage.
-     *    Start reading the header
-     */
-
-    std::string temp;
-    if (storedData.length() > 0) {
-        // EV << "MecAppBase::parseReceivedMsg - buffered data" << endl;
-        //std::cout << "MecAppBase::parseReceivedMsg - buffered data" << std::endl;
-        //std::cout << "MecAppBase::parseReceivedMsg buffered data" << storedData  << std::endl;
-
-        temp = packet;
-        packet = storedData + temp;
-        storedData.clear();
-    }
-
-    while ((pos = packet.find(delimiter)) != std::string::npos) {
-        header = packet.substr(0, pos);
-        packet.erase(0, pos + delimiter.length()); //remove header
-        currentHttpMessage = Http::parseHeader(header);
-
-        Http::HttpMsgState res = Http::parseTcpData(packet, currentHttpMessage);
-        switch (res) {
-            case (Http::COMPLETE_NO_DATA):
-                currentHttpMessage->setSockId(socketId);
-                messageQueue.insert(currentHttpMessage);
-                completeMsg = true;
-                currentHttpMessage = nullptr;
-                return completeMsg;
-            case (Http::COMPLETE_DATA):
-                currentHttpMessage->setSockId(socketId);
-                messageQueue.insert(currentHttpMessage);
-                completeMsg = true;
-                currentHttpMessage = nullptr;
-                break;
-            case (Http::INCOMPLETE_DATA):
-                throw cRuntimeError("httpUtils parseReceivedMsg - current Http Message is incomplete, but there is still data to read");
-            case (Http::INCOMPLETE_NO_DATA):
-                return completeMsg;
-        }
+    // extract all the pipelined messages within the data
+    while (pos < data.size() && parseNextMsg(data, pos, currentHttpMessage)) {
+        currentHttpMessage->setSockId(socketId);
+        messageQueue.insert(currentHttpMessage);
+        completeMsg = true;
+        currentHttpMessage = nullptr;
     }
 
     /*
@@ -401,37 +394,35 @@ bool parseReceivedMsg(int socketId, const std::string& inPacket, cQueue& message
      * it could mean that the HTTP message is fragmented at the header, so the data
      * should be saved and aggregated with the subsequent fragmented
      */
-    if (packet.length() != 0) {
-        storedData = packet;
-        return completeMsg;
-    }
-    return true;
+    storeRemainingData(data, pos, inPlace, storedData);
+    return completeMsg;
 }
 
-void addBodyChunk(std::string& data, HttpBaseMessage *httpMessage)
+size_t addBodyChunk(std::string_view data, HttpBaseMessage *httpMessage)
 {
-    int len = data.length();
+    size_t len = data.length();
     int remainingLength = httpMessage->getRemainingDataToRecv();
-    if (remainingLength == 0 && len == 0) {
+    if (remainingLength == 0 || len == 0) {
         EV << "httpUtils::addBodyChunk - no body" << endl;
-        return;
+        return 0;
     }
     EV << "httpUtils - addBodyChunk: data length: " << len << "B. Remaining bytes: " << remainingLength << endl;
 
+    size_t chunkLength = std::min(len, (size_t)remainingLength);
     if (httpMessage->getType() == RESPONSE) {
         EV << "httpUtils::addBodyChunk - RESPONSE " << endl;
         HttpResponseMessage *resp = dynamic_cast<HttpResponseMessage *>(httpMessage);
-        resp->addBodyChunk(data.substr(0, remainingLength));
+        resp->addBodyChunk(std::string(data.substr(0, chunkLength)));
     }
     else if (httpMessage->getType() == REQUEST) {
         EV << "httpUtils::addBodyChunk - REQUEST " << endl;
         HttpRequestMessage *resp = dynamic_cast<HttpRequestMessage *>(httpMessage);
-        resp->addBodyChunk(data.substr(0, remainingLength));
+        resp->addBodyChunk(std::string(data.substr(0, chunkLength)));
     }
 
-    data.erase(0, remainingLength);
-    httpMessage->setRemainingDataToRecv(remainingLength - (len - data.length()));
+    httpMessage->setRemainingDataToRecv(remainingLength - chunkLength);
     EV << "httpUtils - addBodyChunk: Remaining bytes: " << httpMessage->getRemainingDataToRecv() << endl;
+    return chunkLength;
 }
 
 void sendHttpResponse(inet::TcpSocket *socket, int code, const char *reason, const char *body)
@@ -447,9 +438,10 @@ void sendHttpResponse(inet::TcpSocket *socket, int code, const char *reason, con
         resPkt->setBody(body);
         resPkt->setContentLength(strlen(body));
     }
-    resPkt->setChunkLength(B(resPkt->getPayload().size()));
+    resPkt->setChunkLength(B(resPkt->getPayloadLength()));
     packet->insertAtBack(resPkt);
     socket->send(packet);
+    getMessageCounters().messagesSent++;
 }
 
 void sendHttpResponse(inet::TcpSocket *socket, int code, const char *reason, std::pair<std::string, std::string>& header, const char *body)
@@ -467,11 +459,12 @@ void sendHttpResponse(inet::TcpSocket *socket, int code, const char *reason, std
     }
     resPkt->setHeaderField(header.first, header.second);
 
-    resPkt->setChunkLength(B(resPkt->getPayload().size()));
+    resPkt->setChunkLength(B(resPkt->getPayloadLength()));
     resPkt->addTagIfAbsent<inet::CreationTimeTag>()->setCreationTime(simTime());
 
     packet->insertAtBack(resPkt);
     socket->send(packet);
+    getMessageCounters().messagesSent++;
 }
 
 void sendHttpResponse(inet::TcpSocket *socket, int code, const char *reason, std::map<std::string, std::string>& headers, const char *body)
@@ -490,11 +483,12 @@ void sendHttpResponse(inet::TcpSocket *socket, int code, const char *reason, std
         resPkt->setHeaderField(header.first, header.second);
     }
 
-    resPkt->setChunkLength(B(resPkt->getPayload().size()));
+    resPkt->setChunkLength(B(resPkt->getPayloadLength()));
     resPkt->addTagIfAbsent<inet::CreationTimeTag>()->setCreationTime(simTime());
 
     packet->insertAtBack(resPkt);
     socket->send(packet);
+    getMessageCounters().messagesSent++;
 }
 
 void sendHttpRequest(inet::TcpSocket *socket, const char *method, const char *host, const char *uri, const char *parameters, const char *body)
@@ -513,11 +507,12 @@ void sendHttpRequest(inet::TcpSocket *socket, const char *method, const char *ho
     if (parameters != nullptr) {
         reqPkt->setParameters(parameters);
     }
-    reqPkt->setChunkLength(B(reqPkt->getPayload().size())); // TODO get size more efficiently
+    reqPkt->setChunkLength(B(reqPkt->getPayloadLength()));
     reqPkt->addTagIfAbsent<inet::CreationTimeTag>()->setCreationTime(simTime());
 
     packet->insertAtBack(reqPkt);
     socket->send(packet);
+    getMessageCounters().messagesSent++;
 }
 
 void sendHttpRequest(inet::TcpSocket *socket, const char *method, const char *host, std::pair<std::string, std::string>& header, const char *uri, const char *parameters, const char *body)
@@ -537,11 +532,12 @@ void sendHttpRequest(inet::TcpSocket *socket, const char *method, const char *ho
         reqPkt->setParameters(parameters);
     }
     reqPkt->setHeaderField(header.first, header.second);
-    reqPkt->setChunkLength(B(reqPkt->getPayload().size()));
+    reqPkt->setChunkLength(B(reqPkt->getPayloadLength()));
     reqPkt->addTagIfAbsent<inet::CreationTimeTag>()->setCreationTime(simTime());
 
     packet->insertAtBack(reqPkt);
     socket->send(packet);
+    getMessageCounters().messagesSent++;
 }
 
 void sendHttpRequest(inet::TcpSocket *socket, const char *method, const char *host, std::map<std::string, std::string>& headers, const char *uri, const char *parameters, const char *body)
@@ -563,11 +559,12 @@ void sendHttpRequest(inet::TcpSocket *socket, const char *method, const char *ho
     for (const auto& header : headers) {
         reqPkt->setHeaderField(header.first, header.second);
     }
-    reqPkt->setChunkLength(B(reqPkt->getPayload().size()));
+    reqPkt->setChunkLength(B(reqPkt->getPayloadLength()));
     reqPkt->addTagIfAbsent<inet::CreationTimeTag>()->setCreationTime(simTime());
 
     packet->insertAtBack(reqPkt);
     socket->send(packet);
+    getMessageCounters().messagesSent++;
 }
 
 void send200Response(inet::TcpSocket *socket, const char *body) {
@@ -14,6 +14,7 @@
 #define __HTTPUTILS_H
 
 #include <string>
+#include <string_view>
 
 #include <inet/transportlayer/contract/tcp/TcpSocket.h>
 
@@ -83,6 +84,13 @@ struct ProblemDetailBase
 * strings into HttpBaseMessage is used.                                         *
 ********************************************************************************/
 
+/*
+ * Maximum size of an HTTP header. The bytes of a header fragmented over several
+ * TCP segments are buffered until the header is complete, so this bounds the
+ * memory used by each socket
+ */
+constexpr size_t MAX_HEADER_SIZE = 16384;
+
 /*
  * This function parses a string containing the HTTP header and returns a
  * HttpMessage according to whether it is a request or a response.
@@ -91,60 +99,96 @@ struct ProblemDetailBase
  * @return HttpBaseMessage pointer to a new HTTP message with a field
  * named HttpRequestState that labels the correctness of the message
  */
-HttpBaseMessage *parseHeader(const std::string& header);
+HttpBaseMessage *parseHeader(std::string_view header);
 
-HttpMsgState parseTcpData(std::string& data, HttpBaseMessage *httpMessage);
+/*
+ * This function reads the body of httpMessage from data, starting from pos.
+ * pos is advanced past the bytes belonging to httpMessage
+ * @return HttpMsgState - state of the HTTP message
+ */
+HttpMsgState parseTcpData(std::string_view data, size_t& pos, HttpBaseMessage *httpMessage);
 
 /*
- * This function adds body content (using addBodyChunk)  to a fragmented HTTP Message
- * @param data - string representing the body of a fragmented HTTP Message
+ * This function adds body content (using addBodyChunk) to a fragmented HTTP Message
+ * @param data - string starting with (part of) the body of a fragmented HTTP Message
  * @param httpMessage - HttpBaseMessage of the current message
- * @return HttpMsgState - state of the HTTP message
+ * @return size_t - number of bytes of data added to the body
  */
-void addBodyChunk(std::string& data, HttpBaseMessage *httpMessage);
+size_t addBodyChunk(std::string_view data, HttpBaseMessage *httpMessage);
 
 /*
  * This function parses an incoming message by calling the above functions,
  * i.e. parseHeader and parseTcpData.
+ * One message is returned per call. Bytes following a completed message are
+ * kept in storedData, and they are parsed at the next call (possibly with an empty
+ * inPacket) once the application has consumed the message and reset
+ * currentHttpMessage to nullptr.
  *
- * @param inPacket raw bytes as string of the incoming message
- * @param storedData pointer to a variable where to store undefined data (e.g. segmented header)
+ * @param inPacket raw bytes of the incoming segment
+ * @param storedData per-socket buffer where to store the data not parsed yet (e.g. segmented header)
  * @param currentHttpMessage variable for storing the current HTTP message
  * @return bool - if true the currentHttpMessage is completed and ready to be
  * processed by the application
  */
-bool parseReceivedMsg(const std::string& inPacket, std::string& storedData, HttpBaseMessage *& currentHttpMessage);
+bool parseReceivedMsg(std::string_view inPacket, std::string& storedData, HttpBaseMessage *& currentHttpMessage);
 
 /*
- *  WARNING: This function is not used in our scenarios, so it is not fully tested
- *
  * This function parses an incoming message by calling the above functions,
  * i.e. parseHeader and parseTcpData (as the parseReceivedMsg above), with the
- * addition of the management of TCP segments containing more than one HTTP message.
- * Every completed HTTP message is queued in the messageQueue.
+ * addition of the management of TCP segments containing more than one HTTP message
+ * (e.g. pipelined requests). Every completed HTTP message is queued in the messageQueue.
+ * The segment is parsed in place, and only the bytes of an incomplete header
+ * are copied to storedData.
  *
  * @param socketId needed to know to whom to send back the response
- * @param inPacket raw bytes as string of the incoming message
- * @param storedData reference to a variable where to store undefined data (e.g. segmented header)
+ * @param inPacket raw bytes of the incoming segment
+ * @param storedData per-socket buffer where to store the data not parsed yet (e.g. segmented header)
  * @param currentHttpMessage variable for storing the current HTTP message
  * @param messageQueue queue where to insert completed Http Messages
+ * @return bool - true if at least one message has been queued
  */
-bool parseReceivedMsg(int socketId, const std::string& inPacket, cQueue& messageQueue, std::string& storedData, HttpBaseMessage *& currentHttpMessage);
+bool parseReceivedMsg(int socketId, std::string_view inPacket, cQueue& messageQueue, std::string& storedData, HttpBaseMessage *& currentHttpMessage);
 
 /*************************************************************************************/
 
+/*
+ * Counters of the HTTP messages sent through the functions below, and of the memory
+ * allocations made to build serialized payloads, i.e., the strings holding a whole HTTP
+ * message. Payloads are built only when packets are serialized (e.g., in emulation), and
+ * no allocation is made when the output buffer can already hold them. The counters are
+ * global: modules interested in their own share can take the difference of two snapshots
+ */
+struct MessageCounters
+{
+    unsigned long messagesSent = 0;
+    unsigned long payloadAllocations = 0;
+};
+
+MessageCounters& getMessageCounters();
+
+/*
+ * Output of HttpRequestMessage/HttpResponseMessage serialization that only accumulates
+ * the length of the payload
+ */
+struct PayloadLength
+{
+    size_t length = 0;
+
+    void append(std::string_view data) { length += data.size(); }
+};
+
 void sendPacket(const char *pck, inet::TcpSocket *socket);
 
 /*
  * This function checks the version of the HTTP protocol used.
  * Supported versions: 1.1 and 2
  */
-bool checkHttpVersion(const std::string& httpVersion);
+bool checkHttpVersion(std::string_view httpVersion);
 /*
  * This function checks the method used in the HTTP request.
  * Supported methods: GET, POST, PUT, DELETE
  */
-bool checkHttpRequestMethod(const std::string& method);
+bool checkHttpRequestMethod(std::string_view method);
 
 /*
  * Self-explanatory functions to send HTTP requests and responses.
@@ -0,0 +1,193 @@
+//
+//                  Simu5G
+//
+// Copyright (C) 2019-2021 Giovanni Nardini, Giovanni Stea, Antonio Virdis et al. (University of Pisa)
+// Copyright (C) 2022-2026 Giovanni Nardini, Giovanni Stea et al. (University of Pisa)
+//
+// This file is part of a software released under the license included in file
+// "license.pdf". Please read LICENSE and README files before using it.
+// The above files and the present reference are part of the software itself,
+// and cannot be removed from it.
+//
+#include "simu5g/mec/vim/MecAppContainer.h"
+
+namespace simu5g {
+
+Define_Module(MecAppContainer);
+
+simsignal_t MecAppContainer::numInstancesSignal_ = registerSignal("numInstances");
+
+MecAppContainer::~MecAppContainer()
+{
+    for (auto& [mecAppId, instance] : instances_) {
+        for (auto timer : instance.timers)
+            cancelAndDelete(timer);
+        delete instance.app;
+    }
+    sockets_.deleteSockets();
+}
+
+void MecAppContainer::initialize(int stage)
+{
+    cSimpleModule::initialize(stage);
+
+    if (stage != inet::INITSTAGE_LOCAL)
+        return;
+
+    vim_.reference(this, "vimModule", true);
+    appParameters_ = check_and_cast<cValueMap *>(par("appParameters").objectValue());
+}
+
+void MecAppContainer::handleMessage(cMessage *msg)
+{
+    if (msg->isSelfMessage()) {
+        LightweightMecApp *app = static_cast<LightweightMecApp *>(msg->getContextPointer());
+        app->handleTimer(msg);
+        return;
+    }
+
+    inet::ISocket *socket = sockets_.findSocketFor(msg);
+    if (socket != nullptr)
+        socket->processMessage(msg);
+    else {
+        EV << "MecAppContainer::handleMessage - no instance for message " << msg->getName() << ", discarding it" << endl;
+        delete msg;
+    }
+}
+
+void MecAppContainer::finish()
+{
+    for (auto& [mecAppId, instance] : instances_)
+        instance.app->finish();
+}
+
+MecAppContainer::Instance& MecAppContainer::getInstance(LightweightMecApp *app)
+{
+    auto it = instances_.find(app->getMecAppId());
+    if (it == instances_.end() || it->second.app != app)
+        throw cRuntimeError("MecAppContainer::getInstance - MEC app %d is not hosted by this container", app->getMecAppId());
+    return it->second;
+}
+
+void MecAppContainer::createInstance(const char *className, const std::string& instanceId, int mecAppId, int localUePort, const ResourceDescriptor& resources)
+{
+    Enter_Method("createInstance");
+
+    if (instances_.find(mecAppId) != instances_.end())
+        throw cRuntimeError("MecAppContainer::createInstance - MEC app %d already instantiated", mecAppId);
+
+    LightweightMecApp *app = check_and_cast<LightweightMecApp *>(cObjectFactory::createOne(className));
+    app->container_ = this;
+    app->mecAppId_ = mecAppId;
+    app->localUePort_ = localUePort;
+    app->instanceId_ = instanceId;
+    app->resources_ = resources;
+
+    inet::UdpSocket *socket = new inet::UdpSocket();
+    socket->setOutputGate(gate("socketOut"));
+    socket->setCallback(this);
+    socket->bind(localUePort);
+    sockets_.addSocket(socket);
+    instanceBySocket_[socket->getSocketId()] = mecAppId;
+
+    Instance& instance = instances_[mecAppId];
+    instance.app = app;
+    instance.socket = socket;
+
+    EV << "MecAppContainer::createInstance - " << instanceId << " (" << className << ") listening on port " << localUePort << endl;
+    emit(numInstancesSignal_, (long)instances_.size());
+
+    app->initialize();
+}
+
+bool MecAppContainer::deleteInstance(int mecAppId)
+{
+    Enter_Method("deleteInstance");
+
+    auto it = instances_.find(mecAppId);
+    if (it == instances_.end())
+        return false;
+
+    Instance& instance = it->second;
+    instance.app->finish();
+    for (auto timer : instance.timers) {
+        if (vim_->isProcessing(timer))
+            vim_->cancelProcessingJob(timer);
+        cancelAndDelete(timer);
+    }
+    delete instance.app;
+
+    instanceBySocket_.erase(instance.socket->getSocketId());
+    instance.socket->close();
+    delete sockets_.removeSocket(instance.socket);
+    instances_.erase(it);
+
+    EV << "MecAppContainer::deleteInstance - MEC app " << mecAppId << " deleted" << endl;
+    emit(numInstancesSignal_, (long)instances_.size());
+    return true;
+}
+
+void MecAppContainer::socketDataArrived(inet::UdpSocket *socket, inet::Packet *packet)
+{
+    auto it = instanceBySocket_.find(socket->getSocketId());
+    if (it == instanceBySocket_.end()) {
+        delete packet;
+        return;
+    }
+    instances_.at(it->second).app->handleUePacket(packet);
+}
+
+void MecAppContainer::socketErrorArrived(inet::UdpSocket *socket, inet::Indication *indication)
+{
+    EV_WARN << "MecAppContainer::socketErrorArrived - ignoring UDP error report " << indication->getName() << endl;
+    delete indication;
+}
+
+void MecAppContainer::sendToUe(LightweightMecApp *app, inet::Packet *packet, const inet::L3Address& address, int port)
+{
+    getInstance(app).socket->sendTo(packet, address, port);
+}
+
+cMessage *MecAppContainer::createTimer(LightweightMecApp *app, const char *name)
+{
+    cMessage *msg = new cMessage(name);
+    msg->setContextPointer(app);
+    getInstance(app).timers.insert(msg);
+    return msg;
+}
+
+void MecAppContainer::scheduleTimer(cMessage *msg, simtime_t delay)
+{
+    scheduleAt(simTime() + delay, msg);
+}
+
+void MecAppContainer::cancelTimer(cMessage *msg)
+{
+    if (msg->isScheduled())
+        cancelEvent(msg);
+    else if (vim_->isProcessing(msg))
+        vim_->cancelProcessingJob(msg);
+}
+
+void MecAppContainer::scheduleProcessing(LightweightMecApp *app, cMessage *msg, double processingTime)
+{
+    if (vim_->isProcessorSharing())
+        vim_->startProcessingJob(this, app->getMecAppId(), processingTime, msg);
+    else
+        scheduleAt(simTime() + processingTime, msg);
+}
+
+void MecAppContainer::processingCompleted(cMessage *msg)
+{
+    Enter_Method_Silent("processingCompleted");
+    scheduleAt(simTime(), msg);
+}
+
+cValue MecAppContainer::getAppParameter(const char *name, const cValue& defaultValue) const
+{
+    if (appParameters_ != nullptr && appParameters_->containsKey(name))
+        return appParameters_->get(name);
+    return defaultValue;
+}
+
+} //namespace
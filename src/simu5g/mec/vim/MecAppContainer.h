@@ -0,0 +1,154 @@
+//
+//                  Simu5G
+//
+// Copyright (C) 2019-2021 Giovanni Nardini, Giovanni Stea, Antonio Virdis et al. (University of Pisa)
+// Copyright (C) 2022-2026 Giovanni Nardini, Giovanni Stea et al. (University of Pisa)
+//
+// This file is part of a software released under the license included in file
+// "license.pdf". Please read LICENSE and README files before using it.
+// The above files and the present reference are part of the software itself,
+// and cannot be removed from it.
+//
+#ifndef __MECAPPCONTAINER_H_
+#define __MECAPPCONTAINER_H_
+
+#include <map>
+#include <set>
+
+#include <inet/common/ModuleRefByPar.h>
+#include <inet/common/socket/SocketMap.h>
+#include <inet/transportlayer/contract/udp/UdpSocket.h>
+
+#include "simu5g/mec/utils/MecCommon.h"
+#include "simu5g/mec/vim/VirtualisationInfrastructureManager.h"
+
+namespace simu5g {
+
+using namespace omnetpp;
+
+class MecAppContainer;
+
+//
+// LightweightMecApp
+//
+// Base class for MEC applications hosted by a MecAppContainer. A lightweight MEC app
+// is a plain object rather than a module: it receives the packets sent by its UE app
+// and uses the services of the container (timers, UE socket, processing time).
+// All the methods are called within the context of the container module.
+// Subclasses must be registered with Register_Class() and are referenced by their
+// class name in the containerAppClass field of the application descriptor.
+//
+class LightweightMecApp : public cObject
+{
+    friend class MecAppContainer;
+
+  protected:
+    MecAppContainer *container_ = nullptr;
+    int mecAppId_ = -1;
+    int localUePort_ = -1;
+    std::string instanceId_;
+    ResourceDescriptor resources_;
+
+  public:
+    // called once the app has been created and its UE socket has been bound
+    virtual void initialize() {}
+
+    // called for every packet received from the UE app. The app takes ownership of the packet
+    virtual void handleUePacket(inet::Packet *packet) = 0;
+
+    // called when a timer created through the container expires
+    virtual void handleTimer(cMessage *msg) {}
+
+    // called before the app is deleted
+    virtual void finish() {}
+
+    int getMecAppId() const { return mecAppId_; }
+    int getLocalUePort() const { return localUePort_; }
+    const std::string& getInstanceId() const { return instanceId_; }
+};
+
+//
+// MecAppContainer
+//
+// Hosts many lightweight MEC app instances inside a single module of the MEC host, so
+// that instantiating and terminating a MEC app does not require creating, connecting
+// and deleting a module. The container owns one UDP socket per instance, bound to the
+// port assigned by the VIM, and dispatches the incoming packets and the expired timers
+// to the corresponding instance.
+//
+class MecAppContainer : public cSimpleModule, public inet::UdpSocket::ICallback, public IProcessingJobOwner
+{
+  protected:
+    struct Instance
+    {
+        LightweightMecApp *app = nullptr;
+        inet::UdpSocket *socket = nullptr;
+        std::set<cMessage *> timers; // timers created by the app, deleted with it
+    };
+
+    // key = MEC app id
+    std::map<int, Instance> instances_;
+
+    // socket id -> MEC app id
+    std::map<int, int> instanceBySocket_;
+    inet::SocketMap sockets_;
+
+    inet::ModuleRefByPar<VirtualisationInfrastructureManager> vim_;
+
+    // parameters made available to the hosted apps
+    const cValueMap *appParameters_ = nullptr;
+
+    static simsignal_t numInstancesSignal_;
+
+    int numInitStages() const override { return inet::NUM_INIT_STAGES; }
+    void initialize(int stage) override;
+    void handleMessage(cMessage *msg) override;
+    void finish() override;
+
+    Instance& getInstance(LightweightMecApp *app);
+
+    /* inet::UdpSocket::ICallback callback methods */
+    void socketDataArrived(inet::UdpSocket *socket, inet::Packet *packet) override;
+    void socketErrorArrived(inet::UdpSocket *socket, inet::Indication *indication) override;
+    void socketClosed(inet::UdpSocket *socket) override {}
+
+  public:
+    ~MecAppContainer() override;
+
+    /*
+     * Methods called by the VIM to create/delete an instance
+     *
+     * @param className registered class name of the lightweight MEC app
+     * @param instanceId, mecAppId identifiers of the MEC app
+     * @param localUePort port where the app receives packets from the UE app
+     * @param resources resources allocated to the MEC app
+     */
+    void createInstance(const char *className, const std::string& instanceId, int mecAppId, int localUePort, const ResourceDescriptor& resources);
+    bool deleteInstance(int mecAppId);
+    int getNumInstances() const { return instances_.size(); }
+
+    /*
+     * Services for the hosted apps
+     */
+    void sendToUe(LightweightMecApp *app, inet::Packet *packet, const inet::L3Address& address, int port);
+
+    // timers are owned by the container and deleted together with the app
+    cMessage *createTimer(LightweightMecApp *app, const char *name);
+    void scheduleTimer(cMessage *msg, simtime_t delay);
+    void cancelTimer(cMessage *msg);
+
+    // same as MecAppBase::scheduleProcessing(), the timer is delivered after the processing time
+    void scheduleProcessing(LightweightMecApp *app, cMessage *msg, double processingTime);
+
+    VirtualisationInfrastructureManager *getVim() const { return vim_.get(); }
+
+    // returns the value of the given entry of the appParameters map, or defaultValue if not present
+    cValue getAppParameter(const char *name, const cValue& defaultValue) const;
+
+    /* IProcessingJobOwner callback method */
+    void processingCompleted(cMessage *msg) override;
+};
+
+} //namespace
+
+#endif
@@ -9,8 +9,12 @@
 // The above files and the present reference are part of the software itself,
 // and cannot be removed from it.
 //
+#include <algorithm>
+#include <vector>
+
 #include <inet/networklayer/common/L3AddressResolver.h>
 #include "simu5g/mec/vim/VirtualisationInfrastructureManager.h"
+#include "simu5g/mec/vim/MecAppContainer.h"
 #include "simu5g/mec/ualcmp/messages/UalcmpMessages_m.h"
 #include "simu5g/mec/orchestrator/messages/MecOrchestratorMessages_m.h"
 
@@ -18,6 +22,13 @@ namespace simu5g {
 
 Define_Module(VirtualisationInfrastructureManager);
 
+simsignal_t VirtualisationInfrastructureManager::processingJobsSignal_ = registerSignal("processingJobs");
+
+VirtualisationInfrastructureManager::~VirtualisationInfrastructureManager()
+{
+    cancelAndDelete(jobTimer_);
+}
+
 void VirtualisationInfrastructureManager::initialize(int stage)
 {
     cSimpleModule::initialize(stage);
@@ -58,6 +69,11 @@ void VirtualisationInfrastructureManager::initialize(int stage)
         EV << "VirtualisationInfrastructureManager::initialize - scheduling mode is: fair" << endl;
         scheduling = FAIR_SHARING;
     }
+    else if (strcmp(schedulingMode, "processorSharing") == 0) {
+        EV << "VirtualisationInfrastructureManager::initialize - scheduling mode is: processor sharing" << endl;
+        scheduling = PROCESSOR_SHARING;
+        jobTimer_ = new cMessage("jobTimer");
+    }
     else {
         EV << "VirtualisationInfrastructureManager::initialize - scheduling mode: " << schedulingMode << " not recognized. Using default mode: segregation" << endl;
         scheduling = SEGREGATION;
@@ -109,8 +125,11 @@ void VirtualisationInfrastructureManager::initialize(int stage)
 
 void VirtualisationInfrastructureManager::handleMessage(cMessage *msg)
 {
-    if (msg->isSelfMessage())
+    if (msg->isSelfMessage()) {
+        if (msg == jobTimer_)
+            handleJobCompletion();
         return;
+    }
 }
 
 bool VirtualisationInfrastructureManager::instantiateEmulatedMEApp(CreateAppMessage *msg)
@@ -176,6 +195,9 @@ MecAppInstanceInfo *VirtualisationInfrastructureManager::instantiateMEApp(Create
 {
     EV << "VirtualisationInfrastructureManager::instantiateMEApp - processing..." << endl;
 
+    if (strlen(msg->getContainerAppClass()) > 0)
+        return instantiateContainerMEApp(msg);
+
     int serviceIndex = findService(msg->getRequiredService());
 
     //retrieve UE App ID
@@ -323,6 +345,78 @@ MecAppInstanceInfo *VirtualisationInfrastructureManager::instantiateMEApp(Create
     }
 }
 
+MecAppInstanceInfo *VirtualisationInfrastructureManager::instantiateContainerMEApp(CreateAppMessage *msg)
+{
+    MecAppContainer *container = check_and_cast_nullable<MecAppContainer *>(mecHost->getSubmodule("mecAppContainer"));
+    if (container == nullptr)
+        throw cRuntimeError("VirtualisationInfrastructureManager::instantiateContainerMEApp - the MEC host has no mecAppContainer module");
+
+    int ueAppID = msg->getUeAppID();
+
+    MecAppInstanceInfo *instanceInfo = new MecAppInstanceInfo();
+    instanceInfo->status = false;
+
+    // lightweight MEC apps do not use any gate of the VI, hence they are not limited by maxMecApps
+    if (mecAppMap.find(ueAppID) != mecAppMap.end())
+        return instanceInfo;
+
+    double ram = msg->getRequiredRam();
+    double disk = msg->getRequiredDisk();
+    double cpu = msg->getRequiredCpu();
+
+    if (ram < maxRam - allocatedRam && disk < maxDisk - allocatedDisk && cpu < maxCPU - allocatedCPU)
+        allocateResources(ram, disk, cpu);
+    else {
+        EV << "VirtualisationInfrastructureManager::instantiateContainerMEApp - MEC Application with required resources:\n" <<
+            "ram: " << ram << endl <<
+            "disk: " << disk << endl <<
+            "cpu: " << cpu << endl <<
+            "cannot be instantiated due to unavailable resources" << endl;
+        return instanceInfo;
+    }
+
+    std::string appName = opp_stringf("%s-%04d", msg->getMEModuleName(), nameCounter++);
+
+    MecAppEntry newAppEntry;
+    newAppEntry.meAppGateIndex = -1;
+    newAppEntry.serviceIndex = NO_SERVICE;
+    newAppEntry.meAppModule = container;
+    newAppEntry.ueAppID = ueAppID;
+    newAppEntry.meAppPort = mecAppPortCounter;
+    newAppEntry.resources.ram = ram;
+    newAppEntry.resources.disk = disk;
+    newAppEntry.resources.cpu = cpu;
+    newAppEntry.inContainer = true;
+    mecAppMap.insert({ueAppID, newAppEntry});
+
+    container->createInstance(msg->getContainerAppClass(), appName, ueAppID, mecAppPortCounter, newAppEntry.resources);
+
+    instanceInfo->status = true;
+    instanceInfo->instanceId = appName;
+    instanceInfo->endPoint.addr = mecAppRemoteAddress_;
+    instanceInfo->endPoint.port = mecAppPortCounter;
+    instanceInfo->reference = container;
+
+    mecAppPortCounter++;
+
+    EV << "VirtualisationInfrastructureManager::instantiateContainerMEApp - " << appName << " instantiated in " << container->getFullPath() << " (" << container->getNumInstances() << " instances)" << endl;
+    return instanceInfo;
+}
+
+bool VirtualisationInfrastructureManager::terminateContainerMEApp(int ueAppID)
+{
+    auto it = mecAppMap.find(ueAppID);
+    MecAppContainer *container = check_and_cast<MecAppContainer *>(it->second.meAppModule.get());
+
+    cancelProcessingJobs(ueAppID);
+    container->deleteInstance(ueAppID);
+    deallocateResources(it->second.resources.ram, it->second.resources.disk, it->second.resources.cpu);
+    mecAppMap.erase(it);
+
+    EV << "VirtualisationInfrastructureManager::terminateContainerMEApp - MEC app " << ueAppID << " terminated!" << endl;
+    return true;
+}
+
 bool VirtualisationInfrastructureManager::terminateEmulatedMEApp(DeleteAppMessage *msg)
 {
     int ueAppID = msg->getUeAppID();
@@ -336,6 +430,7 @@ bool VirtualisationInfrastructureManager::terminateEmulatedMEApp(DeleteAppMessag
 
         //deallocate resources
         deallocateResources(mecAppMap[key].resources.ram, mecAppMap[key].resources.disk, mecAppMap[key].resources.cpu);
+        cancelProcessingJobs(key);
 
         //update map
         mecAppMap.erase(ueAppID);
@@ -356,8 +451,12 @@ bool VirtualisationInfrastructureManager::terminateMEApp(DeleteAppMessage *msg)
         //retrieve mecAppMap map key
         int key = ueAppID;
 
+        if (mecAppMap[key].inContainer)
+            return terminateContainerMEApp(key);
+
         EV << "VirtualisationInfrastructureManager::terminateMEApp - " << mecAppMap[key].meAppModule->getName() << " terminated!" << endl;
         //terminating the ME App instance
+        cancelProcessingJobs(key);
         mecAppMap[key].meAppModule->callFinish();
         mecAppMap[key].meAppModule->deleteModule();
         currentMEApps--;
@@ -452,6 +551,7 @@ bool VirtualisationInfrastructureManager::deRegisterMecApp(int ueAppID)
         EV << "VirtualisationInfrastructureManager::handleMEAppResources - resources DEALLOCATED for MecApp with UEAppId " << ueAppID << endl;
         EV << "VirtualisationInfrastructureManager::handleMEAppResources - ram: " << mecAppMap[ueAppID].resources.ram << " disk: " << mecAppMap[ueAppID].resources.disk << " cpu: " << mecAppMap[ueAppID].resources.cpu << endl;
         deallocateResources(mecAppMap[ueAppID].resources.ram, mecAppMap[ueAppID].resources.disk, mecAppMap[ueAppID].resources.cpu);
+        cancelProcessingJobs(ueAppID);
         mecAppMap.erase(ueAppID);
         return true;
     }
@@ -489,6 +589,129 @@ double VirtualisationInfrastructureManager::calculateProcessingTime(int ueAppID,
     }
 }
 
+void VirtualisationInfrastructureManager::startProcessingJob(IProcessingJobOwner *owner, int ueAppID, double nominalTime, cMessage *msg)
+{
+    Enter_Method("startProcessingJob");
+
+    if (scheduling != PROCESSOR_SHARING)
+        throw cRuntimeError("VirtualisationInfrastructureManager::startProcessingJob - processing jobs require the processorSharing scheduling mode");
+    if (isProcessing(msg))
+        throw cRuntimeError("VirtualisationInfrastructureManager::startProcessingJob - a job is already running for message %s", msg->getName());
+
+    // as calculateProcessingTime(), jobs of unknown MEC apps take no time
+    auto ueApp = mecAppMap.find(ueAppID);
+    double weight = (ueApp != mecAppMap.end()) ? ueApp->second.resources.cpu : 0.0;
+    if (weight <= 0)
+        nominalTime = 0;
+
+    advanceVirtualTime();
+
+    ProcessingJob job;
+    job.owner = owner;
+    job.msg = msg;
+    job.mecAppId = ueAppID;
+    job.weight = weight;
+    job.finishTag = virtualTime_ + nominalTime;
+
+    long jobId = jobCounter_++;
+    jobs_[jobId] = job;
+    jobByMsg_[msg] = jobId;
+    finishOrder_.insert({job.finishTag, jobId});
+    totalWeight_ += weight;
+
+    EV << "VirtualisationInfrastructureManager::startProcessingJob - job " << jobId << " of MEC app " << ueAppID << " nominal time " << nominalTime << "s, active jobs: " << jobs_.size() << endl;
+    emit(processingJobsSignal_, (long)jobs_.size());
+
+    scheduleNextJobCompletion();
+}
+
+void VirtualisationInfrastructureManager::cancelProcessingJob(cMessage *msg)
+{
+    Enter_Method_Silent("cancelProcessingJob");
+
+    auto it = jobByMsg_.find(msg);
+    if (it == jobByMsg_.end())
+        return;
+
+    advanceVirtualTime();
+    removeProcessingJob(jobs_.find(it->second));
+    emit(processingJobsSignal_, (long)jobs_.size());
+    scheduleNextJobCompletion();
+}
+
+void VirtualisationInfrastructureManager::cancelProcessingJobs(int ueAppID)
+{
+    if (jobs_.empty())
+        return;
+
+    advanceVirtualTime();
+    for (auto it = jobs_.begin(); it != jobs_.end(); ) {
+        auto next = std::next(it);
+        if (it->second.mecAppId == ueAppID)
+            removeProcessingJob(it);
+        it = next;
+    }
+    emit(processingJobsSignal_, (long)jobs_.size());
+    scheduleNextJobCompletion();
+}
+
+void VirtualisationInfrastructureManager::removeProcessingJob(std::map<long, ProcessingJob>::iterator it)
+{
+    const ProcessingJob& job = it->second;
+    finishOrder_.erase({job.finishTag, it->first});
+    jobByMsg_.erase(job.msg);
+    totalWeight_ -= job.weight;
+    jobs_.erase(it);
+
+    if (jobs_.empty()) {
+        // restart from zero to avoid accumulating rounding errors
+        totalWeight_ = 0;
+        virtualTime_ = 0;
+    }
+}
+
+void VirtualisationInfrastructureManager::advanceVirtualTime()
+{
+    simtime_t now = simTime();
+    if (totalWeight_ > 0)
+        virtualTime_ += (now - lastVirtualTimeUpdate_).dbl() * maxCPU / totalWeight_;
+    lastVirtualTimeUpdate_ = now;
+}
+
+void VirtualisationInfrastructureManager::scheduleNextJobCompletion()
+{
+    if (jobTimer_->isScheduled())
+        cancelEvent(jobTimer_);
+    if (finishOrder_.empty())
+        return;
+
+    double remaining = std::max(0.0, finishOrder_.begin()->first - virtualTime_);
+    double delay = (totalWeight_ > 0) ? remaining * totalWeight_ / maxCPU : 0.0;
+    scheduleAt(simTime() + delay, jobTimer_);
+}
+
+void VirtualisationInfrastructureManager::handleJobCompletion()
+{
+    advanceVirtualTime();
+
+    // jobs whose virtual finish time has been reached, up to rounding errors of the virtual time
+    double threshold = virtualTime_ + 1e-12 * std::max(1.0, virtualTime_);
+    std::vector<ProcessingJob> completed;
+    while (!finishOrder_.empty() && finishOrder_.begin()->first <= threshold) {
+        auto it = jobs_.find(finishOrder_.begin()->second);
+        completed.push_back(it->second);
+        removeProcessingJob(it);
+    }
+    emit(processingJobsSignal_, (long)jobs_.size());
+    scheduleNextJobCompletion();
+
+    // the owners may start new jobs when notified
+    for (auto& job : completed) {
+        EV << "VirtualisationInfrastructureManager::handleJobCompletion - job of MEC app " << job.mecAppId << " completed" << endl;
+        job.owner->processingCompleted(job.msg);
+    }
+}
+
 ResourceDescriptor VirtualisationInfrastructureManager::getAvailableResources() const {
     ResourceDescriptor avRes;
     avRes.ram = maxRam - allocatedRam;
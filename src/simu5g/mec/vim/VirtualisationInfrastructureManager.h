@@ -12,6 +12,9 @@
 #ifndef __VIM_H_
 #define __VIM_H_
 
+#include <map>
+#include <set>
+
 #include <inet/common/ModuleRefByPar.h>
 #include <inet/networklayer/common/InterfaceTable.h>
 #include <inet/networklayer/common/L3Address.h>
@@ -41,6 +44,7 @@ struct MecAppEntry
     int ueAppID;                // for identifying the UEApp
     int meAppPort;              // socket port of the MEC app
     ResourceDescriptor resources;
+    bool inContainer = false;   // true if the MEC app is a lightweight instance hosted by the MecAppContainer
 };
 
 struct MecAppInstanceInfo
@@ -52,7 +56,17 @@ struct MecAppInstanceInfo
 };
 
 // used to calculate processing time needed to execute a number of instructions
-enum SchedulingMode { SEGREGATION, FAIR_SHARING };
+enum SchedulingMode { SEGREGATION, FAIR_SHARING, PROCESSOR_SHARING };
+
+// implemented by the modules that run processing jobs on the MEC host in processor-sharing mode
+class IProcessingJobOwner
+{
+  public:
+    virtual ~IProcessingJobOwner() {}
+
+    // called when the job started with the given message has been completed
+    virtual void processingCompleted(cMessage *msg) = 0;
+};
 
 //###########################################################################
 
@@ -126,7 +140,33 @@ class VirtualisationInfrastructureManager : public cSimpleModule
     double allocatedDisk;
     double allocatedCPU;
 
-    SchedulingMode scheduling; // SEGREGATION or FAIR_SHARING
+    SchedulingMode scheduling; // SEGREGATION, FAIR_SHARING or PROCESSOR_SHARING
+
+    //------------------------------------
+    // Processor-sharing executor
+    // In-progress jobs share the CPU of the MEC host proportionally to the CPU requested by
+    // their MEC apps. Since all jobs are slowed down (or sped up) by the same factor, i.e.
+    // maxCPU / (sum of the requested CPU of the active jobs), progress is tracked with a single
+    // virtual time, advancing at that rate. The virtual finish time of a job is fixed at its
+    // start, so changes of the active set only require to reschedule the earliest completion
+    struct ProcessingJob
+    {
+        IProcessingJobOwner *owner;
+        cMessage *msg;          // owned by the job owner, never accessed by the VIM
+        int mecAppId;
+        double weight;          // requested CPU of the MEC app
+        double finishTag;       // virtual finish time
+    };
+    std::map<long, ProcessingJob> jobs_;
+    std::map<const cMessage *, long> jobByMsg_;
+    std::set<std::pair<double, long>> finishOrder_; // (virtual finish time, job id)
+    long jobCounter_ = 0;
+    double totalWeight_ = 0;
+    double virtualTime_ = 0;
+    simtime_t lastVirtualTimeUpdate_ = 0;
+    cMessage *jobTimer_ = nullptr;
+
+    static simsignal_t processingJobsSignal_;
 
   public:
 
@@ -150,7 +190,9 @@ class VirtualisationInfrastructureManager : public cSimpleModule
      *  proportionally to their requested rate, possibly obtaining more capacity than
      *  stipulated when contention is low
      *
-     *  The variable scheduling selects the mode
+     *  The variable scheduling selects the mode.
+     *  In processor-sharing mode, the returned time is the nominal processing time at the
+     *  CPU requested by the MEC app, to be used as job size for startProcessingJob()
      *
      * @param mecAppID to identify the MEC app
      * @param numOfInstructions - number of instructions the MEC app wants to execute
@@ -174,6 +216,25 @@ class VirtualisationInfrastructureManager : public cSimpleModule
     bool deRegisterMecApp(int mecAppID);
     // ******************************************************************
 
+    /*
+     * Processor-sharing mode
+     *
+     * startProcessingJob() starts a job on behalf of a MEC app. The job requires nominalTime
+     * seconds at the CPU requested by the MEC app, and it is actually completed earlier or
+     * later according to the CPU demand of the other jobs running during its execution.
+     * At completion, owner->processingCompleted(msg) is called.
+     * The message is only used as job handle, it remains owned by the caller.
+     *
+     * @param owner module to be notified at job completion
+     * @param mecAppID to identify the MEC app
+     * @param nominalTime processing time of the job with the requested CPU (see calculateProcessingTime())
+     * @param msg handle of the job
+     */
+    void startProcessingJob(IProcessingJobOwner *owner, int mecAppID, double nominalTime, cMessage *msg);
+    void cancelProcessingJob(cMessage *msg);
+    bool isProcessing(const cMessage *msg) const { return jobByMsg_.find(msg) != jobByMsg_.end(); }
+    bool isProcessorSharing() const { return scheduling == PROCESSOR_SHARING; }
+
     /*
      * Method that checks if a MEC app can be instantiated on the MEC host
      * @param reqRam, reqDisk, reqCpu - computation resources needed by the MEC app
@@ -230,6 +291,20 @@ class VirtualisationInfrastructureManager : public cSimpleModule
     }
 
     void reserveResourcesBGApps();
+
+    // instancing/terminating a lightweight MEC app within the MecAppContainer of the MEC host
+    MecAppInstanceInfo *instantiateContainerMEApp(CreateAppMessage *msg);
+    bool terminateContainerMEApp(int ueAppID);
+
+    // processor-sharing executor
+    void advanceVirtualTime();
+    void removeProcessingJob(std::map<long, ProcessingJob>::iterator it);
+    void cancelProcessingJobs(int mecAppID);
+    void scheduleNextJobCompletion();
+    void handleJobCompletion();
+
+  public:
+    ~VirtualisationInfrastructureManager() override;
 };
 
 } //namespace
@@ -137,6 +137,7 @@ void LteMacBase::fromPhy(cPacket *pktAux)
         }
 
         auto hfbpkt = pkt->peekAtFront<LteHarqFeedback>();
+        ProfilingScope profiling(harqProfile_);
         htit->second->receiveHarqFeedback(pkt);
     }
     else if (userInfo->getFrameType() == FEEDBACKPKT) {
@@ -156,6 +157,7 @@ void LteMacBase::fromPhy(cPacket *pktAux)
         auto pduAux = pkt->peekAtFront<LteMacPdu>();
         auto pdu = pkt;
         Codeword cw = userInfo->getCw();
+        ProfilingScope profiling(harqProfile_);
 
         if (harqRxBuffers_.find(carrierFreq) == harqRxBuffers_.end()) {
             HarqRxBuffers newRxBuffs;
@@ -406,6 +408,8 @@ void LteMacBase::initialize(int stage)
 
         // statistics
         statDisplay_ = par("statDisplay");
+        ttiProfile_ = Profiling::getCounter(this, "handleSelfMessage");
+        harqProfile_ = Profiling::getCounter(this, "harq");
 
         WATCH(queueSize_);
         WATCH(nodeId_);
@@ -417,7 +421,10 @@ void LteMacBase::initialize(int stage)
 void LteMacBase::handleMessage(cMessage *msg)
 {
     if (msg->isSelfMessage()) {
-        handleSelfMessage();
+        {
+            ProfilingScope profiling(ttiProfile_);
+            handleSelfMessage();
+        }
         scheduleAt(NOW + ttiPeriod_, ttiTick_);
         return;
     }
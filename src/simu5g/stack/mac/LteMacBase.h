@@ -18,6 +18,7 @@
 #include "simu5g/common/binder/Binder.h"
 #include "simu5g/common/LteCommon.h"
 #include "simu5g/common/LteControlInfo.h"
+#include "simu5g/common/Profiling.h"
 
 namespace simu5g {
 
@@ -137,6 +138,9 @@ class LteMacBase : public cSimpleModule
     /// Harq Rx Buffers (one entry per carrier)
     std::map<GHz, HarqRxBuffers> harqRxBuffers_;
 
+    /// Scratch storage for the PDUs extracted from the Harq Rx Buffers (reused at every TTI)
+    std::vector<Packet *> correctPdus_;
+
     /* Incoming Connection Descriptors:
      * a connection is stored at the first MAC SDU delivered to the RLC
      */
@@ -173,6 +177,10 @@ class LteMacBase : public cSimpleModule
     };
     std::map<NumerologyIndex, NumerologyPeriodCounter> numerologyPeriodCounter_;
 
+    // profiling of the TTI processing and of the H-ARQ handling
+    ProfilingCounter *ttiProfile_ = nullptr;
+    ProfilingCounter *harqProfile_ = nullptr;
+
     // statistics in visualization
     bool statDisplay_;
     uint64_t nrFromUpper_ = 0;
@@ -192,7 +192,10 @@ void LteMacEnb::handleMessage(cMessage *msg)
 {
     if (msg->isSelfMessage()) {
         if (strcmp(msg->getName(), "flushHarqMsg") == 0) {
-            flushHarqBuffers();
+            {
+                ProfilingScope profiling(harqProfile_);
+                flushHarqBuffers();
+            }
             delete msg;
             return;
         }
@@ -244,8 +247,8 @@ void LteMacEnb::macSduRequest()
 
 LteMacBuffer* LteMacEnb::createBsrBuffer(MacCid cid)
 {
-    // Create new BSR buffer
-    LteMacBuffer *bsrqueue = new LteMacBuffer();
+    // Create new BSR buffer (it holds at most the latest BSR)
+    LteMacBuffer *bsrqueue = new LteMacBuffer(1);
     bsrbuf_[cid] = bsrqueue;
 
     EV << "LteBsrBuffers : Added new BSR buffer for node: "
@@ -773,12 +776,10 @@ void LteMacEnb::handleSelfMessage()
             continue;
 
         for (auto& hit : harqRxBuffer) {
-            auto pduList = hit.second->extractCorrectPdus();
-            while (!pduList.empty()) {
-                auto pdu = pduList.front();
-                pduList.pop_front();
+            correctPdus_.clear();
+            hit.second->extractCorrectPdus(correctPdus_);
+            for (auto pdu : correctPdus_)
                 macPduUnmake(pdu);
-            }
         }
     }
 
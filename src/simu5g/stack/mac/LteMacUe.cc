@@ -177,7 +177,10 @@ void LteMacUe::handleMessage(cMessage *msg)
 {
     if (msg->isSelfMessage()) {
         if (strcmp(msg->getName(), "flushHarqMsg") == 0) {
-            flushHarqBuffers();
+            {
+                ProfilingScope profiling(harqProfile_);
+                flushHarqBuffers();
+            }
             delete msg;
             return;
         }
@@ -595,15 +598,11 @@ void LteMacUe::handleSelfMessage()
 
     // extract PDUs from all HARQ RX buffers and pass them to unmaker
     for (auto& [carrierFreq, harqRxBuffer] : harqRxBuffers_) {
-        std::list<Packet *> pduList;
-
         for (auto& [nodeId, harqBuffer] : harqRxBuffer) {
-            pduList = harqBuffer->extractCorrectPdus();
-            while (!pduList.empty()) {
-                auto pdu = pduList.front();
-                pduList.pop_front();
+            correctPdus_.clear();
+            harqBuffer->extractCorrectPdus(correctPdus_);
+            for (auto pdu : correctPdus_)
                 macPduUnmake(pdu);
-            }
         }
     }
 
@@ -741,7 +740,8 @@ void LteMacUe::handleSelfMessage()
             int cntOuter = 0;
             int cntInner = 0;
             for (auto [nodeId, currHarq] : mtit.second) {
-                BufferStatus harqStatus = currHarq->getBufferStatus();
+                BufferStatus harqStatus;
+                currHarq->getBufferStatus(harqStatus);
 
                 EV << "\t cycleOuter " << cntOuter << " - bufferStatus.size=" << harqStatus.size() << endl;
                 for (const auto& unitStatusVector : harqStatus) {
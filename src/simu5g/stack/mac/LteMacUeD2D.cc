@@ -570,12 +570,10 @@ void LteMacUeD2D::handleSelfMessage()
     // extract PDUs from all HARQ RX buffers and pass them to unmaker
     for (auto& [carrierFreq, harqRxMap] : harqRxBuffers_) {
         for (auto& [nodeId, rxBuffer] : harqRxMap) {
-            std::list<Packet *> pduList = rxBuffer->extractCorrectPdus();
-            while (!pduList.empty()) {
-                auto pdu = pduList.front();
-                pduList.pop_front();
+            correctPdus_.clear();
+            rxBuffer->extractCorrectPdus(correctPdus_);
+            for (auto pdu : correctPdus_)
                 macPduUnmake(pdu);
-            }
         }
     }
 
@@ -727,7 +725,8 @@ void LteMacUeD2D::handleSelfMessage()
             int cntOuter = 0;
             int cntInner = 0;
             for (auto [nodeId, currHarq] : harqTxMap) {
-                BufferStatus harqStatus = currHarq->getBufferStatus();
+                BufferStatus harqStatus;
+                currHarq->getBufferStatus(harqStatus);
                 EV << "\t cicloOuter " << cntOuter << " - bufferStatus.size=" << harqStatus.size() << endl;
                 for (const auto& jt : harqStatus) {
                     EV << "\t\t cicloInner " << cntInner << " - jt->size=" << jt.size()
@@ -38,14 +38,11 @@ void NrMacUe::handleSelfMessage()
         if (getNumerologyPeriodCounter(binder_->getNumerologyIndexFromCarrierFreq(carrierFreq)) > 0)
             continue;
 
-        std::list<Packet *> pduList;
         for (auto [macNodeId, rxBuf] : harqRxMap) {
-            pduList = rxBuf->extractCorrectPdus();
-            while (!pduList.empty()) {
-                auto pdu = pduList.front();
-                pduList.pop_front();
+            correctPdus_.clear();
+            rxBuf->extractCorrectPdus(correctPdus_);
+            for (auto pdu : correctPdus_)
                 macPduUnmake(pdu);
-            }
         }
     }
 
@@ -204,7 +201,8 @@ void NrMacUe::handleSelfMessage()
             int cntOuter = 0;
             int cntInner = 0;
             for (auto [currId, currHarq] : harqTxBufferMap) {
-                BufferStatus harqStatus = currHarq->getBufferStatus();
+                BufferStatus harqStatus;
+                currHarq->getBufferStatus(harqStatus);
                 EV << "\t cycleOuter " << cntOuter << " - bufferStatus.size=" << harqStatus.size() << endl;
                 for (const auto& jt : harqStatus) {
                     EV << "\t\t cycleInner " << cntInner << " - jt->size=" << jt.size()
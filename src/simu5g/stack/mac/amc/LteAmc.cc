@@ -186,6 +186,7 @@ void LteAmc::initialize(int stage)
     mac_ = check_and_cast<LteMacEnb *>(getParentModule());
     binder_ = check_and_cast<Binder *>(getModuleByPath(mac_->par("binderModule").stringValue()));
     cellInfo_ = mac_->getCellInfo();
+    txParamsProfile_ = Profiling::getCounter(this, "computeTxParams");
     numAntennas_ = mac_->getNumAntennas();
 
     // Get MacNodeId and MacCellId
@@ -542,6 +543,8 @@ const UserTxParams& LteAmc::setTxParams(MacNodeId id, const Direction dir, UserT
 
 const UserTxParams& LteAmc::computeTxParams(MacNodeId id, const Direction dir, GHz carrierFrequency)
 {
+    ProfilingScope profiling(txParamsProfile_);
+
     // DEBUG
     EV << NOW << " LteAmc::computeTxParams --------------::[ START ]::--------------\n";
     EV << NOW << " LteAmc::computeTxParams CellId: " << cellId_ << "\n";
@@ -58,6 +58,7 @@ class LteAmc : public cSimpleModule
     opp_component_ptr<Binder> binder_;
     opp_component_ptr<CellInfo> cellInfo_;
     AmcPilot *pilot_ = nullptr;
+    ProfilingCounter *txParamsProfile_ = nullptr;
     RbAllocationType allocationType_;
     int numBands_;
     MacNodeId nodeId_;
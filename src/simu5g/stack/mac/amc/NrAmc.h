@@ -29,7 +29,6 @@ class NrAmc : public LteAmc
     unsigned int getSymbolsPerSlot(GHz carrierFrequency, Direction dir);
     unsigned int getResourceElementsPerBlock(unsigned int symbolsPerSlot);
     unsigned int getResourceElements(unsigned int blocks, unsigned int symbolsPerSlot);
-    unsigned int computeTbsFromNinfo(double nInfo, double coderate);
 
     unsigned int computeCodewordTbs(UserTxParams *info, Codeword cw, Direction dir, unsigned int numRe);
 
@@ -41,6 +40,11 @@ class NrAmc : public LteAmc
 
     NrAmc() {}
 
+    /*
+     * Returns the TBS for the given number of information bits and code rate (TS 38.214, 5.1.3.2)
+     */
+    static unsigned int computeTbsFromNinfo(double nInfo, double coderate);
+
     NrMcsElem getMcsElemPerCqi(Cqi cqi, const Direction dir);
 
     unsigned int computeBitsOnNRbs(MacNodeId id, Band b, unsigned int blocks, const Direction dir, GHz carrierFrequency) override;
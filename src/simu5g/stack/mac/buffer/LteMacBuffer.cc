@@ -16,21 +16,18 @@ namespace simu5g {
 
 using namespace omnetpp;
 
-LteMacBuffer::LteMacBuffer() : processed_(0), queueOccupancy_(0), queueLength_(0)
+LteMacBuffer::LteMacBuffer(unsigned int capacity) : processed_(0), queueOccupancy_(0), Queue_(capacity)
 {
 }
 
-LteMacBuffer::LteMacBuffer(const LteMacQueue& queue)
+LteMacBuffer::LteMacBuffer(const LteMacBuffer& queue) : processed_(queue.processed_), queueOccupancy_(queue.queueOccupancy_), Queue_(queue.Queue_)
 {
-    operator=(queue);
 }
 
-
-
 LteMacBuffer& LteMacBuffer::operator=(const LteMacBuffer& queue)
 {
+    processed_ = queue.processed_;
     queueOccupancy_ = queue.queueOccupancy_;
-    queueLength_ = queue.queueLength_;
     Queue_ = queue.Queue_;
     return *this;
 }
@@ -42,53 +39,49 @@ LteMacBuffer *LteMacBuffer::dup() const
 
 void LteMacBuffer::pushBack(PacketInfo pkt)
 {
-    queueLength_++;
     queueOccupancy_ += pkt.first;
     Queue_.push_back(pkt);
 }
 
 void LteMacBuffer::pushFront(PacketInfo pkt)
 {
-    queueLength_++;
     queueOccupancy_ += pkt.first;
     Queue_.push_front(pkt);
 }
 
 PacketInfo LteMacBuffer::popFront()
 {
-    if (queueLength_ <= 0)
+    if (Queue_.empty())
         throw cRuntimeError("Packet queue is empty");
 
     PacketInfo pkt = Queue_.front();
     Queue_.pop_front();
     processed_++;
-    queueLength_--;
     queueOccupancy_ -= pkt.first;
     return pkt;
 }
 
 PacketInfo LteMacBuffer::popBack()
 {
-    if (queueLength_ <= 0)
+    if (Queue_.empty())
         throw cRuntimeError("Packet queue is empty");
 
     PacketInfo pkt = Queue_.back();
     Queue_.pop_back();
-    queueLength_--;
     queueOccupancy_ -= pkt.first;
     return pkt;
 }
 
 PacketInfo& LteMacBuffer::front()
 {
-    if (queueLength_ <= 0)
+    if (Queue_.empty())
         throw cRuntimeError("Packet queue is empty");
     return Queue_.front();
 }
 
 PacketInfo LteMacBuffer::back() const
 {
-    if (queueLength_ <= 0)
+    if (Queue_.empty())
         throw cRuntimeError("Packet queue is empty");
     return Queue_.back();
 }
@@ -100,7 +93,7 @@ void LteMacBuffer::setProcessed(unsigned int i)
 
 simtime_t LteMacBuffer::getHolTimestamp() const
 {
-    if (queueLength_ <= 0)
+    if (Queue_.empty())
         throw cRuntimeError("Packet queue is empty");
     return Queue_.front().second;
 }
@@ -110,9 +103,11 @@ unsigned int LteMacBuffer::getProcessed() const
     return processed_;
 }
 
-const std::list<PacketInfo> *LteMacBuffer::getPacketlist() const
+const PacketInfo& LteMacBuffer::getPacket(int i) const
 {
-    return &Queue_;
+    if (i < 0 || i >= (int)Queue_.size())
+        throw cRuntimeError("Packet index %d out of range", i);
+    return Queue_[i];
 }
 
 unsigned int LteMacBuffer::getQueueOccupancy() const
@@ -122,12 +117,12 @@ unsigned int LteMacBuffer::getQueueOccupancy() const
 
 int LteMacBuffer::getQueueLength() const
 {
-    return queueLength_;
+    return Queue_.size();
 }
 
 bool LteMacBuffer::isEmpty() const
 {
-    return queueLength_ == 0;
+    return Queue_.empty();
 }
 
 std::ostream& operator<<(std::ostream& stream, const LteMacBuffer *queue)
@@ -14,6 +14,7 @@
 #define _LTE_LTEMACBUFFER_H_
 
 #include "simu5g/common/LteCommon.h"
+#include "simu5g/common/Circular.h"
 
 namespace simu5g {
 
@@ -24,20 +25,27 @@ class LteMacQueue;
 /**
  * @class LteMacBuffer
  * @brief  Buffers for MAC packets
+ *
+ * Virtual packets are kept in a contiguous circular buffer, so that
+ * push/pop operations do not allocate memory (unless the buffer has to
+ * grow) and occupancy and HOL timestamp queries are O(1).
  */
 class LteMacBuffer
 {
   public:
     /**
      * Constructor initializes
-     * the list
+     * the buffer
+     *
+     * @param capacity number of packets that can be stored
+     *        before the buffer needs to grow
      */
-    LteMacBuffer();
+    explicit LteMacBuffer(unsigned int capacity = 16);
 
     /**
      * Copy Constructors
      */
-    LteMacBuffer(const LteMacQueue& queue);
+    LteMacBuffer(const LteMacBuffer& queue);
     LteMacBuffer& operator=(const LteMacBuffer& queue);
     LteMacBuffer *dup() const;
 
@@ -143,11 +151,15 @@ class LteMacBuffer
     unsigned int getProcessed() const;
 
     /**
-     * Get direct (readonly) access to PDU list
+     * getPacket() returns the i-th packet of
+     * the queue, starting from the front
+     *
+     * @param i position of the packet
+     * @return pkt at the given position
      */
-    const std::list<PacketInfo> *getPacketlist() const;
+    const PacketInfo& getPacket(int i) const;
 
-    friend std::ostream& operator<<(std::ostream& stream, const LteMacQueue *queue);
+    friend std::ostream& operator<<(std::ostream& stream, const LteMacBuffer *queue);
 
   private:
     /// Number of packets processed by the scheduler
@@ -156,11 +168,8 @@ class LteMacBuffer
     /// Occupancy of the whole buffer
     unsigned int queueOccupancy_;
 
-    /// Number of queued packets
-    int queueLength_;
-
-    /// List of packets
-    std::list<PacketInfo> Queue_;
+    /// Packets
+    CircularBuffer<PacketInfo> Queue_;
 };
 
 } //namespace
@@ -44,8 +44,7 @@ LteMacQueue *LteMacQueue::dup() const
 // ENQUEUE
 bool LteMacQueue::pushBack(cPacket *pkt)
 {
-    Packet *pktAux = check_and_cast<Packet *>(pkt);
-    if (!isEnqueueablePacket(pktAux))
+    if (queueSize_ != 0 && !isEnqueueablePacket(check_and_cast<Packet *>(pkt)))
         return false; // packet queue full or we have discarded fragments for this main packet
 
     cPacketQueue::insert(pkt);
@@ -54,8 +53,7 @@ bool LteMacQueue::pushBack(cPacket *pkt)
 
 bool LteMacQueue::pushFront(cPacket *pkt)
 {
-    Packet *pktAux = check_and_cast<Packet *>(pkt);
-    if (!isEnqueueablePacket(pktAux))
+    if (queueSize_ != 0 && !isEnqueueablePacket(check_and_cast<Packet *>(pkt)))
         return false; // packet queue full or we have discarded fragments for this main packet
 
     cPacketQueue::insertBefore(cPacketQueue::front(), pkt);
@@ -89,13 +87,13 @@ int64_t LteMacQueue::getQueueSize() const
 
 bool LteMacQueue::isEnqueueablePacket(Packet *pkt) {
 
-    auto chunk = pkt->peekAtFront<Chunk>();
-    auto pdu = dynamicPtrCast<const LteRlcAmPdu>(chunk);
-
     if (queueSize_ == 0) {
         // unlimited queue size -- nothing to check for
         return true;
     }
+
+    auto chunk = pkt->peekAtFront<Chunk>();
+    auto pdu = dynamicPtrCast<const LteRlcAmPdu>(chunk);
     /* Check:
      *
      * For AM: We need to check if all fragments will fit in the queue
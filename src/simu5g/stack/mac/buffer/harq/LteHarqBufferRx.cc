@@ -77,6 +77,8 @@ void LteHarqBufferRx::insertPdu(Codeword cw, inet::Packet *pkt)
 void LteHarqBufferRx::sendFeedback()
 {
     for (unsigned int i = 0; i < numHarqProcesses_; i++) {
+        if (processes_[i]->isEmpty())
+            continue;
         for (Codeword cw = 0; cw < MAX_CODEWORDS; ++cw) {
             if (processes_[i]->isEvaluated(cw)) {
                 auto pkt = processes_[i]->createFeedback(cw);
@@ -103,6 +105,8 @@ unsigned int LteHarqBufferRx::purgeCorruptedPdus()
     unsigned int purged = 0;
 
     for (unsigned int i = 0; i < numHarqProcesses_; i++) {
+        if (processes_[i]->isEmpty())
+            continue;
         for (Codeword cw = 0; cw < MAX_CODEWORDS; ++cw) {
             if (processes_[i]->getUnitStatus(cw) == RXHARQ_PDU_CORRUPTED) {
                 EV << "LteHarqBufferRx::purgeCorruptedPdus - purged PDU with acid " << i << endl;
@@ -117,12 +121,13 @@ unsigned int LteHarqBufferRx::purgeCorruptedPdus()
     return purged;
 }
 
-std::list<Packet *> LteHarqBufferRx::extractCorrectPdus()
+void LteHarqBufferRx::extractCorrectPdus(std::vector<Packet *>& pdus)
 {
     this->sendFeedback();
-    std::list<Packet *> ret;
     unsigned char acid = 0;
     for (unsigned int i = 0; i < numHarqProcesses_; i++) {
+        if (processes_[i]->isEmpty())
+            continue;
         for (Codeword cw = 0; cw < MAX_CODEWORDS; ++cw) {
             if (processes_[i]->isCorrect(cw)) {
                 auto pktTemp = processes_[i]->extractPdu(cw);
@@ -149,17 +154,15 @@ std::list<Packet *> LteHarqBufferRx::extractCorrectPdus()
                 }
 
                 macOwner_->dropObj(pktTemp);
-                ret.push_back(pktTemp);
+                pdus.push_back(pktTemp);
                 acid = i;
 
-                EV << "LteHarqBufferRx::extractCorrectPdus H-ARQ RX: PDU (id " << ret.back()->getId()
+                EV << "LteHarqBufferRx::extractCorrectPdus H-ARQ RX: PDU (id " << pdus.back()->getId()
                    << " ) extracted from process " << (int)acid
                    << " to be sent upper" << endl;
             }
         }
     }
-
-    return ret;
 }
 
 UnitList LteHarqBufferRx::firstAvailable()
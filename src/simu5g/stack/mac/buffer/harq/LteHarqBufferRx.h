@@ -89,9 +89,9 @@ class LteHarqBufferRx
      * Sends feedback for all processes which are older than
      * HARQ_FB_EVALUATION_INTERVAL, then extracts the PDU in correct state (if any)
      *
-     * @return uncorrupted PDUs or empty list if none
+     * @param pdus caller-owned storage the uncorrupted PDUs (if any) are appended to
      */
-    virtual std::list<inet::Packet *> extractCorrectPdus();
+    virtual void extractCorrectPdus(std::vector<inet::Packet *>& pdus);
 
     /**
      * Purges PDUs in corrupted state (if any)
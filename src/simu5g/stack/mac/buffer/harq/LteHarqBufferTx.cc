@@ -16,9 +16,16 @@ namespace simu5g {
 
 using namespace omnetpp;
 
+// index of the lowest bit set in a non-zero mask
+static inline unsigned int lowestSetBit(uint64_t mask)
+{
+    return __builtin_ctzll(mask);
+}
+
 LteHarqBufferTx::LteHarqBufferTx(Binder *binder, unsigned int numProc, LteMacBase *owner, LteMacBase *dstMac)
     : macOwner_(owner), processes_(numProc, nullptr), numProc_(numProc), numEmptyProc_(numProc), selectedAcid_(HARQ_NONE), nodeId_(dstMac->getMacNodeId())
 {
+    initProcessStatus();
     for (unsigned int i = 0; i < numProc_; i++) {
         processes_[i] = new LteHarqProcessTx(binder, i, MAX_CODEWORDS, numProc_, macOwner_, dstMac);
     }
@@ -27,6 +34,23 @@ LteHarqBufferTx::LteHarqBufferTx(Binder *binder, unsigned int numProc, LteMacBas
 LteHarqBufferTx::LteHarqBufferTx(Binder *binder, unsigned int numProc, LteMacBase *owner)
     : macOwner_(owner), processes_(numProc, nullptr), numProc_(numProc), numEmptyProc_(numProc), selectedAcid_(HARQ_NONE), nodeId_((MacNodeId)-1)
 {
+    initProcessStatus();
+}
+
+void LteHarqBufferTx::initProcessStatus()
+{
+    if (numProc_ > 64)
+        throw cRuntimeError("LteHarqBufferTx: at most 64 H-ARQ processes are supported, %u requested", numProc_);
+
+    readyProcesses_ = 0;
+    emptyProcesses_ = (numProc_ == 64) ? ~(uint64_t)0 : (((uint64_t)1 << numProc_) - 1);
+}
+
+void LteHarqBufferTx::updateProcessStatus(unsigned char acid)
+{
+    uint64_t bit = (uint64_t)1 << acid;
+    readyProcesses_ = processes_[acid]->hasReadyUnits() ? (readyProcesses_ | bit) : (readyProcesses_ & ~bit);
+    emptyProcesses_ = processes_[acid]->isEmpty() ? (emptyProcesses_ | bit) : (emptyProcesses_ & ~bit);
 }
 
 UnitList LteHarqBufferTx::firstReadyForRtx()
@@ -35,13 +59,13 @@ UnitList LteHarqBufferTx::firstReadyForRtx()
     simtime_t oldestTxTime = NOW + 1;
     simtime_t currentTxTime = 0;
 
-    for (unsigned int i = 0; i < numProc_; i++) {
-        if (processes_[i]->hasReadyUnits()) {
-            currentTxTime = processes_[i]->getOldestUnitTxTime();
-            if (currentTxTime < oldestTxTime) {
-                oldestTxTime = currentTxTime;
-                oldestProcessAcid = i;
-            }
+    // only visit the processes having ready units
+    for (uint64_t mask = readyProcesses_; mask != 0; mask &= mask - 1) {
+        unsigned int i = lowestSetBit(mask);
+        currentTxTime = processes_[i]->getOldestUnitTxTime();
+        if (currentTxTime < oldestTxTime) {
+            oldestTxTime = currentTxTime;
+            oldestProcessAcid = i;
         }
     }
     UnitList ret;
@@ -102,6 +126,7 @@ void LteHarqBufferTx::markSelected(UnitList unitIds, unsigned char availableTbs)
             processes_[acid]->markSelected(cw);
         }
     }
+    updateProcessStatus(acid);
 
     selectedAcid_ = acid;
 
@@ -125,6 +150,7 @@ void LteHarqBufferTx::insertPdu(unsigned char acid, Codeword cw, Packet *pkt)
     selectedAcid_ = acid;
     numEmptyProc_--;
     processes_[acid]->insertPdu(pkt, cw);
+    updateProcessStatus(acid);
 
     auto tag = pkt->getTag<UserControlInfo>();
     // debug output
@@ -141,12 +167,8 @@ UnitList LteHarqBufferTx::firstAvailable()
     unsigned char acid = HARQ_NONE;
 
     if (selectedAcid_ == HARQ_NONE) {
-        for (unsigned int i = 0; i < numProc_; i++) {
-            if (processes_[i]->isEmpty()) {
-                acid = i;
-                break;
-            }
-        }
+        if (emptyProcesses_ != 0)
+            acid = lowestSetBit(emptyProcesses_);
     }
     else {
         acid = selectedAcid_;
@@ -214,6 +236,7 @@ void LteHarqBufferTx::receiveHarqFeedback(Packet *pkt)
     bool reset = processes_[acid]->pduFeedback(harqResult, cw);
     if (reset)
         numEmptyProc_++;
+    updateProcessStatus(acid);
 
     // debug output
     const char *ack = result ? "ACK" : "NACK";
@@ -232,7 +255,7 @@ void LteHarqBufferTx::sendSelectedDown()
     }
 
     CwList ul = processes_[selectedAcid_]->selectedUnitsIds();
-    for (const auto& id : ul) {
+    for (Codeword id : ul) {
         auto pkt = processes_[selectedAcid_]->extractPdu(id);
         auto pduToSend = pkt->peekAtFront<LteMacPdu>();
         auto cinfo = pkt->getTag<UserControlInfo>();
@@ -242,6 +265,7 @@ void LteHarqBufferTx::sendSelectedDown()
         EV << "\t H-ARQ TX: pdu (id " << pduToSend->getId() << " ) extracted from process " << (int)selectedAcid_ << " "
                 "codeword " << (int)id << " for node with id " << cinfo->getDestId() << endl;
     }
+    updateProcessStatus(selectedAcid_);
     selectedAcid_ = HARQ_NONE;
 }
 
@@ -250,12 +274,13 @@ void LteHarqBufferTx::dropProcess(unsigned char acid)
     // pdus can be dropped only if the unit is in BUFFERED state.
     CwList ul = processes_[acid]->readyUnitsIds();
 
-    for (auto& id : ul) {
+    for (Codeword id : ul) {
         processes_[acid]->dropPdu(id);
     }
     // if a process contains units in BUFFERED state, then all units of this
     // process are either empty or in BUFFERED state (ready).
     numEmptyProc_++;
+    updateProcessStatus(acid);
 }
 
 void LteHarqBufferTx::selfNack(unsigned char acid, Codeword cw)
@@ -263,11 +288,12 @@ void LteHarqBufferTx::selfNack(unsigned char acid, Codeword cw)
     bool reset = false;
     CwList ul = processes_[acid]->readyUnitsIds();
 
-    for (const auto& unitId : ul) {
+    for (Codeword unitId : ul) {
         reset = processes_[acid]->selfNack(unitId);
     }
     if (reset)
         numEmptyProc_++;
+    updateProcessStatus(acid);
 }
 
 void LteHarqBufferTx::forceDropProcess(unsigned char acid)
@@ -276,6 +302,7 @@ void LteHarqBufferTx::forceDropProcess(unsigned char acid)
     if (acid == selectedAcid_)
         selectedAcid_ = HARQ_NONE;
     numEmptyProc_++;
+    updateProcessStatus(acid);
 }
 
 void LteHarqBufferTx::forceDropUnit(unsigned char acid, Codeword cw)
@@ -286,19 +313,20 @@ void LteHarqBufferTx::forceDropUnit(unsigned char acid, Codeword cw)
             selectedAcid_ = HARQ_NONE;
         numEmptyProc_++;
     }
+    updateProcessStatus(acid);
 }
 
-BufferStatus LteHarqBufferTx::getBufferStatus()
+void LteHarqBufferTx::getBufferStatus(BufferStatus& bs)
 {
-    BufferStatus bs(numProc_);
-    unsigned int numHarqUnits = 0;
+    bs.resize(numProc_);
     for (unsigned int i = 0; i < numProc_; i++) {
-        numHarqUnits = processes_[i]->getNumHarqUnits();
-        std::vector<UnitStatus> vus(numHarqUnits);
-        vus = processes_[i]->getProcessStatus();
-        bs[i] = vus;
+        unsigned int numHarqUnits = processes_[i]->getNumHarqUnits();
+        bs[i].resize(numHarqUnits);
+        for (Codeword cw = 0; cw < numHarqUnits; cw++) {
+            bs[i][cw].first = cw;
+            bs[i][cw].second = processes_[i]->getUnitStatus(cw);
+        }
     }
-    return bs;
 }
 
 LteHarqProcessTx *LteHarqBufferTx::getProcess(unsigned char acid)
@@ -319,6 +347,9 @@ LteHarqProcessTx *LteHarqBufferTx::getSelectedProcess()
 // @author Alessandro Noferi
 
 bool LteHarqBufferTx::isHarqBufferActive() const {
+    // processes with ready units are active, hence the scan is needed only if there is none
+    if (readyProcesses_ != 0)
+        return true;
     for (auto process : processes_) {
         if (process->isHarqProcessActive()) {
             return true;
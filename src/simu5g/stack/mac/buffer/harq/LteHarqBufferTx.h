@@ -38,6 +38,10 @@ class LteHarqBufferTx : noncopyable
     unsigned char selectedAcid_; // @ insert, @ marksel, @ sendseldn
     MacNodeId nodeId_; // UE nodeId for which this buffer has been created
 
+    /// Bitmasks of the processes (bit i is acid i) having units ready for retransmission and being empty, respectively
+    uint64_t readyProcesses_ = 0;
+    uint64_t emptyProcesses_ = 0;
+
   protected:
     /**
      * Protected Base Constructor.
@@ -183,7 +187,11 @@ class LteHarqBufferTx : noncopyable
      */
     void forceDropUnit(unsigned char acid, Codeword cw);
 
-    BufferStatus getBufferStatus();
+    /**
+     * Fills the given (caller-owned) structure with the status of all the units
+     * of all the processes. The structure is resized only if needed.
+     */
+    void getBufferStatus(BufferStatus& bs);
 
     std::vector<LteHarqProcessTx *> *getHarqProcesses() { return &processes_; }
     unsigned int getNumProcesses() { return numProc_; }
@@ -202,6 +210,17 @@ class LteHarqBufferTx : noncopyable
 
   protected:
 
+    /**
+     * Initializes the process bitmasks, all processes being empty.
+     */
+    void initProcessStatus();
+
+    /**
+     * Updates the process bitmasks according to the current status of the given process.
+     * Must be called whenever the status of a process may have changed.
+     */
+    void updateProcessStatus(unsigned char acid);
+
     /**
      * Checks if a given unitId is present in a unitIds list.
      *
@@ -235,14 +235,8 @@ CwList LteHarqProcessRx::emptyUnitsIds()
 // @author Alessandro Noferi
 bool LteHarqProcessRx::isHarqProcessActive()
 {
-    std::vector<RxUnitStatus> ues = getProcessStatus();
-
-    // When a process is active? (ask professor)
-    for (const auto& status : ues) {
-        if (status.second != RXHARQ_PDU_EMPTY)
-            return true;
-    }
-    return false;
+    // a process is active if at least one of its units is not empty
+    return !isEmpty();
 }
 
 } //namespace
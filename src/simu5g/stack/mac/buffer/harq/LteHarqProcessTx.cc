@@ -20,7 +20,7 @@ LteHarqProcessTx::LteHarqProcessTx(Binder *binder, unsigned char acid, unsigned
         LteMacBase *macOwner, LteMacBase *dstMac) : macOwner_(macOwner), numProcesses_(numProcesses), numHarqUnits_(numUnits),
         acid_(acid),
         numEmptyUnits_(numUnits), numSelected_(0),
-        dropped_(false)
+        dropped_(false), emptyUnits_((1u << numUnits) - 1)
 {
     units_.resize(numUnits);
 
@@ -36,6 +36,15 @@ LteHarqProcessTx::~LteHarqProcessTx()
         delete unit;
 }
 
+void LteHarqProcessTx::updateUnitStatus(Codeword cw)
+{
+    unsigned int bit = 1u << cw;
+    TxHarqPduStatus status = units_[cw]->getStatus();
+    readyUnits_ = (status == TXHARQ_PDU_BUFFERED) ? (readyUnits_ | bit) : (readyUnits_ & ~bit);
+    emptyUnits_ = (status == TXHARQ_PDU_EMPTY) ? (emptyUnits_ | bit) : (emptyUnits_ & ~bit);
+    selectedUnits_ = (status == TXHARQ_PDU_SELECTED) ? (selectedUnits_ | bit) : (selectedUnits_ & ~bit);
+}
+
 std::vector<UnitStatus> LteHarqProcessTx::getProcessStatus()
 {
     std::vector<UnitStatus> ret(numHarqUnits_);
@@ -53,6 +62,7 @@ void LteHarqProcessTx::insertPdu(Packet *pkt, Codeword cw)
     numEmptyUnits_--;
     numSelected_++;
     units_[cw]->insertPdu(pkt);
+    updateUnitStatus(cw);
     dropped_ = false;
 }
 
@@ -63,6 +73,7 @@ void LteHarqProcessTx::markSelected(Codeword cw)
 
     numSelected_++;
     units_[cw]->markSelected();
+    updateUnitStatus(cw);
 }
 
 Packet *LteHarqProcessTx::extractPdu(Codeword cw)
@@ -72,13 +83,14 @@ Packet *LteHarqProcessTx::extractPdu(Codeword cw)
 
     numSelected_--;
     auto pdu = units_[cw]->extractPdu();
-    auto tmp = pdu->peekAtFront<LteMacPdu>();
+    updateUnitStatus(cw);
     return pdu;
 }
 
 bool LteHarqProcessTx::pduFeedback(HarqAcknowledgment fb, Codeword cw)
 {
     bool reset = units_[cw]->pduFeedback(fb);
+    updateUnitStatus(cw);
 
     if (reset) {
         numEmptyUnits_++;
@@ -91,6 +103,7 @@ bool LteHarqProcessTx::pduFeedback(HarqAcknowledgment fb, Codeword cw)
 bool LteHarqProcessTx::selfNack(Codeword cw)
 {
     bool reset = units_[cw]->selfNack();
+    updateUnitStatus(cw);
 
     if (reset) {
         numEmptyUnits_++;
@@ -100,21 +113,12 @@ bool LteHarqProcessTx::selfNack(Codeword cw)
     return numEmptyUnits_ == numHarqUnits_;
 }
 
-bool LteHarqProcessTx::hasReadyUnits()
-{
-    for (unsigned int i = 0; i < numHarqUnits_; i++) {
-        if (units_[i]->isReady())
-            return true;
-    }
-    return false;
-}
-
 simtime_t LteHarqProcessTx::getOldestUnitTxTime()
 {
     simtime_t oldestTxTime = NOW + 1;
     simtime_t curTxTime = 0;
-    for (unsigned int i = 0; i < numHarqUnits_; i++) {
-        if (units_[i]->isReady()) {
+    for (Codeword i = 0; i < numHarqUnits_; i++) {
+        if (readyUnits_ & (1u << i)) {
             curTxTime = units_[i]->getTxTime();
             if (curTxTime < oldestTxTime) {
                 oldestTxTime = curTxTime;
@@ -124,38 +128,30 @@ simtime_t LteHarqProcessTx::getOldestUnitTxTime()
     return oldestTxTime;
 }
 
-CwList LteHarqProcessTx::readyUnitsIds()
+// builds the list of codewords whose bit is set in the given mask
+static CwList unitsIds(unsigned int mask)
 {
     CwList ul;
-
-    for (Codeword i = 0; i < numHarqUnits_; i++) {
-        if (units_[i]->isReady()) {
+    for (Codeword i = 0; mask != 0; i++, mask >>= 1) {
+        if (mask & 1)
             ul.push_back(i);
-        }
     }
     return ul;
 }
 
+CwList LteHarqProcessTx::readyUnitsIds()
+{
+    return unitsIds(readyUnits_);
+}
+
 CwList LteHarqProcessTx::emptyUnitsIds()
 {
-    CwList ul;
-    for (Codeword i = 0; i < numHarqUnits_; i++) {
-        if (units_[i]->isEmpty()) {
-            ul.push_back(i);
-        }
-    }
-    return ul;
+    return unitsIds(emptyUnits_);
 }
 
 CwList LteHarqProcessTx::selectedUnitsIds()
 {
-    CwList ul;
-    for (Codeword i = 0; i < numHarqUnits_; i++) {
-        if (units_[i]->isMarked()) {
-            ul.push_back(i);
-        }
-    }
-    return ul;
+    return unitsIds(selectedUnits_);
 }
 
 bool LteHarqProcessTx::isEmpty()
@@ -178,6 +174,7 @@ void LteHarqProcessTx::forceDropProcess()
 {
     for (unsigned int i = 0; i < numHarqUnits_; i++) {
         units_[i]->forceDropUnit();
+        updateUnitStatus(i);
     }
     numEmptyUnits_ = numHarqUnits_;
     numSelected_ = 0;
@@ -190,6 +187,7 @@ bool LteHarqProcessTx::forceDropUnit(Codeword cw)
         numSelected_--;
 
     units_[cw]->forceDropUnit();
+    updateUnitStatus(cw);
     numEmptyUnits_++;
 
     // empty process?
@@ -204,6 +202,7 @@ TxHarqPduStatus LteHarqProcessTx::getUnitStatus(Codeword cw)
 void LteHarqProcessTx::dropPdu(Codeword cw)
 {
     units_[cw]->dropPdu();
+    updateUnitStatus(cw);
     numEmptyUnits_++;
 }
 
@@ -245,14 +244,8 @@ bool LteHarqProcessTx::isDropped()
 // @author Alessandro Noferi
 bool LteHarqProcessTx::isHarqProcessActive()
 {
-    std::vector<UnitStatus> ues = getProcessStatus();
-
-    // When is a process active? (ask professor)
-    for (const auto& status : ues) {
-        if (status.second != TXHARQ_PDU_EMPTY)
-            return true;
-    }
-    return false;
+    // a process is active if at least one of its units is not empty
+    return emptyUnits_ != (1u << numHarqUnits_) - 1;
 }
 
 } //namespace
@@ -62,6 +62,17 @@ class LteHarqProcessTx : noncopyable
     /// This is useful in case the process receives a feedback after reset.
     bool dropped_;
 
+    /// Bitmasks of the units (bit i is codeword i) in BUFFERED, EMPTY and SELECTED state, respectively
+    unsigned int readyUnits_ = 0;
+    unsigned int emptyUnits_ = 0;
+    unsigned int selectedUnits_ = 0;
+
+    /**
+     * Updates the unit bitmasks according to the current status of the given unit.
+     * Must be called whenever the status of a unit may have changed.
+     */
+    void updateUnitStatus(Codeword cw);
+
   public:
 
     /*
@@ -108,7 +119,7 @@ class LteHarqProcessTx : noncopyable
      *
      * @return true if there is at least one unit ready for RTX, false if none
      */
-    bool hasReadyUnits();
+    bool hasReadyUnits() const { return readyUnits_ != 0; }
 
     /**
      * Returns the TX time of the unit which is not retransmitting for
@@ -119,6 +130,14 @@ class LteHarqProcessTx : noncopyable
      */
     simtime_t getOldestUnitTxTime();
 
+    /**
+     * Bitmasks of the units (bit i is codeword i) that are ready for retransmission,
+     * empty, or selected for transmission, respectively.
+     */
+    unsigned int getReadyUnits() const { return readyUnits_; }
+    unsigned int getEmptyUnits() const { return emptyUnits_; }
+    unsigned int getSelectedUnits() const { return selectedUnits_; }
+
     /**
      * Returns a list of IDs of ready for retransmission units of
      * this process.
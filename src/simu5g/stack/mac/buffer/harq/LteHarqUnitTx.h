@@ -204,6 +204,12 @@ class LteHarqUnitTx : noncopyable
 
   protected:
 
+    /**
+     * Creates an empty unit that is not attached to any MAC, and thus cannot
+     * carry PDUs (used by the kernel microbenchmarks).
+     */
+    LteHarqUnitTx(unsigned char acid, Codeword cw) : pduLength_(0), acid_(acid), cw_(cw), txTime_(0), maxHarqRtx_(0) {}
+
     virtual void resetUnit();
 };
 
@@ -72,6 +72,8 @@ void LteHarqBufferRxD2D::insertPdu(Codeword cw, Packet *pkt)
 void LteHarqBufferRxD2D::sendFeedback()
 {
     for (unsigned int i = 0; i < numHarqProcesses_; i++) {
+        if (processes_[i]->isEmpty())
+            continue;
         for (Codeword cw = 0; cw < MAX_CODEWORDS; ++cw) {
             if (processes_[i]->isEvaluated(cw)) {
                 // create a copy of the feedback to be sent to the eNB
@@ -108,12 +110,13 @@ void LteHarqBufferRxD2D::sendFeedback()
     }
 }
 
-std::list<Packet *> LteHarqBufferRxD2D::extractCorrectPdus()
+void LteHarqBufferRxD2D::extractCorrectPdus(std::vector<Packet *>& pdus)
 {
     this->sendFeedback();
-    std::list<Packet *> ret;
     unsigned char acid = 0;
     for (unsigned int i = 0; i < numHarqProcesses_; i++) {
+        if (processes_[i]->isEmpty())
+            continue;
         for (Codeword cw = 0; cw < MAX_CODEWORDS; ++cw) {
             if (processes_[i]->isCorrect(cw)) {
                 auto temp = processes_[i]->extractPdu(cw);
@@ -147,17 +150,15 @@ std::list<Packet *> LteHarqBufferRxD2D::extractCorrectPdus()
                     }
                 }
 
-                ret.push_back(temp);
+                pdus.push_back(temp);
                 acid = i;
 
-                EV << "LteHarqBufferRxD2D::extractCorrectPdus H-ARQ RX: PDU (id " << ret.back()->getId()
+                EV << "LteHarqBufferRxD2D::extractCorrectPdus H-ARQ RX: PDU (id " << pdus.back()->getId()
                    << " ) extracted from process " << (int)acid
                    << " to be sent upper" << endl;
             }
         }
     }
-
-    return ret;
 }
 
 
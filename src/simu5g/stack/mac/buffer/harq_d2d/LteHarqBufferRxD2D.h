@@ -62,9 +62,9 @@ class LteHarqBufferRxD2D : public LteHarqBufferRx
      * Sends feedback for all processes which are older than
      * HARQ_FB_EVALUATION_INTERVAL, then extracts the PDU in correct state (if any)
      *
-     * @return uncorrupted PDUs or empty list if none
+     * @param pdus caller-owned storage the uncorrupted PDUs (if any) are appended to
      */
-    std::list<inet::Packet *> extractCorrectPdus() override;
+    void extractCorrectPdus(std::vector<inet::Packet *>& pdus) override;
 
 };
 
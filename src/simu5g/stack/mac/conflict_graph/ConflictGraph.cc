@@ -16,12 +16,80 @@ namespace simu5g {
 
 using namespace omnetpp;
 
+void CGMatrix::reset(const std::vector<CGVertex>& vertices)
+{
+    vertices_ = vertices;
+    vertexIndex_.clear();
+    for (unsigned int i = 0; i < vertices_.size(); i++)
+        vertexIndex_[vertices_[i]] = i;
+
+    numWords_ = (vertices_.size() + 63) / 64;
+    rows_.assign(vertices_.size() * numWords_, 0);
+
+    senderIndex_.clear();
+    for (const auto& v : vertices_)
+        senderIndex_.emplace(v.srcId, senderIndex_.size());
+    numSenderWords_ = (senderIndex_.size() + 63) / 64;
+    senderRows_.assign(senderIndex_.size() * numSenderWords_, 0);
+}
+
+void CGMatrix::setConflict(unsigned int i, unsigned int j)
+{
+    rows_[i * numWords_ + (j >> 6)] |= (uint64_t)1 << (j & 63);
+    rows_[j * numWords_ + (i >> 6)] |= (uint64_t)1 << (i & 63);
+}
+
+void CGMatrix::clearConflicts(unsigned int i)
+{
+    uint64_t *row = &rows_[i * numWords_];
+    for (unsigned int w = 0; w < numWords_; w++) {
+        // clear the symmetric entries
+        for (uint64_t bits = row[w]; bits != 0; bits &= bits - 1) {
+            unsigned int j = w * 64 + __builtin_ctzll(bits);
+            rows_[j * numWords_ + (i >> 6)] &= ~((uint64_t)1 << (i & 63));
+        }
+        row[w] = 0;
+    }
+}
+
+void CGMatrix::updateSenders()
+{
+    std::fill(senderRows_.begin(), senderRows_.end(), 0);
+    for (unsigned int i = 0; i < vertices_.size(); i++) {
+        uint64_t *senderRow = &senderRows_[senderIndex_.at(vertices_[i].srcId) * numSenderWords_];
+        const uint64_t *row = &rows_[i * numWords_];
+        for (unsigned int w = 0; w < numWords_; w++) {
+            for (uint64_t bits = row[w]; bits != 0; bits &= bits - 1) {
+                unsigned int s = senderIndex_.at(vertices_[w * 64 + __builtin_ctzll(bits)].srcId);
+                senderRow[s >> 6] |= (uint64_t)1 << (s & 63);
+            }
+        }
+    }
+}
+
+bool CGMatrix::isConflicting(MacNodeId nodeIdA, MacNodeId nodeIdB) const
+{
+    auto itA = senderIndex_.find(nodeIdA);
+    auto itB = senderIndex_.find(nodeIdB);
+    if (itA == senderIndex_.end() || itB == senderIndex_.end())
+        return false;
+
+    unsigned int b = itB->second;
+    return (senderRows_[itA->second * numSenderWords_ + (b >> 6)] >> (b & 63)) & 1;
+}
+
+int CGMatrix::getVertexIndex(const CGVertex& v) const
+{
+    auto it = vertexIndex_.find(v);
+    return (it == vertexIndex_.end()) ? -1 : it->second;
+}
+
 /*!
  * \fn ConflictGraph()
  * \memberof ConflictGraph
  * \brief class constructor;
  */
-ConflictGraph::ConflictGraph(Binder *binder, LteMacEnbD2D *macEnb, bool reuseD2D, bool reuseD2DMulti) : binder_(binder), macEnb_(macEnb), cellInfo_(macEnb_->getCellInfo()), reuseD2D_(reuseD2D), reuseD2DMulti_(reuseD2DMulti)
+ConflictGraph::ConflictGraph(Binder *binder, LteMacEnbD2D *macEnb, bool reuseD2D, bool reuseD2DMulti) : binder_(binder), macEnb_(macEnb), cellInfo_(macEnb != nullptr ? macEnb->getCellInfo() : nullptr), reuseD2D_(reuseD2D), reuseD2DMulti_(reuseD2DMulti)
 {
 }
 
@@ -34,23 +102,61 @@ ConflictGraph::ConflictGraph(Binder *binder, LteMacEnbD2D *macEnb, bool reuseD2D
 // reset Conflict Graph
 void ConflictGraph::clearConflictGraph()
 {
-    conflictGraph_.clear();
+    conflictGraph_.reset(std::vector<CGVertex>());
+    txPositions_.clear();
+    rxPositions_.clear();
+}
+
+void ConflictGraph::updatePositions(const std::vector<CGVertex>& vertices, bool reset, std::vector<unsigned int>& moved)
+{
+    txPositions_.resize(vertices.size());
+    rxPositions_.resize(vertices.size());
+    for (unsigned int i = 0; i < vertices.size(); i++) {
+        inet::Coord txPos = cellInfo_->getUePosition(vertices[i].srcId);
+        inet::Coord rxPos = vertices[i].isMulticast() ? txPos : cellInfo_->getUePosition(vertices[i].dstId);
+        if (reset || txPos != txPositions_[i] || rxPos != rxPositions_[i]) {
+            txPositions_[i] = txPos;
+            rxPositions_[i] = rxPos;
+            moved.push_back(i);
+        }
+    }
+}
+
+void ConflictGraph::updateEdges(const std::vector<CGVertex>& vertices, const std::vector<unsigned int>& moved)
+{
+    conflictGraph_.reset(vertices);
+    findEdges(vertices);
 }
 
 void ConflictGraph::computeConflictGraph()
 {
     EV << " ConflictGraph::computeConflictGraph - START " << endl;
 
-    // --- remove the old one --- //
-    clearConflictGraph();
-
     // --- find the vertices of the graph by scanning the peering map --- //
     std::vector<CGVertex> vertices;
     findVertices(vertices);
     EV << " ConflictGraph::computeConflictGraph - " << vertices.size() << " vertices found" << endl;
 
-    // --- for each CGVertex, find the interfering vertices --- //
-    findEdges(vertices);
+    std::vector<unsigned int> moved;
+    if (vertices != conflictGraph_.getVertices()) {
+        // --- the set of links changed: remove the old graph and build a new one --- //
+        conflictGraph_.reset(vertices);
+        updatePositions(vertices, true, moved);
+
+        // --- for each CGVertex, find the interfering vertices --- //
+        findEdges(vertices);
+    }
+    else {
+        // --- same links: only update the edges of the links whose endpoints moved --- //
+        updatePositions(vertices, false, moved);
+        EV << " ConflictGraph::computeConflictGraph - " << moved.size() << " vertices moved" << endl;
+        if (moved.empty()) {
+            EV << " ConflictGraph::computeConflictGraph - END (unchanged)" << endl;
+            return;
+        }
+        updateEdges(vertices, moved);
+    }
+    conflictGraph_.updateSenders();
 
     EV << " ConflictGraph::computeConflictGraph - END " << endl;
 }
@@ -64,8 +170,10 @@ void ConflictGraph::printConflictGraph()
         return;
     }
 
+    const std::vector<CGVertex>& vertices = conflictGraph_.getVertices();
+
     EV << "              ";
-    for (const auto& [key, value] : conflictGraph_) {
+    for (const auto& key : vertices) {
         if (key.isMulticast())
             EV << "| (" << key.srcId << ", *  ) ";
         else
@@ -73,17 +181,18 @@ void ConflictGraph::printConflictGraph()
     }
     EV << endl;
 
-    for (const auto& [key, value] : conflictGraph_) {
+    for (unsigned int i = 0; i < vertices.size(); i++) {
+        const CGVertex& key = vertices[i];
         if (key.isMulticast())
             EV << "| (" << key.srcId << ", *  ) ";
         else
             EV << "| (" << key.srcId << "," << key.dstId << ") ";
-        for (const auto& [innerKey, innerValue] : value) {
-            if (key == innerKey) {
+        for (unsigned int j = 0; j < vertices.size(); j++) {
+            if (i == j) {
                 EV << "|      -      ";
             }
             else {
-                EV << "|      " << innerValue << "      ";
+                EV << "|      " << conflictGraph_.isConflicting(i, j) << "      ";
             }
         }
         EV << endl;
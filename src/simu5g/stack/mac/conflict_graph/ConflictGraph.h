@@ -13,6 +13,8 @@
 #ifndef CONFLICTGRAPH_H
 #define CONFLICTGRAPH_H
 
+#include <unordered_map>
+
 #include "simu5g/stack/mac/LteMacEnbD2D.h"
 #include "simu5g/common/cellInfo/CellInfo.h"
 
@@ -60,7 +62,58 @@ struct CGVertex
 
 };
 
-typedef std::map<CGVertex, std::map<CGVertex, bool>> CGMatrix;
+/*
+ * Compact adjacency structure of the conflict graph.
+ *
+ * Vertices are densely indexed and each row of the matrix is a bitset over
+ * the vertex indices, so that only conflicting pairs are stored (as set bits).
+ * Since resource allocation only cares about whether two transmitters conflict,
+ * a second bitset matrix indexed by transmitter is derived from the vertex one.
+ */
+class CGMatrix
+{
+    // vertices of the graph, and their position in the matrix
+    std::vector<CGVertex> vertices_;
+    std::map<CGVertex, unsigned int> vertexIndex_;
+
+    // bitset rows over vertices (numWords_ 64-bit words per row)
+    unsigned int numWords_ = 0;
+    std::vector<uint64_t> rows_;
+
+    // bitset rows over transmitters (numSenderWords_ 64-bit words per row)
+    std::unordered_map<MacNodeId, unsigned int> senderIndex_;
+    unsigned int numSenderWords_ = 0;
+    std::vector<uint64_t> senderRows_;
+
+  public:
+    // reset the matrix with the given set of vertices and no edges
+    void reset(const std::vector<CGVertex>& vertices);
+
+    // add a (symmetric) edge between the vertices with the given indices
+    void setConflict(unsigned int i, unsigned int j);
+
+    // remove all the edges of the vertex with the given index
+    void clearConflicts(unsigned int i);
+
+    // rebuild the transmitter matrix after the vertex matrix has been updated
+    void updateSenders();
+
+    bool isConflicting(unsigned int i, unsigned int j) const
+    {
+        return (rows_[i * numWords_ + (j >> 6)] >> (j & 63)) & 1;
+    }
+
+    // returns true if any link transmitted by nodeIdA conflicts with any link transmitted by nodeIdB
+    bool isConflicting(MacNodeId nodeIdA, MacNodeId nodeIdB) const;
+
+    // returns the index of the given vertex, or -1 if it is not part of the graph
+    int getVertexIndex(const CGVertex& v) const;
+
+    const std::vector<CGVertex>& getVertices() const { return vertices_; }
+    unsigned int size() const { return vertices_.size(); }
+    bool empty() const { return vertices_.empty(); }
+};
+
 class CellInfo;
 class LteMacEnbD2D;
 
@@ -88,6 +141,10 @@ class ConflictGraph
     // Conflict Graph
     CGMatrix conflictGraph_;
 
+    // position of the transmitter and of the receiver of each vertex, as of the last computation
+    std::vector<inet::Coord> txPositions_;
+    std::vector<inet::Coord> rxPositions_;
+
     // flag for enabling/disabling sharing models
     bool reuseD2D_;
     bool reuseD2DMulti_;
@@ -95,9 +152,24 @@ class ConflictGraph
     // reset Conflict Graph
     void clearConflictGraph();
 
+    // store the current positions of the endpoints of the vertices, and return the indices of those that moved
+    void updatePositions(const std::vector<CGVertex>& vertices, bool reset, std::vector<unsigned int>& moved);
+
+    // set the positions of the endpoints of the vertices, e.g., for vertices without mobility modules
+    void setPositions(const std::vector<inet::Coord>& txPositions, const std::vector<inet::Coord>& rxPositions)
+    {
+        txPositions_ = txPositions;
+        rxPositions_ = rxPositions;
+    }
+
     virtual void findVertices(std::vector<CGVertex>& vertices) = 0;
+
+    // compute the edges among all the vertices (conflictGraph_ has no edges when this is called)
     virtual void findEdges(const std::vector<CGVertex>& vertices) = 0;
 
+    // recompute the edges of the given (moved) vertices only. By default, the whole graph is recomputed
+    virtual void updateEdges(const std::vector<CGVertex>& vertices, const std::vector<unsigned int>& moved);
+
   public:
 
     ConflictGraph(Binder *binder, LteMacEnbD2D *macEnb, bool reuseD2D, bool reuseD2DMulti);
@@ -81,174 +81,201 @@ void DistanceBasedConflictGraph::findVertices(std::vector<CGVertex>& vertices)
     }
 }
 
-void DistanceBasedConflictGraph::findEdges(const std::vector<CGVertex>& vertices)
+double DistanceBasedConflictGraph::getSearchRadius() const
 {
-    for (auto vit = vertices.begin(), vet = vertices.end(); vit != vet; ++vit) {
-        const CGVertex& v1 = *vit;
-
-        for (auto it = vit; it != vet; ++it) {
-            const CGVertex& v2 = *it;
+    double radius = 0.0;
+    if (reuseD2D_) {
+        // P2P-P2P
+        if (d2dInterferenceRadius_ <= 0.0)
+            return -1.0;
+        radius = std::max(radius, d2dInterferenceRadius_);
+    }
+    if (reuseD2DMulti_) {
+        // P2MP-P2MP
+        if (d2dMultiTransmissionRadius_ <= 0.0 || d2dMultiInterferenceRadius_ <= 0.0)
+            return -1.0;
+        radius = std::max(radius, d2dMultiTransmissionRadius_ + d2dMultiInterferenceRadius_);
+    }
+    if (reuseD2D_ && reuseD2DMulti_) {
+        // P2P-P2MP and P2MP-P2P (the radii have already been checked)
+        radius = std::max(radius, d2dMultiTransmissionRadius_ + d2dInterferenceRadius_);
+        radius = std::max(radius, d2dMultiInterferenceRadius_);
+    }
+    return radius;
+}
 
-            if (v1 == v2) {
-                // self conflict
-                conflictGraph_[v1][v2] = true;
-                conflictGraph_[v2][v1] = true;
-                continue;
-            }
+uint64_t DistanceBasedConflictGraph::getGridCell(const Coord& pos, int dx, int dy) const
+{
+    int32_t x = (int32_t)std::floor(pos.x / gridCellSize_) + dx;
+    int32_t y = (int32_t)std::floor(pos.y / gridCellSize_) + dy;
+    return ((uint64_t)(uint32_t)x << 32) | (uint32_t)y;
+}
 
-            // Depending on the considered pair of vertices, we are in one of the following cases:
-            //  -> P2P-P2P
-            //  -> P2P-P2MP
-            //  -> P2MP-P2P
-            //  -> P2MP-P2MP
-            //
-            // Each case has a different condition to be verified. The condition can be based on either
-            // distance or dBm thresholds, depending on whether distance thresholds are initialized or not
-
-            if (!v1.isMulticast() && !v2.isMulticast()) { // check P2P-P2P conflict
-                // obtain the position of v1's endpoints
-                Coord v1SenderCoord = cellInfo_->getUePosition(v1.srcId);
-                Coord v1DestCoord = cellInfo_->getUePosition(v1.dstId);
-                // obtain the position of v2's endpoints
-                Coord v2SenderCoord = cellInfo_->getUePosition(v2.srcId);
-                Coord v2DestCoord = cellInfo_->getUePosition(v2.dstId);
-                double distance1 = v1SenderCoord.distance(v2DestCoord);
-                double distance2 = v2SenderCoord.distance(v1DestCoord);
-
-                if (d2dInterferenceRadius_ > 0.0) { // distance threshold initialized
-                    // compare distances
-
-                    if (distance1 < d2dInterferenceRadius_ || distance2 < d2dInterferenceRadius_) {
-                        // add edge to the conflict graph
-                        conflictGraph_[v1][v2] = true;
-                        conflictGraph_[v2][v1] = true;
-                    }
-                    else {
-                        conflictGraph_[v1][v2] = false;
-                        conflictGraph_[v2][v1] = false;
-                    }
-                }
-                else {
-                    // compare path-loss attenuations
+void DistanceBasedConflictGraph::buildSpatialIndex(const std::vector<CGVertex>& vertices, double cellSize)
+{
+    gridCellSize_ = cellSize;
+    grid_.clear();
+    for (unsigned int i = 0; i < vertices.size(); i++) {
+        uint64_t txCell = getGridCell(txPositions_[i]);
+        grid_[txCell].push_back(i);
+        if (!vertices[i].isMulticast()) {
+            uint64_t rxCell = getGridCell(rxPositions_[i]);
+            if (rxCell != txCell)
+                grid_[rxCell].push_back(i);
+        }
+    }
+    visitStamp_.assign(vertices.size(), 0);
+    currentStamp_ = 0;
+}
 
-                    if (getDbmFromDistance(distance1) < d2dDbmThreshold_ || getDbmFromDistance(distance2) < d2dDbmThreshold_) {
-                        // add edge to the conflict graph
-                        conflictGraph_[v1][v2] = true;
-                        conflictGraph_[v2][v1] = true;
-                    }
-                    else {
-                        conflictGraph_[v1][v2] = false;
-                        conflictGraph_[v2][v1] = false;
+void DistanceBasedConflictGraph::findCandidates(const std::vector<CGVertex>& vertices, unsigned int i, std::vector<unsigned int>& candidates)
+{
+    // cells are as large as the search radius, hence any endpoint closer than the radius
+    // to one of the endpoints of the vertex lies in the 3x3 block of cells around it
+    candidates.clear();
+    currentStamp_++;
+    visitStamp_[i] = currentStamp_;
+    unsigned int numEndpoints = vertices[i].isMulticast() ? 1 : 2;
+    for (unsigned int e = 0; e < numEndpoints; e++) {
+        const Coord& pos = (e == 0) ? txPositions_[i] : rxPositions_[i];
+        for (int dx = -1; dx <= 1; dx++) {
+            for (int dy = -1; dy <= 1; dy++) {
+                auto it = grid_.find(getGridCell(pos, dx, dy));
+                if (it == grid_.end())
+                    continue;
+                for (unsigned int j : it->second) {
+                    if (visitStamp_[j] != currentStamp_) {
+                        visitStamp_[j] = currentStamp_;
+                        candidates.push_back(j);
                     }
                 }
             }
-            else if (!v1.isMulticast() && v2.isMulticast()) { // check P2P-P2MP conflict
-                // obtain the position of v1's transmitter
-                Coord v1SenderCoord = cellInfo_->getUePosition(v1.srcId);
-                // obtain the position of v2 transmitter
-                Coord v2SenderCoord = cellInfo_->getUePosition(v2.srcId);
-
-                double distance = v1SenderCoord.distance(v2SenderCoord);
+        }
+    }
+}
 
-                if (d2dMultiTransmissionRadius_ > 0.0 && d2dInterferenceRadius_ > 0.0) { // distance threshold initialized
-                    // compare distances
+void DistanceBasedConflictGraph::findEdges(const std::vector<CGVertex>& vertices)
+{
+    // only the pairs of vertices having endpoints within the search radius are tested,
+    // when all the conditions are based on distance thresholds
+    double radius = getSearchRadius();
+    bool useSpatialIndex = radius > 0.0;
+    if (useSpatialIndex)
+        buildSpatialIndex(vertices, radius);
+
+    std::vector<unsigned int> candidates;
+    for (unsigned int i = 0; i < vertices.size(); i++) {
+        // self conflict
+        conflictGraph_.setConflict(i, i);
+
+        if (useSpatialIndex) {
+            findCandidates(vertices, i, candidates);
+            for (unsigned int j : candidates) {
+                if (j > i && checkConflict(vertices, i, j))
+                    conflictGraph_.setConflict(i, j);
+            }
+        }
+        else {
+            for (unsigned int j = i + 1; j < vertices.size(); j++) {
+                if (checkConflict(vertices, i, j))
+                    conflictGraph_.setConflict(i, j);
+            }
+        }
+    }
+}
 
-                    if (distance < d2dMultiTransmissionRadius_ + d2dInterferenceRadius_) {
-                        // add edge to the conflict graph
-                        conflictGraph_[v1][v2] = true;
-                        conflictGraph_[v2][v1] = true;
-                    }
-                    else {
-                        conflictGraph_[v1][v2] = false;
-                        conflictGraph_[v2][v1] = false;
-                    }
-                }
-                else {
-                    // compare path-loss attenuations
+void DistanceBasedConflictGraph::updateEdges(const std::vector<CGVertex>& vertices, const std::vector<unsigned int>& moved)
+{
+    std::vector<bool> isMoved(vertices.size(), false);
+    for (unsigned int i : moved) {
+        isMoved[i] = true;
+        conflictGraph_.clearConflicts(i);
+    }
 
-                    if (getDbmFromDistance(distance) < d2dMultiTxDbmThreshold_ + d2dDbmThreshold_) {
-                        // add edge to the conflict graph
-                        conflictGraph_[v1][v2] = true;
-                        conflictGraph_[v2][v1] = true;
-                    }
-                    else {
-                        conflictGraph_[v1][v2] = false;
-                        conflictGraph_[v2][v1] = false;
-                    }
-                }
-            }
-            else if (v1.isMulticast() && !v2.isMulticast()) { // check P2MP-P2P conflict
-                // obtain the position of v1's transmitter
-                Coord v1SenderCoord = cellInfo_->getUePosition(v1.srcId);
-                // obtain the position of v2's receiver
-                Coord v2DestCoord = cellInfo_->getUePosition(v2.dstId);
+    double radius = getSearchRadius();
+    bool useSpatialIndex = radius > 0.0;
+    if (useSpatialIndex)
+        buildSpatialIndex(vertices, radius);
+
+    std::vector<unsigned int> candidates;
+    for (unsigned int i : moved) {
+        // self conflict
+        conflictGraph_.setConflict(i, i);
+
+        if (useSpatialIndex)
+            findCandidates(vertices, i, candidates);
+        else {
+            candidates.clear();
+            for (unsigned int j = 0; j < vertices.size(); j++)
+                candidates.push_back(j);
+        }
 
-                double distance = v1SenderCoord.distance(v2DestCoord);
+        for (unsigned int j : candidates) {
+            // pairs of moved vertices are tested only once
+            if (j == i || (isMoved[j] && j < i))
+                continue;
+            // conditions are not symmetric for mixed P2P/P2MP pairs: keep the same order as findEdges()
+            if (checkConflict(vertices, std::min(i, j), std::max(i, j)))
+                conflictGraph_.setConflict(i, j);
+        }
+    }
+}
 
-                if (d2dMultiInterferenceRadius_ > 0.0) { // distance threshold initialized
-                    // compare distances
+bool DistanceBasedConflictGraph::checkConflict(const std::vector<CGVertex>& vertices, unsigned int i, unsigned int j)
+{
+    const CGVertex& v1 = vertices[i];
+    const CGVertex& v2 = vertices[j];
+
+    // Depending on the considered pair of vertices, we are in one of the following cases:
+    //  -> P2P-P2P
+    //  -> P2P-P2MP
+    //  -> P2MP-P2P
+    //  -> P2MP-P2MP
+    //
+    // Each case has a different condition to be verified. The condition can be based on either
+    // distance or dBm thresholds, depending on whether distance thresholds are initialized or not
+
+    if (!v1.isMulticast() && !v2.isMulticast()) { // check P2P-P2P conflict
+        // distance between each sender and the receiver of the other link
+        double distance1 = txPositions_[i].distance(rxPositions_[j]);
+        double distance2 = txPositions_[j].distance(rxPositions_[i]);
+
+        if (d2dInterferenceRadius_ > 0.0) // distance threshold initialized
+            return distance1 < d2dInterferenceRadius_ || distance2 < d2dInterferenceRadius_;
+
+        // compare path-loss attenuations
+        return getDbmFromDistance(distance1) < d2dDbmThreshold_ || getDbmFromDistance(distance2) < d2dDbmThreshold_;
+    }
+    else if (!v1.isMulticast() && v2.isMulticast()) { // check P2P-P2MP conflict
+        // distance between the transmitters
+        double distance = txPositions_[i].distance(txPositions_[j]);
 
-                    if (distance < d2dMultiInterferenceRadius_) {
-                        // add edge to the conflict graph
-                        conflictGraph_[v1][v2] = true;
-                        conflictGraph_[v2][v1] = true;
-                    }
-                    else {
-                        conflictGraph_[v1][v2] = false;
-                        conflictGraph_[v2][v1] = false;
-                    }
-                }
-                else {
-                    // compare path-loss attenuations
+        if (d2dMultiTransmissionRadius_ > 0.0 && d2dInterferenceRadius_ > 0.0) // distance threshold initialized
+            return distance < d2dMultiTransmissionRadius_ + d2dInterferenceRadius_;
 
-                    if (getDbmFromDistance(distance) < d2dMultiInterfDbmThreshold_) {
-                        // add edge to the conflict graph
-                        conflictGraph_[v1][v2] = true;
-                        conflictGraph_[v2][v1] = true;
-                    }
-                    else {
-                        conflictGraph_[v1][v2] = false;
-                        conflictGraph_[v2][v1] = false;
-                    }
-                }
-            }
-            else if (v1.isMulticast() && v2.isMulticast()) {  // check P2MP-P2MP conflict
-                // obtain the position of v1's transmitter
-                Coord v1SenderCoord = cellInfo_->getUePosition(v1.srcId);
-                // obtain the position of v2 transmitter
-                Coord v2SenderCoord = cellInfo_->getUePosition(v2.srcId);
+        // compare path-loss attenuations
+        return getDbmFromDistance(distance) < d2dMultiTxDbmThreshold_ + d2dDbmThreshold_;
+    }
+    else if (v1.isMulticast() && !v2.isMulticast()) { // check P2MP-P2P conflict
+        // distance between v1's transmitter and v2's receiver
+        double distance = txPositions_[i].distance(rxPositions_[j]);
 
-                double distance = v1SenderCoord.distance(v2SenderCoord);
+        if (d2dMultiInterferenceRadius_ > 0.0) // distance threshold initialized
+            return distance < d2dMultiInterferenceRadius_;
 
-                if (d2dMultiTransmissionRadius_ > 0.0 && d2dMultiInterferenceRadius_ > 0.0) { // distance threshold initialized
-                    // compare distances
+        // compare path-loss attenuations
+        return getDbmFromDistance(distance) < d2dMultiInterfDbmThreshold_;
+    }
+    else { // check P2MP-P2MP conflict
+        // distance between the transmitters
+        double distance = txPositions_[i].distance(txPositions_[j]);
 
-                    if (distance < d2dMultiTransmissionRadius_ + d2dMultiInterferenceRadius_) {
-                        // add edge to the conflict graph
-                        conflictGraph_[v1][v2] = true;
-                        conflictGraph_[v2][v1] = true;
-                    }
-                    else {
-                        conflictGraph_[v1][v2] = false;
-                        conflictGraph_[v2][v1] = false;
-                    }
-                }
-                else {
-                    // compare path-loss attenuations
+        if (d2dMultiTransmissionRadius_ > 0.0 && d2dMultiInterferenceRadius_ > 0.0) // distance threshold initialized
+            return distance < d2dMultiTransmissionRadius_ + d2dMultiInterferenceRadius_;
 
-                    if (getDbmFromDistance(distance) < d2dMultiTxDbmThreshold_ + d2dMultiInterfDbmThreshold_) {
-                        // add edge to the conflict graph
-                        conflictGraph_[v1][v2] = true;
-                        conflictGraph_[v2][v1] = true;
-                    }
-                    else {
-                        conflictGraph_[v1][v2] = false;
-                        conflictGraph_[v2][v1] = false;
-                    }
-                }
-            }
-        }  // end inner loop
-    } // end outer loop
+        // compare path-loss attenuations
+        return getDbmFromDistance(distance) < d2dMultiTxDbmThreshold_ + d2dMultiInterfDbmThreshold_;
+    }
 }
 
 } //namespace
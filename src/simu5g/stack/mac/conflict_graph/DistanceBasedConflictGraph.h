@@ -29,12 +29,34 @@ class DistanceBasedConflictGraph : public ConflictGraph
     double d2dMultiTransmissionRadius_ = -1.0;
     double d2dMultiInterferenceRadius_ = -1.0;
 
+    // spatial index: uniform grid over the endpoints of the vertices, each cell lists the vertices having an endpoint in it
+    double gridCellSize_ = 0.0;
+    std::unordered_map<uint64_t, std::vector<unsigned int>> grid_;
+
+    // scratch storage used to avoid duplicate candidates
+    std::vector<unsigned int> visitStamp_;
+    unsigned int currentStamp_ = 0;
+
     // utility function to convert a distance to dBm according to the channel model
     double getDbmFromDistance(double distance);
 
+    // returns true if the vertices with the given indices conflict
+    bool checkConflict(const std::vector<CGVertex>& vertices, unsigned int i, unsigned int j);
+
+    // returns the maximum distance between any two endpoints of conflicting vertices,
+    // or a negative value if (at least) one of the applicable conditions is based on dBm thresholds
+    double getSearchRadius() const;
+
+    // spatial index management
+    uint64_t getGridCell(const inet::Coord& pos, int dx = 0, int dy = 0) const;
+    void buildSpatialIndex(const std::vector<CGVertex>& vertices, double cellSize);
+    void findCandidates(const std::vector<CGVertex>& vertices, unsigned int i, std::vector<unsigned int>& candidates);
+
+  protected:
     // overridden functions
     void findVertices(std::vector<CGVertex>& vertices) override;
     void findEdges(const std::vector<CGVertex>& vertices) override;
+    void updateEdges(const std::vector<CGVertex>& vertices, const std::vector<unsigned int>& moved) override;
 
   public:
     DistanceBasedConflictGraph(Binder *binder, LteMacEnbD2D *macEnb, bool reuseD2D, bool reuseD2DMulti, double dbmThresh);
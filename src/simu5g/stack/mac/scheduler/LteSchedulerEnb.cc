@@ -49,6 +49,7 @@ void LteSchedulerEnb::initialize(int stage)
 
     mac_ = check_and_cast<LteMacEnb *>(getParentModule());
     binder_ = check_and_cast<Binder *>(getModuleByPath(mac_->par("binderModule").stringValue()));
+    scheduleProfile_ = Profiling::getCounter(this, "schedule");
     direction_ = getDirection();
     resourceBlocks_ = mac_->getCellInfo()->getNumBands();
 
@@ -92,6 +93,7 @@ void LteSchedulerEnb::initializeSchedulerPeriodCounter(NumerologyIndex maxNumero
 
 std::map<GHz, LteMacScheduleList> *LteSchedulerEnb::schedule()
 {
+    ProfilingScope profiling(scheduleProfile_);
     EV << "LteSchedulerEnb::schedule performed by Node: " << mac_->getMacNodeId() << endl;
 
     // clearing structures for new scheduling
@@ -77,6 +77,8 @@ class LteSchedulerEnb : public cSimpleModule
     // Reference to the LTE Binder
     opp_component_ptr<Binder> binder_;
 
+    ProfilingCounter *scheduleProfile_ = nullptr;
+
     // System allocator, carries out the block-allocation functions.
     LteAllocationModule *allocator_ = nullptr;
 
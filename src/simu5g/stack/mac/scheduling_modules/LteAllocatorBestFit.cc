@@ -62,27 +62,7 @@ void LteAllocatorBestFit::checkHole(Candidate& candidate, Band holeIndex, unsign
 
 bool LteAllocatorBestFit::checkConflict(const CGMatrix *cgMatrix, MacNodeId nodeIdA, MacNodeId nodeIdB)
 {
-    bool conflict = false;
-
-    for (const auto &[key, value] : *cgMatrix) {
-        if (key.srcId != nodeIdA)
-            continue;
-
-        for (const auto &[confKey, confValue] : value) {
-            if (confKey.srcId != nodeIdB)
-                continue;
-
-            if (confValue) {
-                conflict = true;
-                break;
-            }
-        }
-
-        if (conflict)
-            break;
-    }
-
-    return conflict;
+    return cgMatrix->isConflicting(nodeIdA, nodeIdB);
 }
 
 void LteAllocatorBestFit::prepareSchedule()
@@ -31,6 +31,15 @@ void PacketFlowObserverBase::initialize(int stage)
         harqProcesses_ = mac->harqProcesses();
         pfmType = par("pfmType").stringValue();
 
+        int sduSamplingRate = par("sduSamplingRate");
+        if (sduSamplingRate < 1)
+            throw cRuntimeError("%s::initialize - sduSamplingRate must be at least 1, got %d", pfmType.c_str(), sduSamplingRate);
+        sduSamplingRate_ = sduSamplingRate;
+        initialTrackingWindow_ = par("initialTrackingWindow");
+        maxTrackingWindow_ = par("maxTrackingWindow");
+        if (initialTrackingWindow_ == 0 || maxTrackingWindow_ < initialTrackingWindow_)
+            throw cRuntimeError("%s::initialize - invalid tracking window size", pfmType.c_str());
+
         // Subscribe to PDCP signals
         cModule *pdcpModule = getModuleFromPar<cModule>(par("pdcpModule"), this);
         bool isNrObserver = par("isNrObserver").boolValue();
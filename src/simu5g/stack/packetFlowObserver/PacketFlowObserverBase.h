@@ -15,12 +15,12 @@
 
 #include "simu5g/common/LteCommon.h"
 #include "simu5g/mec/utils/MecCommon.h"
+#include "simu5g/stack/packetFlowObserver/SequenceNumberWindow.h"
 
 namespace simu5g {
 
 using namespace omnetpp;
 
-typedef std::set<unsigned int> SequenceNumberSet;
 typedef unsigned int BurstId;
 
 class LteRlcUmDataPdu;
@@ -58,12 +58,39 @@ class PacketFlowObserverBase : public cSimpleModule, public cListener
      * used to calculate L2Meas of RNI service
      */
     struct PdcpStatus {
-        bool hasArrivedAll;
-        bool discardedAtRlc;
-        bool discardedAtMac;
-        bool sentOverTheAir;
-        unsigned int pdcpSduSize;
+        bool hasArrivedAll = false;
+        bool discardedAtRlc = false;
+        bool discardedAtMac = false;
+        bool sentOverTheAir = false;
+        unsigned int pdcpSduSize = 0;
         simtime_t entryTime;
+        SequenceNumberSet rlcPdus; // RLC PDUs where the PDCP PDU was fragmented and not yet acknowledged or discarded
+
+        void clear()
+        {
+            hasArrivedAll = discardedAtRlc = discardedAtMac = sentOverTheAir = false;
+            pdcpSduSize = 0;
+            entryTime = SIMTIME_ZERO;
+            rlcPdus.clear();
+        }
+    };
+
+    /*
+     * RLC PDU tracked by the observer: the RLC SDUs (PDCP PDUs) included in it and,
+     * if it belongs to a burst, the burst ID and the size of the RLC SDUs counted
+     * in the burst volume
+     */
+    struct RlcPduStatus {
+        SequenceNumberSet pdcpSnos;
+        BurstId burstId = 0;
+        unsigned int burstVolume = 0;
+
+        void clear()
+        {
+            pdcpSnos.clear();
+            burstId = 0;
+            burstVolume = 0;
+        }
     };
 
     DiscardedPkts pktDiscardCounterTotal_; // total discarded packets counter of the node
@@ -75,6 +102,14 @@ class PacketFlowObserverBase : public cSimpleModule, public cListener
 
     int headerCompressedSize_;
 
+    // only one PDCP SDU every sduSamplingRate_ is tracked down to the MAC layer for the
+    // delay and discard statistics (data volume and throughput account for all of them)
+    unsigned int sduSamplingRate_ = 1;
+
+    // initial and maximum number of sequence numbers tracked per DRB
+    unsigned int initialTrackingWindow_ = 64;
+    unsigned int maxTrackingWindow_ = 8192;
+
   protected:
     int numInitStages() const override { return inet::NUM_INIT_STAGES; }
     void initialize(int stage) override;
@@ -93,6 +128,9 @@ class PacketFlowObserverBase : public cSimpleModule, public cListener
     // Reset data structures for all connections
     virtual void clearAllDrbIds() = 0;
 
+    // Return true if the PDCP SDU with the given sequence number is tracked
+    bool isSampled(unsigned int pdcpSno) const { return sduSamplingRate_ == 1 || pdcpSno % sduSamplingRate_ == 0; }
+
   public:
     /**
      * This method is called when a PDCP SDU enters the PDCP layer for downlink transmission.
@@ -47,12 +47,13 @@ void PacketFlowObserverEnb::initDrbId(DrbId drbId, MacNodeId nodeId)
         throw cRuntimeError("%s::initDrbId - DRB ID %d already present", pfmType.c_str(), drbId);
 
     // init new descriptor
-    StatusDescriptor newDesc;
+    StatusDescriptor& newDesc = connectionMap_[drbId];
     newDesc.nodeId_ = nodeId;
     newDesc.burstId_ = 0;
     newDesc.burstState_ = false;
+    newDesc.pdcpStatus_ = SequenceNumberWindow<PdcpStatus>(initialTrackingWindow_, maxTrackingWindow_);
+    newDesc.rlcPduStatus_ = SequenceNumberWindow<RlcPduStatus>(initialTrackingWindow_, maxTrackingWindow_);
 
-    connectionMap_[drbId] = newDesc;
     EV_FATAL << NOW << " node id " << nodeId << " " << pfmType << "::initDrbId - initialized drbId " << drbId << endl;
 }
 
@@ -65,8 +66,7 @@ void PacketFlowObserverEnb::clearDrbId(DrbId drbId)
     }
     else {
         connectionMap_[drbId].pdcpStatus_.clear();
-        connectionMap_[drbId].rlcPdusPerSdu_.clear();
-        connectionMap_[drbId].rlcSdusPerPdu_.clear();
+        connectionMap_[drbId].rlcPduStatus_.clear();
         connectionMap_[drbId].macSdusPerPdu_.clear();
         connectionMap_[drbId].burstStatus_.clear();
         connectionMap_[drbId].burstId_ = 0;
@@ -87,20 +87,16 @@ void PacketFlowObserverEnb::clearAllDrbIds()
 void PacketFlowObserverEnb::initPdcpStatus(StatusDescriptor *desc, unsigned int pdcp, unsigned int sduHeaderSize, simtime_t arrivalTime)
 {
     // if pdcpStatus_ already present, error
-    std::map<unsigned int, PdcpStatus>::iterator it = desc->pdcpStatus_.find(pdcp);
-    if (it != desc->pdcpStatus_.end())
+    if (desc->pdcpStatus_.contains(pdcp))
         throw cRuntimeError("%s::initPdcpStatus - PdcpStatus for PDCP sno [%d] already present for node %hu, this should not happen", pfmType.c_str(), pdcp, num(desc->nodeId_));
 
-    PdcpStatus newpdcpStatus;
-
+    PdcpStatus& newpdcpStatus = desc->pdcpStatus_[pdcp];
     newpdcpStatus.entryTime = arrivalTime;
     newpdcpStatus.discardedAtMac = false;
     newpdcpStatus.discardedAtRlc = false;
     newpdcpStatus.hasArrivedAll = false;
     newpdcpStatus.sentOverTheAir = false;
     newpdcpStatus.pdcpSduSize = sduHeaderSize; // ************************* pdcpSduSize is headerSize!!!
-    newpdcpStatus.entryTime = arrivalTime;
-    desc->pdcpStatus_[pdcp] = newpdcpStatus;
     EV_FATAL << pfmType << "::initPdcpStatus - PDCP PDU " << pdcp << "  with header size " << sduHeaderSize << " added" << endl;
 }
 
@@ -148,6 +144,10 @@ void PacketFlowObserverEnb::insertPdcpSdu(inet::Packet *pdcpPkt)
     // get the descriptor for this connection
     StatusDescriptor *desc = &cit->second;
 
+    // delay and discard statistics are computed on the sampled PDCP SDUs only
+    if (!isSampled(pdcpSno))
+        return;
+
     initPdcpStatus(desc, pdcpSno, sduSize, entryTime);
     EV_FATAL << NOW << " node id " << desc->nodeId_ << " " << pfmType << "::insertPdcpSdu - PDCP status for PDCP PDU SN " << pdcpSno << " added. DRB ID " << drbId << endl;
 
@@ -208,7 +208,7 @@ void PacketFlowObserverEnb::insertRlcPdu(DrbId drbId, const LteRlcUmDataPdu *rlc
 
     unsigned int rlcSno = rlcPdu->getPduSequenceNumber();
 
-    if (desc->rlcSdusPerPdu_.find(rlcSno) != desc->rlcSdusPerPdu_.end())
+    if (desc->rlcPduStatus_.contains(rlcSno))
         throw cRuntimeError("%s::insertRlcPdu - RLC PDU SN %d already present for DRB ID %d", pfmType.c_str(), rlcSno, drbId);
 
 
@@ -217,6 +217,7 @@ void PacketFlowObserverEnb::insertRlcPdu(DrbId drbId, const LteRlcUmDataPdu *rlc
         if (desc->burstState_ == true)
             throw cRuntimeError("%s::insertRlcPdu - node %hu and drbId %d . RLC burst status START incompatible with local status %d", pfmType.c_str(), num(desc->nodeId_), drbId, desc->burstState_);
         BurstStatus newBurst;
+        newBurst.pendingRlcPdus = 0;
         newBurst.isCompleted = false;
         newBurst.startBurstTransmission = simTime();
         newBurst.burstSize = 0;
@@ -262,6 +263,12 @@ void PacketFlowObserverEnb::insertRlcPdu(DrbId drbId, const LteRlcUmDataPdu *rlc
         throw cRuntimeError("%s::insertRlcPdu RLCBurstStatus not recognized", pfmType.c_str());
     }
 
+    // an RLC PDU evicted from the tracking window will not be acked or discarded here,
+    // hence stop counting it in its burst, so that the burst can be completed
+    RlcPduStatus& rlcPduStatus = desc->rlcPduStatus_.insert(rlcSno, [this, desc](RlcPduStatus& evicted) {
+        removePdcpBurstRLC(desc, evicted, false);
+    });
+
     FramingInfo fi = rlcPdu->getFramingInfo();
     for (size_t idx = 0; idx < rlcPdu->getNumSdu(); ++idx) {
         auto sduPacket = rlcPdu->getSdu(idx);
@@ -270,32 +277,35 @@ void PacketFlowObserverEnb::insertRlcPdu(DrbId drbId, const LteRlcUmDataPdu *rlc
         size_t pdcpPduLength = rlcPdu->getSduSize(idx); // TODO fix with size of the chunk!!
 
         EV << "PacketFlowObserverEnb::insertRlcPdu - pdcpSdu " << pdcpSno << " with length: " << pdcpPduLength << " bytes" << endl;
-        //
-        // store the RLC SDUs (PDCP PDUs) included in the RLC PDU
-        desc->rlcSdusPerPdu_[rlcSno].insert(pdcpSno);
 
-        // now store the inverse association, i.e., for each RLC SDU, record in which RLC PDU it is included
-        desc->rlcPdusPerSdu_[pdcpSno].insert(rlcSno);
+        // skip PDCP SDUs not sampled or evicted from the tracking window
+        if (!isSampled(pdcpSno) || !desc->pdcpStatus_.isInWindow(pdcpSno))
+            continue;
 
-        // set the PDCP entry time
-        auto pit = desc->pdcpStatus_.find(pdcpSno);
-        if (pit == desc->pdcpStatus_.end())
+        PdcpStatus *pit = desc->pdcpStatus_.find(pdcpSno);
+        if (pit == nullptr)
             throw cRuntimeError("%s::insertRlcPdu - PdcpStatus for PDCP sno [%d] not present, this should not happen", pfmType.c_str(), pdcpSno);
 
+        // store the RLC SDUs (PDCP PDUs) included in the RLC PDU
+        rlcPduStatus.pdcpSnos.insert(pdcpSno);
+
+        // now store the inverse association, i.e., for each RLC SDU, record in which RLC PDU it is included
+        pit->rlcPdus.insert(rlcSno);
+
         // last pdcp
         if (idx == rlcPdu->getNumSdu() - 1) {
             // 01 or 11, lsb 1 (3GPP TS 36.322)
             // means -> Last byte of the Data field does not correspond to the last byte of a RLC SDU.
             if (fi.lastIsFragment) {
-                pit->second.hasArrivedAll = false;
+                pit->hasArrivedAll = false;
             }
             else {
-                pit->second.hasArrivedAll = true;
+                pit->hasArrivedAll = true;
             }
         }
         // since it is not the last part of the rlc, this pdcp has been entirely inserted in RLCs
         else {
-            pit->second.hasArrivedAll = true;
+            pit->hasArrivedAll = true;
         }
 
         EV_FATAL << NOW << " node id " << desc->nodeId_ << " " << pfmType << "::insertRlcPdu - drbId[" << drbId << "], insert PDCP PDU " << pdcpSno << " in RLC PDU " << rlcSno << endl;
@@ -316,7 +326,9 @@ void PacketFlowObserverEnb::insertRlcPdu(DrbId drbId, const LteRlcUmDataPdu *rlc
         // add rlc to rlc set of the burst and the size
         EV_FATAL << NOW << " node id " << desc->nodeId_ << " " << pfmType << "::insertRlcPdu - drbId[" << drbId << "], insert RLC SDU of size " << rlcSduSize << endl;
 
-        bsit->second.rlcPdu[rlcSno] = rlcSduSize;
+        bsit->second.pendingRlcPdus++;
+        rlcPduStatus.burstId = desc->burstId_;
+        rlcPduStatus.burstVolume = rlcSduSize;
     }
 }
 
@@ -332,29 +344,30 @@ void PacketFlowObserverEnb::discardRlcPdu(DrbId drbId, unsigned int rlcSno, bool
 
     // get the descriptor for this connection
     StatusDescriptor *desc = &cit->second;
-    if (desc->rlcSdusPerPdu_.find(rlcSno) == desc->rlcSdusPerPdu_.end())
+    RlcPduStatus *rlcPduStatus = desc->rlcPduStatus_.find(rlcSno);
+    if (rlcPduStatus == nullptr) {
+        if (!desc->rlcPduStatus_.isInWindow(rlcSno))
+            return; // evicted from the tracking window
         throw cRuntimeError("%s::discardRlcPdu - RLC PDU SN %d not present for DRB ID %d", pfmType.c_str(), rlcSno, drbId);
+    }
 
     // get the PDCP SDUs fragmented in this RLC PDU
-    SequenceNumberSet pdcpSnoSet = desc->rlcSdusPerPdu_.find(rlcSno)->second;
-    for (const auto& pdcpSno : pdcpSnoSet) {
-        // find sdu -> rlc for this pdcp
-        auto rit = desc->rlcPdusPerSdu_.find(pdcpSno);
-        if (rit == desc->rlcPdusPerSdu_.end())
+    for (const auto& pdcpSno : rlcPduStatus->pdcpSnos) {
+        // set this pdcp sdu as discarded, flag use in macPduArrive to not take into account this pdcp
+        PdcpStatus *pit = desc->pdcpStatus_.find(pdcpSno);
+        if (pit == nullptr) {
+            if (!desc->pdcpStatus_.isInWindow(pdcpSno))
+                continue;
             throw cRuntimeError("%s::discardRlcPdu - PdcpStatus for PDCP sno [%d] with drbId [%d] not present, this should not happen", pfmType.c_str(), pdcpSno, drbId);
+        }
 
         // remove the RLC PDUs that contain a fragment of this pdcpSno
-        rit->second.erase(rlcSno);
-
-        // set this pdcp sdu as discarded, flag use in macPduArrive to not take into account this pdcp
-        auto pit = desc->pdcpStatus_.find(pdcpSno);
-        if (pit == desc->pdcpStatus_.end())
-            throw cRuntimeError("%s::discardRlcPdu - PdcpStatus for PDCP sno [%d] already present, this should not happen", pfmType.c_str(), pdcpSno);
+        pit->rlcPdus.erase(rlcSno);
 
         if (fromMac)
-            pit->second.discardedAtMac = true; // discarded rate stats also
+            pit->discardedAtMac = true; // discarded rate stats also
         else
-            pit->second.discardedAtRlc = true;
+            pit->discardedAtRlc = true;
 
         // if the set is empty AND
         // the pdcp pdu has been completely encapsulated AND
@@ -364,26 +377,25 @@ void PacketFlowObserverEnb::discardRlcPdu(DrbId drbId, unsigned int rlcSno, bool
         // count it in discarded stats
         // compliant with ETSI 136 314 at 4.1.5.1
 
-        if (rit->second.empty() && pit->second.hasArrivedAll && !pit->second.discardedAtMac && !pit->second.sentOverTheAir) {
+        if (pit->rlcPdus.empty() && pit->hasArrivedAll && !pit->discardedAtMac && !pit->sentOverTheAir) {
             EV_FATAL << NOW << " node id " << desc->nodeId_ << " " << pfmType << "::discardRlcPdu - drbId[" << drbId << "], discarded PDCP PDU " << pdcpSno << " in RLC PDU " << rlcSno << endl;
             pktDiscardCounterPerUe_[desc->nodeId_].discarded += 1;
             pktDiscardCounterTotal_.discarded += 1;
         }
         // if the pdcp was entire and the set of rlc is empty, discard it
-        if (rit->second.empty() && pit->second.hasArrivedAll) {
-            desc->rlcPdusPerSdu_.erase(rit);
+        if (pit->rlcPdus.empty() && pit->hasArrivedAll) {
             //remove pdcp status
-            desc->pdcpStatus_.erase(pit);
+            desc->pdcpStatus_.erase(pdcpSno);
         }
     }
-    removePdcpBurstRLC(desc, rlcSno, false);
+    removePdcpBurstRLC(desc, *rlcPduStatus, false);
     //remove discarded rlc pdu
-    desc->rlcSdusPerPdu_.erase(rlcSno);
+    desc->rlcPduStatus_.erase(rlcSno);
 }
 
 void PacketFlowObserverEnb::ensureMacPduMapping(const LteMacPdu *macPdu)
 {
-    int macPduId = macPdu->getId();
+    long macPduId = macPdu->getId();
     int len = macPdu->getSduArraySize();
     if (len == 0)
         return; // BSR-only MAC PDU, nothing to track
@@ -394,24 +406,27 @@ void PacketFlowObserverEnb::ensureMacPduMapping(const LteMacPdu *macPdu)
             throw cRuntimeError("%s::ensureMacPduMapping - DRB ID %d not present", pfmType.c_str(), num(drbId));
 
         StatusDescriptor *desc = &cit->second;
-        if (desc->macSdusPerPdu_.find(macPduId) != desc->macSdusPerPdu_.end())
+        if (desc->macSdusPerPdu_.find(macPduId) != nullptr)
             continue; // already mapped (from a previous SDU with same DRB)
 
+        SequenceNumberSet& rlcSnoSet = desc->macSdusPerPdu_[macPduId];
         for (int j = 0; j < len; ++j) {
             auto rlcPdu = macPdu->getSdu(j);
             unsigned int rlcSno = rlcPdu.peekAtFront<LteRlcUmDataPdu>()->getPduSequenceNumber();
 
-            auto tit = desc->rlcSdusPerPdu_.find(rlcSno);
-            if (tit == desc->rlcSdusPerPdu_.end())
+            RlcPduStatus *rlcPduStatus = desc->rlcPduStatus_.find(rlcSno);
+            if (rlcPduStatus == nullptr) {
+                if (!desc->rlcPduStatus_.isInWindow(rlcSno))
+                    continue; // evicted from the tracking window
                 throw cRuntimeError("%s::ensureMacPduMapping - RLC PDU ID %d not present in the status descriptor of drbId %d", pfmType.c_str(), rlcSno, drbId);
+            }
 
-            desc->macSdusPerPdu_[macPduId].insert(rlcSno);
+            rlcSnoSet.insert(rlcSno);
 
-            SequenceNumberSet pdcpSet = tit->second;
-            for (const auto& pdcpSno : pdcpSet) {
-                auto sdit = desc->pdcpStatus_.find(pdcpSno);
-                if (sdit != desc->pdcpStatus_.end())
-                    sdit->second.sentOverTheAir = true;
+            for (const auto& pdcpSno : rlcPduStatus->pdcpSnos) {
+                PdcpStatus *sdit = desc->pdcpStatus_.find(pdcpSno);
+                if (sdit != nullptr)
+                    sdit->sentOverTheAir = true;
             }
         }
     }
@@ -424,7 +439,7 @@ void PacketFlowObserverEnb::macPduArrived(const LteMacPdu *macPdu)
     /*
      * retrieve the macPduId and the DRB ID (from MAC's LCID, which maps 1:1)
      */
-    int macPduId = macPdu->getId();
+    long macPduId = macPdu->getId();
     int len = macPdu->getSduArraySize();
     if (len == 0)
         return; // BSR-only MAC PDU, nothing to track
@@ -448,79 +463,73 @@ void PacketFlowObserverEnb::macPduArrived(const LteMacPdu *macPdu)
             return;
         }
 
-        auto mit = desc->macSdusPerPdu_.find(macPduId);
-        if (mit == desc->macSdusPerPdu_.end())
-            throw cRuntimeError("%s::macPduArrived - MAC PDU ID %d not present for DRB ID %d", pfmType.c_str(), macPduId, drbId);
-        SequenceNumberSet rlcSnoSet = mit->second;
+        SequenceNumberSet *rlcSnoSet = desc->macSdusPerPdu_.find(macPduId);
+        if (rlcSnoSet == nullptr)
+            throw cRuntimeError("%s::macPduArrived - MAC PDU ID %ld not present for DRB ID %d", pfmType.c_str(), macPduId, drbId);
 
         // === STEP 2 ========================================================== //
         // === for each RLC PDU SN, recover the set of RLC SDU (PDCP PDU) SN === //
 
-        for (const auto& rlcPduSno : rlcSnoSet) {
+        for (const auto& rlcPduSno : *rlcSnoSet) {
             EV_FATAL << NOW << " node id " << desc->nodeId_ << " " << pfmType << "::macPduArrived - --> RLC PDU [" << rlcPduSno << "], which contains:" << endl;
 
-            auto nit = desc->rlcSdusPerPdu_.find(rlcPduSno);
-            if (nit == desc->rlcSdusPerPdu_.end())
+            RlcPduStatus *rlcPduStatus = desc->rlcPduStatus_.find(rlcPduSno);
+            if (rlcPduStatus == nullptr) {
+                if (!desc->rlcPduStatus_.isInWindow(rlcPduSno))
+                    continue; // evicted from the tracking window
                 throw cRuntimeError("%s::macPduArrived - RLC PDU SN %d not present for DRB ID %d", pfmType.c_str(), rlcPduSno, drbId);
-            SequenceNumberSet pdcpSnoSet = nit->second;
+            }
 
             // === STEP 3 ============================================================================ //
             // === (PDCP PDU) SN, recover the set of RLC PDU where it is included,                 === //
             // === remove the above RLC PDU SN. If the set becomes empty, compute the delay if     === //
             // === all PDCP PDU fragments have been transmitted                                    === //
 
-            for (const auto& pdcpPduSno : pdcpSnoSet) {
+            for (const auto& pdcpPduSno : rlcPduStatus->pdcpSnos) {
                 EV_FATAL << NOW << " node id " << desc->nodeId_ << " " << pfmType << "::macPduArrived - ----> PDCP PDU [" << pdcpPduSno << "]" << endl;
 
-                auto oit = desc->rlcPdusPerSdu_.find(pdcpPduSno);
-                if (oit == desc->rlcPdusPerSdu_.end())
-                    throw cRuntimeError("%s::macPduArrived - PDCP PDU SN %d not present for DRB ID %d", pfmType.c_str(), pdcpPduSno, drbId);
+                PdcpStatus *pit = desc->pdcpStatus_.find(pdcpPduSno);
+                if (pit == nullptr) {
+                    if (!desc->pdcpStatus_.isInWindow(pdcpPduSno))
+                        continue; // evicted from the tracking window
+                    throw cRuntimeError("%s::macPduArrived - PdcpStatus for PDCP sno [%d] not present for drbId [%d], this should not happen", pfmType.c_str(), pdcpPduSno, drbId);
+                }
 
-                auto kt = oit->second.find(rlcPduSno);
-                if (kt == oit->second.end())
+                auto kt = pit->rlcPdus.find(rlcPduSno);
+                if (kt == pit->rlcPdus.end())
                     throw cRuntimeError("%s::macPduArrived - RLC PDU SN %d not present in the set of PDCP PDU SN %d for DRB ID %d", pfmType.c_str(), pdcpPduSno, rlcPduSno, drbId);
 
                 // the RLC PDU has been sent, so erase it from the set
-                oit->second.erase(kt);
-
-                auto pit = desc->pdcpStatus_.find(pdcpPduSno);
-                if (pit == desc->pdcpStatus_.end())
-                    throw cRuntimeError("%s::macPduArrived - PdcpStatus for PDCP sno [%d] not present for drbId [%d], this should not happen", pfmType.c_str(), pdcpPduSno, drbId);
+                pit->rlcPdus.erase(kt);
 
                 // check whether the set is now empty
-                if (desc->rlcPdusPerSdu_[pdcpPduSno].empty()) {
-                    if (pit->second.entryTime == 0)
+                if (pit->rlcPdus.empty()) {
+                    if (pit->entryTime == 0)
                         throw cRuntimeError("%s::macPduArrived - PDCP PDU SN %d of DRB ID %d has no entry time timestamp, this should not happen", pfmType.c_str(), pdcpPduSno, drbId);
 
-                    if (pit->second.hasArrivedAll && !pit->second.discardedAtRlc && !pit->second.discardedAtMac) {
+                    if (pit->hasArrivedAll && !pit->discardedAtRlc && !pit->discardedAtMac) {
                         EV_FATAL << NOW << " node id " << desc->nodeId_ << " " << pfmType << "::macPduArrived - ----> PDCP PDU [" << pdcpPduSno << "] has been completely sent, remove from PDCP buffer" << endl;
 
-                        auto dit = pdcpDelay_.find(desc->nodeId_);
-                        if (dit == pdcpDelay_.end()) {
-                            pdcpDelay_[desc->nodeId_] = { 0, 0 }; // create new structure
-                            dit = pdcpDelay_.find(desc->nodeId_);
-                        }
+                        Delay& delay = pdcpDelay_[desc->nodeId_]; // created on first use
 
-                        double time = (simTime() - pit->second.entryTime).dbl();
+                        double time = (simTime() - pit->entryTime).dbl();
 
                         EV_FATAL << NOW << " node id " << desc->nodeId_ << " " << pfmType << "::macPduArrived - PDCP PDU " << pdcpPduSno << " of drbId " << drbId << " acknowledged. Delay time: " << time << "s" << endl;
 
-                        dit->second.time += (simTime() - pit->second.entryTime);
+                        delay.time += (simTime() - pit->entryTime);
 
-                        dit->second.pktCount += 1;
+                        delay.pktCount += 1;
 
                         // remove pdcp status
-                        desc->pdcpStatus_.erase(pit);
-                        oit->second.clear();
-                        desc->rlcPdusPerSdu_.erase(oit); // erase PDCP PDU SN
+                        desc->pdcpStatus_.erase(pdcpPduSno);
                     }
                 }
             }
-            desc->rlcSdusPerPdu_.erase(nit); // erase RLC PDU SN
-            removePdcpBurstRLC(desc, rlcPduSno, true); // check if the pdcp is part of a burst
+            removePdcpBurstRLC(desc, *rlcPduStatus, true); // check if the pdcp is part of a burst
+            desc->rlcPduStatus_.erase(rlcPduSno); // erase RLC PDU SN
         }
 
-        desc->macSdusPerPdu_.erase(mit); // erase MAC PDU ID
+        desc->macSdusPerPdu_.erase(macPduId); // erase MAC PDU ID
     }
 }
 
@@ -531,7 +540,7 @@ void PacketFlowObserverEnb::discardMacPdu(const LteMacPdu *macPdu)
     /*
      * retrieve the macPduId and the DRB ID
      */
-    int macPduId = macPdu->getId();
+    long macPduId = macPdu->getId();
     int len = macPdu->getSduArraySize();
     if (len == 0)
         return; // BSR-only MAC PDU, nothing to track
@@ -556,50 +565,43 @@ void PacketFlowObserverEnb::discardMacPdu(const LteMacPdu *macPdu)
             return;
         }
 
-        auto mit = desc->macSdusPerPdu_.find(macPduId);
-        if (mit == desc->macSdusPerPdu_.end())
-            throw cRuntimeError("%s::discardMacPdu - MAC PDU ID %d not present for DRB ID %d", pfmType.c_str(), macPduId, drbId);
-        SequenceNumberSet rlcSnoSet = mit->second;
+        SequenceNumberSet *rlcSnoSet = desc->macSdusPerPdu_.find(macPduId);
+        if (rlcSnoSet == nullptr)
+            throw cRuntimeError("%s::discardMacPdu - MAC PDU ID %ld not present for DRB ID %d", pfmType.c_str(), macPduId, drbId);
 
-        for (const auto& sn : rlcSnoSet) {
+        for (const auto& sn : *rlcSnoSet) {
             discardRlcPdu(drbId, sn, true);
         }
 
-        desc->macSdusPerPdu_.erase(mit); // erase MAC PDU ID
+        desc->macSdusPerPdu_.erase(macPduId); // erase MAC PDU ID
     }
 }
 
-void PacketFlowObserverEnb::removePdcpBurstRLC(StatusDescriptor *desc, unsigned int rlcSno, bool ack)
+void PacketFlowObserverEnb::removePdcpBurstRLC(StatusDescriptor *desc, const RlcPduStatus& rlcPdu, bool ack)
 {
-    // check end of a burst
-    // for each burst_id, we have to search if the relative set has the RLC
-    // it has been assumed that the bursts are quickly emptied so the operation
-    // is not computationally heavy
-    // the other solution is to create <rlcPdu, burst_id> map
-    for (auto &[burstId, burstStatus] : desc->burstStatus_) {
-        auto rlcpit = burstStatus.rlcPdu.find(rlcSno);
-        if (rlcpit != burstStatus.rlcPdu.end()) {
-            if (ack) {
-                // if arrived, sum it to the thpVolDl
-                burstStatus.burstSize += rlcpit->second;
-            }
-            burstStatus.rlcPdu.erase(rlcpit);
-            if (burstStatus.rlcPdu.empty() && burstStatus.isCompleted) {
-                // compute throughput
-                auto tit = pdcpThroughput_.find(desc->nodeId_);
-                if (tit == pdcpThroughput_.end()) {
-                    pdcpThroughput_.insert({desc->nodeId_, { 0, 0 }});
-                    tit = pdcpThroughput_.find(desc->nodeId_);
-                }
-                tit->second.pktSizeCount += burstStatus.burstSize; //*8 --> bits
-                tit->second.time += (simTime() - burstStatus.startBurstTransmission);
-                double tp = ((double)burstStatus.burstSize) / (simTime() - burstStatus.startBurstTransmission).dbl();
-
-                EV_FATAL << NOW << " node id " << desc->nodeId_ << " " << pfmType << "::removePdcpBurst Burst " << burstId << " length " << simTime() - burstStatus.startBurstTransmission << "s, with size " << burstStatus.burstSize << "B -> tput: " << tp << " B/s" << endl;
-                desc->burstStatus_.erase(burstId); // remove emptied burst
-            }
-            break;
-        }
+    // check end of a burst: the RLC PDU records the burst it belongs to
+    if (rlcPdu.burstId == 0)
+        return;
+    auto bsit = desc->burstStatus_.find(rlcPdu.burstId);
+    if (bsit == desc->burstStatus_.end())
+        return; // the burst was removed (e.g., it ended in the same TTI it started)
+
+    BurstId burstId = bsit->first;
+    BurstStatus& burstStatus = bsit->second;
+    if (ack) {
+        // if arrived, sum it to the thpVolDl
+        burstStatus.burstSize += rlcPdu.burstVolume;
+    }
+    burstStatus.pendingRlcPdus--;
+    if (burstStatus.pendingRlcPdus == 0 && burstStatus.isCompleted) {
+        // compute throughput
+        Throughput& throughput = pdcpThroughput_[desc->nodeId_]; // created on first use
+        throughput.pktSizeCount += burstStatus.burstSize; //*8 --> bits
+        throughput.time += (simTime() - burstStatus.startBurstTransmission);
+        double tp = ((double)burstStatus.burstSize) / (simTime() - burstStatus.startBurstTransmission).dbl();
+
+        EV_FATAL << NOW << " node id " << desc->nodeId_ << " " << pfmType << "::removePdcpBurst Burst " << burstId << " length " << simTime() - burstStatus.startBurstTransmission << "s, with size " << burstStatus.burstSize << "B -> tput: " << tp << " B/s" << endl;
+        desc->burstStatus_.erase(bsit); // remove emptied burst
     }
 }
 
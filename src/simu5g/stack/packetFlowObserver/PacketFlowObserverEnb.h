@@ -38,7 +38,7 @@ class PacketFlowObserverEnb : public PacketFlowObserverBase
     };
 
     struct BurstStatus {
-        std::map<unsigned int, unsigned int> rlcPdu; // RLC PDU of the burst and the relative RLC SDU size
+        unsigned int pendingRlcPdus; // RLC PDUs of the burst not yet acknowledged or discarded
         simtime_t startBurstTransmission; // moment of the first transmission of the burst
         unsigned int burstSize; // PDCP SDU size of the burst
         bool isCompleted;
@@ -75,11 +75,10 @@ class PacketFlowObserverEnb : public PacketFlowObserverBase
         MacNodeId nodeId_; // destination node of this DRB ID
         bool burstState_; // control variable that controls one burst active at a time
         BurstId burstId_; // separates the bursts
-        std::map<unsigned int, PdcpStatus> pdcpStatus_; // a PDCP PDU can be fragmented into many RLC PDUs that could be sent and acknowledged at different times (this prevents early removal on acknowledgment)
+        SequenceNumberWindow<PdcpStatus> pdcpStatus_; // a PDCP PDU can be fragmented into many RLC PDUs that could be sent and acknowledged at different times (this prevents early removal on acknowledgment)
         std::map<BurstId, BurstStatus> burstStatus_; // for each burst, stores relative information
-        std::map<unsigned int, SequenceNumberSet> rlcPdusPerSdu_;  // for each RLC SDU, stores the RLC PDUs where the former was fragmented
-        std::map<unsigned int, SequenceNumberSet> rlcSdusPerPdu_;  // for each RLC PDU, stores the included RLC SDUs
-        std::map<unsigned int, SequenceNumberSet> macSdusPerPdu_;  // for each MAC PDU, stores the included MAC SDUs (should be a 1:1 association)
+        SequenceNumberWindow<RlcPduStatus> rlcPduStatus_;  // for each RLC PDU, stores the included RLC SDUs and its burst
+        MacPduTable<SequenceNumberSet> macSdusPerPdu_;  // for each MAC PDU, stores the included MAC SDUs (should be a 1:1 association)
         //std::vector<unsigned int> macPduPerProcess_;               // for each HARQ process, stores the included MAC PDU
     };
 
@@ -108,10 +107,10 @@ class PacketFlowObserverEnb : public PacketFlowObserverBase
      * total of the burst size.
      * It is called by macPduArrived (ack true) and rlcPduDiscarded (ack false)
      * @param desc DRB ID descriptor
-     * @param rlcSno RLC sequence number
+     * @param rlcPdu status of the RLC PDU
      * @bool ack PDCP acknowledgment flag
      */
-    void removePdcpBurstRLC(StatusDescriptor *desc, unsigned int rlcSno, bool ack);
+    void removePdcpBurstRLC(StatusDescriptor *desc, const RlcPduStatus& rlcPdu, bool ack);
     void ensureMacPduMapping(const LteMacPdu *macPdu);
 
     /*
@@ -42,15 +42,12 @@ void PacketFlowObserverUe::initDrbId(DrbId drbId, MacNodeId nodeId)
         throw cRuntimeError("%s::initDrbId - DRB ID %d already present", pfmType.c_str(), drbId);
 
     // init new descriptor
-    StatusDescriptor newDesc;
+    StatusDescriptor& newDesc = connectionMap_[drbId];
     newDesc.nodeId_ = nodeId;
-    newDesc.pdcpStatus_.clear();
-    newDesc.rlcPdusPerSdu_.clear();
-    newDesc.rlcSdusPerPdu_.clear();
-    newDesc.macSdusPerPdu_.clear();
+    newDesc.pdcpStatus_ = SequenceNumberWindow<PdcpStatus>(initialTrackingWindow_, maxTrackingWindow_);
+    newDesc.rlcPduStatus_ = SequenceNumberWindow<RlcPduStatus>(initialTrackingWindow_, maxTrackingWindow_);
     newDesc.macPduPerProcess_.resize(harqProcesses_, 0);
 
-    connectionMap_[drbId] = newDesc;
     EV_FATAL << NOW << "node id " << nodeId << " " << pfmType << "::initDrbId - initialized drbId " << drbId << endl;
 }
 
@@ -65,8 +62,7 @@ void PacketFlowObserverUe::clearDrbId(DrbId drbId)
 
     StatusDescriptor *desc = &it->second;
     desc->pdcpStatus_.clear();
-    desc->rlcPdusPerSdu_.clear();
-    desc->rlcSdusPerPdu_.clear();
+    desc->rlcPduStatus_.clear();
     desc->macSdusPerPdu_.clear();
 
     for (int i = 0; i < harqProcesses_; i++)
@@ -92,20 +88,16 @@ void PacketFlowObserverUe::initPdcpStatus(StatusDescriptor *desc, unsigned int p
 
 {
     // if pdcpStatus_ already present, error
-    std::map<unsigned int, PdcpStatus>::iterator it = desc->pdcpStatus_.find(pdcp);
-    if (it != desc->pdcpStatus_.end())
+    if (desc->pdcpStatus_.contains(pdcp))
         throw cRuntimeError("%s::initPdcpStatus - PdcpStatus for PDCP sno [%d] already present, this should not happen", pfmType.c_str(), pdcp);
 
-    PdcpStatus newpdcpStatus;
-
+    PdcpStatus& newpdcpStatus = desc->pdcpStatus_[pdcp];
     newpdcpStatus.entryTime = arrivalTime;
     newpdcpStatus.discardedAtMac = false;
     newpdcpStatus.discardedAtRlc = false;
     newpdcpStatus.hasArrivedAll = false;
     newpdcpStatus.sentOverTheAir = false;
     newpdcpStatus.pdcpSduSize = pdcpSize;
-
-    desc->pdcpStatus_[pdcp] = newpdcpStatus;
 }
 
 void PacketFlowObserverUe::insertPdcpSdu(inet::Packet *pdcpPkt)
@@ -133,6 +125,10 @@ void PacketFlowObserverUe::insertPdcpSdu(inet::Packet *pdcpPkt)
     // get the descriptor for this connection
     StatusDescriptor *desc = &cit->second;
 
+    // delay and discard statistics are computed on the sampled PDCP SDUs only
+    if (!isSampled(pdcpSno))
+        return;
+
     initPdcpStatus(desc, pdcpSno, pdcpSize, arrivalTime);
     pktDiscardCounterTotal_.total += 1;
 
@@ -153,10 +149,12 @@ void PacketFlowObserverUe::insertRlcPdu(DrbId drbId, const LteRlcUmDataPdu *rlcP
 
     unsigned int rlcSno = rlcPdu->getPduSequenceNumber();
 
-    if (desc->rlcSdusPerPdu_.find(rlcSno) != desc->rlcSdusPerPdu_.end())
+    if (desc->rlcPduStatus_.contains(rlcSno))
         throw cRuntimeError("%s::insertRlcPdu - RLC PDU SN %d already present for DRB ID %d", pfmType.c_str(), rlcSno, drbId);
     EV_FATAL << NOW << "node id " << num(desc->nodeId_) - 1025 << " " << pfmType << "::insertRlcPdu - DRB ID " << drbId << endl;
 
+    RlcPduStatus& rlcPduStatus = desc->rlcPduStatus_[rlcSno];
+
     FramingInfo fi = rlcPdu->getFramingInfo();
     for (size_t idx = 0; idx < rlcPdu->getNumSdu(); ++idx) {
         auto sduPacket = rlcPdu->getSdu(idx);
@@ -166,34 +164,37 @@ void PacketFlowObserverUe::insertRlcPdu(DrbId drbId, const LteRlcUmDataPdu *rlcP
 
         EV << pfmType << "::insertRlcPdu - pdcpSdu " << pdcpSno << " with length: " << pdcpPduLength << " bytes" << endl;
 
+        // skip PDCP SDUs not sampled or evicted from the tracking window
+        if (!isSampled(pdcpSno) || !desc->pdcpStatus_.isInWindow(pdcpSno))
+            continue;
+
+        PdcpStatus *pit = desc->pdcpStatus_.find(pdcpSno);
+        if (pit == nullptr)
+            throw cRuntimeError("%s::insertRlcPdu - PdcpStatus for PDCP sno [%d] not present, this should not happen", pfmType.c_str(), pdcpSno);
+
         // store the RLC SDUs (PDCP PDUs) included in the RLC PDU
-        desc->rlcSdusPerPdu_[rlcSno].insert(pdcpSno);
+        rlcPduStatus.pdcpSnos.insert(pdcpSno);
 
         // now store the inverse association, i.e., for each RLC SDU, record in which RLC PDU is included
-        desc->rlcPdusPerSdu_[pdcpSno].insert(rlcSno);
-
-        // set the PDCP entry time
-        std::map<unsigned int, PdcpStatus>::iterator pit = desc->pdcpStatus_.find(pdcpSno);
-        if (pit == desc->pdcpStatus_.end())
-            throw cRuntimeError("%s::insertRlcPdu - PdcpStatus for PDCP sno [%d] not present, this should not happen", pfmType.c_str(), pdcpSno);
+        pit->rlcPdus.insert(rlcSno);
 
         if (idx == rlcPdu->getNumSdu() - 1) {
             // 01 or 11, lsb 1 (3GPP TS 36.322)
             // means -> Last byte of the Data field does not correspond to the last byte of a RLC SDU.
             if (fi.lastIsFragment) {
-                pit->second.hasArrivedAll = false;
+                pit->hasArrivedAll = false;
             }
             else {
-                pit->second.hasArrivedAll = true;
+                pit->hasArrivedAll = true;
             }
         }
         else {
-            pit->second.hasArrivedAll = true;
+            pit->hasArrivedAll = true;
         }
 
         EV_FATAL << NOW << " " << pfmType << "::insertRlcPdu - drbId[" << drbId << "], insert PDCP PDU " << pdcpSno << " in RLC PDU " << rlcSno << endl;
     }
-    EV << "size:" << desc->rlcSdusPerPdu_[rlcSno].size() << endl;
+    EV << "size:" << rlcPduStatus.pdcpSnos.size() << endl;
 }
 
 void PacketFlowObserverUe::discardRlcPdu(DrbId drbId, unsigned int rlcSno, bool fromMac)
@@ -207,28 +208,30 @@ void PacketFlowObserverUe::discardRlcPdu(DrbId drbId, unsigned int rlcSno, bool
 
     // get the descriptor for this connection
     StatusDescriptor *desc = &cit->second;
-    if (desc->rlcSdusPerPdu_.find(rlcSno) == desc->rlcSdusPerPdu_.end())
+    RlcPduStatus *rlcPduStatus = desc->rlcPduStatus_.find(rlcSno);
+    if (rlcPduStatus == nullptr) {
+        if (!desc->rlcPduStatus_.isInWindow(rlcSno))
+            return; // evicted from the tracking window
         throw cRuntimeError("%s::discardRlcPdu - RLC PDU SN %d not present for DRB ID %d", pfmType.c_str(), rlcSno, drbId);
+    }
 
     // get the PDCP SDUs fragmented in this RLC PDU
-    SequenceNumberSet pdcpSnoSet = desc->rlcSdusPerPdu_.find(rlcSno)->second;
-    for (const auto& pdcpSno : pdcpSnoSet) {
-        auto rit = desc->rlcPdusPerSdu_.find(pdcpSno);
-        if (rit == desc->rlcPdusPerSdu_.end())
+    for (const auto& pdcpSno : rlcPduStatus->pdcpSnos) {
+        // set this pdcp sdu that a RLC has been discarded, i.e the arrived pdcp will be not entire.
+        PdcpStatus *pit = desc->pdcpStatus_.find(pdcpSno);
+        if (pit == nullptr) {
+            if (!desc->pdcpStatus_.isInWindow(pdcpSno))
+                continue;
             throw cRuntimeError("%s::discardRlcPdu - PdcpStatus for PDCP sno [%d] with drbId [%d] not present, this should not happen", pfmType.c_str(), pdcpSno, drbId);
+        }
 
         // remove the RLC PDUs that contains a fragment of this pdcpSno
-        rit->second.erase(rlcSno);
-
-        // set this pdcp sdu that a RLC has been discarded, i.e the arrived pdcp will be not entire.
-        auto pit = desc->pdcpStatus_.find(pdcpSno);
-        if (pit == desc->pdcpStatus_.end())
-            throw cRuntimeError("%s::discardRlcPdu - PdcpStatus for PDCP sno [%d] already present, this should not happen", pfmType.c_str(), pdcpSno);
+        pit->rlcPdus.erase(rlcSno);
 
         if (fromMac)
-            pit->second.discardedAtMac = true;
+            pit->discardedAtMac = true;
         else
-            pit->second.discardedAtRlc = true;
+            pit->discardedAtRlc = true;
 
         // if the set is empty AND
         // the pdcp pdu has been encapsulated all AND
@@ -237,22 +240,22 @@ void PacketFlowObserverUe::discardRlcPdu(DrbId drbId, unsigned int rlcSno, bool
         // ---> all PDCP has been discarded at eNB before start its transmission
         // compliant with ETSI 136 314 at 4.1.5.1
 
-        if (rit->second.empty() && pit->second.hasArrivedAll && !pit->second.discardedAtMac && !pit->second.sentOverTheAir) {
+        if (pit->rlcPdus.empty() && pit->hasArrivedAll && !pit->discardedAtMac && !pit->sentOverTheAir) {
             EV_FATAL << NOW << "node id " << num(desc->nodeId_) - 1025 << " " << pfmType << "::discardRlcPdu - drbId[" << drbId << "], discarded PDCP PDU " << pdcpSno << " in RLC PDU " << rlcSno << endl;
             pktDiscardCounterTotal_.discarded += 1;
         }
         // if the pdcp was entire and the set of rlc is empty, discard it
-        if (rit->second.empty() && pit->second.hasArrivedAll) {
-            desc->rlcPdusPerSdu_.erase(pdcpSno);
+        if (pit->rlcPdus.empty() && pit->hasArrivedAll) {
+            desc->pdcpStatus_.erase(pdcpSno);
         }
     }
     // remove discarded rlc pdu
-    desc->rlcSdusPerPdu_.erase(rlcSno);
+    desc->rlcPduStatus_.erase(rlcSno);
 }
 
 void PacketFlowObserverUe::ensureMacPduMapping(const LteMacPdu *macPdu)
 {
-    int macPduId = macPdu->getId();
+    long macPduId = macPdu->getId();
     int len = macPdu->getSduArraySize();
     if (len == 0)
         return; // BSR-only MAC PDU, nothing to track
@@ -264,23 +267,27 @@ void PacketFlowObserverUe::ensureMacPduMapping(const LteMacPdu *macPdu)
             throw cRuntimeError("%s::ensureMacPduMapping - DRB ID %d not present", pfmType.c_str(), num(drbId));
 
         StatusDescriptor *desc = &cit->second;
-        if (desc->macSdusPerPdu_.find(macPduId) != desc->macSdusPerPdu_.end())
+        if (desc->macSdusPerPdu_.find(macPduId) != nullptr)
             continue; // already mapped
 
+        SequenceNumberSet& rlcSnoSet = desc->macSdusPerPdu_[macPduId];
+
         auto macSdu = macPdu->getSdu(i).peekAtFront<LteRlcUmDataPdu>();
         unsigned int rlcSno = macSdu->getPduSequenceNumber();
 
-        auto tit = desc->rlcSdusPerPdu_.find(rlcSno);
-        if (tit == desc->rlcSdusPerPdu_.end())
+        RlcPduStatus *rlcPduStatus = desc->rlcPduStatus_.find(rlcSno);
+        if (rlcPduStatus == nullptr) {
+            if (!desc->rlcPduStatus_.isInWindow(rlcSno))
+                continue; // evicted from the tracking window
             throw cRuntimeError("%s::ensureMacPduMapping - RLC PDU ID %d not present in the status descriptor of drbId %d", pfmType.c_str(), rlcSno, num(drbId));
+        }
 
-        desc->macSdusPerPdu_[macPduId].insert(rlcSno);
+        rlcSnoSet.insert(rlcSno);
 
-        SequenceNumberSet pdcpSet = tit->second;
-        for (auto pdcpSno : pdcpSet) {
-            auto sdit = desc->pdcpStatus_.find(pdcpSno);
-            if (sdit != desc->pdcpStatus_.end())
-                sdit->second.sentOverTheAir = true;
+        for (auto pdcpSno : rlcPduStatus->pdcpSnos) {
+            PdcpStatus *sdit = desc->pdcpStatus_.find(pdcpSno);
+            if (sdit != nullptr)
+                sdit->sentOverTheAir = true;
         }
     }
 }
@@ -293,7 +300,7 @@ void PacketFlowObserverUe::macPduArrived(const LteMacPdu *macPdu)
     /*
      * retrieve the macPduId and the Lcid
      */
-    int macPduId = macPdu->getId();
+    long macPduId = macPdu->getId();
     int len = macPdu->getSduArraySize();
     if (len == 0)
         return; // BSR-only MAC PDU, nothing to track
@@ -320,28 +327,29 @@ void PacketFlowObserverUe::macPduArrived(const LteMacPdu *macPdu)
             return;
         }
 
-        std::map<unsigned int, SequenceNumberSet>::iterator mit = desc->macSdusPerPdu_.find(macPduId);
-        if (mit == desc->macSdusPerPdu_.end())
-            throw cRuntimeError("%s::macPduArrived - MAC PDU ID %d not present for DRB ID %d", pfmType.c_str(), macPduId, num(drbId));
-        SequenceNumberSet rlcSnoSet = mit->second;
+        SequenceNumberSet *rlcSnoSet = desc->macSdusPerPdu_.find(macPduId);
+        if (rlcSnoSet == nullptr)
+            throw cRuntimeError("%s::macPduArrived - MAC PDU ID %ld not present for DRB ID %d", pfmType.c_str(), macPduId, num(drbId));
 
         auto macSdu = rlcPdu.peekAtFront<LteRlcUmDataPdu>();
         unsigned int rlcSno = macSdu->getPduSequenceNumber();
 
-        if (rlcSnoSet.find(rlcSno) == rlcSnoSet.end())
-            throw cRuntimeError("%s::macPduArrived - RLC sno [%d] not present in rlcSnoSet structure for MAC PDU ID %d not present for DRB ID %d", pfmType.c_str(), rlcSno, macPduId, num(drbId));
+        if (rlcSnoSet->find(rlcSno) == rlcSnoSet->end() && desc->rlcPduStatus_.isInWindow(rlcSno))
+            throw cRuntimeError("%s::macPduArrived - RLC sno [%d] not present in rlcSnoSet structure for MAC PDU ID %ld not present for DRB ID %d", pfmType.c_str(), rlcSno, macPduId, num(drbId));
 
         // === STEP 2 ========================================================== //
         // === for each RLC PDU SN, recover the set of RLC SDU (PDCP PDU) SN === //
 
-        for (auto rlcPduSno : rlcSnoSet) {
+        for (auto rlcPduSno : *rlcSnoSet) {
             // for each RLC PDU
             EV_FATAL << NOW << "node id " << num(desc->nodeId_) - 1025 << " " << pfmType << "::macPduArrived - --> RLC PDU [" << rlcPduSno << "], which contains:" << endl;
 
-            std::map<unsigned int, SequenceNumberSet>::iterator nit = desc->rlcSdusPerPdu_.find(rlcPduSno);
-            if (nit == desc->rlcSdusPerPdu_.end())
+            RlcPduStatus *rlcPduStatus = desc->rlcPduStatus_.find(rlcPduSno);
+            if (rlcPduStatus == nullptr) {
+                if (!desc->rlcPduStatus_.isInWindow(rlcPduSno))
+                    continue; // evicted from the tracking window
                 throw cRuntimeError("%s::macPduArrived - RLC PDU SN %d not present for DRB ID %d", pfmType.c_str(), rlcPduSno, num(drbId));
-            SequenceNumberSet pdcpSnoSet = nit->second;
+            }
 
             // === STEP 3 ============================================================================ //
             // === Since an RLC SDU may be fragmented in more than one RLC PDU, thus it must be     === //
@@ -350,50 +358,48 @@ void PacketFlowObserverUe::macPduArrived(const LteMacPdu *macPdu)
             // === remove the above RLC PDU SN. If the set becomes empty, compute the delay if     === //
             // === all PDCP PDU fragments have been transmitted                                     === //
 
-            for (auto pdcpPduSno : pdcpSnoSet) {
+            for (auto pdcpPduSno : rlcPduStatus->pdcpSnos) {
                 // for each RLC SDU (PDCP PDU), get the set of RLC PDUs where it is included
                 EV_FATAL << NOW << "node id " << num(desc->nodeId_) - 1025 << " " << pfmType << "::macPduArrived - ----> PDCP PDU [" << pdcpPduSno << "]" << endl;
 
-                std::map<unsigned int, SequenceNumberSet>::iterator oit = desc->rlcPdusPerSdu_.find(pdcpPduSno);
-                if (oit == desc->rlcPdusPerSdu_.end())
+                PdcpStatus *pit = desc->pdcpStatus_.find(pdcpPduSno);
+                if (pit == nullptr) {
+                    if (!desc->pdcpStatus_.isInWindow(pdcpPduSno))
+                        continue; // evicted from the tracking window
                     throw cRuntimeError("%s::macPduArrived - PDCP PDU SN %d not present for DRB ID %d", pfmType.c_str(), pdcpPduSno, num(drbId));
+                }
 
-                // oit->second is the set of RLC PDU in which the PDCP PDU is contained
+                // pit->rlcPdus is the set of RLC PDU in which the PDCP PDU is contained
 
                 // the RLC PDU SN must be present in the set
-                if (oit->second.find(rlcPduSno) == oit->second.end())
+                auto kt = pit->rlcPdus.find(rlcPduSno);
+                if (kt == pit->rlcPdus.end())
                     throw cRuntimeError("%s::macPduArrived - RLC PDU SN %d not present in the set of PDCP PDU SN %d for DRB ID %d", pfmType.c_str(), pdcpPduSno, rlcPduSno, num(drbId));
 
                 // the RLC PDU has been sent, so erase it from the set
-                oit->second.erase(rlcPduSno);
-
-                std::map<unsigned int, PdcpStatus>::iterator pit = desc->pdcpStatus_.find(pdcpPduSno);
-                if (pit == desc->pdcpStatus_.end())
-                    throw cRuntimeError("%s::macPduArrived - PdcpStatus for PDCP sno [%d] not present for drbId [%d], this should not happen", pfmType.c_str(), pdcpPduSno, num(drbId));
+                pit->rlcPdus.erase(kt);
 
                 // check whether the set is now empty
-                if (desc->rlcPdusPerSdu_[pdcpPduSno].empty()) {
+                if (pit->rlcPdus.empty()) {
 
                     // set the time for pdcpPduSno
-                    if (pit->second.hasArrivedAll && !pit->second.discardedAtRlc && !pit->second.discardedAtMac) { // the whole current pdcp seqNum has been received
+                    if (pit->hasArrivedAll && !pit->discardedAtRlc && !pit->discardedAtMac) { // the whole current pdcp seqNum has been received
                         EV_FATAL << NOW << "node id " << num(desc->nodeId_) - 1025 << " " << pfmType << "::macPduArrived - ----> PDCP PDU [" << pdcpPduSno << "] has been completely sent, remove from PDCP buffer" << endl;
 
-                        double time = (simTime() - pit->second.entryTime).dbl();
+                        double time = (simTime() - pit->entryTime).dbl();
                         pdcpDelay.time += time;
                         pdcpDelay.pktCount += 1;
 
                         EV_FATAL << NOW << "node id " << num(desc->nodeId_) - 1025 << " " << pfmType << "::macPduArrived - PDCP PDU " << pdcpPduSno << " of drbId " << drbId << " acknowledged. Delay time: " << time << "s" << endl;
 
                         // remove pdcp status
-                        oit->second.clear();
-                        desc->rlcPdusPerSdu_.erase(oit); // erase PDCP PDU SN
+                        desc->pdcpStatus_.erase(pdcpPduSno);
                     }
                 }
             }
         }
 
-        mit->second.clear();
-        desc->macSdusPerPdu_.erase(mit); // erase MAC PDU ID
+        desc->macSdusPerPdu_.erase(macPduId); // erase MAC PDU ID
     }
 }
 
@@ -404,7 +410,7 @@ void PacketFlowObserverUe::discardMacPdu(const LteMacPdu *macPdu)
     /*
      * retrieve the macPduId and the Lcid
      */
-    int macPduId = macPdu->getId();
+    long macPduId = macPdu->getId();
     int len = macPdu->getSduArraySize();
     if (len == 0)
         return; // BSR-only MAC PDU, nothing to track
@@ -434,26 +440,24 @@ void PacketFlowObserverUe::discardMacPdu(const LteMacPdu *macPdu)
             return;
         }
 
-        auto mit = desc->macSdusPerPdu_.find(macPduId);
-        if (mit == desc->macSdusPerPdu_.end())
-            throw cRuntimeError("%s::discardMacPdu - MAC PDU ID %d not present for DRB ID %d", pfmType.c_str(), macPduId, num(drbId));
-        SequenceNumberSet rlcSnoSet = mit->second;
+        SequenceNumberSet *rlcSnoSet = desc->macSdusPerPdu_.find(macPduId);
+        if (rlcSnoSet == nullptr)
+            throw cRuntimeError("%s::discardMacPdu - MAC PDU ID %ld not present for DRB ID %d", pfmType.c_str(), macPduId, num(drbId));
 
         auto macSdu = rlcPdu.peekAtFront<LteRlcUmDataPdu>();
         unsigned int rlcSno = macSdu->getPduSequenceNumber();
 
-        if (rlcSnoSet.find(rlcSno) == rlcSnoSet.end())
-            throw cRuntimeError("%s::discardMacPdu - RLC sno [%d] not present in rlcSnoSet structure for MAC PDU ID %d not present for DRB ID %d", pfmType.c_str(), rlcSno, macPduId, num(drbId));
+        if (rlcSnoSet->find(rlcSno) == rlcSnoSet->end() && desc->rlcPduStatus_.isInWindow(rlcSno))
+            throw cRuntimeError("%s::discardMacPdu - RLC sno [%d] not present in rlcSnoSet structure for MAC PDU ID %ld not present for DRB ID %d", pfmType.c_str(), rlcSno, macPduId, num(drbId));
 
         // === STEP 2 ========================================================== //
         // === for each RLC PDU SN, recover the set of RLC SDU (PDCP PDU) SN === //
 
-        for (const auto& rlcSno : rlcSnoSet) {
+        for (const auto& rlcSno : *rlcSnoSet) {
             discardRlcPdu(drbId, rlcSno, true);
         }
 
-        mit->second.clear();
-        desc->macSdusPerPdu_.erase(mit); // erase MAC PDU ID
+        desc->macSdusPerPdu_.erase(macPduId); // erase MAC PDU ID
     }
 }
 
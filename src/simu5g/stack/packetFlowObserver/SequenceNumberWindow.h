@@ -0,0 +1,298 @@
+//
+//                  Simu5G
+//
+// Copyright (C) 2019-2021 Giovanni Nardini, Giovanni Stea, Antonio Virdis et al. (University of Pisa)
+// Copyright (C) 2022-2026 Giovanni Nardini, Giovanni Stea et al. (University of Pisa)
+//
+// This file is part of a software released under the license included in file
+// "license.pdf". Please read LICENSE and README files before using it.
+// The above files and the present reference are part of the software itself,
+// and cannot be removed from it.
+//
+
+#ifndef _LTE_SEQUENCENUMBERWINDOW_H_
+#define _LTE_SEQUENCENUMBERWINDOW_H_
+
+#include <algorithm>
+#include <vector>
+
+namespace simu5g {
+
+/**
+ * Ordered set of sequence numbers stored in a flat vector. The sets used by the
+ * PacketFlowObserver hold a handful of elements, and clearing them keeps the
+ * storage, so that a set reused for a new PDU does not allocate.
+ */
+class SequenceNumberSet
+{
+  protected:
+    std::vector<unsigned int> elements_;
+
+  public:
+    typedef std::vector<unsigned int>::const_iterator const_iterator;
+
+    const_iterator begin() const { return elements_.begin(); }
+    const_iterator end() const { return elements_.end(); }
+    size_t size() const { return elements_.size(); }
+    bool empty() const { return elements_.empty(); }
+    void clear() { elements_.clear(); }
+
+    const_iterator find(unsigned int sno) const
+    {
+        auto it = std::lower_bound(elements_.begin(), elements_.end(), sno);
+        return (it != elements_.end() && *it == sno) ? it : elements_.end();
+    }
+
+    void insert(unsigned int sno)
+    {
+        // sequence numbers are mostly inserted in increasing order
+        if (elements_.empty() || elements_.back() < sno) {
+            elements_.push_back(sno);
+            return;
+        }
+        auto it = std::lower_bound(elements_.begin(), elements_.end(), sno);
+        if (*it != sno)
+            elements_.insert(it, sno);
+    }
+
+    void erase(const_iterator it) { elements_.erase(it); }
+
+    void erase(unsigned int sno)
+    {
+        auto it = find(sno);
+        if (it != elements_.end())
+            elements_.erase(it);
+    }
+};
+
+/**
+ * Per-DRB table indexed by sequence number, stored as a ring buffer whose size
+ * follows the span of the sequence numbers in flight, up to a maximum.
+ *
+ * Slots are reused in place: erasing an entry only marks it as free, so the table
+ * does not allocate once it has reached its working size. When the sequence number
+ * being inserted maps onto a slot still holding an older entry, the table doubles
+ * its size; once at its maximum size, the older entry is evicted and the window
+ * start moves past it, i.e., entries older than getWindowStart() are no longer
+ * tracked. Sequence numbers restarting from a lower value (e.g., after an RLC
+ * reset) move the window back; the entries they evict, which are past the window
+ * start, are recorded so that isInWindow() reports them as no longer tracked.
+ */
+template<typename T>
+class SequenceNumberWindow
+{
+  protected:
+    struct Slot {
+        unsigned int sno = 0;
+        bool used = false;
+        T value;
+    };
+
+    std::vector<Slot> slots_;
+    unsigned int mask_ = 0;
+    size_t maxSize_;
+    size_t numEntries_ = 0;
+    unsigned int windowStart_ = 0;
+    unsigned long numEvicted_ = 0;
+
+    // entries evicted by a lower sequence number, past the window start
+    SequenceNumberSet evictedAhead_;
+
+    void grow()
+    {
+        std::vector<Slot> old(slots_.size() * 2);
+        old.swap(slots_);
+        mask_ = slots_.size() - 1;
+        for (auto& slot : old) {
+            if (slot.used) {
+                Slot& newSlot = slots_[slot.sno & mask_];
+                newSlot.sno = slot.sno;
+                newSlot.used = true;
+                std::swap(newSlot.value, slot.value);
+            }
+        }
+    }
+
+  public:
+    /*
+     * Sizes are rounded up to powers of two
+     */
+    SequenceNumberWindow(size_t initialSize = 64, size_t maxSize = 8192)
+    {
+        size_t size = 1;
+        while (size < initialSize)
+            size <<= 1;
+        maxSize_ = size;
+        while (maxSize_ < maxSize)
+            maxSize_ <<= 1;
+        slots_.resize(size);
+        mask_ = size - 1;
+    }
+
+    void setMaxSize(size_t maxSize)
+    {
+        size_t size = slots_.size();
+        while (size < maxSize)
+            size <<= 1;
+        maxSize_ = size;
+    }
+
+    T *find(unsigned int sno)
+    {
+        Slot& slot = slots_[sno & mask_];
+        return (slot.used && slot.sno == sno) ? &slot.value : nullptr;
+    }
+
+    bool contains(unsigned int sno) const
+    {
+        const Slot& slot = slots_[sno & mask_];
+        return slot.used && slot.sno == sno;
+    }
+
+    /*
+     * Returns the entry for the given sequence number, creating an empty one if needed
+     */
+    T& operator[](unsigned int sno)
+    {
+        return insert(sno, [](T&) {});
+    }
+
+    /*
+     * Same as operator[], but passes the entry evicted to make room for the new one
+     * (if any) to onEvict before it is cleared
+     */
+    template<typename OnEvict>
+    T& insert(unsigned int sno, OnEvict onEvict)
+    {
+        if (sno < windowStart_)
+            windowStart_ = sno;
+        Slot *slot = &slots_[sno & mask_];
+        while (slot->used && slot->sno != sno && slots_.size() < maxSize_) {
+            grow();
+            slot = &slots_[sno & mask_];
+        }
+        if (slot->used && slot->sno == sno)
+            return slot->value;
+        if (slot->used) {
+            onEvict(slot->value);
+            if (slot->sno < sno)
+                windowStart_ = std::max(windowStart_, slot->sno + 1);
+            else
+                evictedAhead_.insert(slot->sno);
+            numEvicted_++;
+            numEntries_--;
+        }
+        if (!evictedAhead_.empty()) {
+            evictedAhead_.erase(sno);
+            while (!evictedAhead_.empty() && *evictedAhead_.begin() < windowStart_)
+                evictedAhead_.erase(evictedAhead_.begin());
+        }
+        slot->sno = sno;
+        slot->used = true;
+        slot->value.clear();
+        numEntries_++;
+        return slot->value;
+    }
+
+    void erase(unsigned int sno)
+    {
+        Slot& slot = slots_[sno & mask_];
+        if (slot.used && slot.sno == sno) {
+            slot.used = false;
+            slot.value.clear();
+            numEntries_--;
+        }
+    }
+
+    void clear()
+    {
+        for (auto& slot : slots_) {
+            slot.used = false;
+            slot.value.clear();
+        }
+        numEntries_ = 0;
+        windowStart_ = 0;
+        evictedAhead_.clear();
+    }
+
+    // true if the given sequence number has not been evicted from the window
+    bool isInWindow(unsigned int sno) const
+    {
+        return sno >= windowStart_ && (evictedAhead_.empty() || evictedAhead_.find(sno) == evictedAhead_.end());
+    }
+    unsigned int getWindowStart() const { return windowStart_; }
+
+    size_t size() const { return numEntries_; }
+    size_t capacity() const { return slots_.size(); }
+    unsigned long getNumEvicted() const { return numEvicted_; }
+};
+
+/**
+ * Small table indexed by MAC PDU ID. Only the MAC PDUs being transmitted (i.e., at
+ * most one per HARQ process) are in the table, so it is searched linearly and
+ * erased entries are reused.
+ */
+template<typename T>
+class MacPduTable
+{
+  protected:
+    struct Entry {
+        long macPduId = 0;
+        bool used = false;
+        T value;
+    };
+
+    std::vector<Entry> entries_;
+
+  public:
+    T *find(long macPduId)
+    {
+        for (auto& entry : entries_) {
+            if (entry.used && entry.macPduId == macPduId)
+                return &entry.value;
+        }
+        return nullptr;
+    }
+
+    T& operator[](long macPduId)
+    {
+        Entry *free = nullptr;
+        for (auto& entry : entries_) {
+            if (entry.used && entry.macPduId == macPduId)
+                return entry.value;
+            if (!entry.used && free == nullptr)
+                free = &entry;
+        }
+        if (free == nullptr) {
+            entries_.emplace_back();
+            free = &entries_.back();
+        }
+        free->macPduId = macPduId;
+        free->used = true;
+        free->value.clear();
+        return free->value;
+    }
+
+    void erase(long macPduId)
+    {
+        for (auto& entry : entries_) {
+            if (entry.used && entry.macPduId == macPduId) {
+                entry.used = false;
+                entry.value.clear();
+                return;
+            }
+        }
+    }
+
+    void clear()
+    {
+        for (auto& entry : entries_) {
+            entry.used = false;
+            entry.value.clear();
+        }
+    }
+};
+
+} //namespace
+
+#endif
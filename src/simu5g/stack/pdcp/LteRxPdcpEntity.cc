@@ -21,6 +21,7 @@
 #include "simu5g/stack/pdcp/packet/LtePdcpPdu_m.h"
 #include "simu5g/stack/sdap/packet/NrSdapHeader_m.h"
 #include "simu5g/stack/pdcp/packet/RohcHeader.h"
+#include "simu5g/stack/pdcp/packet/RohcCompressedHeader.h"
 
 namespace simu5g {
 
@@ -95,13 +96,26 @@ void LteRxPdcpEntity::decompressHeader(Packet *pkt)
             EV << "LtePdcp : Removed SDAP header before decompression\n";
         }
 
-        auto rohcHeader = pkt->removeAtFront<RohcHeader>();
+        if (auto compressedHeader = dynamicPtrCast<const RohcCompressedHeader>(pkt->peekAtFront())) {
+            // IPv4/UDP headers compressed against the context of the flow: rebuild them from the dynamic fields
+            pkt->popAtFront(compressedHeader->getChunkLength());
+            pkt->trimFront();
+            auto udpHeader = compressedHeader->decompressUdpHeader();
+            udpHeader->markImmutable();
+            pkt->insertAtFront(udpHeader);
+            auto ipHeader = compressedHeader->decompressIpHeader();
+            ipHeader->markImmutable();
+            pkt->insertAtFront(ipHeader);
+        }
+        else {
+            auto rohcHeader = pkt->removeAtFront<RohcHeader>();
 
-        // Get the original headers from the ROHC header
-        auto originalHeaders = rohcHeader->getChunk();
+            // Get the original headers from the ROHC header
+            auto originalHeaders = rohcHeader->getChunk();
 
-        // Insert the original headers back into the packet
-        pkt->insertAtFront(originalHeaders);
+            // Insert the original headers back into the packet
+            pkt->insertAtFront(originalHeaders);
+        }
 
         // If we had an SDAP header, add it back on top
         if (sdapHeader) {
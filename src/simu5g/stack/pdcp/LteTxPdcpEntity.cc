@@ -44,6 +44,7 @@ void LteTxPdcpEntity::initialize(int stage) {
         nodeId_ = MacNodeId(getContainingNode(this)->par("macNodeId").intValue());
 
         headerCompressedSize_ = B(par("headerCompressedSize"));
+        maxRohcContexts_ = par("maxRohcContexts");
         if (headerCompressedSize_ != LTE_PDCP_HEADER_COMPRESSION_DISABLED && headerCompressedSize_ < MIN_COMPRESSED_HEADER_SIZE)
             throw cRuntimeError("Size of compressed header must not be less than %" PRId64 "B.", MIN_COMPRESSED_HEADER_SIZE.get());
     }
@@ -107,36 +108,46 @@ void LteTxPdcpEntity::compressHeader(Packet *pkt)
         auto ipHeader = pkt->removeAtFront<Ipv4Header>();
         int transportProtocol = ipHeader->getProtocolId();
 
-        inet::Ptr<inet::Chunk> transportHeader;
-        if (transportProtocol == IP_PROT_TCP) {
-            transportHeader = pkt->removeAtFront<tcp::TcpHeader>();
-        }
-        else if (transportProtocol == IP_PROT_UDP) {
-            transportHeader = pkt->removeAtFront<UdpHeader>();
+        if (transportProtocol == IP_PROT_UDP && maxRohcContexts_ > 0) {
+            // IPv4/UDP: only the dynamic fields are carried, against the context of the flow
+            auto udpHeader = pkt->removeAtFront<UdpHeader>();
+            ipHeader->markImmutable();
+            udpHeader->markImmutable();
+            auto rohcHeader = makeShared<RohcCompressedHeader>();
+            rohcHeader->compress(getRohcContext(ipHeader, udpHeader), *ipHeader, *udpHeader);
+            rohcHeader->setChunkLength(headerCompressedSize_);
+            rohcHeader->markImmutable();
+            pkt->insertAtFront(rohcHeader);
         }
         else {
-            transportHeader = nullptr;  // cannot compress
-        }
-
-        // Create a sequence chunk containing the original headers
-        auto originalHeaders = inet::makeShared<inet::SequenceChunk>();
-
-        // Make headers immutable before inserting into SequenceChunk
-        ipHeader->markImmutable();
-        originalHeaders->insertAtBack(ipHeader);
-        if (transportHeader) {
-            transportHeader->markImmutable();
-            originalHeaders->insertAtBack(transportHeader);
+            inet::Ptr<inet::Chunk> transportHeader;
+            if (transportProtocol == IP_PROT_TCP) {
+                transportHeader = pkt->removeAtFront<tcp::TcpHeader>();
+            }
+            else {
+                transportHeader = nullptr;  // cannot compress
+            }
+
+            // Create a sequence chunk containing the original headers
+            auto originalHeaders = inet::makeShared<inet::SequenceChunk>();
+
+            // Make headers immutable before inserting into SequenceChunk
+            ipHeader->markImmutable();
+            originalHeaders->insertAtBack(ipHeader);
+            if (transportHeader) {
+                transportHeader->markImmutable();
+                originalHeaders->insertAtBack(transportHeader);
+            }
+
+            // Make originalHeaders immutable before passing to RohcHeader
+            originalHeaders->markImmutable();
+
+            // Create ROHC header with original headers and compressed size
+            auto rohcHeader = makeShared<RohcHeader>(originalHeaders, headerCompressedSize_);
+            rohcHeader->markImmutable();
+            pkt->insertAtFront(rohcHeader);
         }
 
-        // Make originalHeaders immutable before passing to RohcHeader
-        originalHeaders->markImmutable();
-
-        // Create ROHC header with original headers and compressed size
-        auto rohcHeader = makeShared<RohcHeader>(originalHeaders, headerCompressedSize_);
-        rohcHeader->markImmutable();
-        pkt->insertAtFront(rohcHeader);
-
         // If we had an SDAP header, add it back on top of the ROHC header
         if (sdapHeader) {
             sdapHeader->markImmutable();
@@ -148,6 +159,39 @@ void LteTxPdcpEntity::compressHeader(Packet *pkt)
     }
 }
 
+const std::shared_ptr<RohcContext>& LteTxPdcpEntity::getRohcContext(const Ptr<const Ipv4Header>& ipHeader, const Ptr<const UdpHeader>& udpHeader)
+{
+    for (auto& context : rohcContexts_) {
+        if (context->ipHeader->getSrcAddress() != ipHeader->getSrcAddress() || context->ipHeader->getDestAddress() != ipHeader->getDestAddress()
+            || context->udpHeader->getSrcPort() != udpHeader->getSrcPort() || context->udpHeader->getDestPort() != udpHeader->getDestPort())
+            continue;
+
+        if (!context->matches(*ipHeader, *udpHeader)) {
+            // the static part of the headers has changed: refresh the context. Packets in flight keep
+            // a reference to the previous one
+            EV << "LtePdcp : Refreshing ROHC context " << context->contextId << "\n";
+            auto refreshed = std::make_shared<RohcContext>();
+            refreshed->contextId = context->contextId;
+            refreshed->ipHeader = ipHeader;
+            refreshed->udpHeader = udpHeader;
+            context = refreshed;
+        }
+        return context;
+    }
+
+    auto context = std::make_shared<RohcContext>();
+    context->contextId = nextRohcContextId_++ % maxRohcContexts_;
+    context->ipHeader = ipHeader;
+    context->udpHeader = udpHeader;
+    EV << "LtePdcp : Created ROHC context " << context->contextId << " for flow " << ipHeader->getSrcAddress() << ":" << udpHeader->getSrcPort()
+       << " -> " << ipHeader->getDestAddress() << ":" << udpHeader->getDestPort() << "\n";
+
+    if (rohcContexts_.size() < maxRohcContexts_) {
+        rohcContexts_.push_back(context);
+        return rohcContexts_.back();
+    }
+    return rohcContexts_[context->contextId] = context;
+}
 
 void LteTxPdcpEntity::deliverPdcpPdu(Packet *pdcpPkt)
 {
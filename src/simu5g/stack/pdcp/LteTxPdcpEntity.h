@@ -13,12 +13,16 @@
 #ifndef _LTE_LTETXPDCPENTITY_H_
 #define _LTE_LTETXPDCPENTITY_H_
 
+#include <memory>
+#include <vector>
+
 #include <inet/common/ModuleRefByPar.h>
 
 #include "simu5g/common/LteCommon.h"
 #include "simu5g/stack/pdcp/PdcpTxEntityBase.h"
 #include "simu5g/common/LteControlInfo.h"
 #include "simu5g/common/binder/Binder.h"
+#include "simu5g/stack/pdcp/packet/RohcCompressedHeader.h"
 
 namespace simu5g {
 
@@ -57,11 +61,20 @@ class LteTxPdcpEntity : public PdcpTxEntityBase
     // next sequence number to be assigned
     unsigned int sno_ = 0;
 
+    // ROHC compression contexts of the IPv4/UDP flows of this bearer (at most maxRohcContexts_,
+    // once full the least recently created one is replaced)
+    std::vector<std::shared_ptr<RohcContext>> rohcContexts_;
+    unsigned int maxRohcContexts_ = 16;
+    unsigned int nextRohcContextId_ = 0;
+
     // deliver the PDCP PDU to the lower layer
     virtual void deliverPdcpPdu(Packet *pdcpPkt);
 
     virtual void compressHeader(inet::Packet *pkt);
 
+    // returns the compression context for the given headers, creating or refreshing it if needed
+    const std::shared_ptr<RohcContext>& getRohcContext(const inet::Ptr<const inet::Ipv4Header>& ipHeader, const inet::Ptr<const inet::UdpHeader>& udpHeader);
+
     bool isCompressionEnabled() { return headerCompressedSize_ != LTE_PDCP_HEADER_COMPRESSION_DISABLED; }
 
   public:
@@ -0,0 +1,73 @@
+//
+//                  Simu5G
+//
+// Copyright (C) 2012-2021 Giovanni Nardini, Giovanni Stea, Antonio Virdis et al. (University of Pisa)
+// Copyright (C) 2022-2026 Giovanni Nardini, Giovanni Stea et al. (University of Pisa)
+//
+// This file is part of a software released under the license included in file
+// "license.pdf". Please read LICENSE and README files before using it.
+// The above files and the present reference are part of the software itself,
+// and cannot be removed from it.
+//
+
+#include "simu5g/stack/pdcp/packet/RohcCompressedHeader.h"
+
+using namespace omnetpp;
+using namespace inet;
+
+namespace simu5g {
+
+Register_Class(RohcCompressedHeader);
+
+bool RohcContext::matches(const Ipv4Header& ip, const UdpHeader& udp) const
+{
+    const Ipv4Header& ctxIp = *ipHeader;
+    const UdpHeader& ctxUdp = *udpHeader;
+    return ip.getSrcAddress() == ctxIp.getSrcAddress() && ip.getDestAddress() == ctxIp.getDestAddress()
+           && ip.getProtocolId() == ctxIp.getProtocolId() && ip.getTimeToLive() == ctxIp.getTimeToLive()
+           && ip.getTypeOfService() == ctxIp.getTypeOfService() && ip.getHeaderLength() == ctxIp.getHeaderLength()
+           && ip.getDontFragment() == ctxIp.getDontFragment() && ip.getMoreFragments() == ctxIp.getMoreFragments()
+           && ip.getFragmentOffset() == ctxIp.getFragmentOffset() && ip.getReservedBit() == ctxIp.getReservedBit()
+           && ip.getCrcMode() == ctxIp.getCrcMode()
+           && udp.getSrcPort() == ctxUdp.getSrcPort() && udp.getDestPort() == ctxUdp.getDestPort()
+           && udp.getCrcMode() == ctxUdp.getCrcMode();
+}
+
+void RohcCompressedHeader::compress(const std::shared_ptr<const RohcContext>& context, const Ipv4Header& ip, const UdpHeader& udp)
+{
+    handleChange();
+    this->context = context;
+    ipIdentification = ip.getIdentification();
+    ipTotalLengthField = ip.getTotalLengthField();
+    ipCrc = ip.getCrc();
+    udpTotalLengthField = udp.getTotalLengthField();
+    udpCrc = udp.getCrc();
+}
+
+Ptr<Ipv4Header> RohcCompressedHeader::decompressIpHeader() const
+{
+    auto ip = staticPtrCast<Ipv4Header>(context->ipHeader->dupShared());
+    ip->setIdentification(ipIdentification);
+    ip->setTotalLengthField(ipTotalLengthField);
+    ip->setCrc(ipCrc);
+    return ip;
+}
+
+Ptr<UdpHeader> RohcCompressedHeader::decompressUdpHeader() const
+{
+    auto udp = staticPtrCast<UdpHeader>(context->udpHeader->dupShared());
+    udp->setTotalLengthField(udpTotalLengthField);
+    udp->setCrc(udpCrc);
+    return udp;
+}
+
+std::ostream& RohcCompressedHeader::printFieldsToStream(std::ostream& stream, int level, int evFlags) const
+{
+    if (level <= PRINT_LEVEL_DETAIL) {
+        stream << EV_FIELD(contextId, getContextId());
+        stream << EV_FIELD(ipIdentification);
+    }
+    return stream;
+}
+
+} // namespace simu5g
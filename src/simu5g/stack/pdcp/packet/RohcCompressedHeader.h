@@ -0,0 +1,81 @@
+//
+//                  Simu5G
+//
+// Copyright (C) 2012-2021 Giovanni Nardini, Giovanni Stea, Antonio Virdis et al. (University of Pisa)
+// Copyright (C) 2022-2026 Giovanni Nardini, Giovanni Stea et al. (University of Pisa)
+//
+// This file is part of a software released under the license included in file
+// "license.pdf". Please read LICENSE and README files before using it.
+// The above files and the present reference are part of the software itself,
+// and cannot be removed from it.
+//
+
+#ifndef __SIMU5G_ROHCCOMPRESSEDHEADER_H
+#define __SIMU5G_ROHCCOMPRESSEDHEADER_H
+
+#include <memory>
+
+#include <inet/common/packet/chunk/FieldsChunk.h>
+#include <inet/networklayer/ipv4/Ipv4Header_m.h>
+#include <inet/transportlayer/udp/UdpHeader_m.h>
+
+namespace simu5g {
+
+/**
+ * ROHC compression context of one IPv4/UDP flow. It stores the full headers of the
+ * first packet of the flow (the static part of the headers, which is the same for
+ * all the packets of the flow) and is shared between compressor and decompressor.
+ */
+struct RohcContext
+{
+    unsigned short contextId = 0;
+    inet::Ptr<const inet::Ipv4Header> ipHeader;
+    inet::Ptr<const inet::UdpHeader> udpHeader;
+
+    // returns true if the given headers only differ from the context in the fields carried by RohcCompressedHeader
+    bool matches(const inet::Ipv4Header& ip, const inet::UdpHeader& udp) const;
+};
+
+/**
+ * Fixed-size chunk representing the IPv4 and UDP headers of a packet compressed against
+ * a RohcContext. It only carries the dynamic fields of the headers, i.e. those changing
+ * from packet to packet; the length of the chunk is the configured compressed header size.
+ */
+class RohcCompressedHeader : public inet::FieldsChunk
+{
+  protected:
+    std::shared_ptr<const RohcContext> context;
+
+    // dynamic fields
+    uint16_t ipIdentification = 0;
+    inet::B ipTotalLengthField = inet::B(-1);
+    uint16_t ipCrc = 0;
+    inet::B udpTotalLengthField = inet::B(-1);
+    uint16_t udpCrc = 0;
+
+  public:
+    RohcCompressedHeader() {}
+    RohcCompressedHeader(const RohcCompressedHeader& other) = default;
+
+    RohcCompressedHeader *dup() const override { return new RohcCompressedHeader(*this); }
+
+    /*
+     * Stores the dynamic fields of the given headers
+     */
+    void compress(const std::shared_ptr<const RohcContext>& context, const inet::Ipv4Header& ip, const inet::UdpHeader& udp);
+
+    /*
+     * Rebuilds the original headers from the context and the dynamic fields
+     */
+    inet::Ptr<inet::Ipv4Header> decompressIpHeader() const;
+    inet::Ptr<inet::UdpHeader> decompressUdpHeader() const;
+
+    const std::shared_ptr<const RohcContext>& getContext() const { return context; }
+    unsigned short getContextId() const { return context ? context->contextId : 0; }
+
+    std::ostream& printFieldsToStream(std::ostream& stream, int level, int evFlags = 0) const override;
+};
+
+} // namespace simu5g
+
+#endif
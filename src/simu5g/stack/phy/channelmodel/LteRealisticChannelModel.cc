@@ -44,6 +44,10 @@ void LteRealisticChannelModel::initialize(int stage)
 {
     LteChannelModel::initialize(stage);
     if (stage == inet::INITSTAGE_LOCAL) {
+        sinrProfile_ = Profiling::getCounter(this, "getSINR");
+        receptionProfile_ = Profiling::getCounter(this, "isReceptionSuccessful");
+        interferenceProfile_ = Profiling::getCounter(this, "interference");
+
         scenario_ = aToDeploymentScenario(par("scenario").stringValue());
         hNodeB_ = par("nodebHeight");
         shadowing_ = par("shadowing");
@@ -394,6 +398,8 @@ double LteRealisticChannelModel::computeAngularAttenuation(double hAngle, double
 
 std::vector<double> LteRealisticChannelModel::getSINR(LteAirFrame *frame, UserControlInfo *lteInfo)
 {
+    ProfilingScope profiling(sinrProfile_);
+
     // get tx power
     double recvPower = lteInfo->getTxPower(); // dBm
 
@@ -1708,6 +1714,7 @@ double LteRealisticChannelModel::jakesFading(MacNodeId nodeId, double speed,
 
 bool LteRealisticChannelModel::isReceptionSuccessful(LteAirFrame *frame, UserControlInfo *lteInfo)
 {
+    ProfilingScope profiling(receptionProfile_);
     EV << "LteRealisticChannelModel::error" << endl;
 
     // get codeword
@@ -2280,6 +2287,7 @@ double LteRealisticChannelModel::getStdDev(bool dist, MacNodeId nodeId)
 bool LteRealisticChannelModel::computeExtCellInterference(MacNodeId eNbId, MacNodeId nodeId, Coord coord, bool isCqi, GHz carrierFrequency,
         std::vector<double> *interference)
 {
+    ProfilingScope profiling(interferenceProfile_);
     EV << "**** Ext Cell Interference **** " << endl;
 
     // get external cell list
@@ -2357,6 +2365,7 @@ bool LteRealisticChannelModel::computeExtCellInterference(MacNodeId eNbId, MacNo
 bool LteRealisticChannelModel::computeBackgroundCellInterference(MacNodeId nodeId, inet::Coord bsCoord, inet::Coord ueCoord, bool isCqi, GHz carrierFrequency, const RbMap& rbmap, Direction dir,
         std::vector<double> *interference)
 {
+    ProfilingScope profiling(interferenceProfile_);
     EV << "**** Background Cell Interference **** " << endl;
 
     // get bg schedulers list
@@ -2598,6 +2607,7 @@ LteRealisticChannelModel::ShadowFadingMap *LteRealisticChannelModel::obtainShado
 bool LteRealisticChannelModel::computeDownlinkInterference(MacNodeId eNbId, MacNodeId ueId, Coord coord, bool isCqi, GHz carrierFrequency, const RbMap& rbmap,
         std::vector<double> *interference)
 {
+    ProfilingScope profiling(interferenceProfile_);
     EV << "**** Downlink Interference ****" << endl;
 
     const auto& enbList = binder_->getEnbList();
@@ -2697,6 +2707,7 @@ bool LteRealisticChannelModel::computeDownlinkInterference(MacNodeId eNbId, MacN
 
 bool LteRealisticChannelModel::computeUplinkInterference(MacNodeId eNbId, MacNodeId senderId, bool isCqi, GHz carrierFrequency, const RbMap& rbmap, std::vector<double> *interference)
 {
+    ProfilingScope profiling(interferenceProfile_);
     EV << "**** Uplink Interference for cellId[" << eNbId << "] node[" << senderId << "] ****" << endl;
 
     const std::vector<std::vector<UeAllocationInfo>> *ulTransmissionMap;
@@ -2812,6 +2823,7 @@ bool LteRealisticChannelModel::computeUplinkInterference(MacNodeId eNbId, MacNod
 bool LteRealisticChannelModel::computeD2DInterference(MacNodeId eNbId, MacNodeId senderId, Coord senderCoord, MacNodeId destId, Coord destCoord, bool isCqi, GHz carrierFrequency, const RbMap& rbmap,
         std::vector<double> *interference, Direction dir)
 {
+    ProfilingScope profiling(interferenceProfile_);
     EV << "**** D2D Interference for cellId[" << eNbId << "] node[" << destId << "] ****" << endl;
 
     // get the reference to the MAC of the eNodeB
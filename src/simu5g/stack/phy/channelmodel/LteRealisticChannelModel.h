@@ -14,6 +14,7 @@
 #define STACK_PHY_CHANNELMODEL_LTEREALISTICCHANNELMODEL_H_
 
 #include "simu5g/common/LteDefs.h"
+#include "simu5g/common/Profiling.h"
 #include "simu5g/stack/phy/channelmodel/LteChannelModel.h"
 
 namespace simu5g {
@@ -47,6 +48,11 @@ class LteRealisticChannelModel : public LteChannelModel
 {
   protected:
 
+    // profiling of the SINR and error computation
+    ProfilingCounter *sinrProfile_ = nullptr;
+    ProfilingCounter *receptionProfile_ = nullptr;
+    ProfilingCounter *interferenceProfile_ = nullptr;
+
     // Information needed about the playground
     bool useTorus_;
 
@@ -405,6 +411,16 @@ class LteRealisticChannelModel : public LteChannelModel
 
   protected:
 
+    /*
+     * Deployment scenario used by the path loss models. The setter allows subclasses
+     * to switch the scenario after initialization
+     */
+    DeploymentScenario getScenario() const { return scenario_; }
+    void setScenario(DeploymentScenario scenario) { scenario_ = scenario; }
+
+    double getNodeBHeight() const { return hNodeB_; }
+    double getUeHeight() const { return hUe_; }
+
     /*
      * Returns the 2D distance between two coordinates (ignore z-axis)
      */
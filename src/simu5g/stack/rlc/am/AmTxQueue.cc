@@ -37,6 +37,7 @@ void AmTxQueue::initialize(int stage)
         maxRtx_ = par("maxRtx");
         fragDesc_.fragUnit_ = par("fragmentSize");
         pduRtxTimeout_ = par("pduRtxTimeout");
+        pduMakeProfile_ = Profiling::getCounter(getParentModule(), "rlcPduMake");
         ctrlPduRtxTimeout_ = par("ctrlPduRtxTimeout");
         bufferStatusTimeout_ = par("bufferStatusTimeout");
         txWindowDesc_.windowSize_ = par("txWindowSize");
@@ -145,6 +146,7 @@ std::deque<Packet *> *AmTxQueue::fragmentFrame(Packet *frame, std::deque<int>& w
 void AmTxQueue::addPdus()
 {
     Enter_Method("addPdus()");
+    ProfilingScope profiling(pduMakeProfile_);
 
     // Add PDUs to the AM transmission buffer until the transmission
     // window is full or until the SDU buffer is empty
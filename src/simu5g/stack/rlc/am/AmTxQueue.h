@@ -17,6 +17,7 @@
 
 #include "simu5g/common/LteCommon.h"
 #include "simu5g/common/LteControlInfo.h"
+#include "simu5g/common/Profiling.h"
 #include "simu5g/common/timer/TTimer.h"
 #include "simu5g/stack/pdcp/packet/LtePdcpPdu_m.h"
 #include "simu5g/stack/rlc/LteRlcDefs.h"
@@ -61,6 +62,9 @@ class AmTxQueue : public RlcTxEntityBase
 
     FlowControlInfo *lteInfo_ = nullptr;
 
+    // profiling of addPdus(), shared by the entities of the same NIC
+    ProfilingCounter *pduMakeProfile_ = nullptr;
+
     //--------------------------------------------------------------------------------------
     //        Buffers
     //--------------------------------------------------------------------------------------
@@ -44,6 +44,7 @@ void UmTxEntity::initialize(int stage)
         ownerNodeId_ = mac->getMacNodeId();
 
         queueSize_ = par("queueSize");
+        pduMakeProfile_ = Profiling::getCounter(getParentModule(), "rlcPduMake");
 
         auto *rrc = getParentModule()->getSubmodule("rrc");
         d2dModeController_ = dynamic_cast<D2DModeController *>(rrc ? rrc->getSubmodule("d2dModeController") : nullptr);
@@ -139,6 +140,8 @@ bool UmTxEntity::enque(cPacket *pkt)
 
 void UmTxEntity::rlcPduMake(int pduLength)
 {
+    ProfilingScope profiling(pduMakeProfile_);
+
     EV << NOW << " UmTxEntity::rlcPduMake - PDU with size " << pduLength << " requested from MAC" << endl;
 
     // create the RLC PDU
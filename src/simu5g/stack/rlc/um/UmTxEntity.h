@@ -14,6 +14,7 @@
 #define _LTE_UMTXENTITY_H_
 
 #include "simu5g/common/LteDefs.h"
+#include "simu5g/common/Profiling.h"
 #include "simu5g/stack/rlc/RlcTxEntityBase.h"
 #include "simu5g/stack/rlc/LteRlcDefs.h"
 #include "simu5g/mec/utils/MecCommon.h"
@@ -174,6 +175,9 @@ class UmTxEntity : public RlcTxEntityBase
      */
     unsigned int queueSize_;
 
+    // profiling of rlcPduMake(), shared by the entities of the same NIC
+    ProfilingCounter *pduMakeProfile_ = nullptr;
+
     /*
      * The currently stored amount of data in the SDU queue (in bytes)
      */
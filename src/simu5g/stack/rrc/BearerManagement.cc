@@ -201,6 +201,7 @@ void BearerManagement::createOutgoingConnection(FlowControlInfo *lteInfo, bool w
             std::string name = "pdcp-tx-" + std::to_string(num(id.getNodeId())) + "-" + std::to_string(num(id.getDrbId()));
             auto *module = pdcpTxEntityModuleType_->create(name.c_str(), nicModule_);
             module->par("headerCompressedSize") = par("headerCompressedSize");
+            module->par("maxRohcContexts") = par("maxRohcContexts");
             module->finalizeParameters();
             module->buildInside();
             setEntityDisplayPosition(module, true, rlcMux, num(id.getDrbId()));
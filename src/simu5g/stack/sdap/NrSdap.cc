@@ -48,6 +48,9 @@ void NrSdap::initialize()
     isUe = (nodeRole == "UE");
     if (!isUe && reflectiveQosTable.getNullable() != nullptr)
         throw cRuntimeError("Only UE may use a reflective QoS table");
+
+    useReflectiveQos_ = par("useReflectiveQos").boolValue();
+    useDscpAsQfiFallback_ = par("useDscpAsQfiFallback").boolValue();
 }
 
 bool NrSdap::requiresSdapHeader(const DrbConfig *drb)
@@ -62,7 +65,7 @@ bool NrSdap::requiresSdapHeader(const DrbConfig *drb)
 
 bool NrSdap::shouldEnableReflectiveQos(Qfi qfi)
 {
-    return par("useReflectiveQos").boolValue(); // for now -- should come from RRC config
+    return useReflectiveQos_; // for now -- should come from RRC config
 }
 
 const inet::Protocol *NrSdap::getUpperProtocol(const DrbConfig *ctx)
@@ -110,9 +113,10 @@ void NrSdap::handleUpperPacket(inet::Packet *pkt)
     Qfi qfi = QFI_NONE;
     bool qfiFromReflectiveQos = false;
 
-    // Extract QFI from QfiReq tag if present (set by GtpUser from GTP-U header, or by app directly)
-    if (pkt->hasTag<QfiReq>()) {
-        qfi = pkt->getTag<QfiReq>()->getQfi();
+    // Extract QFI from QfiReq tag if present (set by GtpUser from GTP-U header, or by app directly).
+    // In this case the packet headers are not inspected at all
+    if (auto qfiReq = pkt->findTag<QfiReq>()) {
+        qfi = qfiReq->getQfi();
         EV_INFO << "SDAP TX: QFI = " << qfi << " extracted from QfiReq\n";
     }
     else if (isUe) {
@@ -126,7 +130,7 @@ void NrSdap::handleUpperPacket(inet::Packet *pkt)
             }
         }
         // Optional non-standard fallback: derive QFI from DSCP field of the IP header
-        if (qfi == QFI_NONE && par("useDscpAsQfiFallback").boolValue()) {
+        if (qfi == QFI_NONE && useDscpAsQfiFallback_) {
             if (pkt->hasTag<FlowControlInfo>()) {
                 uint8_t tos = (uint8_t)pkt->getTag<FlowControlInfo>()->getTypeOfService();
                 if (tos > 0) {
@@ -54,6 +54,10 @@ class NrSdap : public cSimpleModule
 
     bool isUe = true;  // Node role: true for UE, false for gNB
 
+    // cached parameters
+    bool useReflectiveQos_ = false;
+    bool useDscpAsQfiFallback_ = false;
+
   protected:
     bool requiresSdapHeader(const DrbConfig *drb);
     bool shouldEnableReflectiveQos(Qfi qfi);
@@ -36,10 +36,17 @@ void DrbTable::loadFromJson(const cValueArray *arr)
         if (entry->containsKey("isDefault"))
             ctx.isDefault = entry->get("isDefault").boolValue();
 
+        if (num(ctx.drbId) >= NUM_DRB_IDS)
+            throw cRuntimeError("DrbTable: invalid DRB ID %d in drbConfig (should be 0-%d)", (int)num(ctx.drbId), NUM_DRB_IDS - 1);
+
         // qfiList
         const cValueArray *qfiArr = check_and_cast<const cValueArray *>(entry->get("qfiList").objectValue());
-        for (int j = 0; j < (int)qfiArr->size(); j++)
-            ctx.qfiList.push_back(Qfi(qfiArr->get(j).intValue()));
+        for (int j = 0; j < (int)qfiArr->size(); j++) {
+            intval_t qfi = qfiArr->get(j).intValue();
+            if (qfi < 0 || qfi >= NUM_QFIS)
+                throw cRuntimeError("DrbTable: invalid QFI %d in drbConfig (should be 0-%d)", (int)qfi, NUM_QFIS - 1);
+            ctx.qfiList.push_back(Qfi(qfi));
+        }
 
         // rlcType (optional, default UM)
         if (entry->containsKey("rlcType"))
@@ -74,36 +81,49 @@ void DrbTable::loadFromJson(const cValueArray *arr)
             nodesWithAutoDefault.insert(ctx.ueNodeId);
         }
 
-        // Build reverse lookup: (nodeId, qfi) -> DrbConfig*
+        // Build the dense lookup tables of the node: qfi -> DrbConfig*, drbId -> DrbConfig*
         const DrbConfig *ptr = &ctx;
+        NodeDrbs& nodeDrbs = getOrCreateNodeDrbs(ctx.ueNodeId);
+        nodeDrbs.drbById[num(ctx.drbId)] = ptr;
         for (Qfi qfi : ctx.qfiList)
-            qfiToDrb_[{ctx.ueNodeId, qfi}] = ptr;
+            nodeDrbs.drbForQfi[num(qfi)] = ptr;
 
-        // Build default DRB map
+        // Build default DRB entry
         if (ctx.isDefault) {
-            defaultDrb_[ctx.ueNodeId] = ptr;
+            nodeDrbs.defaultDrb = ptr;
             if (ctx.ueNodeId == NODEID_NONE)
                 ueDefaultDrb_ = ptr;
         }
     }
 }
 
+DrbTable::NodeDrbs& DrbTable::getOrCreateNodeDrbs(MacNodeId nodeId)
+{
+    unsigned int index = num(nodeId);
+    if (index >= nodeDrbs_.size())
+        nodeDrbs_.resize(index + 1);
+    if (!nodeDrbs_[index])
+        nodeDrbs_[index] = std::make_unique<NodeDrbs>();
+    return *nodeDrbs_[index];
+}
+
 const DrbConfig* DrbTable::getDrb(DrbKey key) const
 {
-    auto it = drbMap_.find(key);
-    return it != drbMap_.end() ? &it->second : nullptr;
+    const NodeDrbs *nodeDrbs = findNodeDrbs(key.getNodeId());
+    unsigned int drbId = num(key.getDrbId());
+    return (nodeDrbs && drbId < NUM_DRB_IDS) ? nodeDrbs->drbById[drbId] : nullptr;
 }
 
 const DrbConfig* DrbTable::getDrbForQfi(MacNodeId nodeId, Qfi qfi) const
 {
-    auto it = qfiToDrb_.find({nodeId, qfi});
-    return it != qfiToDrb_.end() ? it->second : nullptr;
+    const NodeDrbs *nodeDrbs = findNodeDrbs(nodeId);
+    return (nodeDrbs && num(qfi) < NUM_QFIS) ? nodeDrbs->drbForQfi[num(qfi)] : nullptr;
 }
 
 const DrbConfig* DrbTable::getDefaultDrb(MacNodeId nodeId) const
 {
-    auto it = defaultDrb_.find(nodeId);
-    return it != defaultDrb_.end() ? it->second : nullptr;
+    const NodeDrbs *nodeDrbs = findNodeDrbs(nodeId);
+    return nodeDrbs ? nodeDrbs->defaultDrb : nullptr;
 }
 
 void DrbTable::dump(std::ostream& os) const
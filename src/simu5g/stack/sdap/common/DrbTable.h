@@ -13,7 +13,9 @@
 #ifndef STACK_SDAP_COMMON_DRBTABLE_H_
 #define STACK_SDAP_COMMON_DRBTABLE_H_
 
+#include <array>
 #include <map>
+#include <memory>
 #include <vector>
 #include <iostream>
 #include "DrbConfig.h"
@@ -29,15 +31,29 @@ class DrbTable
     // Primary table: DrbKey(nodeId, drbId) -> DrbConfig (owns DrbConfig objects)
     std::map<DrbKey, DrbConfig> drbMap_;
 
-    // Reverse lookup: (nodeId, qfi) -> DrbConfig*  (UE uses NODEID_NONE as nodeId)
-    std::map<std::pair<MacNodeId,Qfi>, const DrbConfig*> qfiToDrb_;
+    // QFIs are 6 bits and DRB IDs are at most 63, so per-node lookups are plain array accesses
+    static constexpr int NUM_QFIS = 64;
+    static constexpr int NUM_DRB_IDS = 64;
 
-    // Default DRB per nodeId (UE: NODEID_NONE key; gNB: per-UE keys)
-    std::map<MacNodeId, const DrbConfig*> defaultDrb_;
+    // Dense lookup tables of one node (pointers into drbMap_, stable after insertion)
+    struct NodeDrbs {
+        std::array<const DrbConfig*, NUM_QFIS> drbForQfi{};    // qfi -> DrbConfig*
+        std::array<const DrbConfig*, NUM_DRB_IDS> drbById{};   // drbId -> DrbConfig*
+        const DrbConfig *defaultDrb = nullptr;
+    };
+
+    // indexed by num(nodeId) (UE uses NODEID_NONE); nullptr for nodes without DRBs
+    std::vector<std::unique_ptr<NodeDrbs>> nodeDrbs_;
 
     // UE shortcut: default DRB for NODEID_NONE (nullptr if not configured)
     const DrbConfig* ueDefaultDrb_ = nullptr;
 
+    const NodeDrbs *findNodeDrbs(MacNodeId nodeId) const {
+        unsigned int index = num(nodeId);
+        return index < nodeDrbs_.size() ? nodeDrbs_[index].get() : nullptr;
+    }
+    NodeDrbs& getOrCreateNodeDrbs(MacNodeId nodeId);
+
   public:
     void loadFromJson(const omnetpp::cValueArray *arr);
 
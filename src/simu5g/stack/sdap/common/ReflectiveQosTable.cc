@@ -13,6 +13,8 @@
 #include <inet/networklayer/ipv4/Ipv4Header_m.h>
 #include <inet/transportlayer/tcp_common/TcpHeader.h>
 #include <inet/transportlayer/udp/UdpHeader_m.h>
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <sstream>
 
@@ -34,6 +36,13 @@ void ReflectiveQosTable::initialize()
 {
     // Read module parameters
     timeout_ = par("timeout").doubleValue();
+    cleanupInterval_ = par("cleanupInterval").doubleValue();
+    if (cleanupInterval_ <= 0)
+        throw cRuntimeError("ReflectiveQosTable: cleanupInterval must be positive");
+
+    // a flow is checked at most timeout/cleanupInterval + 2 ticks after it has been (re)scheduled
+    expiryWheel_.resize((size_t)ceil(timeout_ / cleanupInterval_) + 3);
+    wheelStart_ = simTime();
 
     // Initialize cleanup timer
     cleanupTimer_ = new cMessage("cleanupTimer");
@@ -44,7 +53,7 @@ void ReflectiveQosTable::handleMessage(cMessage *msg)
 {
     if (msg == cleanupTimer_) {
         // Periodic cleanup of expired flows
-        cleanupExpiredFlows();
+        processExpiryTick();
         scheduleCleanupTimer();
     }
     else {
@@ -65,7 +74,7 @@ void ReflectiveQosTable::handleDownlinkFlow(inet::Packet *pkt, Qfi qfi)
     // Extract flow key from the packet
     FlowKey downlinkFlowKey = extractFlowKey(pkt);
 
-    if (downlinkFlowKey.srcAddr.empty() || downlinkFlowKey.dstAddr.empty()) {
+    if (downlinkFlowKey.isEmpty()) {
         EV_WARN << "ReflectiveQosTable: Could not extract flow information for reflective QoS\n";
         return;
     }
@@ -76,21 +85,20 @@ void ReflectiveQosTable::handleDownlinkFlow(inet::Packet *pkt, Qfi qfi)
     // Store or update the reflective flow
     auto it = reflectiveFlows_.find(uplinkFlowKey);
     if (it != reflectiveFlows_.end()) {
-        // Update existing flow
+        // Update existing flow. An expired mapping not yet removed by the cleanup is replaced
+        if (simTime() - it->second.lastSeen > timeout_)
+            it->second.qfi = qfi;
         it->second.lastSeen = simTime();
         it->second.isActive = true;
         EV_INFO << "ReflectiveQosTable: Updated reflective QoS flow: " << uplinkFlowKey.toString()
-                << " -> QFI " << qfi << "\n";
+                << " -> QFI " << it->second.qfi << "\n";
     } else {
         // Create new reflective flow
-        ReflectiveQosFlow newFlow(qfi, uplinkFlowKey);
-        reflectiveFlows_[uplinkFlowKey] = newFlow;
+        ReflectiveQosFlow& newFlow = reflectiveFlows_[uplinkFlowKey] = ReflectiveQosFlow(qfi, uplinkFlowKey);
+        scheduleExpiryCheck(newFlow);
         EV_INFO << "ReflectiveQosTable: Created new reflective QoS flow: " << uplinkFlowKey.toString()
                 << " -> QFI " << qfi << "\n";
     }
-
-    // Cleanup expired flows periodically
-    cleanupExpiredFlows();
 }
 
 Qfi ReflectiveQosTable::lookupUplinkQfi(inet::Packet *pkt)
@@ -101,7 +109,7 @@ Qfi ReflectiveQosTable::lookupUplinkQfi(inet::Packet *pkt)
     // Extract flow key from the packet
     FlowKey uplinkFlowKey = extractFlowKey(pkt);
 
-    if (uplinkFlowKey.srcAddr.empty() || uplinkFlowKey.dstAddr.empty())
+    if (uplinkFlowKey.isEmpty())
         return QFI_NONE;
 
     // Look up the flow in reflective flows
@@ -123,24 +131,37 @@ Qfi ReflectiveQosTable::lookupUplinkQfi(inet::Packet *pkt)
     return QFI_NONE; // No match found
 }
 
-void ReflectiveQosTable::cleanupExpiredFlows()
+void ReflectiveQosTable::scheduleExpiryCheck(ReflectiveQosFlow& flow)
 {
-    if (reflectiveFlows_.empty())
-        return;
+    // first cleanup tick after the expiration time (ticks take place every cleanupInterval since wheelStart)
+    long tick = (long)floor((flow.lastSeen + timeout_ - wheelStart_) / cleanupInterval_) + 1;
+    flow.expiryTick = std::max(tick, currentTick_ + 1);
+    expiryWheel_[flow.expiryTick % expiryWheel_.size()].push_back(flow.flowKey);
+}
+
+void ReflectiveQosTable::processExpiryTick()
+{
+    currentTick_++;
 
     simtime_t currentTime = simTime();
-    auto it = reflectiveFlows_.begin();
     int removedCount = 0;
 
-    while (it != reflectiveFlows_.end()) {
+    // flows refreshed after being scheduled are rescheduled here rather than at each update
+    expiringFlows_.swap(expiryWheel_[currentTick_ % expiryWheel_.size()]);
+    for (const FlowKey& key : expiringFlows_) {
+        auto it = reflectiveFlows_.find(key);
+        if (it == reflectiveFlows_.end() || it->second.expiryTick != currentTick_)
+            continue; // stale entry, the flow has been removed or rescheduled
         if (currentTime - it->second.lastSeen > timeout_) {
-            EV_INFO << "ReflectiveQosTable: Removing expired reflective QoS flow: " << it->first.toString() << "\n";
-            it = reflectiveFlows_.erase(it);
+            EV_INFO << "ReflectiveQosTable: Removing expired reflective QoS flow: " << key.toString() << "\n";
+            reflectiveFlows_.erase(it);
             removedCount++;
-        } else {
-            ++it;
+        }
+        else {
+            scheduleExpiryCheck(it->second);
         }
     }
+    expiringFlows_.clear();
 
     if (removedCount > 0) {
         EV_INFO << "ReflectiveQosTable: Cleaned up " << removedCount << " expired reflective QoS flows\n";
@@ -150,6 +171,8 @@ void ReflectiveQosTable::cleanupExpiredFlows()
 void ReflectiveQosTable::clearAllFlows()
 {
     reflectiveFlows_.clear();
+    for (auto& slot : expiryWheel_)
+        slot.clear();
     EV_INFO << "ReflectiveQosTable: Cleared all reflective QoS flows\n";
 }
 
@@ -181,8 +204,8 @@ FlowKey ReflectiveQosTable::extractFlowKey(inet::Packet *pkt) const
             return flowKey; // Return empty FlowKey
         }
 
-        flowKey.srcAddr = ipHeader->getSrcAddress().str();
-        flowKey.dstAddr = ipHeader->getDestAddress().str();
+        flowKey.srcAddr = ipHeader->getSrcAddress().getInt();
+        flowKey.dstAddr = ipHeader->getDestAddress().getInt();
         flowKey.protocol = ipHeader->getProtocolId();
 
         // Extract transport layer ports
@@ -213,8 +236,7 @@ FlowKey ReflectiveQosTable::extractFlowKey(inet::Packet *pkt) const
 void ReflectiveQosTable::scheduleCleanupTimer()
 {
     if (cleanupTimer_ != nullptr) {
-        simtime_t cleanupInterval = par("cleanupInterval").doubleValue();
-        scheduleAt(simTime() + cleanupInterval, cleanupTimer_);
+        scheduleAt(simTime() + cleanupInterval_, cleanupTimer_);
     }
 }
 
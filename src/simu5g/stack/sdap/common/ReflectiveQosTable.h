@@ -13,33 +13,35 @@
 #define STACK_SDAP_COMMON_REFLECTIVEQOSTABLE_H_
 
 #include <omnetpp.h>
-#include <map>
-#include <set>
 #include <string>
+#include <unordered_map>
+#include <vector>
 #include <inet/common/packet/Packet.h>
+#include <inet/networklayer/contract/ipv4/Ipv4Address.h>
 #include "simu5g/common/LteTypes.h"
 
 using namespace omnetpp;
 
 namespace simu5g {
 
-// Structure to represent a flow key (5-tuple)
 struct FlowKey {
-    std::string srcAddr;
-    std::string dstAddr;
+    uint32_t srcAddr = 0;   // IPv4 addresses (0 = unspecified)
+    uint32_t dstAddr = 0;
     uint16_t srcPort = 0;
     uint16_t dstPort = 0;
     uint8_t protocol = 0;
 
     // Constructor
     FlowKey() = default;
-    FlowKey(const std::string& src, const std::string& dst, uint16_t sp, uint16_t dp, uint8_t prot)
+    FlowKey(uint32_t src, uint32_t dst, uint16_t sp, uint16_t dp, uint8_t prot)
         : srcAddr(src), dstAddr(dst), srcPort(sp), dstPort(dp), protocol(prot) {}
 
-    // Generate string representation for map keys
+    bool isEmpty() const { return srcAddr == 0 || dstAddr == 0; }
+
+    // Generate string representation
     std::string toString() const {
-        return srcAddr + ":" + std::to_string(srcPort) + "->" +
-               dstAddr + ":" + std::to_string(dstPort) + "/" + std::to_string(protocol);
+        return inet::Ipv4Address(srcAddr).str() + ":" + std::to_string(srcPort) + "->" +
+               inet::Ipv4Address(dstAddr).str() + ":" + std::to_string(dstPort) + "/" + std::to_string(protocol);
     }
 
     // Generate reverse flow key (swap src/dst)
@@ -47,15 +49,6 @@ struct FlowKey {
         return FlowKey(dstAddr, srcAddr, dstPort, srcPort, protocol);
     }
 
-    // Comparison operators for use in maps
-    bool operator<(const FlowKey& other) const {
-        if (srcAddr != other.srcAddr) return srcAddr < other.srcAddr;
-        if (dstAddr != other.dstAddr) return dstAddr < other.dstAddr;
-        if (srcPort != other.srcPort) return srcPort < other.srcPort;
-        if (dstPort != other.dstPort) return dstPort < other.dstPort;
-        return protocol < other.protocol;
-    }
-
     bool operator==(const FlowKey& other) const {
         return srcAddr == other.srcAddr && dstAddr == other.dstAddr &&
                srcPort == other.srcPort && dstPort == other.dstPort &&
@@ -63,12 +56,20 @@ struct FlowKey {
     }
 };
 
-// Structure to store reflective QoS flow information
+struct FlowKeyHash {
+    size_t operator()(const FlowKey& key) const {
+        uint64_t addresses = ((uint64_t)key.srcAddr << 32) | key.dstAddr;
+        uint64_t ports = ((uint64_t)key.srcPort << 24) | ((uint64_t)key.dstPort << 8) | key.protocol;
+        return std::hash<uint64_t>()(addresses ^ (ports * 0x9E3779B97F4A7C15ULL));
+    }
+};
+
 struct ReflectiveQosFlow {
     Qfi qfi = QFI_NONE;
     FlowKey flowKey;
     simtime_t lastSeen;
     bool isActive = true;
+    long expiryTick = -1;   // cleanup tick at which the flow is checked for expiration
 
     // Constructor
     ReflectiveQosFlow() = default;
@@ -85,7 +86,8 @@ struct ReflectiveQosFlow {
  * Key features:
  * - Tracks downlink flows with QFI associations
  * - Enables dynamic uplink QFI derivation
- * - Automatic flow expiration and cleanup
+ * - Automatic flow expiration and cleanup. Flows are kept in a timer wheel with one slot per
+ *   cleanup interval, so each cleanup only visits the flows that may have expired since the last one
  * - Support for TCP and UDP protocols
  * - Configurable via module parameters
  */
@@ -94,10 +96,17 @@ class ReflectiveQosTable : public cSimpleModule
   private:
     // Configuration (from module parameters)
     simtime_t timeout_ = 30;
+    simtime_t cleanupInterval_ = 10;
 
-    std::map<FlowKey, ReflectiveQosFlow> reflectiveFlows_;
+    std::unordered_map<FlowKey, ReflectiveQosFlow, FlowKeyHash> reflectiveFlows_;
     cMessage *cleanupTimer_ = nullptr;
 
+    // timer wheel: slot (tick % size) lists the flows to be checked at that cleanup tick
+    std::vector<std::vector<FlowKey>> expiryWheel_;
+    std::vector<FlowKey> expiringFlows_;   // scratch buffer, reused at each tick
+    simtime_t wheelStart_;
+    long currentTick_ = 0;
+
   protected:
     virtual void initialize() override;
     virtual void handleMessage(cMessage *msg) override;
@@ -113,7 +122,6 @@ class ReflectiveQosTable : public cSimpleModule
     Qfi lookupUplinkQfi(inet::Packet *pkt);
 
     // Flow management
-    void cleanupExpiredFlows();
     size_t getActiveFlowCount() const { return reflectiveFlows_.size(); }
     void clearAllFlows();
 
@@ -124,6 +132,10 @@ class ReflectiveQosTable : public cSimpleModule
     // Helper methods
     FlowKey extractFlowKey(inet::Packet *pkt) const;
 
+    // Timer wheel management
+    void scheduleExpiryCheck(ReflectiveQosFlow& flow);
+    void processExpiryTick();
+
     // Timer management
     void scheduleCleanupTimer();
     void cancelCleanupTimer();
@@ -0,0 +1,86 @@
+//
+// Allocation counter for the benchmarks.
+//
+// Built as a shared library and loaded with LD_PRELOAD, it replaces the global
+// operator new/delete and appends the number of allocations performed by the process
+// to the file named by the ALLOCCOUNT_FILE environment variable at exit. Since the
+// library is also preloaded in the processes started by the simulation (e.g., the
+// shell running bin/simu5g), the file gets one line per process and the readers
+// sum them.
+//
+//   c++ -O2 -shared -fPIC -o alloccount.so alloccount.cc
+//
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+static std::atomic<unsigned long long> numAllocations{0};
+
+static void *countedAlloc(std::size_t size)
+{
+    numAllocations.fetch_add(1, std::memory_order_relaxed);
+    return std::malloc(size ? size : 1);
+}
+
+static void *countedAlignedAlloc(std::size_t size, std::align_val_t alignment)
+{
+    numAllocations.fetch_add(1, std::memory_order_relaxed);
+    std::size_t align = static_cast<std::size_t>(alignment);
+    void *ptr = nullptr;
+    return posix_memalign(&ptr, align < sizeof(void *) ? sizeof(void *) : align, size ? size : 1) == 0 ? ptr : nullptr;
+}
+
+void *operator new(std::size_t size)
+{
+    if (void *ptr = countedAlloc(size))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size)
+{
+    if (void *ptr = countedAlloc(size))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment)
+{
+    if (void *ptr = countedAlignedAlloc(size, alignment))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size, std::align_val_t alignment)
+{
+    if (void *ptr = countedAlignedAlloc(size, alignment))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void *operator new(std::size_t size, const std::nothrow_t&) noexcept { return countedAlloc(size); }
+void *operator new[](std::size_t size, const std::nothrow_t&) noexcept { return countedAlloc(size); }
+
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+void operator delete[](void *ptr) noexcept { std::free(ptr); }
+void operator delete(void *ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void *ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete(void *ptr, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete[](void *ptr, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete(void *ptr, std::size_t, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete[](void *ptr, std::size_t, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete(void *ptr, const std::nothrow_t&) noexcept { std::free(ptr); }
+void operator delete[](void *ptr, const std::nothrow_t&) noexcept { std::free(ptr); }
+
+__attribute__((destructor)) static void reportAllocations()
+{
+    const char *fileName = std::getenv("ALLOCCOUNT_FILE");
+    if (fileName == nullptr)
+        return;
+    if (FILE *f = std::fopen(fileName, "a")) {
+        std::fprintf(f, "%llu\n", numAllocations.load());
+        std::fclose(f);
+    }
+}
@@ -0,0 +1,587 @@
+//
+//                  Simu5G
+//
+// Copyright (C) 2022-2026 Giovanni Nardini, Giovanni Stea et al. (University of Pisa)
+//
+// This file is part of a software released under the license included in file
+// "license.pdf". Please read LICENSE and README files before using it.
+// The above files and the present reference are part of the software itself,
+// and cannot be removed from it.
+//
+
+#include "KernelBenchmark.h"
+
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+
+#include "simu5g/common/binder/Binder.h"
+#include "simu5g/mec/utils/httpUtils/httpUtils.h"
+#include "simu5g/stack/mac/allocator/LteAllocationModule.h"
+#include "simu5g/stack/mac/amc/NrAmc.h"
+#include "simu5g/stack/mac/buffer/LteMacBuffer.h"
+#include "simu5g/stack/mac/buffer/harq/LteHarqBufferTx.h"
+#include "simu5g/stack/mac/conflict_graph/DistanceBasedConflictGraph.h"
+#include "simu5g/stack/phy/channelmodel/LteRealisticChannelModel.h"
+#include "simu5g/stack/phy/channelmodel/NrChannelModel_3GPP38_901.h"
+#include "simu5g/stack/phy/feedback/LteFeedbackComputationRealistic.h"
+
+namespace simu5g {
+
+// LTE channel model whose deployment scenario can be switched by the benchmark
+class RealisticChannelModelKernel : public LteRealisticChannelModel
+{
+  public:
+    using LteRealisticChannelModel::getScenario;
+    using LteRealisticChannelModel::setScenario;
+};
+
+// NR channel model exposing the antenna heights used by the urban macro path loss
+class NrChannelModelKernel : public NrChannelModel_3GPP38_901
+{
+  public:
+    using NrChannelModel_3GPP38_901::getNodeBHeight;
+    using NrChannelModel_3GPP38_901::getUeHeight;
+};
+
+Define_Module(KernelBenchmark);
+Define_Module(RealisticChannelModelKernel);
+Define_Module(NrChannelModelKernel);
+
+using namespace omnetpp;
+
+namespace {
+
+// number of precomputed inputs of the kernels taking a continuous value
+const unsigned int NUM_INPUTS = 1024;
+
+// UE speed used by the shadowing and fading kernels (30 km/h)
+const double UE_SPEED = 30 / 3.6;
+
+// MAC buffer operations per TTI (half enqueues, half dequeues)
+const unsigned int MAC_BUFFER_OPS_PER_TTI = 100000;
+
+// TCP maximum segment size used to fragment the HTTP messages
+const size_t TCP_MSS = 1460;
+
+// splits data into segments of at most segmentSize bytes
+std::vector<std::string> segment(const std::string& data, size_t segmentSize)
+{
+    std::vector<std::string> segments;
+    for (size_t pos = 0; pos < data.size(); pos += segmentSize)
+        segments.push_back(data.substr(pos, segmentSize));
+    return segments;
+}
+
+std::vector<double> logSpace(double min, double max, unsigned int n)
+{
+    std::vector<double> values(n);
+    for (unsigned int i = 0; i < n; i++)
+        values[i] = min * pow(max / min, (double)i / (n - 1));
+    return values;
+}
+
+std::vector<double> linSpace(double min, double max, unsigned int n)
+{
+    std::vector<double> values(n);
+    for (unsigned int i = 0; i < n; i++)
+        values[i] = min + (max - min) * i / (n - 1);
+    return values;
+}
+
+MacNodeId ueId(uint64_t i)
+{
+    return MacNodeId(NR_UE_MIN_ID + i);
+}
+
+// exposes the CQI computation of the realistic feedback
+class FeedbackComputationKernel : public LteFeedbackComputationRealistic
+{
+  public:
+    using LteFeedbackComputationRealistic::LteFeedbackComputationRealistic;
+    using LteFeedbackComputationRealistic::getCqi;
+};
+
+// H-ARQ unit carrying no PDU, whose state is set directly
+class HarqUnitKernel : public LteHarqUnitTx
+{
+  public:
+    HarqUnitKernel(unsigned char acid, Codeword cw) : LteHarqUnitTx(acid, cw) {}
+
+    void setStatus(TxHarqPduStatus status, simtime_t txTime)
+    {
+        status_ = status;
+        txTime_ = txTime;
+    }
+};
+
+// H-ARQ process made of MAX_CODEWORDS HarqUnitKernel units
+class HarqProcessKernel : public LteHarqProcessTx
+{
+  public:
+    HarqProcessKernel(unsigned char acid, unsigned int numProcesses)
+    {
+        numProcesses_ = numProcesses;
+        numHarqUnits_ = MAX_CODEWORDS;
+        acid_ = acid;
+        numEmptyUnits_ = MAX_CODEWORDS;
+        numSelected_ = 0;
+        dropped_ = false;
+        for (Codeword cw = 0; cw < MAX_CODEWORDS; cw++) {
+            units_.push_back(new HarqUnitKernel(acid, cw));
+            updateUnitStatus(cw);
+        }
+    }
+
+    // sets the state of all the units, as H-ARQ feedback is received for the whole process
+    void setStatus(TxHarqPduStatus status, simtime_t txTime)
+    {
+        for (Codeword cw = 0; cw < numHarqUnits_; cw++) {
+            static_cast<HarqUnitKernel *>(units_[cw])->setStatus(status, txTime);
+            updateUnitStatus(cw);
+        }
+        numEmptyUnits_ = (status == TXHARQ_PDU_EMPTY) ? numHarqUnits_ : 0;
+    }
+};
+
+// H-ARQ TX buffer made of HarqProcessKernel processes, not attached to any MAC
+class HarqBufferKernel : public LteHarqBufferTx
+{
+  public:
+    HarqBufferKernel(Binder *binder, unsigned int numProc) : LteHarqBufferTx(binder, numProc, nullptr)
+    {
+        for (unsigned int acid = 0; acid < numProc; acid++)
+            processes_[acid] = new HarqProcessKernel(acid, numProc);
+    }
+
+    void setProcessStatus(unsigned char acid, TxHarqPduStatus status, simtime_t txTime)
+    {
+        static_cast<HarqProcessKernel *>(processes_[acid])->setStatus(status, txTime);
+        updateProcessStatus(acid);
+    }
+};
+
+// conflict graph built from synthetic positions instead of the mobility of the UEs
+class ConflictGraphKernel : public DistanceBasedConflictGraph
+{
+  public:
+    using DistanceBasedConflictGraph::DistanceBasedConflictGraph;
+    using DistanceBasedConflictGraph::setPositions;
+    using DistanceBasedConflictGraph::findEdges;
+
+    // removes all the edges, as expected by findEdges()
+    void clearEdges(const std::vector<CGVertex>& vertices) { conflictGraph_.reset(vertices); }
+};
+
+} // namespace
+
+KernelBenchmark::~KernelBenchmark()
+{
+    cancelAndDelete(startMsg_);
+}
+
+void KernelBenchmark::initialize(int stage)
+{
+    if (stage == inet::INITSTAGE_LOCAL) {
+        binder_.reference(this, "binderModule", true);
+        lteChannelModel_.reference(this, "lteChannelModelModule", true);
+        nrChannelModel_.reference(this, "nrChannelModelModule", true);
+
+        for (const auto& kernel : cStringTokenizer(par("kernels")).asVector())
+            kernels_.insert(kernel);
+        minTime_ = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(par("minTime").doubleValue()));
+        ueCounts_ = cStringTokenizer(par("ueCounts")).asIntVector();
+        bandCounts_ = cStringTokenizer(par("bandCounts")).asIntVector();
+        linkCounts_ = cStringTokenizer(par("linkCounts")).asIntVector();
+
+        // run the kernels when all the modules have been initialized
+        startMsg_ = new cMessage("startBenchmark");
+        scheduleAt(simTime(), startMsg_);
+    }
+}
+
+void KernelBenchmark::handleMessage(cMessage *msg)
+{
+    std::cout << std::left << std::setw(16) << "kernel" << std::setw(36) << "input" << std::right << std::setw(14) << "ns/call" << std::setw(14) << "calls" << std::endl;
+
+    benchmarkPathLoss();
+    benchmarkShadowing();
+    benchmarkJakesFading();
+    benchmarkNrUrbanMacro();
+    benchmarkTbsFromNinfo();
+    benchmarkFeedbackCqi();
+    benchmarkBler();
+    benchmarkMacBuffer();
+    benchmarkHarq();
+    benchmarkAddBlocks();
+    benchmarkConflictGraph();
+    benchmarkHttpParser();
+}
+
+bool KernelBenchmark::isSelected(const char *kernel) const
+{
+    return kernels_.empty() || kernels_.count(kernel) > 0;
+}
+
+template<typename Setup, typename Op>
+void KernelBenchmark::measure(const char *kernel, const std::string& input, unsigned int batchSize, Setup setup, Op op)
+{
+    double sum = 0;
+
+    // warm-up batch, not timed
+    setup();
+    for (unsigned int i = 0; i < batchSize; i++)
+        sum += op(i);
+
+    std::chrono::steady_clock::duration time = std::chrono::steady_clock::duration::zero();
+    uint64_t calls = 0;
+    do {
+        setup();
+        auto start = std::chrono::steady_clock::now();
+        for (unsigned int i = 0; i < batchSize; i++)
+            sum += op(calls + i);
+        time += std::chrono::steady_clock::now() - start;
+        calls += batchSize;
+    } while (time < minTime_);
+    sink_ = sink_ + sum;
+
+    double nsPerCall = std::chrono::duration<double, std::nano>(time).count() / calls;
+    std::cout << std::left << std::setw(16) << kernel << std::setw(36) << input << std::right << std::fixed << std::setprecision(1)
+              << std::setw(14) << nsPerCall << std::setw(14) << calls << std::endl;
+    recordScalar(("kernel:" + std::string(kernel) + ":" + input).c_str(), nsPerCall, "ns");
+}
+
+void KernelBenchmark::benchmarkPathLoss()
+{
+    if (!isSelected("pathLoss"))
+        return;
+
+    struct Scenario
+    {
+        DeploymentScenario scenario;
+        const char *name;
+        double minDistance;   // validity range of both the LOS and the NLOS models
+        double maxDistance;
+    };
+    const Scenario scenarios[] = {
+        { INDOOR_HOTSPOT, "InH", 6, 150 },
+        { URBAN_MICROCELL, "UMi", 10, 2000 },
+        { URBAN_MACROCELL, "UMa", 10, 5000 },
+        { RURAL_MACROCELL, "RMa", 10, 5000 },
+        { SUBURBAN_MACROCELL, "SMa", 10, 5000 },
+    };
+
+    RealisticChannelModelKernel *channelModel = lteChannelModel_.get();
+    DeploymentScenario configuredScenario = channelModel->getScenario();
+    for (const auto& s : scenarios) {
+        std::vector<double> distances = logSpace(s.minDistance, s.maxDistance, NUM_INPUTS);
+        channelModel->setScenario(s.scenario);
+        for (bool los : { true, false }) {
+            std::string input = std::string(s.name) + (los ? " LOS" : " NLOS");
+            measure("pathLoss", input, NUM_INPUTS, [] {}, [&](uint64_t i) {
+                return channelModel->computePathLoss(distances[i % NUM_INPUTS], 0, los);
+            });
+        }
+    }
+    channelModel->setScenario(configuredScenario);
+}
+
+void KernelBenchmark::benchmarkShadowing()
+{
+    if (!isSelected("shadowing"))
+        return;
+
+    RealisticChannelModelKernel *channelModel = lteChannelModel_.get();
+    auto *shadowingMap = channelModel->getShadowingMap();
+    for (int numUes : ueCounts_) {
+        std::string ues = "ues=" + std::to_string(numUes);
+        auto call = [&](uint64_t i) {
+            return channelModel->computeShadowing(0, ueId(i % numUes), UE_SPEED, false);
+        };
+
+        // first computation for each UE
+        measure("shadowing", ues + " new", numUes, [&] { shadowingMap->clear(); }, call);
+
+        // the UEs moved less than the correlation distance: the last value is returned
+        measure("shadowing", ues + " cached", numUes, [] {}, call);
+
+        // the UEs moved farther than the correlation distance: the value is updated
+        measure("shadowing", ues + " update", numUes, [&] {
+            for (auto& entry : *shadowingMap)
+                entry.second.first = NOW - SimTime(1000, SIMTIME_S);
+        }, call);
+    }
+    shadowingMap->clear();
+}
+
+void KernelBenchmark::benchmarkJakesFading()
+{
+    if (!isSelected("jakesFading"))
+        return;
+
+    RealisticChannelModelKernel *channelModel = lteChannelModel_.get();
+    auto *jakesMap = channelModel->getJakesMap();
+    unsigned int numBands = channelModel->getNumBands();
+    for (int numUes : ueCounts_) {
+        std::string ues = "ues=" + std::to_string(numUes) + " bands=" + std::to_string(numBands);
+
+        // first computation for each UE, which draws the paths of all the bands
+        measure("jakesFading", ues + " new", numUes, [&] { jakesMap->clear(); }, [&](uint64_t i) {
+            return channelModel->jakesFading(ueId(i % numUes), UE_SPEED, 0, false);
+        });
+
+        // one call per UE and band, as done for each transmission
+        measure("jakesFading", ues, NUM_INPUTS, [] {}, [&](uint64_t i) {
+            return channelModel->jakesFading(ueId(i % numUes), UE_SPEED, (i / numUes) % numBands, false);
+        });
+    }
+    jakesMap->clear();
+}
+
+void KernelBenchmark::benchmarkNrUrbanMacro()
+{
+    if (!isSelected("nrUrbanMacro"))
+        return;
+
+    NrChannelModelKernel *channelModel = nrChannelModel_.get();
+    std::vector<double> twoDimDistances = logSpace(10, 5000, NUM_INPUTS);
+    std::vector<double> threeDimDistances(NUM_INPUTS);
+    double heightDiff = channelModel->getNodeBHeight() - channelModel->getUeHeight();
+    for (unsigned int i = 0; i < NUM_INPUTS; i++)
+        threeDimDistances[i] = sqrt(twoDimDistances[i] * twoDimDistances[i] + heightDiff * heightDiff);
+
+    for (bool los : { true, false }) {
+        measure("nrUrbanMacro", los ? "LOS" : "NLOS", NUM_INPUTS, [] {}, [&](uint64_t i) {
+            return channelModel->computeUrbanMacro(threeDimDistances[i % NUM_INPUTS], twoDimDistances[i % NUM_INPUTS], los);
+        });
+    }
+}
+
+void KernelBenchmark::benchmarkTbsFromNinfo()
+{
+    if (!isSelected("tbsFromNinfo"))
+        return;
+
+    // from one RB with QPSK up to 275 RBs with 256QAM and 4 layers
+    std::vector<double> smallInfo = logSpace(24, 3824, NUM_INPUTS);
+    std::vector<double> largeInfo = logSpace(3825, 1.3e6, NUM_INPUTS);
+    for (auto& nInfo : smallInfo)
+        nInfo = floor(nInfo);
+    for (auto& nInfo : largeInfo)
+        nInfo = floor(nInfo);
+
+    measure("tbsFromNinfo", "nInfo<=3824 (table)", NUM_INPUTS, [] {}, [&](uint64_t i) {
+        return NrAmc::computeTbsFromNinfo(smallInfo[i % NUM_INPUTS], 0.5);
+    });
+    for (double coderate : { 0.2, 0.6 }) {
+        std::ostringstream input;
+        input << "nInfo>3824 R=" << coderate;
+        measure("tbsFromNinfo", input.str(), NUM_INPUTS, [] {}, [&](uint64_t i) {
+            return NrAmc::computeTbsFromNinfo(largeInfo[i % NUM_INPUTS], coderate);
+        });
+    }
+}
+
+void KernelBenchmark::benchmarkFeedbackCqi()
+{
+    if (!isSelected("feedbackCqi"))
+        return;
+
+    // the SNRs span the whole range of the BLER curves, plus the values mapped to CQI 0 and 15
+    std::vector<double> snrs = linSpace(-20, 45, NUM_INPUTS);
+    for (double targetBler : { 0.01, 0.1 }) {
+        FeedbackComputationKernel feedback(binder_.get(), targetBler, 1);
+        for (TxMode txMode : { SINGLE_ANTENNA_PORT0, TRANSMIT_DIVERSITY }) {
+            std::ostringstream input;
+            input << txModeToA(txMode) << " targetBler=" << targetBler;
+            measure("feedbackCqi", input.str(), NUM_INPUTS, [] {}, [&](uint64_t i) {
+                return (double)feedback.getCqi(txMode, snrs[i % NUM_INPUTS]);
+            });
+        }
+    }
+}
+
+void KernelBenchmark::benchmarkBler()
+{
+    if (!isSelected("bler"))
+        return;
+
+    PhyPisaData& phyPisaData = binder_->phyPisaData;
+    int minSnr = phyPisaData.minSnr();
+    int numSnrs = phyPisaData.maxSnr() - minSnr + 1;
+    int numCqis = phyPisaData.nCqi();
+    measure("bler", "all CQIs and SINRs", numCqis * numSnrs, [] {}, [&](uint64_t i) {
+        return phyPisaData.getBler(0, 1 + i % numCqis, minSnr + (i / numCqis) % numSnrs);
+    });
+}
+
+void KernelBenchmark::benchmarkMacBuffer()
+{
+    if (!isSelected("macBuffer"))
+        return;
+
+    // one TTI per batch: the SDUs arrived in the TTI are enqueued in the per-UE virtual
+    // buffers, then the scheduler drains them, querying the occupancy and HOL delay
+    const unsigned int numPackets = MAC_BUFFER_OPS_PER_TTI / 2;
+    for (int numUes : ueCounts_) {
+        std::vector<LteMacBuffer> buffers(numUes);
+        std::string input = "ues=" + std::to_string(numUes) + " ops/TTI=" + std::to_string(MAC_BUFFER_OPS_PER_TTI);
+        measure("macBuffer", input, MAC_BUFFER_OPS_PER_TTI, [] {}, [&](uint64_t i) {
+            unsigned int op = i % MAC_BUFFER_OPS_PER_TTI;
+            LteMacBuffer& buffer = buffers[op % numUes];
+            if (op < numPackets) {
+                buffer.pushBack(PacketInfo(100, NOW));
+                return (double)buffer.getQueueLength();
+            }
+            double occupancy = buffer.getQueueOccupancy() + buffer.getHolTimestamp().dbl();
+            return occupancy + buffer.popFront().first;
+        });
+    }
+}
+
+void KernelBenchmark::benchmarkHarq()
+{
+    if (!isSelected("harq"))
+        return;
+
+    // per-TTI lookups of the scheduler for each UE: a process to retransmit and, if there
+    // is none, an empty process for a new transmission. One UE out of ten has a process
+    // ready for retransmission, and half of the processes are waiting for feedback
+    for (unsigned int numProcs : { 8, 16 }) {
+        for (int numUes : ueCounts_) {
+            std::vector<std::unique_ptr<HarqBufferKernel>> buffers;
+            for (int u = 0; u < numUes; u++) {
+                buffers.emplace_back(new HarqBufferKernel(binder_.get(), numProcs));
+                for (unsigned int acid = 0; acid < numProcs; acid++) {
+                    if (u % 10 == 0 && acid == u % numProcs)
+                        buffers[u]->setProcessStatus(acid, TXHARQ_PDU_BUFFERED, NOW);
+                    else if ((u + acid) % 2 == 0)
+                        buffers[u]->setProcessStatus(acid, TXHARQ_PDU_WAITING, NOW);
+                }
+            }
+
+            std::string input = "procs=" + std::to_string(numProcs) + " cws=" + std::to_string(MAX_CODEWORDS) + " ues=" + std::to_string(numUes);
+            measure("harq", input, numUes, [] {}, [&](uint64_t i) {
+                HarqBufferKernel& buffer = *buffers[i % numUes];
+                UnitList units = buffer.firstReadyForRtx();
+                if (units.first == HARQ_NONE)
+                    units = buffer.firstAvailable();
+                return (double)(units.first + units.second.size());
+            });
+        }
+    }
+}
+
+void KernelBenchmark::benchmarkAddBlocks()
+{
+    if (!isSelected("addBlocks"))
+        return;
+
+    // one TTI per batch: the allocator is reset and each band is assigned to one of the UEs
+    for (int numBands : bandCounts_) {
+        LteAllocationModule allocator(nullptr, DL);
+        allocator.init(numBands, numBands);
+        for (int numUes : ueCounts_) {
+            std::string input = "bands=" + std::to_string(numBands) + " ues=" + std::to_string(numUes);
+            measure("addBlocks", input, numBands, [&] { allocator.reset(numBands, numBands); }, [&](uint64_t i) {
+                return (double)allocator.addBlocks(MACRO, (Band)(i % numBands), ueId(i % numUes), 1, 100);
+            });
+        }
+    }
+}
+
+void KernelBenchmark::benchmarkConflictGraph()
+{
+    if (!isSelected("conflictGraph"))
+        return;
+
+    // D2D pairs placed uniformly in a 1 km x 1 km area, with the receiver within 30 m of the transmitter
+    const double areaSize = 1000;
+    const double pairDistance = 30;
+    const double interferenceRadius = 50;
+    const double multicastRadius = 100;
+
+    for (bool multicast : { false, true }) {
+        for (int numLinks : linkCounts_) {
+            ConflictGraphKernel graph(binder_.get(), nullptr, true, multicast, -90);
+            graph.setThresholds(interferenceRadius, multicastRadius, multicastRadius);
+
+            // with multicast, one link out of five is a one-to-many transmission
+            std::vector<CGVertex> vertices;
+            std::vector<inet::Coord> txPositions, rxPositions;
+            for (int i = 0; i < numLinks; i++) {
+                inet::Coord tx(uniform(0, areaSize), uniform(0, areaSize));
+                if (multicast && i % 5 == 0) {
+                    vertices.emplace_back(ueId(2 * i), NODEID_NONE);
+                    txPositions.push_back(tx);
+                    rxPositions.push_back(tx);
+                }
+                else {
+                    double angle = uniform(0, 2 * M_PI);
+                    vertices.emplace_back(ueId(2 * i), ueId(2 * i + 1));
+                    txPositions.push_back(tx);
+                    rxPositions.push_back(tx + inet::Coord(pairDistance * cos(angle), pairDistance * sin(angle)));
+                }
+            }
+            graph.setPositions(txPositions, rxPositions);
+
+            std::string input = std::string(multicast ? "p2p+p2mp" : "p2p") + " links=" + std::to_string(numLinks);
+            measure("conflictGraph", input, 1, [&] { graph.clearEdges(vertices); }, [&](uint64_t i) {
+                graph.findEdges(vertices);
+                return (double)graph.getConflictMatrix()->size();
+            });
+        }
+    }
+}
+
+void KernelBenchmark::benchmarkHttpParser()
+{
+    if (!isSelected("httpParser"))
+        return;
+
+    // a request of the Location Service API and a response carrying a JSON body
+    const std::string request = "GET /example/location/v2/queries/users?accessPointId=1 HTTP/1.1\r\nHost: 10.0.2.1:10020\r\n\r\n";
+    std::string body = "{\"userList\":{\"user\":[";
+    for (int i = 0; i < 40; i++)
+        body += std::string(i > 0 ? "," : "") + "{\"address\":\"acr:10.0.0." + std::to_string(i) + "\",\"accessPointId\":\"1\",\"zoneId\":\"1\"}";
+    body += "]}}";
+    const std::string response = "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\nContent-Length: " + std::to_string(body.size()) + "\r\n\r\n" + body;
+
+    // the TCP segments delivering numMessages messages to the socket
+    struct Stream
+    {
+        std::string name;
+        std::vector<std::string> segments;
+        unsigned int numMessages;
+    };
+    std::string pipelined;
+    for (int i = 0; i < 4; i++)
+        pipelined += request;
+    const Stream streams[] = {
+        { "GET 1/segment", { request }, 1 },
+        { "GET 4 pipelined/segment", { pipelined }, 4 },
+        { "GET header over 2 segments", { request.substr(0, request.size() / 2), request.substr(request.size() / 2) }, 1 },
+        { "200 body=" + std::to_string(body.size()) + "B MSS=" + std::to_string(TCP_MSS), segment(response, TCP_MSS), 1 },
+    };
+
+    // one call per message: the segments of the stream are parsed, then each message is consumed
+    cQueue messageQueue;
+    std::string storedData;
+    HttpBaseMessage *currentMessage = nullptr;
+    for (const auto& stream : streams) {
+        measure("httpParser", stream.name + " (per msg)", stream.numMessages * 256, [] {}, [&](uint64_t i) {
+            if (i % stream.numMessages == 0) {
+                for (const auto& data : stream.segments)
+                    Http::parseReceivedMsg(0, data, messageQueue, storedData, currentMessage);
+            }
+            delete messageQueue.pop();
+            return (double)messageQueue.getLength();
+        });
+        if (currentMessage != nullptr || !storedData.empty())
+            throw cRuntimeError("KernelBenchmark: the HTTP stream \"%s\" left an incomplete message", stream.name.c_str());
+    }
+}
+
+} //namespace
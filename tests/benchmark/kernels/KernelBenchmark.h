@@ -0,0 +1,89 @@
+//
+//                  Simu5G
+//
+// Copyright (C) 2022-2026 Giovanni Nardini, Giovanni Stea et al. (University of Pisa)
+//
+// This file is part of a software released under the license included in file
+// "license.pdf". Please read LICENSE and README files before using it.
+// The above files and the present reference are part of the software itself,
+// and cannot be removed from it.
+//
+
+#ifndef __SIMU5G_KERNELBENCHMARK_H_
+#define __SIMU5G_KERNELBENCHMARK_H_
+
+#include <chrono>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <inet/common/ModuleRefByPar.h>
+
+#include "simu5g/common/LteCommon.h"
+
+namespace simu5g {
+
+using namespace omnetpp;
+
+class Binder;
+class RealisticChannelModelKernel;
+class NrChannelModelKernel;
+
+/**
+ * Microbenchmarks of the Simu5G kernels, see KernelBenchmark.ned.
+ *
+ * Each benchmark*() function sweeps the inputs of one kernel and calls measure()
+ * for each input. measure() repeats batches of calls until minTime has been spent
+ * in them: the (untimed) setup function is called before each batch, e.g., to
+ * restore the state of a per-TTI structure, and the operation is called batchSize
+ * times with increasing indices, which select the input of each call.
+ */
+class KernelBenchmark : public cSimpleModule
+{
+  protected:
+    inet::ModuleRefByPar<Binder> binder_;
+    inet::ModuleRefByPar<RealisticChannelModelKernel> lteChannelModel_;
+    inet::ModuleRefByPar<NrChannelModelKernel> nrChannelModel_;
+
+    cMessage *startMsg_ = nullptr;
+
+    // kernels to run (all of them if empty)
+    std::set<std::string> kernels_;
+
+    std::chrono::steady_clock::duration minTime_;
+    std::vector<int> ueCounts_;
+    std::vector<int> bandCounts_;
+    std::vector<int> linkCounts_;
+
+    // sum of the values returned by the kernels, so that the calls are not optimized away
+    volatile double sink_ = 0;
+
+    bool isSelected(const char *kernel) const;
+
+    template<typename Setup, typename Op>
+    void measure(const char *kernel, const std::string& input, unsigned int batchSize, Setup setup, Op op);
+
+    void benchmarkPathLoss();
+    void benchmarkShadowing();
+    void benchmarkJakesFading();
+    void benchmarkNrUrbanMacro();
+    void benchmarkTbsFromNinfo();
+    void benchmarkFeedbackCqi();
+    void benchmarkBler();
+    void benchmarkMacBuffer();
+    void benchmarkHarq();
+    void benchmarkAddBlocks();
+    void benchmarkConflictGraph();
+    void benchmarkHttpParser();
+
+    void initialize(int stage) override;
+    int numInitStages() const override { return inet::NUM_INIT_STAGES; }
+    void handleMessage(cMessage *msg) override;
+
+  public:
+    ~KernelBenchmark() override;
+};
+
+} //namespace
+
+#endif
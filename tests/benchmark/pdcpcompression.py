@@ -0,0 +1,99 @@
+#!/usr/bin/env python3
+#
+# PDCP header compression benchmark
+#
+# Runs the VoIP-DL and VoIP-UL configurations of simulations/nr/standalone without
+# header compression, with the legacy compression path (maxRohcContexts = 0) and with
+# the ROHC context path, and reports the wall-clock time and the number of heap
+# allocations per received VoIP packet. Allocations are counted by preloading the
+# library built from alloccount.cc, which is compiled on the fly.
+#
+# Usage (after '. setenv' in the Simu5G root directory):
+#   python3 pdcpcompression.py [--configs VoIP-DL VoIP-UL] [--simtime 20s] [--compressedSize 4B]
+#
+
+import argparse
+import json
+import os
+import re
+import subprocess
+import sys
+import tempfile
+import time
+
+benchmarkDir = os.path.abspath(os.path.dirname(__file__))
+rootDir = os.path.abspath(os.path.join(benchmarkDir, "..", ".."))
+workingDir = os.path.join(rootDir, "simulations", "nr", "standalone")
+receiverPattern = re.compile(r"\.app\[\d+\]$")
+
+
+def buildAllocCounter(buildDir):
+    library = os.path.join(buildDir, "alloccount.so")
+    subprocess.run([os.environ.get("CXX", "c++"), "-O2", "-shared", "-fPIC", "-o", library,
+                    os.path.join(benchmarkDir, "alloccount.cc")], check=True)
+    return library
+
+
+def countReceivedPackets(scaFile):
+    packets = 0
+    with open(scaFile) as f:
+        for line in f:
+            fields = line.split()
+            if len(fields) == 4 and fields[0] == "scalar" and receiverPattern.search(fields[1]) and fields[2] == "voipFrameDelay:count":
+                packets += int(float(fields[3]))
+    return packets
+
+
+def runOnce(config, simtime, modeArgs, allocCounter):
+    with tempfile.TemporaryDirectory() as resultDir:
+        scaFile = os.path.join(resultDir, "pdcp.sca")
+        countFile = os.path.join(resultDir, "allocations")
+        command = ["simu5g", "-u", "Cmdenv", "-f", "omnetpp.ini", "-c", config, "-r", "0",
+                   "--sim-time-limit=" + simtime,
+                   "--**.voipFrameDelay.result-recording-modes=+count",
+                   "--cmdenv-express-mode=true", "--cmdenv-status-frequency=1000s",
+                   "--output-scalar-file=" + scaFile, "--output-vector-file=" + os.path.join(resultDir, "pdcp.vec")] + modeArgs
+        env = dict(os.environ, LD_PRELOAD=allocCounter, ALLOCCOUNT_FILE=countFile)
+        start = time.perf_counter()
+        result = subprocess.run(command, cwd=workingDir, env=env, stdout=subprocess.PIPE, stderr=subprocess.STDOUT, universal_newlines=True)
+        elapsed = time.perf_counter() - start
+        if result.returncode != 0:
+            sys.stderr.write(result.stdout)
+            raise RuntimeError("simulation exited with code %d" % result.returncode)
+        with open(countFile) as f:
+            allocations = sum(int(line) for line in f)
+        return countReceivedPackets(scaFile), allocations, elapsed
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Measure allocations and run time of the PDCP header compression paths")
+    parser.add_argument("--configs", nargs="+", default=["VoIP-DL", "VoIP-UL"], help="configurations to run")
+    parser.add_argument("--simtime", default="20s", help="simulated time")
+    parser.add_argument("--compressedSize", default="4B", help="size of the compressed headers")
+    parser.add_argument("--json", help="write the results to this file")
+    args = parser.parse_args()
+
+    modes = [
+        ("uncompressed", ["--**.headerCompressedSize=-1B"]),
+        ("legacy", ["--**.headerCompressedSize=" + args.compressedSize, "--**.maxRohcContexts=0"]),
+        ("rohc", ["--**.headerCompressedSize=" + args.compressedSize]),
+    ]
+
+    results = []
+    with tempfile.TemporaryDirectory() as buildDir:
+        allocCounter = buildAllocCounter(buildDir)
+        for config in args.configs:
+            for mode, modeArgs in modes:
+                packets, allocations, elapsed = runOnce(config, args.simtime, modeArgs, allocCounter)
+                perPacket = allocations / packets if packets else float("nan")
+                results.append({"config": config, "mode": mode, "simtime": args.simtime, "packets": packets,
+                                "allocations": allocations, "allocationsPerPacket": perPacket, "wallClockSeconds": elapsed})
+                print("%-8s %-12s packets=%-8d allocations=%-12d %10.1f allocs/packet  elapsed=%8.3fs" % (config, mode, packets, allocations, perPacket, elapsed))
+
+    if args.json:
+        with open(args.json, "w") as f:
+            json.dump(results, f, indent=2)
+
+
+if __name__ == "__main__":
+    main()
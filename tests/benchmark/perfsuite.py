@@ -0,0 +1,274 @@
+#!/usr/bin/env python3
+#
+# Performance benchmark suite
+#
+# Runs the scenarios listed in perfsuite.csv for each combination of their UE count,
+# cell count and carrier bandwidth (number of RBs), and records for each run:
+#   - the number of events and the events per wall-clock second
+#   - the wall-clock time per simulated second
+#   - the peak resident set size of the simulation process
+#   - the number of heap allocations (counted by preloading the library built from
+#     alloccount.cc, which is compiled on the fly)
+# The results are written to a JSON report and compared against the baselines: like
+# fingerprint changes, runs that process more events, allocate more, or are slower or
+# bigger than the baseline beyond the given tolerance are reported as FAILED, and the
+# exit code is 1.
+#
+# There are two baselines:
+#   - perfbaseline.json (committed) holds the metrics that do not depend on the machine,
+#     i.e., the number of events and of heap allocations. A variant without an entry in
+#     it is reported as FAILED too, unless --allow-missing-baseline is given (e.g., while
+#     adding a new scenario, before recording its baseline)
+#   - perfbaseline.local.json (not committed) holds the timings and the peak RSS, which
+#     are only compared if it exists, i.e., if they have been recorded on this machine
+# --update-baseline records both of them.
+#
+# Usage (after '. setenv' in the Simu5G root directory):
+#   python3 perfsuite.py [--filter REGEX] [--ues 10 50] [--cells 3] [--bands 50]
+#                        [--repeat 3] [--report perfreport.json]
+#                        [--baseline perfbaseline.json] [--local-baseline perfbaseline.local.json]
+#                        [--update-baseline] [--allow-missing-baseline] [--tolerance 10]
+#
+
+import argparse
+import csv
+import datetime
+import itertools
+import json
+import os
+import platform
+import re
+import subprocess
+import sys
+import tempfile
+import time
+
+benchmarkDir = os.path.abspath(os.path.dirname(__file__))
+rootDir = os.path.abspath(os.path.join(benchmarkDir, "..", ".."))
+
+# metric -> True if higher values are better
+deterministicMetrics = {
+    "events": False,
+    "allocations": False,
+}
+timingMetrics = {
+    "eventsPerSecond": True,
+    "wallClockPerSimSecond": False,
+    "peakRssKiB": False,
+}
+
+
+def buildAllocCounter(buildDir):
+    library = os.path.join(buildDir, "alloccount.so")
+    subprocess.run([os.environ.get("CXX", "c++"), "-O2", "-shared", "-fPIC", "-o", library,
+                    os.path.join(benchmarkDir, "alloccount.cc")], check=True)
+    return library
+
+
+def readSuite(fileName):
+    suite = []
+    with open(fileName) as f:
+        lines = [line for line in f if line.strip() and not line.lstrip().startswith("#")]
+    for fields in csv.reader(lines, skipinitialspace=True):
+        if len(fields) != 8:
+            raise ValueError("%s: expected 8 columns, found %d: %s" % (fileName, len(fields), fields))
+        name, workingDir, args, simtime, ues, cells, bands, overrides = [field.strip() for field in fields]
+        suite.append({"name": name, "workingDir": workingDir, "args": args.split(), "simtime": simtime,
+                      "ues": ues, "cells": cells, "bands": bands, "overrides": overrides.split()})
+    return suite
+
+
+def dimensionValues(column, requested):
+    if column == "-":
+        return [None]
+    return requested if requested else [int(value) for value in column.split(";")]
+
+
+def variants(entry, args):
+    for ues, cells, bands in itertools.product(dimensionValues(entry["ues"], args.ues),
+                                               dimensionValues(entry["cells"], args.cells),
+                                               dimensionValues(entry["bands"], args.bands)):
+        values = {"ues": ues, "cells": cells, "bands": bands}
+        name = entry["name"] + "".join("-%s=%d" % (key, value) for key, value in values.items() if value is not None)
+        overrides = ["--" + override.format(**values) for override in entry["overrides"]]
+        yield name, values, overrides
+
+
+def parseSimTime(text):
+    match = re.fullmatch(r"([0-9.]+)\s*(s|ms|us)?", text)
+    if not match:
+        raise ValueError("cannot parse simulation time '%s'" % text)
+    scale = {"s": 1, "ms": 1e-3, "us": 1e-6, None: 1}[match.group(2)]
+    return float(match.group(1)) * scale
+
+
+def runOnce(entry, overrides, allocCounter):
+    with tempfile.TemporaryDirectory() as resultDir:
+        countFile = os.path.join(resultDir, "allocations")
+        logFile = os.path.join(resultDir, "out.log")
+        command = ["simu5g", "-u", "Cmdenv"] + entry["args"] + [
+                   "--sim-time-limit=" + entry["simtime"],
+                   "--cmdenv-express-mode=true", "--cmdenv-status-frequency=1000s",
+                   "--**.vector-recording=false", "--**.scalar-recording=false",
+                   "--result-dir=" + resultDir] + overrides
+        env = dict(os.environ)
+        if allocCounter:
+            env.update(LD_PRELOAD=allocCounter, ALLOCCOUNT_FILE=countFile)
+
+        with open(logFile, "w") as log:
+            start = time.perf_counter()
+            process = subprocess.Popen(command, cwd=rootDir + entry["workingDir"], env=env, stdout=log, stderr=subprocess.STDOUT)
+            _, status, usage = os.wait4(process.pid, 0)
+            elapsed = time.perf_counter() - start
+        process.returncode = os.waitstatus_to_exitcode(status)
+
+        with open(logFile) as log:
+            output = log.read()
+        if process.returncode != 0:
+            sys.stderr.write(output)
+            raise RuntimeError("%s exited with code %d" % (" ".join(command), process.returncode))
+
+        events = [int(n) for n in re.findall(r"[Ee]vent #(\d+)", output)]
+        if not events:
+            raise RuntimeError("cannot find the number of events in the output of %s" % " ".join(command))
+        allocations = None
+        if allocCounter:
+            with open(countFile) as f:
+                allocations = sum(int(line) for line in f)
+        return {"events": max(events), "wallClockSeconds": elapsed, "peakRssKiB": usage.ru_maxrss, "allocations": allocations}
+
+
+def runVariant(entry, overrides, repeat, allocCounter):
+    runs = [runOnce(entry, overrides, allocCounter) for _ in range(repeat)]
+    # the fastest run is the least disturbed by the rest of the system
+    best = min(runs, key=lambda run: run["wallClockSeconds"])
+    simSeconds = parseSimTime(entry["simtime"])
+    return {
+        "events": best["events"],
+        "simSeconds": simSeconds,
+        "wallClockSeconds": best["wallClockSeconds"],
+        "eventsPerSecond": best["events"] / best["wallClockSeconds"],
+        "wallClockPerSimSecond": best["wallClockSeconds"] / simSeconds,
+        "peakRssKiB": max(run["peakRssKiB"] for run in runs),
+        "allocations": best["allocations"],
+    }
+
+
+def compare(name, result, baseline, metrics, tolerance):
+    """Returns the list of regressions of the given result with respect to the baseline, for the given metrics"""
+    regressions = []
+    for metric, higherIsBetter in metrics.items():
+        value, reference = result.get(metric), baseline.get(metric)
+        if value is None or not reference:
+            continue
+        change = (value - reference) / reference * 100
+        if (-change if higherIsBetter else change) > tolerance:
+            regressions.append("%s %s: %.4g -> %.4g (%+.1f%%)" % (name, metric, reference, value, change))
+    return regressions
+
+
+def readBaseline(fileName):
+    if not os.path.exists(fileName):
+        return {}
+    with open(fileName) as f:
+        return {result["name"]: result for result in json.load(f)["results"]}
+
+
+def writeBaseline(fileName, report, results, metrics):
+    """Stores the given metrics of the results, keeping the baseline of the variants that were not run"""
+    keys = ["name", "ues", "cells", "bands"] + list(metrics)
+    results = [{key: result[key] for key in keys if result[key] is not None} for result in results]
+    names = set(result["name"] for result in results)
+    previous = [result for result in readBaseline(fileName).values() if result["name"] not in names]
+    with open(fileName, "w") as f:
+        json.dump(dict(report, results=sorted(previous + results, key=lambda result: result["name"])), f, indent=2)
+        f.write("\n")
+    print("Baseline written to " + fileName)
+
+
+def gitRevision():
+    try:
+        return subprocess.run(["git", "rev-parse", "--short", "HEAD"], cwd=rootDir, stdout=subprocess.PIPE,
+                              stderr=subprocess.DEVNULL, universal_newlines=True).stdout.strip()
+    except OSError:
+        return ""
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Run the Simu5G performance benchmark suite")
+    parser.add_argument("--suite", default=os.path.join(benchmarkDir, "perfsuite.csv"), help="CSV file with the scenarios")
+    parser.add_argument("--filter", default="", help="only run the variants whose name matches this regex")
+    parser.add_argument("--ues", type=int, nargs="+", help="UE counts (overrides the ones in the suite)")
+    parser.add_argument("--cells", type=int, nargs="+", help="cell counts (overrides the ones in the suite)")
+    parser.add_argument("--bands", type=int, nargs="+", help="numbers of RBs (overrides the ones in the suite)")
+    parser.add_argument("--repeat", type=int, default=1, help="runs of each variant; the fastest one is reported")
+    parser.add_argument("--no-alloc-count", action="store_true", help="do not count heap allocations")
+    parser.add_argument("--report", default="perfreport.json", help="JSON file to write the results to")
+    parser.add_argument("--baseline", default=os.path.join(benchmarkDir, "perfbaseline.json"),
+                        help="JSON file with the baseline of the events and allocations")
+    parser.add_argument("--local-baseline", default=os.path.join(benchmarkDir, "perfbaseline.local.json"),
+                        help="JSON file with the baseline of the timings and memory usage, recorded on this machine")
+    parser.add_argument("--update-baseline", action="store_true", help="store the results as the new baselines")
+    parser.add_argument("--allow-missing-baseline", action="store_true",
+                        help="do not fail the variants that have no entry in the baseline")
+    parser.add_argument("--tolerance", type=float, default=10, help="accepted regression, in percent")
+    args = parser.parse_args()
+
+    baseline, localBaseline = {}, {}
+    if not args.update_baseline:
+        baseline = readBaseline(args.baseline)
+        localBaseline = readBaseline(args.local_baseline)
+
+    results = []
+    regressions = []
+    with tempfile.TemporaryDirectory() as buildDir:
+        allocCounter = None if args.no_alloc_count else buildAllocCounter(buildDir)
+        for entry in readSuite(args.suite):
+            for name, values, overrides in variants(entry, args):
+                if not re.search(args.filter, name):
+                    continue
+                result = dict(name=name, **values, **runVariant(entry, overrides, args.repeat, allocCounter))
+                results.append(result)
+
+                status = ""
+                if not args.update_baseline:
+                    failures = compare(name, result, baseline.get(name, {}), deterministicMetrics, args.tolerance)
+                    failures += compare(name, result, localBaseline.get(name, {}), timingMetrics, args.tolerance)
+                    if name not in baseline and not args.allow_missing_baseline:
+                        failures.append("%s: no entry in %s" % (name, args.baseline))
+                    regressions += failures
+                    status = "FAILED" if failures else ("PASS" if name in baseline else "NO BASELINE")
+                allocations = "-" if result["allocations"] is None else str(result["allocations"])
+                print("%-50s events=%-10d %12.0f ev/s %10.3f s/simsec  peakRSS=%8d KiB  allocations=%-12s %s" % (
+                      name, result["events"], result["eventsPerSecond"], result["wallClockPerSimSecond"],
+                      result["peakRssKiB"], allocations, status))
+                sys.stdout.flush()
+
+    report = {
+        "date": datetime.datetime.now().isoformat(timespec="seconds"),
+        "host": platform.node(),
+        "platform": platform.platform(),
+        "revision": gitRevision(),
+        "tolerance": args.tolerance,
+        "results": results,
+    }
+    with open(args.report, "w") as f:
+        json.dump(report, f, indent=2)
+    if args.update_baseline:
+        # the date and host of the committed baseline would only cause spurious diffs
+        writeBaseline(args.baseline, {"revision": report["revision"]}, results, deterministicMetrics)
+        writeBaseline(args.local_baseline, report, results, timingMetrics)
+    else:
+        if any(result["name"] not in baseline for result in results):
+            print("Some variants have no baseline in %s, run them with --update-baseline to record it" % args.baseline)
+        if not localBaseline:
+            print("No local baseline recorded in %s, timings are not compared; run with --update-baseline "
+                  "on this machine to record them" % args.local_baseline)
+
+    for regression in regressions:
+        print("FAILED: " + regression)
+    return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
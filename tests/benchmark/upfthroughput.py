@@ -0,0 +1,82 @@
+#!/usr/bin/env python3
+#
+# UPF throughput benchmark
+#
+# Runs the UpfThroughput configuration of simulations/nr/standalone and reports
+# how many GTP-U packets per wall-clock second the UPF processed, i.e. the number
+# of packets sent and received by its GtpUser module divided by the elapsed time.
+#
+# Usage (after '. setenv' in the Simu5G root directory):
+#   python3 upfthroughput.py [--numUe 20 50 100] [--interval 1ms] [--simtime 5s] [--repeat 3]
+#
+
+import argparse
+import json
+import os
+import re
+import subprocess
+import sys
+import tempfile
+import time
+
+rootDir = os.path.abspath(os.path.join(os.path.dirname(__file__), "..", ".."))
+workingDir = os.path.join(rootDir, "simulations", "nr", "standalone")
+upfModulePattern = re.compile(r"\.upf\.gtp_user$")
+
+
+def countUpfPackets(scaFile):
+    packets = 0
+    with open(scaFile) as f:
+        for line in f:
+            fields = line.split()
+            if len(fields) == 4 and fields[0] == "scalar" and upfModulePattern.search(fields[1]) and fields[2] in ("gtpPacketSent:count", "gtpPacketReceived:count"):
+                packets += int(float(fields[3]))
+    return packets
+
+
+def runOnce(numUe, interval, simtime):
+    with tempfile.TemporaryDirectory() as resultDir:
+        scaFile = os.path.join(resultDir, "upf.sca")
+        command = ["simu5g", "-u", "Cmdenv", "-f", "omnetpp.ini", "-c", "UpfThroughput", "-r", "0",
+                   "--sim-time-limit=" + simtime,
+                   "--*.numUe=%d" % numUe, "--*.server.numApps=%d" % numUe,
+                   "--*.server.app[*].samplingTime=" + interval,
+                   "--cmdenv-express-mode=true", "--cmdenv-status-frequency=1000s",
+                   "--output-scalar-file=" + scaFile, "--output-vector-file=" + os.path.join(resultDir, "upf.vec")]
+        start = time.perf_counter()
+        result = subprocess.run(command, cwd=workingDir, stdout=subprocess.PIPE, stderr=subprocess.STDOUT, universal_newlines=True)
+        elapsed = time.perf_counter() - start
+        if result.returncode != 0:
+            sys.stderr.write(result.stdout)
+            raise RuntimeError("simulation exited with code %d" % result.returncode)
+        return countUpfPackets(scaFile), elapsed
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Measure UPF throughput in GTP-U packets per wall-clock second")
+    parser.add_argument("--numUe", type=int, nargs="+", default=[20], help="number of UEs (one DL CBR flow each)")
+    parser.add_argument("--interval", default="1ms", help="packet interval of each flow")
+    parser.add_argument("--simtime", default="5s", help="simulated time")
+    parser.add_argument("--repeat", type=int, default=3, help="runs per point, the fastest one is reported")
+    parser.add_argument("--json", help="write the results to this file")
+    args = parser.parse_args()
+
+    results = []
+    for numUe in args.numUe:
+        best = None
+        for _ in range(args.repeat):
+            packets, elapsed = runOnce(numUe, args.interval, args.simtime)
+            if best is None or elapsed < best[1]:
+                best = (packets, elapsed)
+        packets, elapsed = best
+        results.append({"numUe": numUe, "interval": args.interval, "simtime": args.simtime,
+                        "upfPackets": packets, "wallClockSeconds": elapsed, "packetsPerSecond": packets / elapsed})
+        print("numUe=%-5d upfPackets=%-10d elapsed=%8.3fs  %12.0f packets/s" % (numUe, packets, elapsed, packets / elapsed))
+
+    if args.json:
+        with open(args.json, "w") as f:
+            json.dump(results, f, indent=2)
+
+
+if __name__ == "__main__":
+    main()